@@ -389,7 +389,7 @@ main(void)
     hal_gpio_init_out(LED_BLINK_PIN, 1);
 
     while (1) {
-        os_eventq_run(os_eventq_dflt_get());
+        os_eventq_run_n(os_eventq_dflt_get(), 0);
     }
     /* Never exit */
 
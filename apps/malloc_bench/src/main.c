@@ -0,0 +1,152 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "sysinit/sysinit.h"
+#include "os/os.h"
+#include "malloc_bench.h"
+
+/* How often (in trace steps) fragmentation of the heap is sampled. */
+#define MALLOC_BENCH_FRAG_INTERVAL  16
+
+struct malloc_bench_stats {
+    uint32_t alloc_cnt;
+    uint32_t alloc_usecs;
+    uint32_t alloc_max;
+    uint32_t free_cnt;
+    uint32_t free_usecs;
+    uint32_t free_max;
+    uint32_t fail_cnt;
+    /* Worst 1 - largest free block / free bytes seen, in per mille. */
+    uint32_t frag_max;
+};
+
+static void *slots[MALLOC_BENCH_SLOTS];
+
+static void
+malloc_bench_sample_frag(struct malloc_bench_stats *stats)
+{
+#if MYNEWT_VAL(BASELIBC_PRESENT)
+    size_t free_bytes;
+    size_t largest;
+    uint32_t frag;
+
+    get_malloc_memory_status(&free_bytes, &largest);
+    if (free_bytes == 0) {
+        return;
+    }
+    frag = 1000 - (uint32_t)((uint64_t)largest * 1000 / free_bytes);
+    if (frag > stats->frag_max) {
+        stats->frag_max = frag;
+    }
+#else
+    (void)stats;
+#endif
+}
+
+static void
+malloc_bench_run(struct malloc_bench_stats *stats)
+{
+    const struct malloc_bench_op *op;
+    uint32_t start;
+    uint32_t usecs;
+    int i;
+
+    for (i = 0; i < malloc_bench_trace_len; i++) {
+        op = &malloc_bench_trace[i];
+
+        if (op->size != 0) {
+            start = os_cputime_get32();
+            slots[op->slot] = os_malloc(op->size);
+            usecs = os_cputime_ticks_to_usecs(os_cputime_get32() - start);
+
+            if (slots[op->slot] == NULL) {
+                stats->fail_cnt++;
+                continue;
+            }
+            stats->alloc_cnt++;
+            stats->alloc_usecs += usecs;
+            if (usecs > stats->alloc_max) {
+                stats->alloc_max = usecs;
+            }
+        } else if (slots[op->slot] != NULL) {
+            start = os_cputime_get32();
+            os_free(slots[op->slot]);
+            usecs = os_cputime_ticks_to_usecs(os_cputime_get32() - start);
+            slots[op->slot] = NULL;
+
+            stats->free_cnt++;
+            stats->free_usecs += usecs;
+            if (usecs > stats->free_max) {
+                stats->free_max = usecs;
+            }
+        }
+
+        if (i % MALLOC_BENCH_FRAG_INTERVAL == 0) {
+            malloc_bench_sample_frag(stats);
+        }
+    }
+
+    /* Release whatever the trace left allocated before the next round. */
+    for (i = 0; i < MALLOC_BENCH_SLOTS; i++) {
+        os_free(slots[i]);
+        slots[i] = NULL;
+    }
+}
+
+int
+main(void)
+{
+    struct malloc_bench_stats stats = { 0 };
+    int i;
+
+    sysinit();
+
+    printf("\n=== malloc benchmark (%s), %d ops x %d rounds ===\n",
+           MYNEWT_VAL(BASELIBC_MALLOC_TLSF) ? "tlsf" : "first fit",
+           malloc_bench_trace_len, MYNEWT_VAL(MALLOC_BENCH_ROUNDS));
+
+    for (i = 0; i < MYNEWT_VAL(MALLOC_BENCH_ROUNDS); i++) {
+        malloc_bench_run(&stats);
+    }
+
+    printf("malloc: %lu calls, avg %lu us, max %lu us, %lu failed\n",
+           (unsigned long)stats.alloc_cnt,
+           (unsigned long)(stats.alloc_cnt ?
+                           stats.alloc_usecs / stats.alloc_cnt : 0),
+           (unsigned long)stats.alloc_max,
+           (unsigned long)stats.fail_cnt);
+    printf("free:   %lu calls, avg %lu us, max %lu us\n",
+           (unsigned long)stats.free_cnt,
+           (unsigned long)(stats.free_cnt ?
+                           stats.free_usecs / stats.free_cnt : 0),
+           (unsigned long)stats.free_max);
+    printf("worst fragmentation: %lu.%lu%%\n",
+           (unsigned long)(stats.frag_max / 10),
+           (unsigned long)(stats.frag_max % 10));
+
+    while (1) {
+        os_eventq_run(os_eventq_dflt_get());
+    }
+
+    return 0;
+}
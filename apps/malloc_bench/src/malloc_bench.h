@@ -0,0 +1,46 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#ifndef H_MALLOC_BENCH_
+#define H_MALLOC_BENCH_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MALLOC_BENCH_SLOTS  64
+
+/*
+ * One step of an allocation trace.  A non-zero size allocates that many
+ * bytes into the slot, a size of zero frees the slot.
+ */
+struct malloc_bench_op {
+    uint16_t slot;
+    uint16_t size;
+};
+
+extern const struct malloc_bench_op malloc_bench_trace[];
+extern const int malloc_bench_trace_len;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,518 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include "malloc_bench.h"
+
+/*
+ * Synthetic trace of a networked device: a few long-lived buffers which are
+ * occasionally replaced by ones of another size, many short-lived small
+ * objects, packet sized messages and the odd large buffer.  Peak live heap
+ * use is about 12.5kB.  A trace captured on a device can be dropped in
+ * instead, in the same format.
+ */
+const struct malloc_bench_op malloc_bench_trace[] = {
+    {  0,  768 }, {  1,   48 }, {  2,   48 }, {  3,  512 }, {  4,  768 },
+    {  5,  256 }, {  6,  512 }, {  7,  160 }, { 58, 1262 }, { 22,   83 },
+    {  8,   13 }, { 13,    8 }, { 21,   62 }, { 59,  616 }, { 55,  216 },
+    { 40,  595 }, { 48,  307 }, { 36,  107 }, { 42,  396 }, { 30,   58 },
+    { 21,    0 }, { 49,  287 }, { 19,  100 }, { 63,  660 }, { 63,    0 },
+    { 49,    0 }, { 29,   12 }, { 28,   79 }, { 29,    0 }, { 22,    0 },
+    { 63,  669 }, { 48,    0 }, { 30,    0 }, { 47,  430 }, { 16,   12 },
+    { 50,  511 }, {  8,    0 }, { 18,  120 }, { 55,    0 }, { 50,    0 },
+    { 36,    0 }, { 45,  391 }, { 61, 1343 }, { 56,  674 }, { 28,    0 },
+    { 19,    0 }, { 11,   34 }, { 22,   81 }, { 22,    0 }, { 30,   53 },
+    { 38,   20 }, { 60, 1318 }, { 16,    0 }, { 11,    0 }, { 56,    0 },
+    { 16,   35 }, { 44,  548 }, { 14,  117 }, { 21,   82 }, { 25,   73 },
+    { 12,   81 }, { 14,    0 }, { 45,    0 }, { 48,  375 }, { 18,    0 },
+    { 51,  429 }, { 33,  121 }, { 38,    0 }, { 21,    0 }, { 30,    0 },
+    { 47,    0 }, { 38,   41 }, { 28,   60 }, { 50,  548 }, { 23,   77 },
+    { 38,    0 }, { 35,  115 }, { 38,   93 }, { 21,   75 }, { 38,    0 },
+    { 33,    0 }, { 32,   82 }, { 15,   29 }, { 29,   87 }, { 42,    0 },
+    {  8,   33 }, { 44,    0 }, { 28,    0 }, { 48,    0 }, { 42,  407 },
+    { 30,   64 }, {  9,   93 }, { 22,   98 }, { 48,  403 }, { 22,    0 },
+    { 46,  269 }, { 36,  123 }, {  9,    0 }, { 30,    0 }, { 21,    0 },
+    { 46,    0 }, { 33,   35 }, { 10,   22 }, { 55,  251 }, { 16,    0 },
+    { 11,   22 }, { 40,    0 }, { 18,   93 }, { 17,   73 }, { 21,   40 },
+    { 52,  382 }, { 51,    0 }, { 43,  483 }, { 13,    0 }, { 26,  102 },
+    { 42,    0 }, { 14,   57 }, { 29,    0 }, { 26,    0 }, { 13,  105 },
+    { 31,   92 }, { 25,    0 }, { 21,    0 }, { 35,    0 }, { 37,   12 },
+    { 12,    0 }, { 48,    0 }, { 10,    0 }, { 53,  348 }, { 41,  271 },
+    { 17,    0 }, { 39,   94 }, { 29,   75 }, { 45,  480 }, { 43,    0 },
+    { 29,    0 }, { 20,   71 }, { 21,   65 }, { 61,    0 }, { 36,    0 },
+    { 61,  763 }, { 43,  256 }, { 31,    0 }, { 27,   82 }, { 20,    0 },
+    { 11,    0 }, { 14,    0 }, { 32,    0 }, { 53,    0 }, { 11,   90 },
+    { 50,    0 }, { 42,  241 }, { 31,   22 }, { 47,  410 }, { 25,    8 },
+    { 30,  111 }, { 11,    0 }, { 36,   48 }, {  9,   98 }, { 54,  218 },
+    { 45,    0 }, { 40,  507 }, { 34,   25 }, { 28,  111 }, { 32,   28 },
+    { 48,  456 }, { 31,    0 }, { 16,   95 }, { 20,   11 }, { 15,    0 },
+    {  8,    0 }, { 21,    0 }, { 39,    0 }, { 22,   80 }, { 11,   13 },
+    { 17,   91 }, { 40,    0 }, { 18,    0 }, { 29,  128 }, { 53,  375 },
+    { 37,    0 }, { 30,    0 }, { 35,   16 }, { 39,  119 }, { 38,    9 },
+    { 15,   16 }, { 34,    0 }, { 11,    0 }, { 10,   19 }, { 10,    0 },
+    { 19,  106 }, { 31,   43 }, { 16,    0 }, { 19,    0 }, { 49,  230 },
+    { 19,   45 }, { 52,    0 }, { 34,   51 }, { 18,   37 }, { 17,    0 },
+    { 23,    0 }, { 38,    0 }, { 36,    0 }, { 48,    0 }, { 62,  789 },
+    { 43,    0 }, { 52,  463 }, { 22,    0 }, { 23,   41 }, { 15,    0 },
+    { 12,   71 }, {  9,    0 }, {  1,    0 }, {  1,   96 }, { 17,   60 },
+    { 19,    0 }, { 15,   11 }, { 10,   24 }, { 28,    0 }, { 11,   95 },
+    { 49,    0 }, { 25,    0 }, { 54,    0 }, {  8,   70 }, { 47,    0 },
+    { 16,   36 }, { 44,  258 }, { 19,   86 }, { 23,    0 }, { 29,    0 },
+    { 32,    0 }, { 26,   32 }, { 46,  364 }, { 52,    0 }, { 34,    0 },
+    { 48,  302 }, { 15,    0 }, { 26,    0 }, { 46,    0 }, { 52,  324 },
+    {  5,    0 }, {  5,  256 }, { 47,  388 }, {  8,    0 }, { 35,    0 },
+    { 31,    0 }, { 39,    0 }, { 37,  122 }, { 11,    0 }, { 51,  366 },
+    { 52,    0 }, { 42,    0 }, { 20,    0 }, {  8,   95 }, { 51,    0 },
+    { 33,    0 }, { 10,    0 }, { 10,   18 }, { 10,    0 }, { 17,    0 },
+    {  3,    0 }, {  3,  160 }, { 11,   56 }, { 35,   51 }, { 30,   67 },
+    { 19,    0 }, { 13,    0 }, { 35,    0 }, { 38,    8 }, { 16,    0 },
+    { 20,  127 }, { 32,  117 }, { 26,   13 }, { 34,  103 }, { 20,    0 },
+    { 12,    0 }, { 45,  537 }, { 21,   23 }, { 26,    0 }, { 44,    0 },
+    { 30,    0 }, { 17,    8 }, { 38,    0 }, { 21,    0 }, { 27,    0 },
+    { 20,   24 }, { 11,    0 }, { 59,    0 }, { 48,    0 }, { 57,  719 },
+    { 16,  128 }, { 18,    0 }, { 24,  115 }, { 11,   67 }, { 15,   20 },
+    { 12,    8 }, { 49,  327 }, {  7,    0 }, {  7,  512 }, { 52,  204 },
+    { 18,   45 }, { 31,   36 }, { 10,  118 }, {  8,    0 }, { 21,   40 },
+    { 32,    0 }, { 17,    0 }, { 23,   10 }, { 33,   46 }, { 30,   92 },
+    { 52,    0 }, { 34,    0 }, {  8,   82 }, { 24,    0 }, { 12,    0 },
+    { 21,    0 }, { 60,    0 }, { 16,    0 }, { 12,   97 }, { 33,    0 },
+    { 31,    0 }, { 41,    0 }, { 22,   92 }, { 37,    0 }, { 45,    0 },
+    { 25,   26 }, { 46,  464 }, { 15,    0 }, { 19,   63 }, { 56, 1377 },
+    { 29,   87 }, { 13,   31 }, { 58,    0 }, { 20,    0 }, { 39,   64 },
+    { 19,    0 }, { 12,    0 }, { 57,    0 }, {  8,    0 }, { 59, 1442 },
+    { 28,   40 }, { 45,  325 }, { 18,    0 }, { 48,  359 }, { 39,    0 },
+    { 36,   13 }, { 25,    0 }, { 12,  120 }, { 54,  565 }, { 37,   87 },
+    { 28,    0 }, { 22,    0 }, { 29,    0 }, { 41,  206 }, { 36,    0 },
+    { 37,    0 }, { 31,   23 }, { 55,    0 }, { 40,  203 }, { 17,   28 },
+    { 13,    0 }, { 31,    0 }, {  1,    0 }, {  1,  768 }, { 40,    0 },
+    { 41,    0 }, { 61,    0 }, { 24,  100 }, { 15,   51 }, { 34,  119 },
+    { 12,    0 }, { 48,    0 }, { 30,    0 }, { 55,  220 }, { 15,    0 },
+    { 24,    0 }, { 60,  640 }, { 46,    0 }, { 54,    0 }, { 49,    0 },
+    { 62,    0 }, { 43,  499 }, { 28,   96 }, { 54,  302 }, { 21,   13 },
+    { 49,  341 }, { 52,  239 }, { 52,    0 }, { 42,  340 }, { 36,  118 },
+    { 36,    0 }, { 14,   46 }, { 11,    0 }, { 14,    0 }, { 14,   33 },
+    { 40,  304 }, { 32,   92 }, { 29,   33 }, { 14,    0 }, { 34,    0 },
+    { 27,   99 }, { 48,  440 }, { 40,    0 }, { 21,    0 }, { 23,    0 },
+    { 33,   34 }, { 31,   88 }, { 20,   47 }, { 24,   19 }, { 29,    0 },
+    { 20,    0 }, { 36,   13 }, { 54,    0 }, { 46,  451 }, {  8,   14 },
+    { 42,    0 }, { 29,  123 }, { 55,    0 }, { 33,    0 }, { 46,    0 },
+    { 13,  105 }, { 55,  280 }, { 45,    0 }, { 40,  222 }, { 25,   82 },
+    { 34,  107 }, { 43,    0 }, { 44,  254 }, { 30,   46 }, { 55,    0 },
+    { 37,   82 }, { 36,    0 }, { 30,    0 }, { 40,    0 }, { 13,    0 },
+    { 57, 1078 }, { 17,    0 }, { 63,    0 }, { 48,    0 }, { 25,    0 },
+    { 10,    0 }, { 24,    0 }, { 28,    0 }, { 58,  737 }, { 28,  105 },
+    { 27,    0 }, { 30,   61 }, { 31,    0 }, { 30,    0 }, { 35,   33 },
+    { 43,  377 }, { 40,  333 }, {  8,    0 }, { 38,   67 }, { 39,  109 },
+    { 59,    0 }, { 53,    0 }, { 50,  446 }, { 29,    0 }, { 58,    0 },
+    { 38,    0 }, { 49,    0 }, { 16,   56 }, { 57,    0 }, { 43,    0 },
+    {  9,   22 }, { 46,  224 }, { 14,   45 }, { 58,  736 }, { 59,  628 },
+    { 41,  331 }, { 22,   16 }, { 44,    0 }, { 39,    0 }, { 41,    0 },
+    { 40,    0 }, { 32,    0 }, { 47,    0 }, { 23,  124 }, { 37,    0 },
+    {  6,    0 }, {  6,  512 }, { 26,   73 }, { 11,   13 }, {  9,    0 },
+    { 22,    0 }, { 41,  213 }, { 55,  522 }, { 47,  421 }, { 14,    0 },
+    { 46,    0 }, { 16,    0 }, { 13,   22 }, { 39,   34 }, { 47,    0 },
+    { 39,    0 }, { 57, 1494 }, { 58,    0 }, {  8,   10 }, { 50,    0 },
+    { 27,   25 }, { 27,    0 }, { 47,  574 }, {  8,    0 }, { 34,    0 },
+    { 36,   55 }, {  0,    0 }, {  0,  160 }, { 54,  237 }, { 11,    0 },
+    { 13,    0 }, { 34,   11 }, { 58, 1100 }, { 55,    0 }, { 38,   20 },
+    { 15,  121 }, { 58,    0 }, { 28,    0 }, { 19,   35 }, { 34,    0 },
+    { 57,    0 }, { 54,    0 }, { 47,    0 }, { 21,  112 }, { 35,    0 },
+    { 46,  485 }, { 52,  263 }, { 27,   29 }, { 57,  723 }, { 13,   25 },
+    { 19,    0 }, { 55,  209 }, { 13,    0 }, { 15,    0 }, { 56,    0 },
+    { 45,  266 }, { 35,   79 }, { 57,    0 }, { 50,  324 }, { 27,    0 },
+    { 49,  468 }, { 53,  335 }, { 56, 1342 }, { 49,    0 }, { 23,    0 },
+    { 40,  253 }, { 46,    0 }, {  0,    0 }, {  0,  160 }, {  3,    0 },
+    {  3,  768 }, {  0,    0 }, {  0,   48 }, { 26,    0 }, { 31,   64 },
+    { 40,    0 }, { 11,  102 }, { 21,    0 }, { 55,    0 }, { 52,    0 },
+    { 35,    0 }, { 43,  593 }, { 43,    0 }, { 42,  565 }, { 57, 1389 },
+    { 36,    0 }, { 56,    0 }, { 14,   19 }, { 41,    0 }, { 12,   17 },
+    { 33,   49 }, { 38,    0 }, { 58,  824 }, { 35,  109 }, { 52,  505 },
+    { 50,    0 }, { 26,   35 }, { 31,    0 }, { 20,   77 }, { 50,  532 },
+    {  8,  103 }, { 54,  574 }, { 33,    0 }, { 52,    0 }, {  8,    0 },
+    { 24,   41 }, { 14,    0 }, { 29,   82 }, { 37,  106 }, { 11,    0 },
+    { 28,  123 }, {  4,    0 }, {  4,  512 }, { 53,    0 }, {  2,    0 },
+    {  2,  768 }, { 41,  362 }, { 55,  564 }, { 34,   66 }, { 30,   98 },
+    { 43,  240 }, { 29,    0 }, { 35,    0 }, { 24,    0 }, { 60,    0 },
+    { 41,    0 }, { 62,  897 }, { 28,    0 }, { 21,   23 }, { 29,   78 },
+    { 17,   87 }, { 27,   65 }, { 30,    0 }, { 15,  112 }, { 40,  472 },
+    { 42,    0 }, { 55,    0 }, { 34,    0 }, { 12,    0 }, { 37,    0 },
+    { 20,    0 }, { 29,    0 }, { 34,   93 }, { 26,    0 }, { 45,    0 },
+    { 37,    9 }, { 37,    0 }, { 31,   72 }, { 13,  113 }, { 59,    0 },
+    { 47,  306 }, { 10,  110 }, { 29,   85 }, { 30,   92 }, { 21,    0 },
+    { 28,   30 }, { 13,    0 }, { 17,    0 }, { 61,  998 }, { 48,  459 },
+    { 58,    0 }, { 21,  104 }, { 27,    0 }, { 11,   51 }, { 48,    0 },
+    { 30,    0 }, { 38,  126 }, { 15,    0 }, { 42,  511 }, { 39,   33 },
+    { 12,   99 }, { 55,  501 }, { 48,  516 }, { 14,   27 }, { 13,   31 },
+    { 54,    0 }, { 25,   44 }, { 28,    0 }, { 24,   57 }, { 27,   89 },
+    {  4,    0 }, {  4,  512 }, { 20,   35 }, { 38,    0 }, { 42,    0 },
+    { 34,    0 }, { 20,    0 }, { 48,    0 }, { 12,    0 }, { 50,    0 },
+    { 20,   23 }, { 49,  226 }, { 38,   90 }, { 33,   94 }, { 12,   91 },
+    { 21,    0 }, { 58,  955 }, { 17,   35 }, { 36,   78 }, { 22,   98 },
+    { 52,  268 }, { 28,   12 }, { 35,   95 }, { 55,    0 }, { 19,   79 },
+    { 18,   18 }, { 40,    0 }, { 32,  109 }, { 17,    0 }, { 40,  416 },
+    { 34,  105 }, { 48,  358 }, { 32,    0 }, { 30,   16 }, { 35,    0 },
+    { 19,    0 }, { 25,    0 }, { 25,   23 }, { 45,  238 }, { 42,  207 },
+    { 22,    0 }, { 31,    0 }, { 53,  242 }, { 49,    0 }, { 42,    0 },
+    { 54,  350 }, { 37,  114 }, { 18,    0 }, { 11,    0 }, { 14,    0 },
+    { 35,    9 }, { 12,    0 }, { 47,    0 }, { 24,    0 }, { 42,  201 },
+    { 53,    0 }, { 38,    0 }, {  9,   35 }, { 44,  303 }, { 25,    0 },
+    { 42,    0 }, { 35,    0 }, { 37,    0 }, { 18,   68 }, { 24,   13 },
+    { 32,  116 }, { 11,   34 }, { 44,    0 }, { 20,    0 }, { 30,    0 },
+    { 50,  350 }, { 27,    0 }, { 30,  119 }, { 30,    0 }, { 13,    0 },
+    { 32,    0 }, { 29,    0 }, { 54,    0 }, { 62,    0 }, { 45,    0 },
+    { 23,  105 }, { 32,   71 }, { 24,    0 }, { 62, 1491 }, { 27,   22 },
+    { 10,    0 }, { 36,    0 }, { 24,  121 }, {  2,    0 }, {  2,   48 },
+    { 34,    0 }, { 42,  228 }, { 47,  281 }, { 52,    0 }, {  6,    0 },
+    {  6,  512 }, { 54,  286 }, { 63,  690 }, { 14,   15 }, { 14,    0 },
+    { 33,    0 }, { 15,   80 }, { 20,   36 }, { 25,   85 }, { 38,   49 },
+    { 10,   72 }, {  8,   13 }, { 17,   17 }, { 15,    0 }, { 33,  102 },
+    { 20,    0 }, { 43,    0 }, { 14,   96 }, { 58,    0 }, { 28,    0 },
+    { 10,    0 }, { 33,    0 }, { 42,    0 }, { 18,    0 }, { 29,  125 },
+    {  8,    0 }, { 46,  234 }, { 45,  437 }, { 10,   42 }, { 55,  291 },
+    {  9,    0 }, { 14,    0 }, { 53,  533 }, { 47,    0 }, { 63,    0 },
+    { 39,    0 }, { 18,  118 }, { 12,   32 }, {  3,    0 }, {  3,  256 },
+    { 11,    0 }, { 17,    0 }, { 44,  323 }, { 43,  226 }, { 47,  314 },
+    { 10,    0 }, { 10,   38 }, { 11,   60 }, { 46,    0 }, { 46,  485 },
+    { 46,    0 }, { 21,   20 }, { 23,    0 }, { 32,    0 }, { 25,    0 },
+    { 46,  203 }, { 11,    0 }, { 56,  891 }, {  9,   36 }, { 55,    0 },
+    { 54,    0 }, { 42,  363 }, { 17,  114 }, { 12,    0 }, { 39,   47 },
+    {  9,    0 }, { 13,   14 }, {  9,   72 }, { 12,   21 }, { 19,   19 },
+    { 57,    0 }, { 42,    0 }, { 51,  438 }, { 49,  418 }, { 38,    0 },
+    { 40,    0 }, { 16,   70 }, { 33,   18 }, { 56,    0 }, { 30,   78 },
+    { 21,    0 }, { 32,   81 }, { 59,  629 }, { 40,  448 }, { 38,   13 },
+    { 54,  579 }, { 34,  115 }, { 34,    0 }, { 10,    0 }, { 40,    0 },
+    { 28,  108 }, { 36,   48 }, { 35,   60 }, { 40,  450 }, { 39,    0 },
+    { 16,    0 }, { 54,    0 }, { 35,    0 }, { 38,    0 }, { 40,    0 },
+    { 16,   62 }, { 32,    0 }, { 33,    0 }, { 47,    0 }, { 13,    0 },
+    { 12,    0 }, { 25,   36 }, { 25,    0 }, { 30,    0 }, { 15,   33 },
+    { 32,   44 }, { 59,    0 }, { 25,   48 }, { 27,    0 }, { 23,  101 },
+    { 51,    0 }, { 12,   49 }, { 30,   36 }, { 47,  304 }, { 15,    0 },
+    { 23,    0 }, { 22,   43 }, { 30,    0 }, { 24,    0 }, { 38,   20 },
+    { 22,    0 }, { 35,  115 }, { 28,    0 }, { 28,   15 }, { 25,    0 },
+    { 32,    0 }, { 13,  120 }, { 19,    0 }, { 33,   68 }, { 34,   61 },
+    { 31,   58 }, {  9,    0 }, { 11,   48 }, { 13,    0 }, { 50,    0 },
+    { 44,    0 }, { 34,    0 }, { 56,  920 }, { 18,    0 }, { 35,    0 },
+    { 34,   49 }, { 36,    0 }, { 38,    0 }, { 48,    0 }, { 15,   68 },
+    { 47,    0 }, { 39,   18 }, { 45,    0 }, { 63,  844 }, { 34,    0 },
+    { 34,   56 }, { 31,    0 }, { 32,   50 }, { 46,    0 }, { 54,  420 },
+    { 45,  251 }, { 28,    0 }, { 14,   61 }, { 50,  403 }, { 31,    8 },
+    { 39,    0 }, { 48,  378 }, { 42,  271 }, { 36,   76 }, { 54,    0 },
+    { 47,  362 }, { 31,    0 }, { 29,    0 }, { 53,    0 }, { 62,    0 },
+    { 30,  120 }, { 60,  775 }, { 35,  106 }, { 33,    0 }, { 14,    0 },
+    { 62,  973 }, { 56,    0 }, { 11,    0 }, { 30,    0 }, { 49,    0 },
+    { 38,   73 }, { 18,   50 }, { 30,   61 }, { 18,    0 }, { 52,  210 },
+    { 32,    0 }, { 38,    0 }, { 16,    0 }, { 17,    0 }, { 12,    0 },
+    { 16,   25 }, { 34,    0 }, { 38,  111 }, { 39,   33 }, { 41,  449 },
+    { 33,   87 }, { 33,    0 }, { 25,  104 }, {  7,    0 }, {  7,  512 },
+    { 16,    0 }, { 31,   13 }, { 27,   57 }, { 56, 1039 }, { 31,    0 },
+    { 34,   79 }, { 43,    0 }, { 19,   80 }, { 27,    0 }, { 19,    0 },
+    { 34,    0 }, { 30,    0 }, { 36,    0 }, { 31,   88 }, { 31,    0 },
+    { 39,    0 }, { 46,  405 }, { 25,    0 }, { 49,  544 }, { 49,    0 },
+    { 23,   94 }, {  9,    8 }, { 48,    0 }, { 15,    0 }, { 41,    0 },
+    {  9,    0 }, { 39,   98 }, { 50,    0 }, { 48,  333 }, { 32,   93 },
+    { 17,   61 }, { 46,    0 }, { 47,    0 }, { 24,   98 }, { 17,    0 },
+    { 35,    0 }, { 37,  111 }, { 34,   65 }, { 38,    0 }, { 42,    0 },
+    { 34,    0 }, { 47,  401 }, { 32,    0 }, { 45,    0 }, { 24,    0 },
+    { 53,  404 }, { 51,  290 }, { 20,   38 }, { 53,    0 }, { 37,    0 },
+    { 43,  407 }, { 48,    0 }, { 35,    8 }, { 35,    0 }, { 41,  252 },
+    { 14,   46 }, { 39,    0 }, { 29,   71 }, { 34,  122 }, { 34,    0 },
+    { 14,    0 }, { 19,   59 }, { 63,    0 }, { 19,    0 }, { 52,    0 },
+    { 42,  227 }, { 20,    0 }, { 10,  117 }, { 43,    0 }, { 14,   16 },
+    { 19,   38 }, { 22,  111 }, { 42,    0 }, { 48,  412 }, {  9,   15 },
+    { 59,  950 }, { 16,   62 }, { 10,    0 }, { 39,   32 }, { 30,   99 },
+    { 30,    0 }, { 39,    0 }, { 24,   24 }, { 30,   76 }, { 10,   81 },
+    { 18,  117 }, { 19,    0 }, { 58,  795 }, { 21,   53 }, {  8,   68 },
+    { 37,   39 }, { 33,   43 }, { 38,   76 }, { 18,    0 }, { 63, 1155 },
+    { 36,   52 }, { 28,  106 }, { 37,    0 }, { 17,   31 }, { 22,    0 },
+    { 32,   65 }, { 58,    0 }, { 54,  477 }, { 28,    0 }, { 25,   60 },
+    { 10,    0 }, { 24,    0 }, { 21,    0 }, { 36,    0 }, { 18,   24 },
+    { 30,    0 }, { 41,    0 }, { 20,  114 }, { 32,    0 }, { 37,   83 },
+    { 18,    0 }, { 20,    0 }, { 30,   78 }, { 42,  317 }, { 37,    0 },
+    { 46,  558 }, { 16,    0 }, { 31,   96 }, { 23,    0 }, {  8,    0 },
+    { 60,    0 }, { 25,    0 }, { 12,   10 }, { 17,    0 }, { 34,  111 },
+    { 13,   57 }, { 30,    0 }, { 62,    0 }, { 12,    0 }, { 25,    9 },
+    { 11,   76 }, { 38,    0 }, { 42,    0 }, { 58, 1472 }, { 42,  206 },
+    { 50,  311 }, { 11,    0 }, { 33,    0 }, { 27,  107 }, { 34,    0 },
+    { 35,   42 }, { 51,    0 }, { 27,    0 }, { 36,  105 }, { 31,    0 },
+    { 39,   73 }, { 30,   97 }, { 51,  432 }, { 50,    0 }, { 25,    0 },
+    { 12,   39 }, { 56,    0 }, { 39,    0 }, { 11,   45 }, { 48,    0 },
+    { 62,  978 }, { 36,    0 }, { 14,    0 }, { 18,   65 }, { 19,  124 },
+    { 15,   37 }, { 35,    0 }, { 30,    0 }, { 54,    0 }, { 49,  365 },
+    { 15,    0 }, { 29,    0 }, { 13,    0 }, { 18,    0 }, { 55,  384 },
+    { 11,    0 }, { 53,  452 }, { 21,  127 }, { 53,    0 }, {  9,    0 },
+    { 34,   58 }, { 46,    0 }, { 55,    0 }, { 16,  102 }, { 49,    0 },
+    { 16,    0 }, { 40,  242 }, { 55,  271 }, { 47,    0 }, { 20,  118 },
+    { 40,    0 }, { 34,    0 }, { 45,  236 }, { 54,  474 }, { 12,    0 },
+    { 55,    0 }, { 24,  115 }, { 43,  382 }, { 35,  110 }, { 51,    0 },
+    { 46,  535 }, { 43,    0 }, { 54,    0 }, { 45,    0 }, { 46,    0 },
+    { 38,  104 }, { 34,   67 }, { 42,    0 }, { 19,    0 }, { 11,   71 },
+    { 11,    0 }, { 39,   21 }, { 21,    0 }, {  8,   96 }, { 51,  361 },
+    { 39,    0 }, { 14,   37 }, { 24,    0 }, { 38,    0 }, { 31,   75 },
+    { 15,  124 }, { 20,    0 }, { 26,  107 }, { 35,    0 }, { 14,    0 },
+    { 29,   32 }, { 37,   98 }, { 19,   95 }, { 15,    0 }, { 56,  911 },
+    { 59,    0 }, { 62,    0 }, { 29,    0 }, { 22,  113 }, { 14,  119 },
+    { 16,   74 }, { 13,   55 }, { 35,  101 }, { 26,    0 }, {  9,   17 },
+    { 13,    0 }, { 55,  533 }, { 42,  382 }, { 39,   79 }, { 60,  727 },
+    { 22,    0 }, { 63,    0 }, { 39,    0 }, { 44,  383 }, { 33,   42 },
+    {  8,    0 }, { 54,  518 }, { 45,  364 }, { 18,   43 }, { 14,    0 },
+    { 19,    0 }, { 44,    0 }, { 45,    0 }, { 40,  225 }, { 18,    0 },
+    { 13,  111 }, { 40,    0 }, { 12,  104 }, {  0,    0 }, {  0,  512 },
+    { 54,    0 }, { 47,  504 }, { 31,    0 }, { 31,   88 }, { 52,  304 },
+    { 24,   71 }, { 31,    0 }, { 34,    0 }, { 50,  501 }, { 17,    8 },
+    { 55,    0 }, { 50,    0 }, { 13,    0 }, { 28,   60 }, { 37,    0 },
+    { 29,   36 }, { 13,  104 }, { 53,  231 }, { 56,    0 }, { 55,  308 },
+    { 35,    0 }, { 36,   29 }, { 61,    0 }, { 47,    0 }, { 12,    0 },
+    { 60,    0 }, { 32,   79 }, {  9,    0 }, { 51,    0 }, { 32,    0 },
+    { 29,    0 }, { 28,    0 }, {  9,   64 }, { 46,  472 }, { 45,  303 },
+    {  9,    0 }, { 14,   94 }, { 24,    0 }, { 14,    0 }, { 12,  125 },
+    { 37,   72 }, { 49,  479 }, { 46,    0 }, { 55,    0 }, { 16,    0 },
+    { 12,    0 }, { 25,  104 }, { 33,    0 }, { 43,  338 }, { 12,   35 },
+    { 31,  108 }, { 10,   39 }, { 14,   98 }, { 12,    0 }, { 13,    0 },
+    {  8,   85 }, { 57, 1375 }, { 17,    0 }, { 44,  524 }, { 60, 1426 },
+    { 38,    9 }, { 36,    0 }, { 24,  104 }, { 42,    0 }, { 49,    0 },
+    { 14,    0 }, {  8,    0 }, { 46,  552 }, { 35,   65 }, { 12,   12 },
+    { 22,  123 }, { 25,    0 }, { 51,  585 }, { 24,    0 }, { 17,   53 },
+    { 25,   43 }, { 34,   38 }, { 38,    0 }, { 21,   23 }, { 13,   42 },
+    { 36,   26 }, { 53,    0 }, { 55,  258 }, { 54,  568 }, { 38,  127 },
+    { 31,    0 }, { 38,    0 }, { 10,    0 }, { 23,  100 }, { 37,    0 },
+    { 35,    0 }, { 23,    0 }, { 15,  103 }, { 43,    0 }, { 28,   52 },
+    { 54,    0 }, { 42,  298 }, { 22,    0 }, { 37,  115 }, { 54,  406 },
+    { 41,  347 }, {  8,   74 }, {  9,  117 }, { 12,    0 }, {  8,    0 },
+    { 36,    0 }, { 46,    0 }, { 44,    0 }, { 18,   28 }, { 15,    0 },
+    { 27,   29 }, { 22,   63 }, { 46,  407 }, { 34,    0 }, { 54,    0 },
+    { 50,  392 }, { 46,    0 }, { 47,  429 }, { 21,    0 }, {  9,    0 },
+    { 33,   42 }, { 57,    0 }, { 47,    0 }, { 14,   36 }, { 28,    0 },
+    { 40,  246 }, { 42,    0 }, { 22,    0 }, { 37,    0 }, { 48,  542 },
+    { 41,    0 }, { 52,    0 }, { 14,    0 }, { 52,  370 }, { 45,    0 },
+    { 23,   26 }, { 51,    0 }, { 14,  116 }, { 31,   87 }, { 34,   21 },
+    { 35,  115 }, { 20,   33 }, { 28,   88 }, { 24,  104 }, { 37,   15 },
+    { 59, 1054 }, { 18,    0 }, { 37,    0 }, {  6,    0 }, {  6,  256 },
+    { 52,    0 }, { 32,   29 }, { 18,  109 }, { 52,  308 }, { 21,  101 },
+    { 52,    0 }, { 20,    0 }, { 59,    0 }, { 42,  540 }, { 38,  127 },
+    { 24,    0 }, { 40,    0 }, {  8,   64 }, { 46,  396 }, { 49,  254 },
+    { 28,    0 }, { 25,    0 }, { 44,  397 }, { 13,    0 }, { 37,   72 },
+    { 33,    0 }, { 39,   97 }, { 48,    0 }, { 27,    0 }, { 59, 1218 },
+    { 15,   71 }, { 27,   99 }, { 19,  105 }, { 27,    0 }, { 26,   49 },
+    { 29,  102 }, { 13,  103 }, { 49,    0 }, { 29,    0 }, { 43,  515 },
+    { 22,   80 }, { 26,    0 }, { 54,  313 }, { 37,    0 }, { 23,    0 },
+    {  3,    0 }, {  3,  512 }, { 55,    0 }, { 43,    0 }, { 27,   36 },
+    { 31,    0 }, { 35,    0 }, { 54,    0 }, { 54,  293 }, { 34,    0 },
+    { 33,   84 }, { 51,  299 }, { 21,    0 }, { 35,   37 }, { 57,  801 },
+    { 51,    0 }, { 40,  242 }, { 26,   61 }, { 17,    0 }, { 30,  115 },
+    { 35,    0 }, { 30,    0 }, { 33,    0 }, { 27,    0 }, { 26,    0 },
+    { 46,    0 }, { 60,    0 }, {  7,    0 }, {  7,  160 }, { 33,   91 },
+    { 32,    0 }, { 39,    0 }, { 14,    0 }, {  1,    0 }, {  1,  256 },
+    { 33,    0 }, { 32,  127 }, { 38,    0 }, { 23,    8 }, { 22,    0 },
+    { 53,  542 }, { 41,  501 }, { 54,    0 }, { 46,  396 }, { 62,  752 },
+    { 53,    0 }, { 32,    0 }, { 40,    0 }, { 35,   10 }, { 21,   18 },
+    { 13,    0 }, { 57,    0 }, { 44,    0 }, { 63, 1379 }, { 54,  597 },
+    { 26,   12 }, { 19,    0 }, { 24,  121 }, { 57, 1082 }, { 15,    0 },
+    { 23,    0 }, {  2,    0 }, {  2,  256 }, { 16,   12 }, { 30,   24 },
+    { 45,  280 }, { 38,   90 }, { 31,   81 }, { 23,   30 }, {  8,    0 },
+    { 38,    0 }, { 13,   90 }, { 23,    0 }, { 16,    0 }, { 21,    0 },
+    {  0,    0 }, {  0, 1024 }, { 30,    0 }, { 26,    0 }, { 24,    0 },
+    { 62,    0 }, {  2,    0 }, {  2,  160 }, { 18,    0 }, { 52,  533 },
+    { 23,   21 }, { 58,    0 }, { 19,   86 }, { 47,  262 }, { 62,  635 },
+    { 22,   64 }, { 39,   23 }, { 37,  120 }, { 17,   97 }, { 13,    0 },
+    { 53,  445 }, { 35,    0 }, { 29,   92 }, { 23,    0 }, { 39,    0 },
+    { 63,    0 }, { 29,    0 }, {  3,    0 }, {  3, 1024 }, { 32,   69 },
+    { 13,  121 }, { 37,    0 }, { 39,   75 }, { 15,   60 }, { 40,  421 },
+    { 29,   95 }, { 15,    0 }, {  9,   62 }, {  9,    0 }, { 52,    0 },
+    { 34,   65 }, { 48,  394 }, { 22,    0 }, { 12,   29 }, { 35,  124 },
+    { 47,    0 }, { 19,    0 }, { 51,  303 }, { 19,   47 }, { 20,   77 },
+    { 28,   34 }, { 40,    0 }, { 17,    0 }, { 29,    0 }, { 10,   47 },
+    { 36,   22 }, { 49,  489 }, { 33,   68 }, { 23,   26 }, { 49,    0 },
+    { 26,  103 }, { 28,    0 }, { 35,    0 }, { 49,  297 }, { 32,    0 },
+    { 10,    0 }, { 19,    0 }, { 37,  116 }, { 37,    0 }, { 26,    0 },
+    { 53,    0 }, { 18,   33 }, { 54,    0 }, { 63,  728 }, { 44,  296 },
+    { 28,   20 }, { 50,    0 }, { 22,  108 }, { 22,    0 }, { 52,  211 },
+    { 60,  653 }, { 39,    0 }, { 23,    0 }, { 50,  242 }, { 33,    0 },
+    { 16,   97 }, { 12,    0 }, { 44,    0 }, { 37,   92 }, { 50,    0 },
+    { 22,   46 }, { 28,    0 }, { 10,   88 }, { 23,  113 }, { 34,    0 },
+    { 28,   12 }, { 31,    0 }, { 28,    0 }, { 16,    0 }, { 23,    0 },
+    { 28,  126 }, { 31,   57 }, { 11,   43 }, {  9,   45 }, { 54,  322 },
+    { 18,    0 }, { 34,   46 }, { 62,    0 }, { 33,  111 }, { 47,  354 },
+    { 63,    0 }, { 26,   11 }, { 21,   23 }, { 43,  211 }, { 33,    0 },
+    { 27,   35 }, { 20,    0 }, { 47,    0 }, { 52,    0 }, { 24,   98 },
+    { 29,   74 }, { 44,  552 }, { 53,  210 }, { 27,    0 }, { 51,    0 },
+    { 46,    0 }, { 28,    0 }, { 58, 1110 }, { 33,   18 }, { 34,    0 },
+    { 45,    0 }, { 22,    0 }, { 21,    0 }, { 23,  119 }, { 22,  112 },
+    { 18,  123 }, { 24,    0 }, { 36,    0 }, { 27,   13 }, { 28,  102 },
+    { 58,    0 }, { 37,    0 }, { 19,   32 }, { 10,    0 }, { 30,   56 },
+    { 17,   90 }, { 53,    0 }, { 56, 1116 }, { 11,    0 }, { 57,    0 },
+    { 39,   23 }, { 44,    0 }, { 11,   24 }, { 37,   72 }, { 51,  600 },
+    {  9,    0 }, { 21,   59 }, { 46,  359 }, { 17,    0 }, { 38,   47 },
+    { 32,   39 }, { 15,  107 }, { 20,   75 }, { 26,    0 }, { 33,    0 },
+    { 59,    0 }, { 12,   83 }, { 53,  395 }, { 45,  351 }, { 34,  122 },
+    { 25,   97 }, { 10,   53 }, { 10,    0 }, { 33,   14 }, { 19,    0 },
+    { 22,    0 }, { 14,   51 }, { 15,    0 }, { 55,  508 }, { 31,    0 },
+    { 11,    0 }, { 34,    0 }, { 15,  115 }, { 16,  124 }, { 31,   78 },
+    { 24,   62 }, { 25,    0 }, { 22,   73 }, { 19,   65 }, { 21,    0 },
+    { 40,  420 }, {  8,   78 }, { 28,    0 }, { 11,   61 }, { 13,    0 },
+    { 14,    0 }, { 21,  127 }, { 15,    0 }, { 34,   49 }, { 28,   41 },
+    { 46,    0 }, { 25,   27 }, { 52,  515 }, { 25,    0 }, { 37,    0 },
+    { 39,    0 }, { 51,    0 }, { 46,  318 }, {  9,  100 }, { 49,    0 },
+    { 48,    0 }, { 32,    0 }, { 14,   75 }, { 34,    0 }, { 57,  661 },
+    { 12,    0 }, { 51,  436 }, { 20,    0 }, { 30,    0 }, { 25,   16 },
+    { 26,   39 }, { 26,    0 }, { 34,   93 }, { 31,    0 }, { 21,    0 },
+    { 15,  117 }, { 23,    0 }, { 33,    0 }, { 33,  122 }, { 35,   25 },
+    { 26,   49 }, { 53,    0 }, { 32,   12 }, { 55,    0 }, { 34,    0 },
+    { 58,  791 }, { 24,    0 }, { 34,   57 }, { 18,    0 }, { 17,  125 },
+    { 40,    0 }, { 28,    0 }, { 50,  216 }, { 11,    0 }, { 53,  201 },
+    { 52,    0 }, { 21,   97 }, { 50,    0 }, { 59,  700 }, { 36,   83 },
+    { 51,    0 }, { 58,    0 }, { 55,  336 }, { 22,    0 }, { 38,    0 },
+    { 25,    0 }, { 40,  410 }, { 32,    0 }, { 18,   33 }, { 36,    0 },
+    { 52,  466 }, { 45,    0 }, { 10,   58 }, { 43,    0 }, { 22,  107 },
+    { 14,    0 }, { 30,   85 }, { 62,  764 }, { 12,   26 }, { 34,    0 },
+    { 38,   23 }, { 12,    0 }, { 16,    0 }, { 18,    0 }, { 24,   59 },
+    { 62,    0 }, { 22,    0 }, { 13,   72 }, { 22,  113 }, { 11,   64 },
+    { 42,    0 }, { 20,  105 }, { 21,    0 }, { 49,  266 }, { 21,   93 },
+    { 51,  264 }, { 22,    0 }, { 32,   68 }, { 13,    0 }, { 35,    0 },
+    { 32,    0 }, { 15,    0 }, { 30,    0 }, { 43,  343 }, { 28,  123 },
+    { 20,    0 }, { 32,  119 }, { 13,   74 }, {  0,    0 }, {  0,  256 },
+    { 16,   78 }, { 25,  116 }, { 45,  551 }, { 21,    0 }, { 37,    8 },
+    {  8,    0 }, { 44,  539 }, { 54,    0 }, { 14,   92 }, { 52,    0 },
+    { 47,  502 }, { 39,   16 }, { 23,   37 }, { 27,    0 }, { 37,    0 },
+    { 33,    0 }, { 36,   10 }, { 34,   72 }, { 17,    0 }, { 31,   58 },
+    { 55,    0 }, { 39,    0 }, { 48,  225 }, { 40,    0 }, { 20,   89 },
+    { 19,    0 }, { 44,    0 }, { 10,    0 }, { 42,  366 }, { 40,  345 },
+    { 54,  466 }, { 52,  390 }, { 38,    0 }, { 48,    0 }, { 42,    0 },
+    { 28,    0 }, {  8,   60 }, { 62,  617 }, { 39,   49 }, { 11,    0 },
+    { 36,    0 }, { 23,    0 }, { 39,    0 }, {  0,    0 }, {  0,  256 },
+    { 23,   83 }, { 22,   68 }, { 54,    0 }, { 50,  375 }, { 20,    0 },
+    {  8,    0 }, { 21,   54 }, { 34,    0 }, { 37,   77 }, { 45,    0 },
+    { 38,   48 }, { 21,    0 }, { 37,    0 }, { 48,  359 }, {  0,    0 },
+    {  0,  160 }, { 13,    0 }, { 15,   83 }, { 31,    0 }, { 49,    0 },
+    { 49,  258 }, { 12,   29 }, { 53,    0 }, { 38,    0 }, { 51,    0 },
+    { 34,   72 }, { 38,   99 }, { 32,    0 }, { 32,   82 }, { 11,   40 },
+    { 56,    0 }, { 29,    0 }, { 36,  112 }, { 40,    0 }, { 52,    0 },
+    {  9,    0 }, { 55,  522 }, { 32,    0 }, { 38,    0 }, { 10,   22 },
+    { 10,    0 }, { 18,   55 }, { 25,    0 }, { 44,  566 }, { 13,   19 },
+    { 38,  100 }, { 51,  244 }, { 10,   23 }, { 16,    0 }, { 49,    0 },
+    { 26,    0 }, {  8,   69 }, { 41,    0 }, { 24,    0 }, { 21,   80 },
+    { 38,    0 }, { 20,   50 }, { 17,   78 }, { 49,  505 }, { 15,    0 },
+    { 17,    0 }, { 43,    0 }, { 36,    0 }, { 13,    0 }, { 51,    0 },
+    { 44,    0 }, { 61, 1332 }, { 27,  110 }, { 14,    0 }, { 27,    0 },
+    {  1,    0 }, {  1,  768 }, { 26,   39 }, { 17,  126 }, { 14,  115 },
+    { 58,  691 }, { 43,  342 }, { 53,  274 }, { 23,    0 }, { 43,    0 },
+    { 46,    0 }, { 14,    0 }, { 42,  243 }, { 21,    0 }, { 42,    0 },
+    {  9,   74 }, { 27,   62 }, { 26,    0 }, { 29,  120 }, { 44,  517 },
+    { 61,    0 }, { 47,    0 }, { 15,   50 }, { 35,   15 }, { 38,   74 },
+    { 28,  119 }, { 37,  106 }, { 30,   37 }, { 18,    0 }, { 42,  304 },
+    { 39,   66 }, { 15,    0 }, { 16,   72 }, { 45,  575 }, { 41,  252 },
+    { 31,   82 }, { 33,   35 }, { 50,    0 }, { 48,    0 }, {  9,    0 },
+    { 32,   49 }, { 14,  124 }, { 40,  265 }, { 27,    0 }, { 40,    0 },
+    { 22,    0 }, { 29,    0 }, { 21,   99 }, { 44,    0 }, { 30,    0 },
+    { 26,   97 }, { 22,  107 }, { 37,    0 }, { 61,  720 }, { 53,    0 },
+    { 28,    0 }, { 20,    0 }, { 11,    0 }, { 17,    0 }, { 32,    0 },
+    { 53,  310 }, { 17,   65 }, { 54,  438 }, { 36,   83 }, { 29,  101 },
+    { 54,    0 }, { 59,    0 }, { 55,    0 }, { 21,    0 }, { 41,    0 },
+    { 47,  490 }, { 51,  418 }, { 56, 1389 }, { 24,   43 }, { 28,   91 },
+    { 62,    0 }, {  8,    0 }, { 13,  113 }, { 21,   50 }, { 25,   19 },
+    { 20,   71 }, { 50,  326 }, { 32,   22 }, { 16,    0 }, { 12,    0 },
+    { 14,    0 }, { 16,  119 }, { 20,    0 }, { 10,    0 }, { 29,    0 },
+    { 26,    0 }, { 11,   20 }, { 22,    0 }, { 43,  300 }, { 16,    0 },
+    { 36,    0 }, { 32,    0 }, { 40,  380 }, { 43,    0 }, { 42,    0 },
+    { 34,    0 }, { 36,  125 }, { 41,  512 }, { 22,   71 }, { 21,    0 },
+    { 29,   36 }, { 28,    0 }, { 14,   56 }, { 47,    0 }, { 38,    0 },
+    { 17,    0 }, { 46,  228 }, { 19,   16 }, { 37,   89 }, { 50,    0 },
+    { 52,  450 }, { 15,   76 }, { 45,    0 }, { 22,    0 }, { 43,  336 },
+    { 30,   48 }, { 22,  114 }, { 21,   74 }, { 37,    0 }, { 23,   21 },
+    { 33,    0 }, { 11,    0 }, { 39,    0 }, { 12,   97 }, { 38,   93 },
+    { 39,   85 }, { 33,  121 }, { 11,   46 }, {  9,  118 }, { 40,    0 },
+    { 14,    0 }, { 28,  122 }, { 26,   41 }, { 16,  104 }, { 38,    0 },
+    { 43,    0 }, { 42,  239 }, { 32,  109 }, { 53,    0 }, { 34,  121 },
+    { 44,  394 }, { 28,    0 }, { 51,    0 }, { 61,    0 }, { 14,  128 },
+    { 55,  531 }, { 24,    0 }, { 52,    0 }, {  9,    0 }, { 21,    0 },
+    { 44,    0 }, { 47,  334 }, { 40,  592 }, { 47,    0 }, { 20,   43 },
+    { 12,    0 }, { 14,    0 }, { 17,   48 }, {  8,   31 }, { 54,  319 },
+    { 44,  528 }, { 42,    0 }, { 57,    0 }, { 28,   64 }, { 35,    0 },
+    { 63,  915 }, { 54,    0 }, { 24,   39 }, { 26,    0 }, { 19,    0 },
+    { 27,   48 }, { 51,  525 }, { 10,    9 }, { 17,    0 }, { 31,    0 },
+    { 19,   81 }, { 19,    0 }, { 34,    0 }, { 22,    0 }, { 33,    0 },
+    { 30,    0 }, { 18,   30 }, { 51,    0 }, { 57,  887 }, { 13,    0 },
+    { 22,   11 }, { 27,    0 }, { 16,    0 }, { 38,   67 }, { 24,    0 },
+    { 26,   35 }, { 22,    0 }, { 51,  409 }, { 24,   27 }, {  8,    0 },
+    { 46,    0 }, { 10,    0 }, { 51,    0 }, { 16,   19 }, {  9,  118 },
+    { 51,  346 }, { 24,    0 }, { 29,    0 }, { 11,    0 }, { 55,    0 },
+    { 63,    0 }, {  9,    0 }, { 40,    0 }, { 44,    0 }, { 59, 1450 },
+    { 14,  125 }, { 45,  245 }, { 25,    0 }, { 20,    0 }, { 45,    0 },
+    { 36,    0 }, { 61,  620 }, { 28,    0 }, { 55,  353 }, { 16,    0 },
+    { 43,  493 }, { 60,    0 }, { 32,    0 }, { 39,    0 }, { 15,    0 },
+    { 55,    0 }, { 23,    0 }, { 26,    0 }, { 49,    0 }, { 10,  103 },
+    { 51,    0 }, { 12,   41 }, { 38,    0 }, { 32,   28 }, { 36,   90 },
+    { 50,  359 }, { 19,   92 }, { 26,   27 }, { 56,    0 }, { 32,    0 },
+    { 52,  543 }, {  8,   63 }, { 10,    0 }, { 38,  102 }, {  3,    0 },
+    {  3,  160 }, { 18,    0 }, { 26,    0 }, { 41,    0 }, {  8,    0 },
+    { 43,    0 }, { 40,  283 }, { 51,  508 }, { 14,    0 }, { 19,    0 },
+    { 32,   59 }, { 29,  112 }, { 32,    0 }, { 54,  395 }, { 54,    0 },
+    { 12,    0 }, { 32,   71 }, { 36,    0 }, { 17,   79 }, { 38,    0 },
+    { 45,  210 }, { 39,   95 }, { 40,    0 }, { 27,  124 }, { 52,    0 },
+    { 38,   37 }, { 47,  278 }, { 29,    0 }, { 57,    0 }, { 45,    0 },
+    { 40,  309 }, { 45,  366 }, { 53,  429 }, { 38,    0 }, { 38,   99 },
+    { 30,   97 }, { 55,  591 }, {  2,    0 }, {  2,  256 }, { 34,   75 },
+    { 45,    0 }, { 12,   81 }, { 52,  518 }, { 42,  447 }, { 21,   16 },
+    { 49,  241 }, { 63,  932 }, { 25,   60 }, { 30,    0 }, { 15,   38 },
+    { 39,    0 }, { 39,  101 }, { 15,    0 }, { 55,    0 }, { 32,    0 },
+    { 34,    0 }, { 34,   25 }, { 38,    0 }, { 47,    0 }, {  8,   64 },
+    {  8,    0 }, { 48,  285 }, { 62,  895 }, { 21,    0 }, { 11,   96 },
+    { 62,    0 }, { 10,  115 }, { 44,  476 }, { 28,  108 }, { 47,  558 },
+    { 30,  127 }, { 28,    0 }, { 28,   80 }, { 27,    0 }, { 51,    0 },
+    { 18,   77 }, { 18,    0 }, { 45,  263 }, { 20,   86 }, { 54,  461 },
+    { 26,  111 }, { 24,   48 }, { 41,  260 }, { 22,    8 }, { 26,    0 },
+    { 21,  102 }, { 11,    0 }, { 12,    0 }, { 29,   31 }, { 26,   54 },
+    { 12,   69 }, { 12,    0 }, { 36,   69 }, { 10,    0 }, { 33,  114 },
+    { 49,    0 }, { 46,  390 }, { 11,   39 }, { 52,    0 }, { 36,    0 },
+    { 23,   23 }, { 43,  226 }, { 43,    0 }, { 36,  106 }, { 13,   24 },
+    { 43,  212 }, { 59,    0 }, { 41,    0 }, { 54,    0 }, { 53,    0 },
+    { 47,    0 }, { 10,   69 }, { 25,    0 }, { 43,    0 }, { 55,  533 },
+    { 43,  283 }, { 56, 1392 }, { 21,    0 }, { 38,  104 }, { 20,    0 },
+    { 39,    0 }, { 25,   59 }, { 53,  330 }, { 24,    0 }, { 23,    0 },
+    { 40,    0 }, { 28,    0 }, { 33,    0 }, { 26,    0 }, { 42,    0 },
+    { 49,  366 }, { 59,  931 }, { 25,    0 }, { 55,    0 }, { 43,    0 },
+    { 30,    0 }, { 16,   14 }, { 50,    0 }, { 13,    0 }, { 36,    0 },
+    { 22,    0 }, { 29,    0 }, { 38,    0 }, { 62,  831 }, { 48,    0 },
+    { 45,    0 }, { 44,    0 }, {  9,   12 }, { 28,   54 }, { 45,  517 },
+    { 42,  405 }, { 61,    0 }, { 24,  117 }, { 11,    0 }, { 23,  106 },
+    { 18,  124 }, { 15,   95 }, {  0,    0 }, {  0,   96 }, { 25,   78 },
+    { 18,    0 }, { 35,  110 }, {  9,    0 }, {  9,   70 }, { 28,    0 },
+    { 23,    0 }, { 40,  579 }, { 45,    0 }, { 17,    0 }, { 15,    0 },
+    { 26,   43 }, { 51,  368 }, { 47,  427 }, {  9,    0 }, { 37,  104 },
+    { 25,    0 }, { 16,    0 }, { 28,    8 }, { 51,    0 }, { 34,    0 },
+    { 42,    0 }, { 63,    0 }, { 60, 1139 }, { 47,    0 }, { 47,  382 },
+    { 37,    0 }, { 10,    0 }, { 25,   59 }, {  5,    0 }, {  5,   48 },
+    { 26,    0 }, { 28,    0 }, { 33,   43 }, { 53,    0 }, { 32,   39 },
+    { 52,  357 }, { 43,  437 }, { 57, 1179 }, { 32,    0 }, { 17,   91 },
+    { 48,  414 }, { 43,    0 }, {  2,    0 }, {  2,   96 }, { 33,    0 },
+    { 35,    0 }, { 49,    0 }, { 16,   29 }, { 20,  106 }, { 52,    0 },
+    { 26,   89 }, { 46,    0 }, { 36,  113 }, { 11,   58 }, { 16,    0 },
+    { 41,  340 }, { 33,   61 }, { 29,   90 }, { 42,  336 }, { 11,    0 },
+    { 11,   71 }, { 52,  397 }, { 26,    0 }, { 42,    0 }, { 58,    0 },
+    { 19,   24 }, { 37,  127 }, { 33,    0 }, { 43,  486 }, { 25,    0 },
+    { 58,  919 }, { 29,    0 }, { 32,  120 }, { 36,    0 }, { 13,   84 },
+    {  9,   30 }, { 28,  105 }, { 41,    0 }, { 39,   19 }, { 34,   18 },
+    { 26,   55 }, { 39,    0 }, { 48,    0 }, { 24,    0 }, { 10,   82 },
+    {  0,    0 }, {  1,    0 }, {  2,    0 }, {  3,    0 }, {  4,    0 },
+    {  5,    0 }, {  6,    0 }, {  7,    0 }, {  9,    0 }, { 10,    0 },
+    { 11,    0 }, { 13,    0 }, { 17,    0 }, { 19,    0 }, { 20,    0 },
+    { 26,    0 }, { 28,    0 }, { 32,    0 }, { 34,    0 }, { 37,    0 },
+    { 40,    0 }, { 43,    0 }, { 47,    0 }, { 52,    0 }, { 56,    0 },
+    { 57,    0 }, { 58,    0 }, { 59,    0 }, { 60,    0 }, { 62,    0 },
+};
+
+const int malloc_bench_trace_len =
+    sizeof malloc_bench_trace / sizeof malloc_bench_trace[0];
@@ -256,7 +256,7 @@ main(int argc, char **argv)
     ocf_init_tasks();
 
     while (1) {
-        os_eventq_run(os_eventq_dflt_get());
+        os_eventq_run_n(os_eventq_dflt_get(), 0);
     }
     /* Never returns */
 
@@ -533,7 +533,7 @@ main(int argc, char **argv)
      * As the last thing, process events from default event queue.
      */
     while (1) {
-        os_eventq_run(os_eventq_dflt_get());
+        os_eventq_run_n(os_eventq_dflt_get(), 0);
     }
 
     return (0);
@@ -24,11 +24,14 @@
 static uint8_t
 cbor_mbuf_reader_get8(struct cbor_decoder_reader *d, int offset)
 {
-    uint8_t val;
+    uint8_t *p;
     struct cbor_mbuf_reader *cb = (struct cbor_mbuf_reader *) d;
 
-    os_mbuf_copydata(cb->m, offset + cb->init_off, sizeof(val), &val);
-    return val;
+    p = os_mbuf_cursor_seek(&cb->cur, offset + cb->init_off, NULL);
+    if (p == NULL) {
+        return 0;
+    }
+    return *p;
 }
 
 static uint16_t
@@ -37,7 +40,8 @@ cbor_mbuf_reader_get16(struct cbor_decoder_reader *d, int offset)
     uint16_t val;
     struct cbor_mbuf_reader *cb = (struct cbor_mbuf_reader *) d;
 
-    os_mbuf_copydata(cb->m, offset + cb->init_off, sizeof(val), &val);
+    os_mbuf_cursor_copydata(&cb->cur, offset + cb->init_off, sizeof(val),
+                            &val);
     return cbor_ntohs(val);
 }
 
@@ -47,7 +51,8 @@ cbor_mbuf_reader_get32(struct cbor_decoder_reader *d, int offset)
     uint32_t val;
     struct cbor_mbuf_reader *cb = (struct cbor_mbuf_reader *) d;
 
-    os_mbuf_copydata(cb->m, offset + cb->init_off, sizeof(val), &val);
+    os_mbuf_cursor_copydata(&cb->cur, offset + cb->init_off, sizeof(val),
+                            &val);
     return cbor_ntohl(val);
 }
 
@@ -57,7 +62,8 @@ cbor_mbuf_reader_get64(struct cbor_decoder_reader *d, int offset)
     uint64_t val;
     struct cbor_mbuf_reader *cb = (struct cbor_mbuf_reader *) d;
 
-    os_mbuf_copydata(cb->m, offset + cb->init_off, sizeof(val), &val);
+    os_mbuf_cursor_copydata(&cb->cur, offset + cb->init_off, sizeof(val),
+                            &val);
     return cbor_ntohll(val);
 }
 
@@ -66,7 +72,7 @@ cbor_mbuf_reader_cmp(struct cbor_decoder_reader *d, char *buf, int offset,
                      size_t len)
 {
     struct cbor_mbuf_reader *cb = (struct cbor_mbuf_reader *) d;
-    return os_mbuf_cmpf(cb->m, offset + cb->init_off, buf, len) == 0;
+    return os_mbuf_cursor_cmpf(&cb->cur, offset + cb->init_off, buf, len) == 0;
 }
 
 static uintptr_t
@@ -76,7 +82,7 @@ cbor_mbuf_reader_cpy(struct cbor_decoder_reader *d, char *dst, int offset,
     int rc;
     struct cbor_mbuf_reader *cb = (struct cbor_mbuf_reader *) d;
 
-    rc = os_mbuf_copydata(cb->m, offset + cb->init_off, len, dst);
+    rc = os_mbuf_cursor_copydata(&cb->cur, offset + cb->init_off, len, dst);
     if (rc == 0) {
         return true;
     }
@@ -100,5 +106,6 @@ cbor_mbuf_reader_init(struct cbor_mbuf_reader *cb, struct os_mbuf *m,
     hdr = OS_MBUF_PKTHDR(m);
     cb->m = m;
     cb->init_off = initial_offset;
+    os_mbuf_cursor_init(&cb->cur, m);
     cb->r.message_size = hdr->omp_len - initial_offset;
 }
@@ -63,6 +63,10 @@ struct fcb {
     struct fcb_entry f_active;
     uint16_t f_active_id;
     uint8_t f_align;		/* writes to flash have to aligned to this */
+    uint8_t f_active_flags;	/* Sector header flags of active area */
+    uint8_t f_active_sums;	/* Summary slots used in active area */
+    uint16_t f_active_cnt;	/* Elements in active area */
+    uint32_t f_active_bytes;	/* Data bytes in active area */
 };
 
 /**
@@ -90,6 +94,30 @@ int fcb_init(struct fcb *fcb);
 int fcb_append(struct fcb *, uint16_t len, struct fcb_entry *loc);
 int fcb_append_finish(struct fcb *, struct fcb_entry *append_loc);
 
+/**
+ * A contiguous piece of an element passed to fcb_append_iov().
+ */
+struct fcb_iovec {
+    const void *fi_data;
+    uint16_t fi_len;
+};
+
+struct os_mbuf;
+
+/**
+ * fcb_append_iov() appends an element made up of the concatenation of
+ * iovcnt buffers, and fcb_append_mbuf() one made up of the buffers followed
+ * by the contents of an mbuf chain (iov may be NULL).  The element is
+ * written and its CRC computed in a single pass, with the FCB locked for
+ * the whole append; there is no fcb_append_finish() step.  Writes are
+ * padded to the flash alignment internally.  On success, loc (may be NULL)
+ * is filled in with the location of the new element.
+ */
+int fcb_append_iov(struct fcb *, const struct fcb_iovec *iov, int iovcnt,
+                   struct fcb_entry *loc);
+int fcb_append_mbuf(struct fcb *, const struct fcb_iovec *iov, int iovcnt,
+                    struct os_mbuf *om, struct fcb_entry *loc);
+
 /**
  * Walk over all entries in FCB.
  * cb gets called for every entry. If cb wants to stop the walk, it should
@@ -0,0 +1,82 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include <time.h>
+#include "fcb_sum_test.h"
+
+/*
+ * Compares the time fcb_init() takes on a full FCB against walking every
+ * element of the active sector, which is what mounting took before sector
+ * summaries.
+ */
+
+#define FTMB_ELEM_LEN       8
+#define FTMB_NUM_ROUNDS     200
+
+static double
+ftmb_usecs(clock_t clk)
+{
+    return (double)clk * 1000000 / CLOCKS_PER_SEC / FTMB_NUM_ROUNDS;
+}
+
+TEST_CASE_SELF(fcb_test_mount_bench)
+{
+    struct fcb_iovec iov;
+    struct fcb_entry loc;
+    uint8_t test_data[FTMB_ELEM_LEN];
+    clock_t mount_clk;
+    clock_t walk_clk;
+    clock_t start;
+    int round;
+    int rc;
+
+    fcb_tc_pretest(4);
+
+    memset(test_data, 0xa5, sizeof(test_data));
+    iov.fi_data = test_data;
+    iov.fi_len = sizeof(test_data);
+    do {
+        rc = fcb_append_iov(&test_fcb, &iov, 1, NULL);
+    } while (rc == 0);
+    TEST_ASSERT_FATAL(rc == FCB_ERR_NOSPACE);
+
+    start = clock();
+    for (round = 0; round < FTMB_NUM_ROUNDS; round++) {
+        memset(&test_fcb, 0, sizeof(test_fcb));
+        test_fcb.f_sector_cnt = 4;
+        test_fcb.f_sectors = test_fcb_area;
+        rc = fcb_init(&test_fcb);
+        TEST_ASSERT_FATAL(rc == 0);
+    }
+    mount_clk = clock() - start;
+
+    start = clock();
+    for (round = 0; round < FTMB_NUM_ROUNDS; round++) {
+        loc.fe_area = test_fcb.f_active.fe_area;
+        loc.fe_elem_off = sizeof(struct fcb_disk_area);
+        while (fcb_getnext_in_area(&test_fcb, &loc) == 0) {
+        }
+    }
+    walk_clk = clock() - start;
+
+    TEST_ASSERT(loc.fe_elem_off == test_fcb.f_active.fe_elem_off);
+
+    printf("fcb mount: %.1f us, active sector walk: %.1f us (%d elements)\n",
+           ftmb_usecs(mount_clk), ftmb_usecs(walk_clk),
+           test_fcb.f_active_cnt);
+}
@@ -0,0 +1,193 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include <crc/crc8.h>
+#include "fcb_sum_test.h"
+
+struct fcb_test_summary_arg {
+    struct flash_area *fa;
+    int elems;
+    int bytes;
+};
+
+static int
+fcb_test_summary_walk_cb(struct fcb_entry *loc, void *arg)
+{
+    struct fcb_test_summary_arg *sa = arg;
+
+    if (loc->fe_area == sa->fa) {
+        sa->elems++;
+        sa->bytes += loc->fe_data_len;
+    }
+    return 0;
+}
+
+static void
+fcb_test_summary_append(int cnt)
+{
+    struct fcb_iovec iov;
+    uint8_t test_data[100];
+    int len;
+    int rc;
+    int i;
+    int j;
+
+    for (i = 0; i < cnt; i++) {
+        len = i % sizeof(test_data) + 1;
+        for (j = 0; j < len; j++) {
+            test_data[j] = fcb_test_append_data(len, j);
+        }
+        iov.fi_data = test_data;
+        iov.fi_len = len;
+        rc = fcb_append_iov(&test_fcb, &iov, 1, NULL);
+        TEST_ASSERT_FATAL(rc == 0);
+    }
+}
+
+static void
+fcb_test_summary_reinit(uint8_t sector_count)
+{
+    struct fcb old;
+    struct fcb_test_summary_arg sa;
+    int elems;
+    int bytes;
+    int rc;
+    int i;
+
+    /*
+     * Pretend reset; mount has to end up in the same place.
+     */
+    old = test_fcb;
+    memset(&test_fcb, 0, sizeof(test_fcb));
+    test_fcb.f_sector_cnt = sector_count;
+    test_fcb.f_sectors = test_fcb_area;
+    rc = fcb_init(&test_fcb);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    TEST_ASSERT(test_fcb.f_oldest == old.f_oldest);
+    TEST_ASSERT(test_fcb.f_active.fe_area == old.f_active.fe_area);
+    TEST_ASSERT(test_fcb.f_active.fe_elem_off == old.f_active.fe_elem_off);
+    TEST_ASSERT(test_fcb.f_active_cnt == old.f_active_cnt);
+    TEST_ASSERT(test_fcb.f_active_bytes == old.f_active_bytes);
+
+    /*
+     * Area info from summaries has to match a full walk.
+     */
+    for (i = 0; i < sector_count; i++) {
+        memset(&sa, 0, sizeof(sa));
+        sa.fa = &test_fcb_area[i];
+        rc = fcb_walk(&test_fcb, NULL, fcb_test_summary_walk_cb, &sa);
+        TEST_ASSERT(rc == 0);
+
+        rc = fcb_area_info(&test_fcb, &test_fcb_area[i], &elems, &bytes);
+        TEST_ASSERT(rc == 0);
+        TEST_ASSERT(elems == sa.elems);
+        TEST_ASSERT(bytes == sa.bytes);
+    }
+}
+
+TEST_CASE_SELF(fcb_test_summary)
+{
+    struct fcb_disk_area fda;
+    struct fcb_iovec iov;
+    struct fcb_entry loc;
+    uint8_t test_data[16];
+    int var_cnt;
+    int rc;
+
+    fcb_tc_pretest(4);
+    TEST_ASSERT(!(test_fcb.f_active_flags & FCB_DISK_F_NO_SUMMARY));
+    memset(test_data, 0x5a, sizeof(test_data));
+
+    fcb_test_summary_append(250);
+
+    /*
+     * Summaries only count elements once they are finished; one that is
+     * never finished is skipped by walks, and must not be counted either.
+     */
+    rc = fcb_append(&test_fcb, sizeof(test_data), &loc);
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = fcb_append(&test_fcb, sizeof(test_data), &loc);
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = flash_area_write(loc.fe_area, loc.fe_data_off, test_data,
+                          sizeof(test_data));
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = fcb_append_finish(&test_fcb, &loc);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    fcb_test_summary_append(248);
+
+    /*
+     * Mount counts elements written after the last summary from their
+     * length and CRC bytes.  An element whose CRC reads as erased is
+     * counted only if its CRC really is 0xff.
+     */
+    test_data[0] = 0;
+    while (crc8_calc(crc8_calc(crc8_init(), "\x01", 1), test_data, 1) !=
+           0xff) {
+        test_data[0]++;
+    }
+    iov.fi_data = test_data;
+    iov.fi_len = 1;
+    rc = fcb_append_iov(&test_fcb, &iov, 1, NULL);
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = fcb_append(&test_fcb, sizeof(test_data), &loc);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(test_fcb.f_active.fe_area != &test_fcb_area[0]);
+    TEST_ASSERT(test_fcb.f_active_sums > 0);
+    fcb_test_summary_reinit(4);
+
+    /* Summary slots must not be mistaken for elements. */
+    memset(&loc, 0, sizeof(loc));
+    var_cnt = 0;
+    while (fcb_getnext(&test_fcb, &loc) == 0) {
+        var_cnt++;
+    }
+    TEST_ASSERT(var_cnt == 500);
+
+    /*
+     * Sector written without summaries; it has to be read as before, and
+     * the following sectors get summaries.
+     */
+    fcb_test_wipe();
+    memset(&fda, 0xff, sizeof(fda));
+    fda.fd_magic = 0;
+    fda.fd_ver = 0;
+    fda.fd_id = 0;
+    rc = flash_area_write(&test_fcb_area[0], 0, &fda, sizeof(fda));
+    TEST_ASSERT_FATAL(rc == 0);
+
+    memset(&test_fcb, 0, sizeof(test_fcb));
+    test_fcb.f_sector_cnt = 4;
+    test_fcb.f_sectors = test_fcb_area;
+    rc = fcb_init(&test_fcb);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(test_fcb.f_active_flags & FCB_DISK_F_NO_SUMMARY);
+
+    fcb_test_summary_append(400);
+    TEST_ASSERT(test_fcb.f_active.fe_area != &test_fcb_area[0]);
+    TEST_ASSERT(!(test_fcb.f_active_flags & FCB_DISK_F_NO_SUMMARY));
+    fcb_test_summary_reinit(4);
+
+    memset(&loc, 0, sizeof(loc));
+    var_cnt = 0;
+    while (fcb_getnext(&test_fcb, &loc) == 0) {
+        var_cnt++;
+    }
+    TEST_ASSERT(var_cnt == 400);
+}
@@ -17,8 +17,10 @@
  * under the License.
  */
 #include <limits.h>
+#include <stddef.h>
 #include <stdlib.h>
 
+#include "crc/crc8.h"
 #include "fcb/fcb.h"
 #include "fcb_priv.h"
 #include "string.h"
@@ -34,6 +36,10 @@ fcb_init(struct fcb *fcb)
     int oldest = -1, newest = -1;
     struct flash_area *oldest_fap = NULL, *newest_fap = NULL;
     struct fcb_disk_area fda;
+    struct fcb_disk_summary fds;
+    struct fcb_entry *active;
+    uint8_t newest_flags = 0xff;
+    uint8_t crc8;
 
     if (!fcb->f_sectors || fcb->f_sector_cnt - fcb->f_scratch_cnt < 1) {
         return FCB_ERR_ARGS;
@@ -56,16 +62,19 @@ fcb_init(struct fcb *fcb)
         if (oldest < 0) {
             oldest = newest = fda.fd_id;
             oldest_fap = newest_fap = fap;
+            newest_flags = fda.fd_flags;
             continue;
         }
         if (FCB_ID_GT(fda.fd_id, newest)) {
             newest = fda.fd_id;
             newest_fap = fap;
+            newest_flags = fda.fd_flags;
         } else if (FCB_ID_GT(oldest, fda.fd_id)) {
             oldest = fda.fd_id;
             oldest_fap = fap;
         }
     }
+    fcb->f_align = max_align;
     if (oldest < 0) {
         /*
          * No initialized areas.
@@ -76,27 +85,72 @@ fcb_init(struct fcb *fcb)
             return rc;
         }
         newest = oldest = 0;
+        newest_flags = fcb_sector_flags(fcb, newest_fap);
     }
-    fcb->f_align = max_align;
     fcb->f_oldest = oldest_fap;
-    fcb->f_active.fe_area = newest_fap;
-    fcb->f_active.fe_elem_off = sizeof(struct fcb_disk_area);
+    active = &fcb->f_active;
+    active->fe_area = newest_fap;
+    active->fe_elem_off = sizeof(struct fcb_disk_area);
     fcb->f_active_id = newest;
+    fcb->f_active_flags = newest_flags;
+    fcb->f_active_sums = 0;
+    fcb->f_active_cnt = 0;
+    fcb->f_active_bytes = 0;
 
     /* Require alignment to be a power of two.  Some code depends on this
      * assumption.
      */
     assert((fcb->f_align & (fcb->f_align - 1)) == 0);
 
+    /* Skip over the elements covered by the latest summary, if any. */
+    if (!(newest_flags & FCB_DISK_F_NO_SUMMARY)) {
+        rc = fcb_summary_read(fcb, newest_fap, &fds);
+        if (rc < 0) {
+            return rc;
+        }
+        fcb->f_active_sums = rc;
+        if (fds.fds_end) {
+            active->fe_elem_off = fds.fds_end;
+            fcb->f_active_cnt = fds.fds_cnt;
+            fcb->f_active_bytes = fds.fds_bytes;
+        }
+    }
+
+    /*
+     * Find the end of the active area.  Only the lengths of the elements are
+     * read.  An element is counted once its CRC has been written, as it is
+     * when appended; only one whose CRC reads as erased has its data checked,
+     * as that is a valid CRC too.
+     */
     while (1) {
-        rc = fcb_getnext_in_area(fcb, &fcb->f_active);
+        rc = fcb_elem_len(fcb, active);
         if (rc == FCB_ERR_NOVAR) {
             rc = FCB_OK;
             break;
         }
-        if (rc != 0) {
+        if (rc) {
+            break;
+        }
+        rc = flash_area_read_is_empty(active->fe_area,
+          active->fe_data_off + fcb_len_in_flash(fcb, active->fe_data_len),
+          &crc8, sizeof(crc8));
+        if (rc < 0) {
+            rc = FCB_ERR_FLASH;
             break;
         }
+        if (rc == 1) {
+            rc = fcb_elem_info(fcb, active);
+            if (rc != 0 && rc != FCB_ERR_CRC) {
+                break;
+            }
+        }
+        if (rc == 0) {
+            fcb->f_active_cnt++;
+            fcb->f_active_bytes += active->fe_data_len;
+        }
+        active->fe_elem_off = active->fe_data_off +
+          fcb_len_in_flash(fcb, active->fe_data_len) +
+          fcb_len_in_flash(fcb, FCB_CRC_SZ);
     }
     os_mutex_init(&fcb->f_mtx);
     return rc;
@@ -170,7 +224,7 @@ fcb_sector_hdr_init(struct fcb *fcb, struct flash_area *fap, uint16_t id)
 
     fda.fd_magic = fcb->f_magic;
     fda.fd_ver = fcb->f_version;
-    fda._pad = 0xff;
+    fda.fd_flags = fcb_sector_flags(fcb, fap);
     fda.fd_id = id;
 
     rc = flash_area_write(fap, 0, &fda, sizeof(fda));
@@ -180,6 +234,49 @@ fcb_sector_hdr_init(struct fcb *fcb, struct flash_area *fap, uint16_t id)
     return 0;
 }
 
+/**
+ * Header flags to use for a newly initialized sector.
+ */
+int
+fcb_sector_flags(struct fcb *fcb, struct flash_area *fap)
+{
+    int flags;
+
+    flags = FCB_SECTOR_FLAGS;
+    if (!(flags & FCB_DISK_F_NO_SUMMARY)) {
+        /* Summaries are written through a FCB_TMP_BUF_SZ buffer, and
+         * should not take up a significant part of the sector.
+         */
+        if (fcb_summary_slot_sz(fcb) > FCB_TMP_BUF_SZ ||
+            fap->fa_size < 8 * FCB_SUMMARY_SLOTS * fcb_summary_slot_sz(fcb)) {
+            flags |= FCB_DISK_F_NO_SUMMARY;
+        }
+    }
+    return flags;
+}
+
+/**
+ * Initialize erased sector, and make it the active one.
+ */
+int
+fcb_sector_activate(struct fcb *fcb, struct flash_area *fap, uint16_t id)
+{
+    int rc;
+
+    rc = fcb_sector_hdr_init(fcb, fap, id);
+    if (rc) {
+        return rc;
+    }
+    fcb->f_active.fe_area = fap;
+    fcb->f_active.fe_elem_off = sizeof(struct fcb_disk_area);
+    fcb->f_active_id = id;
+    fcb->f_active_flags = fcb_sector_flags(fcb, fap);
+    fcb->f_active_sums = 0;
+    fcb->f_active_cnt = 0;
+    fcb->f_active_bytes = 0;
+    return 0;
+}
+
 /**
  * Checks whether FCB sector contains data or not.
  * Returns <0 in error.
@@ -211,6 +308,44 @@ fcb_sector_hdr_read(struct fcb *fcb, struct flash_area *fap,
     return 1;
 }
 
+/**
+ * Reads the summary slots of a sector which has them.  The latest valid
+ * summary is returned in fdsp; fds_end is 0 if there is none.
+ * Returns <0 on error, otherwise the number of slots in use.
+ */
+int
+fcb_summary_read(struct fcb *fcb, struct flash_area *fap,
+  struct fcb_disk_summary *fdsp)
+{
+    struct fcb_disk_summary fds;
+    uint32_t data_end;
+    uint32_t off;
+    int rc;
+    int i;
+
+    memset(fdsp, 0, sizeof(*fdsp));
+    data_end = fcb_area_data_end(fcb, fap, 0);
+    off = fap->fa_size;
+    for (i = 0; i < FCB_SUMMARY_SLOTS; i++) {
+        off -= fcb_summary_slot_sz(fcb);
+        rc = flash_area_read_is_empty(fap, off, &fds, sizeof(fds));
+        if (rc < 0) {
+            return FCB_ERR_FLASH;
+        } else if (rc == 1) {
+            break;
+        }
+        /* Slot may have been torn by a reset; skip it if so. */
+        if (crc8_calc(crc8_init(), &fds, offsetof(struct fcb_disk_summary,
+                                                  fds_crc8)) != fds.fds_crc8 ||
+            fds.fds_end < sizeof(struct fcb_disk_area) ||
+            fds.fds_end > data_end) {
+            continue;
+        }
+        *fdsp = fds;
+    }
+    return i;
+}
+
 /**
  * Finds the fcb entry that gives back upto n entries at the end.
  * @param0 ptr to fcb
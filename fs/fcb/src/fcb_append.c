@@ -17,7 +17,10 @@
  * under the License.
  */
 #include <stddef.h>
+#include <string.h>
 
+#include "os/mynewt.h"
+#include "crc/crc8.h"
 #include "fcb/fcb.h"
 #include "fcb_priv.h"
 
@@ -43,6 +46,63 @@ fcb_new_area(struct fcb *fcb, int cnt)
     return rfa;
 }
 
+/*
+ * Record the current state of the active area in its next summary slot, if
+ * it has any left.
+ */
+static int
+fcb_summary_write(struct fcb *fcb)
+{
+    struct fcb_disk_summary *fds;
+    uint8_t buf[FCB_TMP_BUF_SZ];
+    uint32_t off;
+    int slot_sz;
+
+    if ((fcb->f_active_flags & FCB_DISK_F_NO_SUMMARY) ||
+        fcb->f_active_sums >= FCB_SUMMARY_SLOTS) {
+        return 0;
+    }
+
+    slot_sz = fcb_summary_slot_sz(fcb);
+    memset(buf, flash_area_erased_val(fcb->f_active.fe_area), slot_sz);
+    fds = (struct fcb_disk_summary *)buf;
+    fds->fds_end = fcb->f_active.fe_elem_off;
+    fds->fds_bytes = fcb->f_active_bytes;
+    fds->fds_cnt = fcb->f_active_cnt;
+    fds->_pad = 0xff;
+    fds->fds_crc8 = crc8_calc(crc8_init(), fds,
+                              offsetof(struct fcb_disk_summary, fds_crc8));
+
+    off = fcb->f_active.fe_area->fa_size -
+          (fcb->f_active_sums + 1) * slot_sz;
+    fcb->f_active_sums++;
+    if (flash_area_write(fcb->f_active.fe_area, off, buf, slot_sz)) {
+        return FCB_ERR_FLASH;
+    }
+    return 0;
+}
+
+/*
+ * Whether the active area has filled up enough to write the next summary.
+ * Summaries are spread evenly over the data area.
+ */
+static int
+fcb_summary_due(struct fcb *fcb)
+{
+    uint32_t start;
+    uint32_t step;
+
+    if ((fcb->f_active_flags & FCB_DISK_F_NO_SUMMARY) ||
+        fcb->f_active_sums >= FCB_SUMMARY_SLOTS) {
+        return 0;
+    }
+    start = sizeof(struct fcb_disk_area);
+    step = (fcb_area_data_end(fcb, fcb->f_active.fe_area, 0) - start) /
+           FCB_SUMMARY_SLOTS;
+    return fcb->f_active.fe_elem_off >=
+           start + (fcb->f_active_sums + 1) * step;
+}
+
 /*
  * Take one of the scratch blocks into use, if at all possible.
  */
@@ -56,18 +116,32 @@ fcb_append_to_scratch(struct fcb *fcb)
     if (!fa) {
         return FCB_ERR_NOSPACE;
     }
-    rc = fcb_sector_hdr_init(fcb, fa, fcb->f_active_id + 1);
+    rc = fcb_summary_write(fcb);
     if (rc) {
         return rc;
     }
-    fcb->f_active.fe_area = fa;
-    fcb->f_active.fe_elem_off = sizeof(struct fcb_disk_area);
-    fcb->f_active_id++;
-    return FCB_OK;
+    return fcb_sector_activate(fcb, fa, fcb->f_active_id + 1);
 }
 
-int
-fcb_append(struct fcb *fcb, uint16_t len, struct fcb_entry *append_loc)
+/*
+ * Count a completed element towards the summaries of the active area.
+ * Elements are counted once their crc is written, the same way fcb_init()
+ * counts the valid ones. Caller holds f_mtx.
+ */
+static void
+fcb_append_count(struct fcb *fcb, struct fcb_entry *loc)
+{
+    if (loc->fe_area == fcb->f_active.fe_area) {
+        fcb->f_active_cnt++;
+        fcb->f_active_bytes += loc->fe_data_len;
+    }
+}
+
+/*
+ * Reserve space for an element and write its length. Caller holds f_mtx.
+ */
+static int
+fcb_append_nolock(struct fcb *fcb, uint16_t len, struct fcb_entry *append_loc)
 {
     struct fcb_entry *active;
     struct flash_area *fa;
@@ -82,31 +156,32 @@ fcb_append(struct fcb *fcb, uint16_t len, struct fcb_entry *append_loc)
     cnt = fcb_len_in_flash(fcb, cnt);
     len = fcb_len_in_flash(fcb, len) + fcb_len_in_flash(fcb, FCB_CRC_SZ);
 
-    rc = os_mutex_pend(&fcb->f_mtx, OS_WAIT_FOREVER);
-    if (rc && rc != OS_NOT_STARTED) {
-        return FCB_ERR_ARGS;
-    }
     active = &fcb->f_active;
-    if (active->fe_elem_off + len + cnt > active->fe_area->fa_size) {
+    if (active->fe_elem_off + len + cnt >
+        fcb_area_data_end(fcb, active->fe_area, fcb->f_active_flags)) {
         fa = fcb_new_area(fcb, fcb->f_scratch_cnt);
-        if (!fa || (fa->fa_size <
+        if (!fa || (fcb_area_data_end(fcb, fa, fcb_sector_flags(fcb, fa)) <
             sizeof(struct fcb_disk_area) + len + cnt)) {
-            rc = FCB_ERR_NOSPACE;
-            goto err;
+            return FCB_ERR_NOSPACE;
+        }
+        rc = fcb_summary_write(fcb);
+        if (rc) {
+            return rc;
+        }
+        rc = fcb_sector_activate(fcb, fa, fcb->f_active_id + 1);
+        if (rc) {
+            return rc;
         }
-        rc = fcb_sector_hdr_init(fcb, fa, fcb->f_active_id + 1);
+    } else if (fcb_summary_due(fcb)) {
+        rc = fcb_summary_write(fcb);
         if (rc) {
-            goto err;
+            return rc;
         }
-        fcb->f_active.fe_area = fa;
-        fcb->f_active.fe_elem_off = sizeof(struct fcb_disk_area);
-        fcb->f_active_id++;
     }
 
     rc = flash_area_write(active->fe_area, active->fe_elem_off, tmp_str, cnt);
     if (rc) {
-        rc = FCB_ERR_FLASH;
-        goto err;
+        return FCB_ERR_FLASH;
     }
     append_loc->fe_area = active->fe_area;
     append_loc->fe_elem_off = active->fe_elem_off;
@@ -116,14 +191,193 @@ fcb_append(struct fcb *fcb, uint16_t len, struct fcb_entry *append_loc)
     active->fe_data_off = append_loc->fe_data_off;
     active->fe_data_len = len;
 
+    return FCB_OK;
+}
+
+int
+fcb_append(struct fcb *fcb, uint16_t len, struct fcb_entry *append_loc)
+{
+    int rc;
+
+    rc = os_mutex_pend(&fcb->f_mtx, OS_WAIT_FOREVER);
+    if (rc && rc != OS_NOT_STARTED) {
+        return FCB_ERR_ARGS;
+    }
+    rc = fcb_append_nolock(fcb, len, append_loc);
     os_mutex_release(&fcb->f_mtx);
 
-    return FCB_OK;
-err:
+    return rc;
+}
+
+/*
+ * Streams element data to flash, computing crc8 on the way. Small pieces
+ * are gathered into wr_buf, which is only written out in multiples of the
+ * flash alignment.
+ */
+struct fcb_append_wr {
+    struct flash_area *wr_area;
+    uint32_t wr_off;
+    uint8_t wr_align;
+    uint8_t wr_crc8;
+    uint8_t wr_buf_len;
+    uint8_t wr_buf[FCB_TMP_BUF_SZ];
+};
+
+static int
+fcb_append_wr_flush(struct fcb_append_wr *wr)
+{
+    int len;
+
+    if (wr->wr_buf_len == 0) {
+        return 0;
+    }
+    len = wr->wr_buf_len;
+    if (wr->wr_align > 1) {
+        len = (len + (wr->wr_align - 1)) & ~(wr->wr_align - 1);
+        memset(wr->wr_buf + wr->wr_buf_len,
+               flash_area_erased_val(wr->wr_area), len - wr->wr_buf_len);
+    }
+    if (flash_area_write(wr->wr_area, wr->wr_off, wr->wr_buf, len)) {
+        return FCB_ERR_FLASH;
+    }
+    wr->wr_off += len;
+    wr->wr_buf_len = 0;
+
+    return 0;
+}
+
+static int
+fcb_append_wr_data(struct fcb_append_wr *wr, const void *data, int len)
+{
+    const uint8_t *u8p;
+    int chunk;
+    int rc;
+
+    u8p = data;
+    wr->wr_crc8 = crc8_calc(wr->wr_crc8, (void *)u8p, len);
+
+    while (len > 0) {
+        if (wr->wr_buf_len == 0 && len >= sizeof(wr->wr_buf)) {
+            /* Large piece; write the aligned part straight from the
+             * caller's buffer. */
+            chunk = len;
+            if (wr->wr_align > 1) {
+                chunk &= ~(wr->wr_align - 1);
+            }
+            if (flash_area_write(wr->wr_area, wr->wr_off, u8p, chunk)) {
+                return FCB_ERR_FLASH;
+            }
+            wr->wr_off += chunk;
+        } else {
+            chunk = sizeof(wr->wr_buf) - wr->wr_buf_len;
+            if (chunk > len) {
+                chunk = len;
+            }
+            memcpy(wr->wr_buf + wr->wr_buf_len, u8p, chunk);
+            wr->wr_buf_len += chunk;
+            if (wr->wr_buf_len == sizeof(wr->wr_buf)) {
+                rc = fcb_append_wr_flush(wr);
+                if (rc) {
+                    return rc;
+                }
+            }
+        }
+        u8p += chunk;
+        len -= chunk;
+    }
+
+    return 0;
+}
+
+int
+fcb_append_mbuf(struct fcb *fcb, const struct fcb_iovec *iov, int iovcnt,
+                struct os_mbuf *om, struct fcb_entry *append_loc)
+{
+    struct fcb_append_wr wr;
+    struct fcb_entry loc;
+    struct os_mbuf *cur;
+    uint8_t tmp_str[2];
+    uint32_t len;
+    int cnt;
+    int rc;
+    int i;
+
+    if (fcb->f_align > FCB_TMP_BUF_SZ || iovcnt < 0 ||
+        (iovcnt > 0 && iov == NULL)) {
+        return FCB_ERR_ARGS;
+    }
+
+    len = 0;
+    for (i = 0; i < iovcnt; i++) {
+        len += iov[i].fi_len;
+    }
+    for (cur = om; cur != NULL; cur = SLIST_NEXT(cur, om_next)) {
+        len += cur->om_len;
+    }
+    if (len > FCB_MAX_LEN) {
+        return FCB_ERR_ARGS;
+    }
+
+    rc = os_mutex_pend(&fcb->f_mtx, OS_WAIT_FOREVER);
+    if (rc && rc != OS_NOT_STARTED) {
+        return FCB_ERR_ARGS;
+    }
+
+    rc = fcb_append_nolock(fcb, len, &loc);
+    if (rc) {
+        goto out;
+    }
+    loc.fe_data_len = len;
+
+    /* The crc covers the length bytes as well as the data. */
+    cnt = fcb_put_len(tmp_str, len);
+    wr.wr_area = loc.fe_area;
+    wr.wr_off = loc.fe_data_off;
+    wr.wr_align = fcb->f_align;
+    wr.wr_crc8 = crc8_calc(crc8_init(), tmp_str, cnt);
+    wr.wr_buf_len = 0;
+
+    for (i = 0; i < iovcnt; i++) {
+        rc = fcb_append_wr_data(&wr, iov[i].fi_data, iov[i].fi_len);
+        if (rc) {
+            goto out;
+        }
+    }
+    for (cur = om; cur != NULL; cur = SLIST_NEXT(cur, om_next)) {
+        rc = fcb_append_wr_data(&wr, cur->om_data, cur->om_len);
+        if (rc) {
+            goto out;
+        }
+    }
+    rc = fcb_append_wr_flush(&wr);
+    if (rc) {
+        goto out;
+    }
+
+    /* Crc goes right after the data, padded to alignment. */
+    wr.wr_buf[0] = wr.wr_crc8;
+    wr.wr_buf_len = FCB_CRC_SZ;
+    rc = fcb_append_wr_flush(&wr);
+    if (rc) {
+        goto out;
+    }
+    fcb_append_count(fcb, &loc);
+
+    if (append_loc) {
+        *append_loc = loc;
+    }
+out:
     os_mutex_release(&fcb->f_mtx);
     return rc;
 }
 
+int
+fcb_append_iov(struct fcb *fcb, const struct fcb_iovec *iov, int iovcnt,
+               struct fcb_entry *append_loc)
+{
+    return fcb_append_mbuf(fcb, iov, iovcnt, NULL, append_loc);
+}
+
 int
 fcb_append_finish(struct fcb *fcb, struct fcb_entry *loc)
 {
@@ -141,5 +395,13 @@ fcb_append_finish(struct fcb *fcb, struct fcb_entry *loc)
     if (rc) {
         return FCB_ERR_FLASH;
     }
+
+    rc = os_mutex_pend(&fcb->f_mtx, OS_WAIT_FOREVER);
+    if (rc && rc != OS_NOT_STARTED) {
+        return FCB_ERR_ARGS;
+    }
+    fcb_append_count(fcb, loc);
+    os_mutex_release(&fcb->f_mtx);
+
     return 0;
 }
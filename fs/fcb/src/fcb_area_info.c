@@ -20,6 +20,47 @@
 #include "fcb/fcb.h"
 #include "fcb_priv.h"
 
+/*
+ * Starts the count from the latest summary of the area, if it has one.
+ * Returns 0 if loc is at a valid element from which to continue the walk,
+ * non-zero otherwise.
+ */
+static int
+fcb_area_info_summary(struct fcb *fcb, struct fcb_entry *loc, int *elemsp,
+                      int *bytesp)
+{
+    struct fcb_disk_area fda;
+    struct fcb_disk_summary fds;
+    int rc;
+
+    rc = fcb_sector_hdr_read(fcb, loc->fe_area, &fda);
+    if (rc != 1 || (fda.fd_flags & FCB_DISK_F_NO_SUMMARY)) {
+        return -1;
+    }
+    rc = fcb_summary_read(fcb, loc->fe_area, &fds);
+    if (rc <= 0 || !fds.fds_end) {
+        return -1;
+    }
+    *elemsp = fds.fds_cnt;
+    *bytesp = fds.fds_bytes;
+
+    loc->fe_elem_off = fds.fds_end;
+    while (1) {
+        rc = fcb_elem_info(fcb, loc);
+        if (rc != FCB_ERR_CRC) {
+            break;
+        }
+        loc->fe_elem_off = loc->fe_data_off +
+          fcb_len_in_flash(fcb, loc->fe_data_len) +
+          fcb_len_in_flash(fcb, FCB_CRC_SZ);
+    }
+    if (rc == 0) {
+        (*elemsp)++;
+        *bytesp += loc->fe_data_len;
+    }
+    return rc;
+}
+
 int
 fcb_area_info(struct fcb *fcb, struct flash_area *fa, int *elemsp, int *bytesp)
 {
@@ -31,6 +72,17 @@ fcb_area_info(struct fcb *fcb, struct flash_area *fa, int *elemsp, int *bytesp)
     loc.fe_area = fa;
     loc.fe_elem_off = 0;
 
+    if (fa) {
+        rc = fcb_area_info_summary(fcb, &loc, &elems, &bytes);
+        if (rc == FCB_ERR_NOVAR) {
+            goto done;
+        } else if (rc) {
+            elems = 0;
+            bytes = 0;
+            loc.fe_elem_off = 0;
+        }
+    }
+
     while (1) {
         rc = fcb_getnext(fcb, &loc);
         if (rc) {
@@ -44,6 +96,7 @@ fcb_area_info(struct fcb *fcb, struct flash_area *fa, int *elemsp, int *bytesp)
         elems++;
         bytes += loc.fe_data_len;
     }
+done:
     if (elemsp) {
         *elemsp = elems;
     }
@@ -17,46 +17,95 @@
  * under the License.
  */
 
+#include <stddef.h>
+
 #include <crc/crc8.h>
 
 #include "fcb/fcb.h"
 #include "fcb_priv.h"
 
 /*
- * Given offset in flash area, fill in rest of the fcb_entry, and crc8 over
- * the data.
+ * Given offset in flash area, read the length of the element there and fill
+ * in its data offset and length.  The length bytes are left in buf, which
+ * must have room for 2 bytes.  Returns the number of length bytes.
  */
-int
-fcb_elem_crc8(struct fcb *fcb, struct fcb_entry *loc, uint8_t *c8p)
+static int
+fcb_elem_len_read(struct fcb *fcb, struct fcb_entry *loc, uint8_t *buf)
 {
-    uint8_t tmp_str[FCB_TMP_BUF_SZ];
-    int cnt;
-    int blk_sz;
-    uint8_t crc8;
     uint16_t len;
-    uint32_t off;
-    uint32_t end;
+    int cnt;
     int rc;
 
     if (loc->fe_elem_off + 2 > loc->fe_area->fa_size) {
         return FCB_ERR_NOVAR;
     }
-    rc = flash_area_read_is_empty(loc->fe_area, loc->fe_elem_off, tmp_str, 2);
+    if (loc->fe_elem_off + 2 > fcb_area_data_end(fcb, loc->fe_area, 0)) {
+        /* Past the summary slots, if this sector has them. */
+        rc = flash_area_read(loc->fe_area,
+          offsetof(struct fcb_disk_area, fd_flags), buf, 1);
+        if (rc) {
+            return FCB_ERR_FLASH;
+        }
+        if (!(buf[0] & FCB_DISK_F_NO_SUMMARY)) {
+            return FCB_ERR_NOVAR;
+        }
+    }
+    rc = flash_area_read_is_empty(loc->fe_area, loc->fe_elem_off, buf, 2);
     if (rc < 0) {
         return FCB_ERR_FLASH;
     } else if (rc == 1) {
         return FCB_ERR_NOVAR;
     }
 
-    cnt = fcb_get_len(tmp_str, &len);
+    cnt = fcb_get_len(buf, &len);
     loc->fe_data_off = loc->fe_elem_off + fcb_len_in_flash(fcb, cnt);
     loc->fe_data_len = len;
 
+    return cnt;
+}
+
+/*
+ * Given offset in flash area, fill in rest of the fcb_entry without reading
+ * the element data.
+ */
+int
+fcb_elem_len(struct fcb *fcb, struct fcb_entry *loc)
+{
+    uint8_t tmp_str[2];
+    int rc;
+
+    rc = fcb_elem_len_read(fcb, loc, tmp_str);
+    if (rc < 0) {
+        return rc;
+    }
+    return 0;
+}
+
+/*
+ * Given offset in flash area, fill in rest of the fcb_entry, and crc8 over
+ * the data.
+ */
+int
+fcb_elem_crc8(struct fcb *fcb, struct fcb_entry *loc, uint8_t *c8p)
+{
+    uint8_t tmp_str[FCB_TMP_BUF_SZ];
+    int cnt;
+    int blk_sz;
+    uint8_t crc8;
+    uint32_t off;
+    uint32_t end;
+    int rc;
+
+    cnt = fcb_elem_len_read(fcb, loc, tmp_str);
+    if (cnt < 0) {
+        return cnt;
+    }
+
     crc8 = crc8_init();
     crc8 = crc8_calc(crc8, tmp_str, cnt);
 
     off = loc->fe_data_off;
-    end = loc->fe_data_off + len;
+    end = loc->fe_data_off + loc->fe_data_len;
     for (; off < end; off += blk_sz) {
         blk_sz = end - off;
         if (blk_sz > sizeof(tmp_str)) {
@@ -31,10 +31,44 @@ extern "C" {
 struct fcb_disk_area {
     uint32_t fd_magic;
     uint8_t  fd_ver;
-    uint8_t  _pad;
+    uint8_t  fd_flags;
     uint16_t fd_id;
 };
 
+/*
+ * Bits in fd_flags. These are cleared to turn a feature on, so that sectors
+ * written before the flag existed (where fd_flags is 0xff) read as not
+ * having it.
+ */
+#define FCB_DISK_F_NO_SUMMARY   0x01    /* Sector has no summary slots */
+
+/*
+ * Sector summary, describing the elements in a sector up to fds_end.
+ * Sectors with summaries reserve FCB_SUMMARY_SLOTS of these at the end of
+ * the sector, filled from the end towards the element data. They are
+ * written as the active sector fills up, and when it is closed.
+ *
+ * fds_cnt and fds_bytes only include elements whose crc had been written
+ * when the summary was; elements that were never finished do not count.
+ * An element that another task was still writing at that time is below
+ * fds_end but left out of the counts, even once it is finished.
+ */
+struct fcb_disk_summary {
+    uint32_t fds_end;       /* Offset of the first element not covered */
+    uint32_t fds_bytes;     /* Sum of data lengths of covered elements */
+    uint16_t fds_cnt;       /* Number of covered elements */
+    uint8_t  _pad;
+    uint8_t  fds_crc8;      /* Over the preceding fields */
+};
+
+#define FCB_SUMMARY_SLOTS       8
+
+#if MYNEWT_VAL(FCB_SECTOR_SUMMARY)
+#define FCB_SECTOR_FLAGS        (0xff & ~FCB_DISK_F_NO_SUMMARY)
+#else
+#define FCB_SECTOR_FLAGS        0xff
+#endif
+
 int fcb_put_len(uint8_t *buf, uint16_t len);
 int fcb_get_len(uint8_t *buf, uint16_t *len);
 
@@ -47,16 +81,40 @@ fcb_len_in_flash(struct fcb *fcb, uint16_t len)
     return (len + (fcb->f_align - 1)) & ~(fcb->f_align - 1);
 }
 
+static inline int
+fcb_summary_slot_sz(struct fcb *fcb)
+{
+    return fcb_len_in_flash(fcb, sizeof(struct fcb_disk_summary));
+}
+
+/*
+ * Offset where element data has to end in a sector with the given flags.
+ */
+static inline uint32_t
+fcb_area_data_end(struct fcb *fcb, struct flash_area *fap, uint8_t flags)
+{
+    if (flags & FCB_DISK_F_NO_SUMMARY) {
+        return fap->fa_size;
+    }
+    return fap->fa_size - FCB_SUMMARY_SLOTS * fcb_summary_slot_sz(fcb);
+}
+
 int fcb_getnext_in_area(struct fcb *fcb, struct fcb_entry *loc);
 struct flash_area *fcb_getnext_area(struct fcb *fcb, struct flash_area *fap);
 int fcb_getnext_nolock(struct fcb *fcb, struct fcb_entry *loc);
 
 int fcb_elem_info(struct fcb *, struct fcb_entry *);
+int fcb_elem_len(struct fcb *, struct fcb_entry *);
 int fcb_elem_crc8(struct fcb *, struct fcb_entry *loc, uint8_t *crc8p);
 
 int fcb_sector_hdr_init(struct fcb *, struct flash_area *fap, uint16_t id);
 int fcb_sector_hdr_read(struct fcb *, struct flash_area *fap,
   struct fcb_disk_area *fdap);
+int fcb_sector_flags(struct fcb *, struct flash_area *fap);
+int fcb_sector_activate(struct fcb *, struct flash_area *fap, uint16_t id);
+
+int fcb_summary_read(struct fcb *, struct flash_area *fap,
+  struct fcb_disk_summary *fdsp);
 
 #ifdef __cplusplus
 }
@@ -41,13 +41,10 @@ fcb_rotate(struct fcb *fcb)
          * Need to create a new active area, as we're wiping the current.
          */
         fap = fcb_getnext_area(fcb, fcb->f_oldest);
-        rc = fcb_sector_hdr_init(fcb, fap, fcb->f_active_id + 1);
+        rc = fcb_sector_activate(fcb, fap, fcb->f_active_id + 1);
         if (rc) {
             goto out;
         }
-        fcb->f_active.fe_area = fap;
-        fcb->f_active.fe_elem_off = sizeof(struct fcb_disk_area);
-        fcb->f_active_id++;
     }
     fcb->f_oldest = fcb_getnext_area(fcb, fcb->f_oldest);
 out:
@@ -158,6 +158,48 @@ int fcb2_write(struct fcb2_entry *loc, uint16_t off, const void *buf,
  */
 int fcb2_append_finish(struct fcb2_entry *append_loc);
 
+/**
+ * A contiguous piece of an entry passed to fcb2_append_iov().
+ */
+struct fcb2_iovec {
+    const void *fi_data;
+    uint16_t fi_len;
+};
+
+struct os_mbuf;
+
+/**
+ * Append an entry made up of the concatenation of iovcnt buffers. The data
+ * is written and its CRC computed in a single pass, with the FCB locked for
+ * the whole append. There is no fcb2_append_finish() step; writes are
+ * padded to the flash alignment internally.
+ *
+ * @param fcb            FCB this entry is being appended to.
+ * @param iov            Pieces of the entry
+ * @param iovcnt         Number of elements in iov
+ * @param loc            If not NULL, filled with location of the new entry
+ *
+ * @return 0 on success. Otherwise one of FCB2_XXX error codes.
+ */
+int fcb2_append_iov(struct fcb2 *fcb, const struct fcb2_iovec *iov,
+                    int iovcnt, struct fcb2_entry *loc);
+
+/**
+ * Same as fcb2_append_iov(), with the contents of an mbuf chain following
+ * the iov buffers.
+ *
+ * @param fcb            FCB this entry is being appended to.
+ * @param iov            Pieces of the entry preceding the mbuf data; may be
+ *                       NULL if iovcnt is 0
+ * @param iovcnt         Number of elements in iov
+ * @param om             Mbuf chain holding the rest of the entry
+ * @param loc            If not NULL, filled with location of the new entry
+ *
+ * @return 0 on success. Otherwise one of FCB2_XXX error codes.
+ */
+int fcb2_append_mbuf(struct fcb2 *fcb, const struct fcb2_iovec *iov,
+                     int iovcnt, struct os_mbuf *om, struct fcb2_entry *loc);
+
 /**
  * Callback routine getting called when walking through FCB entries.
  * Entry data can be read by using fcb2_read().
@@ -0,0 +1,102 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include "fcb_test.h"
+
+#define FTAI_MBUF_BUF_SIZE      (sizeof(struct os_mbuf) + 24)
+#define FTAI_MBUF_BUF_COUNT     8
+
+static os_membuf_t ftai_mbuf_membuf[
+    OS_MEMPOOL_SIZE(FTAI_MBUF_BUF_COUNT, FTAI_MBUF_BUF_SIZE)];
+static struct os_mbuf_pool ftai_mbuf_pool;
+static struct os_mempool ftai_mbuf_mempool;
+
+static void
+fcb_test_append_iov_run(uint8_t align, int use_mbuf)
+{
+    int rc;
+    struct fcb2 *fcb;
+    struct fcb2_entry loc;
+    struct fcb2_iovec iov[3];
+    struct os_mbuf *om;
+    uint8_t test_data[128];
+    int i;
+    int j;
+    int var_cnt;
+
+    test_fcb_ranges[0].fsr_align = align;
+    fcb_tc_pretest(2);
+
+    fcb = &test_fcb;
+
+    for (i = 1; i < sizeof(test_data); i++) {
+        for (j = 0; j < i; j++) {
+            test_data[j] = fcb_test_append_data(i, j);
+        }
+        iov[0].fi_data = test_data;
+        iov[0].fi_len = i / 3;
+        iov[1].fi_data = test_data + iov[0].fi_len;
+        iov[1].fi_len = i / 2 - iov[0].fi_len;
+        iov[2].fi_data = test_data + i / 2;
+        iov[2].fi_len = i - i / 2;
+
+        if (!use_mbuf) {
+            rc = fcb2_append_iov(fcb, iov, 3, &loc);
+        } else {
+            om = os_mbuf_get(&ftai_mbuf_pool, 0);
+            TEST_ASSERT_FATAL(om != NULL);
+            rc = os_mbuf_append(om, iov[1].fi_data, iov[1].fi_len);
+            TEST_ASSERT_FATAL(rc == 0);
+            rc = os_mbuf_append(om, iov[2].fi_data, iov[2].fi_len);
+            TEST_ASSERT_FATAL(rc == 0);
+
+            rc = fcb2_append_mbuf(fcb, iov, 1, om, &loc);
+            os_mbuf_free_chain(om);
+        }
+        TEST_ASSERT_FATAL(rc == 0);
+        TEST_ASSERT(loc.fe_data_len == i);
+    }
+
+    var_cnt = 1;
+    rc = fcb2_walk(fcb, 0, fcb_test_data_walk_cb, &var_cnt);
+    TEST_ASSERT(rc == 0);
+    TEST_ASSERT(var_cnt == sizeof(test_data));
+
+    test_fcb_ranges[0].fsr_align = 1;
+}
+
+TEST_CASE_SELF(fcb_test_append_iov)
+{
+    int rc;
+
+    rc = os_mempool_init(&ftai_mbuf_mempool, FTAI_MBUF_BUF_COUNT,
+                         FTAI_MBUF_BUF_SIZE, ftai_mbuf_membuf, "ftai_pool");
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = os_mbuf_pool_init(&ftai_mbuf_pool, &ftai_mbuf_mempool,
+                           FTAI_MBUF_BUF_SIZE, FTAI_MBUF_BUF_COUNT);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    fcb_test_append_iov_run(1, 0);
+    fcb_test_append_iov_run(8, 0);
+    fcb_test_append_iov_run(1, 1);
+    fcb_test_append_iov_run(8, 1);
+
+    /* Empty entries are not allowed. */
+    rc = fcb2_append_iov(&test_fcb, NULL, 0, NULL);
+    TEST_ASSERT(rc == FCB2_ERR_ARGS);
+}
@@ -33,6 +33,8 @@ fcb2_init(struct fcb2 *fcb)
     int oldest = -1, newest = -1;
     int oldest_sec = -1, newest_sec = -1;
     struct fcb2_disk_area fda;
+    struct fcb2_entry *active;
+    uint32_t data_end;
 
     if (!fcb->f_ranges || fcb->f_sector_cnt - fcb->f_scratch_cnt < 1) {
         return FCB2_ERR_ARGS;
@@ -80,23 +82,35 @@ fcb2_init(struct fcb2 *fcb)
         newest = oldest = 0;
     }
     fcb->f_oldest_sec = oldest_sec;
-    fcb->f_active.fe_range = newest_srp;
-    fcb->f_active.fe_sector = newest_sec;
-    fcb->f_active.fe_data_off =
-        fcb2_len_in_flash(newest_srp, sizeof(struct fcb2_disk_area));
-    fcb->f_active.fe_entry_num = 0;
+    active = &fcb->f_active;
+    active->fe_range = newest_srp;
+    active->fe_sector = newest_sec;
+    active->fe_entry_num = 0;
     fcb->f_active_id = newest;
 
+    /*
+     * Find the first free entry slot, and where the data of the last entry
+     * ends.  Only the entries at the end of the sector need to be read for
+     * this; element data and its CRC are not looked at.
+     */
+    data_end = fcb2_len_in_flash(newest_srp, sizeof(struct fcb2_disk_area));
     while (1) {
-        rc = fcb2_getnext_in_area(fcb, &fcb->f_active);
+        active->fe_entry_num++;
+        rc = fcb2_read_entry(active);
         if (rc == FCB2_ERR_NOVAR) {
             rc = FCB2_OK;
             break;
         }
-        if (rc != 0) {
+        if (rc == 0) {
+            data_end = active->fe_data_off +
+                fcb2_len_in_flash(newest_srp, active->fe_data_len) +
+                fcb2_len_in_flash(newest_srp, FCB2_CRC_LEN);
+        } else if (rc != FCB2_ERR_CRC) {
             break;
         }
     }
+    active->fe_data_off = data_end;
+    active->fe_data_len = 0;
     os_mutex_init(&fcb->f_mtx);
     return rc;
 }
@@ -17,10 +17,13 @@
  * under the License.
  */
 #include <stddef.h>
+#include <string.h>
 
+#include "os/mynewt.h"
 #include "fcb/fcb2.h"
 #include "fcb_priv.h"
 #include "crc/crc8.h"
+#include "crc/crc16.h"
 
 int
 fcb2_new_sector(struct fcb2 *fcb, int cnt)
@@ -159,8 +162,12 @@ fcb2_element_length_in_flash(const struct fcb2_entry *loc, int len)
         fcb2_len_in_flash(loc->fe_range, FCB2_CRC_LEN);
 }
 
-int
-fcb2_append(struct fcb2 *fcb, uint16_t len, struct fcb2_entry *append_loc)
+/*
+ * Reserve space for an entry and write its descriptor. Caller holds f_mtx.
+ */
+static int
+fcb2_append_nolock(struct fcb2 *fcb, uint16_t len,
+                   struct fcb2_entry *append_loc)
 {
     struct fcb2_entry *active;
     struct flash_sector_range *range;
@@ -168,14 +175,6 @@ fcb2_append(struct fcb2 *fcb, uint16_t len, struct fcb2_entry *append_loc)
     int sector;
     int rc;
 
-    if (len == 0 || len >= FCB2_MAX_LEN) {
-        return FCB2_ERR_ARGS;
-    }
-
-    rc = os_mutex_pend(&fcb->f_mtx, OS_WAIT_FOREVER);
-    if (rc && rc != OS_NOT_STARTED) {
-        return FCB2_ERR_ARGS;
-    }
     active = &fcb->f_active;
     if (fcb2_active_sector_free_space(fcb) < fcb2_element_length_in_flash(active,
                                                                           len)) {
@@ -187,12 +186,11 @@ fcb2_append(struct fcb2 *fcb, uint16_t len, struct fcb2_entry *append_loc)
             fcb2_len_in_flash(range, sizeof(struct fcb2_disk_area)) +
             fcb2_len_in_flash(range, len) +
             fcb2_len_in_flash(range, FCB2_CRC_LEN))) {
-            rc = FCB2_ERR_NOSPACE;
-            goto err;
+            return FCB2_ERR_NOSPACE;
         }
         rc = fcb2_sector_hdr_init(fcb, sector, fcb->f_active_id + 1);
         if (rc) {
-            goto err;
+            return rc;
         }
         fcb->f_active.fe_range = range;
         fcb->f_active.fe_sector = sector;
@@ -219,8 +217,7 @@ fcb2_append(struct fcb2 *fcb, uint16_t len, struct fcb2_entry *append_loc)
         active->fe_entry_num * -fcb2_len_in_flash(range, FCB2_ENTRY_SIZE),
         flash_entry, FCB2_ENTRY_SIZE);
     if (rc) {
-        rc = FCB2_ERR_FLASH;
-        goto err;
+        return FCB2_ERR_FLASH;
     }
     *append_loc = *active;
     /* Active element had everything ready except lenght */
@@ -230,11 +227,25 @@ fcb2_append(struct fcb2 *fcb, uint16_t len, struct fcb2_entry *append_loc)
     active->fe_data_off += fcb2_element_length_in_flash(active, len);
     active->fe_entry_num++;
 
-    os_mutex_release(&fcb->f_mtx);
-
     return FCB2_OK;
-err:
+}
+
+int
+fcb2_append(struct fcb2 *fcb, uint16_t len, struct fcb2_entry *append_loc)
+{
+    int rc;
+
+    if (len == 0 || len >= FCB2_MAX_LEN) {
+        return FCB2_ERR_ARGS;
+    }
+
+    rc = os_mutex_pend(&fcb->f_mtx, OS_WAIT_FOREVER);
+    if (rc && rc != OS_NOT_STARTED) {
+        return FCB2_ERR_ARGS;
+    }
+    rc = fcb2_append_nolock(fcb, len, append_loc);
     os_mutex_release(&fcb->f_mtx);
+
     return rc;
 }
 
@@ -259,3 +270,167 @@ fcb2_append_finish(struct fcb2_entry *loc)
     }
     return 0;
 }
+
+/*
+ * Streams entry data to flash, computing crc16 on the way. Small pieces
+ * are gathered into wr_buf, which is only written out in multiples of the
+ * flash alignment.
+ */
+struct fcb2_append_wr {
+    struct fcb2_entry *wr_loc;
+    int wr_off;
+    uint8_t wr_align;
+    uint8_t wr_buf_len;
+    uint16_t wr_crc16;
+    uint8_t wr_buf[FCB2_TMP_BUF_SZ];
+};
+
+static int
+fcb2_append_wr_flush(struct fcb2_append_wr *wr)
+{
+    int len;
+
+    if (wr->wr_buf_len == 0) {
+        return 0;
+    }
+    len = fcb2_len_in_flash(wr->wr_loc->fe_range, wr->wr_buf_len);
+    memset(wr->wr_buf + wr->wr_buf_len,
+           flash_area_erased_val(&wr->wr_loc->fe_range->fsr_flash_area),
+           len - wr->wr_buf_len);
+    if (fcb2_write_to_sector(wr->wr_loc, wr->wr_off, wr->wr_buf, len)) {
+        return FCB2_ERR_FLASH;
+    }
+    wr->wr_off += len;
+    wr->wr_buf_len = 0;
+
+    return 0;
+}
+
+static int
+fcb2_append_wr_data(struct fcb2_append_wr *wr, const void *data, int len)
+{
+    const uint8_t *u8p;
+    int chunk;
+    int rc;
+
+    u8p = data;
+    wr->wr_crc16 = crc16_ccitt(wr->wr_crc16, u8p, len);
+
+    while (len > 0) {
+        if (wr->wr_buf_len == 0 && len >= sizeof(wr->wr_buf)) {
+            /* Large piece; write the aligned part straight from the
+             * caller's buffer. */
+            chunk = len;
+            if (wr->wr_align > 1) {
+                chunk &= ~(wr->wr_align - 1);
+            }
+            if (fcb2_write_to_sector(wr->wr_loc, wr->wr_off, u8p, chunk)) {
+                return FCB2_ERR_FLASH;
+            }
+            wr->wr_off += chunk;
+        } else {
+            chunk = sizeof(wr->wr_buf) - wr->wr_buf_len;
+            if (chunk > len) {
+                chunk = len;
+            }
+            memcpy(wr->wr_buf + wr->wr_buf_len, u8p, chunk);
+            wr->wr_buf_len += chunk;
+            if (wr->wr_buf_len == sizeof(wr->wr_buf)) {
+                rc = fcb2_append_wr_flush(wr);
+                if (rc) {
+                    return rc;
+                }
+            }
+        }
+        u8p += chunk;
+        len -= chunk;
+    }
+
+    return 0;
+}
+
+int
+fcb2_append_mbuf(struct fcb2 *fcb, const struct fcb2_iovec *iov, int iovcnt,
+                 struct os_mbuf *om, struct fcb2_entry *append_loc)
+{
+    struct fcb2_append_wr wr;
+    struct fcb2_entry loc;
+    struct os_mbuf *cur;
+    uint32_t len;
+    int rc;
+    int i;
+
+    if (iovcnt < 0 || (iovcnt > 0 && iov == NULL)) {
+        return FCB2_ERR_ARGS;
+    }
+    for (i = 0; i < fcb->f_range_cnt; i++) {
+        if (fcb->f_ranges[i].fsr_align > FCB2_TMP_BUF_SZ) {
+            return FCB2_ERR_ARGS;
+        }
+    }
+
+    len = 0;
+    for (i = 0; i < iovcnt; i++) {
+        len += iov[i].fi_len;
+    }
+    for (cur = om; cur != NULL; cur = SLIST_NEXT(cur, om_next)) {
+        len += cur->om_len;
+    }
+    if (len == 0 || len >= FCB2_MAX_LEN) {
+        return FCB2_ERR_ARGS;
+    }
+
+    rc = os_mutex_pend(&fcb->f_mtx, OS_WAIT_FOREVER);
+    if (rc && rc != OS_NOT_STARTED) {
+        return FCB2_ERR_ARGS;
+    }
+
+    rc = fcb2_append_nolock(fcb, len, &loc);
+    if (rc) {
+        goto out;
+    }
+    wr.wr_loc = &loc;
+    wr.wr_off = loc.fe_data_off;
+    wr.wr_align = loc.fe_range->fsr_align;
+    wr.wr_buf_len = 0;
+    wr.wr_crc16 = 0xFFFF;
+
+    for (i = 0; i < iovcnt; i++) {
+        rc = fcb2_append_wr_data(&wr, iov[i].fi_data, iov[i].fi_len);
+        if (rc) {
+            goto out;
+        }
+    }
+    for (cur = om; cur != NULL; cur = SLIST_NEXT(cur, om_next)) {
+        rc = fcb2_append_wr_data(&wr, cur->om_data, cur->om_len);
+        if (rc) {
+            goto out;
+        }
+    }
+    rc = fcb2_append_wr_flush(&wr);
+    if (rc) {
+        goto out;
+    }
+
+    /* Crc goes right after the data, padded to alignment. */
+    put_be16(wr.wr_buf, wr.wr_crc16);
+    wr.wr_buf_len = FCB2_CRC_LEN;
+    rc = fcb2_append_wr_flush(&wr);
+    if (rc) {
+        goto out;
+    }
+
+    if (append_loc) {
+        *append_loc = loc;
+    }
+out:
+    os_mutex_release(&fcb->f_mtx);
+    return rc;
+}
+
+int
+fcb2_append_iov(struct fcb2 *fcb, const struct fcb2_iovec *iov, int iovcnt,
+                struct fcb2_entry *append_loc)
+{
+    return fcb2_append_mbuf(fcb, iov, iovcnt, NULL, append_loc);
+}
@@ -57,7 +57,7 @@ fcb2_elem_crc16(struct fcb2_entry *loc, uint16_t *c16p)
     return 0;
 }
 
-static int
+int
 fcb2_read_entry(struct fcb2_entry *loc)
 {
     uint8_t buf[FCB2_ENTRY_SIZE];
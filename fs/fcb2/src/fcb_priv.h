@@ -62,6 +62,7 @@ fcb2_getnext_sector(struct fcb2 *fcb, int sector)
 
 int fcb2_getnext_nolock(struct fcb2 *fcb, struct fcb2_entry *loc);
 
+int fcb2_read_entry(struct fcb2_entry *loc);
 int fcb2_elem_info(struct fcb2_entry *loc);
 int fcb2_elem_crc16(struct fcb2_entry *loc, uint16_t *c16p);
 int fcb2_sector_hdr_init(struct fcb2 *fcb, int sector, uint16_t id);
@@ -692,6 +692,7 @@ nffs_init(void)
     if (rc != 0) {
         return FS_EOS;
     }
+    os_mutex_stats_register(&nffs_mutex, "nffs");
 
     free(nffs_file_mem);
     nffs_file_mem = malloc(
@@ -0,0 +1,56 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "native_test.h"
+
+/* An hour; far longer than the test could wait on the real clock. */
+#define NTCVT_DELAY         (3600 * OS_TICKS_PER_SEC)
+#define NTCVT_CALLOUT       (5 * OS_TICKS_PER_SEC)
+
+static struct os_eventq ntcvt_evq;
+static struct os_callout ntcvt_callout;
+static os_time_t ntcvt_fired;
+
+static void
+ntcvt_callout_fn(struct os_event *ev)
+{
+    ntcvt_fired = os_time_get();
+}
+
+TEST_CASE_TASK(native_test_case_virtual_time)
+{
+    os_time_t start;
+    int rc;
+
+    /* A sleeping task wakes exactly when its delay expires. */
+    start = os_time_get();
+    os_time_delay(NTCVT_DELAY);
+    TEST_ASSERT(os_time_get() - start == NTCVT_DELAY);
+
+    /* So does a callout. */
+    os_eventq_init(&ntcvt_evq);
+    os_callout_init(&ntcvt_callout, &ntcvt_evq, ntcvt_callout_fn, NULL);
+
+    start = os_time_get();
+    rc = os_callout_reset(&ntcvt_callout, NTCVT_CALLOUT);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    os_eventq_run(&ntcvt_evq);
+    TEST_ASSERT(ntcvt_fired - start == NTCVT_CALLOUT);
+}
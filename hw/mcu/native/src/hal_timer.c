@@ -200,16 +200,32 @@ hal_timer_read(int num)
 int
 hal_timer_delay(int num, uint32_t ticks)
 {
+#if MYNEWT_VAL(MCU_NATIVE_VIRTUAL_TIME)
+    struct native_timer *nt;
+    os_sr_t sr;
+#else
     uint32_t until;
+#endif
 
     if (num != 0) {
         return -1;
     }
 
+#if MYNEWT_VAL(MCU_NATIVE_VIRTUAL_TIME)
+    /*
+     * The virtual clock only moves while all tasks are idle, so spinning
+     * would never end.  Advance the clock by the delay instead.
+     */
+    nt = &native_timers[num];
+    OS_ENTER_CRITICAL(sr);
+    os_time_advance((ticks + nt->ticks_per_ostick - 1) / nt->ticks_per_ostick);
+    OS_EXIT_CRITICAL(sr);
+#else
     until = hal_timer_read(0) + ticks;
     while ((int32_t)(hal_timer_read(0) - until) <= 0) {
         ;
     }
+#endif
     return 0;
 }
 
@@ -684,6 +684,7 @@ sensor_mgr_init(void)
     os_callout_reset(&st_up_osco, OS_TICKS_PER_SEC);
 
     os_mutex_init(&sensor_mgr.mgr_lock);
+    os_mutex_stats_register(&sensor_mgr.mgr_lock, "sensor_mgr");
 }
 
 /**
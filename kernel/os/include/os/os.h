@@ -125,6 +125,7 @@ void os_system_reset(void);
 #include "os/os_dev.h"
 #include "os/os_error.h"
 #include "os/os_eventq.h"
+#include "os/os_evring.h"
 #include "os/os_fault.h"
 #include "os/os_heap.h"
 #include "os/os_mbuf.h"
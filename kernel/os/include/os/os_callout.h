@@ -45,6 +45,10 @@ struct os_callout {
     struct os_eventq *c_evq;
     /** Number of ticks in the future to expire the callout */
     os_time_t c_ticks;
+#if MYNEWT_VAL(OS_CALLOUT_WHEEL)
+    /** Timing wheel slot the callout is queued on */
+    uint8_t c_wheel_slot;
+#endif
 
 
     TAILQ_ENTRY(os_callout) c_next;
@@ -166,6 +166,23 @@ uint32_t os_cputime_usecs_to_ticks(uint32_t usecs);
 uint32_t os_cputime_ticks_to_usecs(uint32_t ticks);
 #endif
 
+/**
+ * Convert a 64-bit number of ticks, such as an accumulated total, into
+ * microseconds.
+ *
+ * @param ticks The number of ticks to convert to microseconds.
+ *
+ * @return uint64_t The number of microseconds corresponding to 'ticks'
+ */
+static inline uint64_t
+os_cputime_ticks_to_usecs64(uint64_t ticks)
+{
+    /* Divide first; the tick count times 10^6 can overflow. */
+    return ticks / MYNEWT_VAL(OS_CPUTIME_FREQ) * 1000000 +
+           ticks % MYNEWT_VAL(OS_CPUTIME_FREQ) * 1000000 /
+           MYNEWT_VAL(OS_CPUTIME_FREQ);
+}
+
 /**
  * Wait until the number of ticks has elapsed. This is a blocking delay.
  *
@@ -55,6 +55,10 @@ struct os_event {
     os_event_fn *ev_cb;
     /** Argument to pass to the event queue callback. */
     void *ev_arg;
+#if MYNEWT_VAL(OS_EVENTQ_STATS)
+    /** os_cputime at which the event was last put on a queue. */
+    uint32_t ev_enq_time;
+#endif
 
     STAILQ_ENTRY(os_event) ev_next;
 };
@@ -78,6 +82,43 @@ struct os_eventq_mon {
 };
 #endif
 
+#if MYNEWT_VAL(OS_EVENTQ_STATS)
+/**
+ * Number of buckets in the queue wait histogram.  Bucket 0 counts events
+ * which were picked up within the same os_cputime tick, bucket n counts
+ * wait times in [2^(n-1), 2^n) ticks; the last bucket also holds anything
+ * longer.
+ */
+#define OS_EVENTQ_WAIT_HIST_BUCKETS     16
+
+/**
+ * Depth and wait statistics of an event queue.  Updated on every put and
+ * on every removal from the queue.  Wait times are in os_cputime ticks.
+ */
+struct os_eventq_stats {
+    uint16_t es_depth;          /* number of events currently queued */
+    uint16_t es_max_depth;      /* most events ever queued at once */
+    uint32_t es_puts;           /* number of events queued */
+    uint32_t es_max_wait;       /* longest time an event sat on the queue */
+    uint32_t es_wait_hist[OS_EVENTQ_WAIT_HIST_BUCKETS];
+};
+
+#define OS_EVENTQ_INFO_NAME_LEN         (32)
+
+/**
+ * Information about an event queue, as returned by
+ * os_eventq_info_get_next().
+ */
+struct os_eventq_info {
+    /** Name of the task which owns the queue, empty if not yet known. */
+    char oei_owner[OS_EVENTQ_INFO_NAME_LEN];
+    /** Snapshot of the queue statistics */
+    struct os_eventq_stats oei_stats;
+};
+#endif
+
+struct os_eventq_run_batch;
+
 struct os_eventq {
     /** Pointer to task that "owns" this event queue. */
     struct os_task *evq_owner;
@@ -88,6 +129,8 @@ struct os_eventq {
     struct os_task *evq_task;
 
     STAILQ_HEAD(, os_event) evq_list;
+    /** Events taken by os_eventq_run_n(), NULL when it is not running. */
+    struct os_eventq_run_batch *evq_run_batch;
 
 #if MYNEWT_VAL(OS_EVENTQ_DEBUG)
     /** Most recently processed event. */
@@ -97,6 +140,10 @@ struct os_eventq {
     struct os_eventq_mon *evq_mon;
     int evq_mon_elems;
 #endif
+#if MYNEWT_VAL(OS_EVENTQ_STATS)
+    struct os_eventq_stats evq_stats;
+    STAILQ_ENTRY(os_eventq) evq_stats_next;
+#endif
 };
 
 /**
@@ -147,6 +194,27 @@ struct os_event *os_eventq_get(struct os_eventq *);
  */
 void os_eventq_run(struct os_eventq *evq);
 
+/**
+ * Run a batch of events from an event queue.  Blocks until at least one
+ * event is available and runs it, then takes the events pending at that
+ * point, up to max or OS_EVENTQ_RUN_N_BATCH, off the queue in a single
+ * critical section and calls their callbacks in order.
+ *
+ * Events put on the queue while the batch is running are left for the next
+ * call, so an event which re-posts itself cannot keep this function from
+ * returning.  An event waiting in the batch still counts as queued: it
+ * reads as such with OS_EVENT_QUEUED(), os_eventq_put() of it is ignored
+ * and os_eventq_remove() takes it out of the batch.  A callback may call
+ * this function again on the same queue.
+ *
+ * @param evq The event queue to pull the events off.
+ * @param max Maximum number of events to run, 0 to run as many as one
+ *            batch holds.
+ *
+ * @return The number of events run.
+ */
+int os_eventq_run_n(struct os_eventq *evq, int max);
+
 
 /**
  * Poll the list of event queues specified by the evq parameter
@@ -207,6 +275,40 @@ static inline void os_eventq_mon_stop(struct os_eventq *evq)
 }
 #endif
 
+#if MYNEWT_VAL(OS_EVENTQ_STATS)
+/**
+ * Walk the list of initialized event queues.  A queue is added to the list
+ * by os_eventq_init().
+ *
+ * @param evq The previously returned event queue, or NULL to start from the
+ *            beginning of the list.
+ * @param oei Filled with information about the returned event queue.
+ *
+ * @return The next event queue, or NULL at the end of the list.
+ */
+struct os_eventq *os_eventq_info_get_next(struct os_eventq *evq,
+                                          struct os_eventq_info *oei);
+
+/**
+ * Clear the high-water depth, put count and wait statistics of an event
+ * queue.  The current depth is kept.
+ *
+ * @param evq The event queue to reset, or NULL to reset all queues.
+ */
+void os_eventq_stats_reset(struct os_eventq *evq);
+
+/**
+ * Remove an event queue from the list walked by os_eventq_info_get_next().
+ * Must be called before the memory of an initialized event queue is freed
+ * or goes out of scope.
+ *
+ * @param evq The event queue to remove.
+ */
+void os_eventq_stats_unlink(struct os_eventq *evq);
+#else
+#define os_eventq_stats_unlink(evq)
+#endif
+
 /**
  * @cond INTERNAL_HIDDEN
  * [DEPRECATED]
@@ -0,0 +1,135 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/**
+ * @addtogroup OSKernel
+ * @{
+ *   @defgroup OSEvring Interrupt Event Rings
+ *   @{
+ */
+
+#ifndef _OS_EVRING_H
+#define _OS_EVRING_H
+
+#include <inttypes.h>
+#include "os/os_eventq.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Bounded single-producer, single-consumer ring of events.
+ *
+ * The producer (typically one interrupt handler) pushes events with
+ * os_evring_put() without disabling interrupts.  The first push after the
+ * ring was drained posts the ring's drain event to an event queue, so a
+ * burst of events costs a single os_eventq_put() and at most one
+ * reschedule.  When the drain event is processed (by os_eventq_run(), or by
+ * calling its callback after os_eventq_poll()), the callbacks of all
+ * events in the ring are run in order.
+ *
+ * Unlike os_eventq, the same event may be in the ring several times; its
+ * ev_queued flag is not used.
+ */
+struct os_evring {
+    /** Event posted to er_evq when the ring becomes non-empty. */
+    struct os_event er_ev;
+    /** Event queue that drains this ring. */
+    struct os_eventq *er_evq;
+    /** Ring storage; er_size entries. */
+    struct os_event **er_buf;
+    /** Number of entries in er_buf; power of two. */
+    uint16_t er_size;
+    /** Free-running producer index. */
+    volatile uint16_t er_head;
+    /** Free-running consumer index. */
+    volatile uint16_t er_tail;
+    /** Whether er_ev has been posted and not yet started draining. */
+    volatile uint8_t er_posted;
+    /** Number of events dropped because the ring was full. */
+    uint32_t er_drops;
+};
+
+/**
+ * Initializes an event ring.
+ *
+ * @param er    The ring to initialize.
+ * @param evq   The event queue the ring's drain event is posted to.
+ * @param buf   Storage for the ring; must hold size event pointers.
+ * @param size  Number of entries in buf; must be a power of two.
+ *
+ * @return 0 on success; OS_EINVAL on bad arguments.
+ */
+int os_evring_init(struct os_evring *er, struct os_eventq *evq,
+                   struct os_event **buf, uint16_t size);
+
+/**
+ * Pushes an event into the ring.  Must only be called from a single
+ * context (e.g. one interrupt handler, which is not nested with itself).
+ *
+ * @param er    The ring to push into.
+ * @param ev    The event to push.
+ *
+ * @return 0 on success; OS_ENOMEM if the ring is full.
+ */
+int os_evring_put(struct os_evring *er, struct os_event *ev);
+
+/**
+ * Pulls the oldest event from the ring.  Must only be called by the task
+ * consuming the ring.
+ *
+ * @param er    The ring to pull from.
+ *
+ * @return The event, or NULL if the ring is empty.
+ */
+struct os_event *os_evring_get(struct os_evring *er);
+
+/**
+ * Runs the callbacks of all events currently in the ring.  This is the
+ * callback of the ring's drain event.
+ *
+ * @param er    The ring to drain.
+ *
+ * @return The number of events run.
+ */
+int os_evring_drain(struct os_evring *er);
+
+/**
+ * Returns the number of events waiting in the ring.
+ *
+ * @param er    The ring to query.
+ */
+static inline uint16_t
+os_evring_count(const struct os_evring *er)
+{
+    return er->er_head - er->er_tail;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _OS_EVRING_H */
+
+
+/**
+ *   @} OSEvring
+ * @} OSKernel
+ */
@@ -30,6 +30,8 @@
 #define H_OS_HEAP_
 
 #include <stddef.h>
+#include <stdint.h>
+#include "syscfg/syscfg.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -70,6 +72,101 @@ void os_free(void *mem);
  */
 void *os_realloc(void *ptr, size_t size);
 
+#if MYNEWT_VAL(OS_HEAP_TRACK)
+/**
+ * Heap usage counters, as returned by os_heap_stats_get().  Byte and block
+ * counts cover the allocations held in the tracking table; ohs_untracked
+ * counts the ones that did not fit.
+ */
+struct os_heap_stats {
+    /** Bytes currently allocated through os_malloc() and os_realloc() */
+    uint32_t ohs_cur_bytes;
+    /** High-water mark of ohs_cur_bytes */
+    uint32_t ohs_peak_bytes;
+    /** Number of currently allocated blocks */
+    uint16_t ohs_cur_blocks;
+    /** High-water mark of ohs_cur_blocks */
+    uint16_t ohs_peak_blocks;
+    /** Successful allocations, reallocations included */
+    uint32_t ohs_allocs;
+    /** Blocks released by os_free() or replaced by os_realloc() */
+    uint32_t ohs_frees;
+    /** Total number of bytes handed out, a measure of heap churn */
+    uint32_t ohs_alloc_bytes;
+    /** Allocations which failed */
+    uint32_t ohs_fails;
+    /** Allocations which did not fit in the tracking table */
+    uint32_t ohs_untracked;
+};
+
+/**
+ * A live allocation, as returned by os_heap_alloc_info_get_next().
+ */
+struct os_heap_alloc_info {
+    /** The allocated memory */
+    void *ohai_ptr;
+    /** Return address of the os_malloc() or os_realloc() call */
+    void *ohai_caller;
+    /** Requested size */
+    uint32_t ohai_size;
+    /**
+     * Priority of the task which made the allocation.  Allocations made
+     * before the OS was started are attributed to the idle task.
+     */
+    uint8_t ohai_prio;
+};
+
+/**
+ * All live allocations made from one call site, as returned by
+ * os_heap_site_info_get_next().
+ */
+struct os_heap_site_info {
+    /** Return address of the os_malloc() or os_realloc() call */
+    void *ohsi_caller;
+    /** Number of live allocations made from the call site */
+    uint16_t ohsi_blocks;
+    /** Bytes held by those allocations */
+    uint32_t ohsi_bytes;
+};
+
+/**
+ * Get a snapshot of the heap usage counters.
+ *
+ * @param ohs Filled in with the counters.
+ */
+void os_heap_stats_get(struct os_heap_stats *ohs);
+
+/**
+ * Clear the allocation, free, churn and failure counters and restart the
+ * high-water marks from the current usage.
+ */
+void os_heap_stats_reset(void);
+
+/**
+ * Walk the live allocations.  Start with idx 0 and pass the returned value
+ * back in to get the next allocation.
+ *
+ * @param idx Position to continue the walk from.
+ * @param ohai Filled in with the next allocation.
+ *
+ * @return The position to pass to the next call, or -1 at the end.
+ */
+int os_heap_alloc_info_get_next(int idx, struct os_heap_alloc_info *ohai);
+
+/**
+ * Walk the live allocations grouped by call site.  Start with idx 0 and
+ * pass the returned value back in to get the next site.  Each call scans
+ * the whole tracking table, so walking all sites is quadratic in the number
+ * of live allocations; this is meant for diagnostics only.
+ *
+ * @param idx Position to continue the walk from.
+ * @param ohsi Filled in with the totals of the next call site.
+ *
+ * @return The position to pass to the next call, or -1 at the end.
+ */
+int os_heap_site_info_get_next(int idx, struct os_heap_site_info *ohsi);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
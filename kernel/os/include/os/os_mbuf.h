@@ -36,6 +36,20 @@
 extern "C" {
 #endif
 
+#if MYNEWT_VAL(MSYS_STATS)
+/**
+ * Allocation statistics of an msys pool.
+ */
+struct os_mbuf_pool_stats {
+    /** Allocations for which this was the best fit pool, but it was empty */
+    uint32_t omps_miss;
+    /** Allocations served by this pool after a miss on another pool */
+    uint32_t omps_fallback;
+    /** Allocations which missed this pool and no other pool could serve */
+    uint32_t omps_fail;
+};
+#endif
+
 /**
  * A mbuf pool from which to allocate mbufs. This contains a pointer to the os
  * mempool to allocate mbufs out of, the total number of elements in the pool,
@@ -55,6 +69,10 @@ struct os_mbuf_pool {
     struct os_mempool *omp_pool;
 
     STAILQ_ENTRY(os_mbuf_pool) omp_next;
+#if MYNEWT_VAL(MSYS_STATS)
+    /** Msys allocation statistics */
+    struct os_mbuf_pool_stats omp_stats;
+#endif
 };
 
 
@@ -102,12 +120,49 @@ struct os_mbuf {
 
     SLIST_ENTRY(os_mbuf) om_next;
 
+#if MYNEWT_VAL(OS_MBUF_CLONE)
+    /**
+     * Number of mbufs referencing this mbuf's data buffer, this one included
+     */
+    uint16_t om_refcnt;
+    /**
+     * Mbuf whose data buffer om_data points into; NULL if om_data points into
+     * this mbuf's own buffer.  Kept last so that om_databuf directly follows
+     * the header without padding.
+     */
+    struct os_mbuf *om_shared;
+#endif
+
     /**
      * Pointer to the beginning of the data, after this buffer
      */
     uint8_t om_databuf[0];
 };
 
+/**
+ * Cursor into an mbuf chain.  Remembers the mbuf a chain offset was last
+ * found in, so that accessing the chain at increasing offsets does not walk
+ * it from the start every time.
+ */
+struct os_mbuf_cursor {
+    /** First mbuf of the chain */
+    struct os_mbuf *omc_head;
+    /** Mbuf the last seek ended in */
+    struct os_mbuf *omc_om;
+    /** Chain offset of the first data byte of omc_om */
+    int omc_base;
+};
+
+/**
+ * A contiguous data segment of an mbuf chain, see os_mbuf_to_iovec().
+ */
+struct os_mbuf_iovec {
+    /** Start of the segment */
+    void *iov_base;
+    /** Length of the segment, in bytes */
+    uint16_t iov_len;
+};
+
 /**
  * Structure representing a queue of mbufs.
  */
@@ -172,6 +227,36 @@ struct os_mqueue {
 #define OS_MBUF_USRHDR_LEN(om) \
     ((om)->om_pkthdr_len - sizeof (struct os_mbuf_pkthdr))
 
+/**
+ * Checks whether an mbuf does not have exclusive use of the buffer its data
+ * lives in, see os_mbuf_clone().  Such an mbuf has no leading or trailing
+ * space, and its data must not be written in place: os_mbuf_copyinto()
+ * copies it first, os_mbuf_unshare() does so for a whole chain.  An mbuf
+ * whose data lives in another mbuf's buffer that it alone references is not
+ * shared.
+ *
+ * @param __om The mbuf to check
+ */
+#if MYNEWT_VAL(OS_MBUF_CLONE)
+#define OS_MBUF_IS_SHARED(__om) \
+    (OS_MBUF_BUF_OWNER(__om)->om_refcnt > 1)
+#else
+#define OS_MBUF_IS_SHARED(__om) (0)
+#endif
+
+
+/** @cond INTERNAL_HIDDEN */
+
+/* The mbuf whose data buffer an mbuf's data lives in. */
+#if MYNEWT_VAL(OS_MBUF_CLONE)
+#define OS_MBUF_BUF_OWNER(__om) \
+    ((__om)->om_shared != NULL ? (__om)->om_shared : (__om))
+#else
+#define OS_MBUF_BUF_OWNER(__om) (__om)
+#endif
+
+/** @endcond */
+
 
 /** @cond INTERNAL_HIDDEN */
 
@@ -181,16 +266,22 @@ struct os_mqueue {
 static inline uint16_t
 _os_mbuf_leadingspace(struct os_mbuf *om)
 {
+    struct os_mbuf *owner;
     uint16_t startoff;
     uint16_t leadingspace;
 
+    if (OS_MBUF_IS_SHARED(om)) {
+        return 0;
+    }
+
+    owner = OS_MBUF_BUF_OWNER(om);
     startoff = 0;
-    if (OS_MBUF_IS_PKTHDR(om)) {
-        startoff = om->om_pkthdr_len;
+    if (OS_MBUF_IS_PKTHDR(owner)) {
+        startoff = owner->om_pkthdr_len;
     }
 
     leadingspace = (uint16_t) (OS_MBUF_DATA(om, uint8_t *) -
-        ((uint8_t *) &om->om_databuf[0] + startoff));
+        ((uint8_t *) &owner->om_databuf[0] + startoff));
 
     return (leadingspace);
 }
@@ -217,10 +308,16 @@ static inline uint16_t
 _os_mbuf_trailingspace(struct os_mbuf *om)
 {
     struct os_mbuf_pool *omp;
+    struct os_mbuf *owner;
+
+    if (OS_MBUF_IS_SHARED(om)) {
+        return 0;
+    }
 
-    omp = om->om_omp;
+    owner = OS_MBUF_BUF_OWNER(om);
+    omp = owner->om_omp;
 
-    return (&om->om_databuf[0] + omp->omp_databuf_len) -
+    return (&owner->om_databuf[0] + omp->omp_databuf_len) -
       (om->om_data + om->om_len);
 }
 
@@ -298,7 +395,9 @@ int os_msys_register(struct os_mbuf_pool *);
 
 /**
  * Allocate a mbuf from msys.  Based upon the data size requested,
- * os_msys_get() will choose the mbuf pool that has the best fit.
+ * os_msys_get() will choose the mbuf pool that has the best fit.  If that
+ * pool is empty and MSYS_FALLBACK is enabled, larger pools are tried in
+ * order of block size.
  *
  * @param dsize The estimated size of the data being stored in the mbuf
  * @param leadingspace The amount of leadingspace to allocate in the mbuf
@@ -316,6 +415,9 @@ void os_msys_reset(void);
  * Allocate a packet header structure from the MSYS pool.  See
  * os_msys_register() for a description of MSYS.
  *
+ * If the best fit pool is empty and MSYS_FALLBACK is enabled, larger pools
+ * are tried in order of block size.
+ *
  * @param dsize The estimated size of the data being stored in the mbuf
  * @param user_hdr_len The length to allocate for the packet header structure
  *
@@ -337,6 +439,15 @@ int os_msys_count(void);
  */
 int os_msys_num_free(void);
 
+/**
+ * Walk the mbuf pools registered with msys, smallest block size first.
+ *
+ * @param omp The previously returned pool, or NULL to get the first one.
+ *
+ * @return The next pool, or NULL at the end of the list.
+ */
+struct os_mbuf_pool *os_msys_pool_get_next(struct os_mbuf_pool *omp);
+
 /**
  * Initialize a pool of mbufs.
  *
@@ -383,6 +494,34 @@ struct os_mbuf *os_mbuf_get_pkthdr(struct os_mbuf_pool *omp,
  */
 struct os_mbuf *os_mbuf_dup(struct os_mbuf *m);
 
+/**
+ * Clones a chain of mbufs without copying its data.  The mbufs of the clone
+ * point into the data buffers of the original chain, which stay allocated
+ * until the last mbuf referencing them is freed.  The data of both chains
+ * becomes read-only, see OS_MBUF_IS_SHARED().
+ *
+ * Without OS_MBUF_CLONE, the data is copied as by os_mbuf_dup().
+ *
+ * @param om                    The mbuf chain to clone.
+ * @param omp                   The pool to allocate the clone's mbufs from;
+ *                                  NULL to use the smallest msys pool which
+ *                                  fits the packet header.
+ *
+ * @return                      The clone on success; NULL on failure.
+ */
+struct os_mbuf *os_mbuf_clone(struct os_mbuf *om, struct os_mbuf_pool *omp);
+
+/**
+ * Gives every mbuf in a chain a private copy of data it shares with other
+ * mbufs, so that the data can be written in place.
+ *
+ * @param om                    The mbuf chain to unshare.
+ *
+ * @return                      0 on success;
+ *                              OS_ENOMEM if a buffer could not be allocated.
+ */
+int os_mbuf_unshare(struct os_mbuf *om);
+
 /**
  * Locates the specified absolute offset within an mbuf chain.  The offset
  * can be one past than the total length of the chain, but no greater.
@@ -528,6 +667,70 @@ int os_mbuf_cmpm(const struct os_mbuf *om1, uint16_t offset1,
                  const struct os_mbuf *om2, uint16_t offset2,
                  uint16_t len);
 
+/**
+ * Initializes a cursor at the start of an mbuf chain.
+ *
+ * @param omc                   The cursor to initialize.
+ * @param om                    The mbuf chain to iterate.
+ */
+void os_mbuf_cursor_init(struct os_mbuf_cursor *omc, struct os_mbuf *om);
+
+/**
+ * Locates an offset within the cursor's mbuf chain.  Seeking forward
+ * continues from the previous position; seeking backward starts over from
+ * the head of the chain.
+ *
+ * Iterating over the contiguous segments of a chain is done by seeking to
+ * off, consuming *out_len bytes and seeking to off + *out_len.
+ *
+ * @param omc                   The cursor to seek.
+ * @param off                   The offset from the start of the chain.
+ * @param out_len               On success, the number of contiguous bytes
+ *                                  available at the returned address.
+ *                                  May be NULL.
+ *
+ * @return                      Pointer to the data at the offset on success;
+ *                              NULL if the offset is out of bounds.
+ */
+uint8_t *os_mbuf_cursor_seek(struct os_mbuf_cursor *omc, int off,
+                             int *out_len);
+
+/**
+ * Same as os_mbuf_copydata(), but goes through a cursor.
+ *
+ * @return                      0 on success;
+ *                              -1 if the mbuf does not contain enough data.
+ */
+int os_mbuf_cursor_copydata(struct os_mbuf_cursor *omc, int off, int len,
+                            void *dst);
+
+/**
+ * Same as os_mbuf_cmpf(), but goes through a cursor.
+ *
+ * @return                      0 if both memory regions are identical;
+ *                              A memcmp return code if there is a mismatch;
+ *                              INT_MAX if the mbuf is too short.
+ */
+int os_mbuf_cursor_cmpf(struct os_mbuf_cursor *omc, int off,
+                        const void *data, int len);
+
+/**
+ * Describes a region of an mbuf chain as an array of contiguous segments,
+ * without copying any data.
+ *
+ * @param om                    The mbuf chain.
+ * @param off                   The offset of the region within the chain.
+ * @param len                   The length of the region.
+ * @param iov                   Array to fill in.
+ * @param iovcnt                Number of entries in iov.
+ *
+ * @return                      The number of entries filled in.  The region
+ *                                  is cut short if the chain ends or iov
+ *                                  fills up.
+ */
+int os_mbuf_to_iovec(struct os_mbuf *om, int off, int len,
+                     struct os_mbuf_iovec *iov, int iovcnt);
+
 /**
  * Increases the length of an mbuf chain by adding data to the front.  If there
  * is insufficient room in the leading mbuf, additional mbufs are allocated and
@@ -273,6 +273,89 @@ os_error_t os_memblock_put_from_cb(struct os_mempool *mp, void *block_addr);
  */
 os_error_t os_memblock_put(struct os_mempool *mp, void *block_addr);
 
+#if MYNEWT_VAL(OS_MEMPOOL_CACHE)
+/**
+ * A small cache of free blocks taken from a memory pool, for use by a single
+ * task (or by whatever task runs a given event queue).  Gets and puts that
+ * hit the cache run without a critical section; the cache is refilled from
+ * and flushed to the pool in batches.
+ *
+ * Cached blocks are not free as far as the pool is concerned, i.e. they are
+ * not counted in mp_num_free.  A cache must not be used from interrupt
+ * context or by more than one task.
+ */
+struct os_mempool_cache {
+    /** Pool the cached blocks belong to */
+    struct os_mempool *mc_pool;
+    /** Task whose removal flushes the cache, or NULL */
+    struct os_task *mc_task;
+    /** Cached free blocks */
+    SLIST_HEAD(, os_memblock) mc_blocks;
+    /** Number of cached blocks */
+    uint16_t mc_cnt;
+    /** Maximum number of cached blocks */
+    uint16_t mc_size;
+    /** Number of blocks moved per refill or flush */
+    uint16_t mc_batch;
+    /** Number of gets served from the cache */
+    uint32_t mc_hits;
+    /** Number of refills from the pool */
+    uint32_t mc_refills;
+    /** Number of flushes to the pool */
+    uint32_t mc_flushes;
+
+    SLIST_ENTRY(os_mempool_cache) mc_next;
+};
+
+/**
+ * Initializes a mempool cache.
+ *
+ * @param mc            The cache to initialize.
+ * @param mp            The pool to cache blocks of.  Extended pools with a
+ *                          put callback can not be cached.
+ * @param size          Maximum number of blocks to hold.
+ * @param task          Task which uses the cache; the cache is flushed when
+ *                          the task is removed with os_task_remove().  NULL
+ *                          if the owner calls os_mempool_cache_flush()
+ *                          itself.
+ *
+ * @return 0 on success, OS_INVALID_PARM on bad arguments.
+ */
+os_error_t os_mempool_cache_init(struct os_mempool_cache *mc,
+                                 struct os_mempool *mp, uint16_t size,
+                                 struct os_task *task);
+
+/**
+ * Gets a block through a mempool cache.  Refills the cache from the pool
+ * when it is empty.
+ *
+ * @param mc            The cache to get a block from.
+ *
+ * @return A block, or NULL if the cache and the pool are both empty.
+ */
+void *os_mempool_cache_get(struct os_mempool_cache *mc);
+
+/**
+ * Puts a block through a mempool cache.  Flushes a batch of blocks back to
+ * the pool when the cache is full.
+ *
+ * @param mc            The cache to put the block into.
+ * @param block_addr    A block allocated from the cache's pool.
+ *
+ * @return 0 on success, OS_INVALID_PARM on bad arguments.
+ */
+os_error_t os_mempool_cache_put(struct os_mempool_cache *mc, void *block_addr);
+
+/**
+ * Returns all blocks held by a mempool cache to its pool and detaches the
+ * cache from its task.  The cache can still be used afterwards, but is no
+ * longer flushed automatically.
+ *
+ * @param mc            The cache to flush.
+ */
+void os_mempool_cache_flush(struct os_mempool_cache *mc);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
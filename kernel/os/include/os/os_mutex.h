@@ -34,6 +34,47 @@
 extern "C" {
 #endif
 
+#if MYNEWT_VAL(OS_MUTEX_STATS)
+/**
+ * Contention statistics of a mutex.  Times are in os_cputime ticks.
+ * Nested pends by the owner are not counted.
+ */
+struct os_mutex_stats {
+    /** Number of times the mutex was acquired */
+    uint32_t ms_acquired;
+    /** Pends which found the mutex held by another task */
+    uint32_t ms_contended;
+    /** Contended pends which failed, including those with no timeout */
+    uint32_t ms_timeouts;
+    /** Times the owner's priority was raised for a waiter */
+    uint32_t ms_boosts;
+    /** Longest time a task waited for the mutex */
+    uint32_t ms_max_wait;
+    /** Longest time the mutex was held */
+    uint32_t ms_max_hold;
+    /** Total time tasks spent waiting for the mutex */
+    uint64_t ms_total_wait;
+};
+
+/**
+ * Information about a mutex, as returned by os_mutex_info_get_next().
+ */
+struct os_mutex_info {
+    /** Name given with os_mutex_stats_register() */
+    const char *omi_name;
+    /** Return address of the os_mutex_init() call */
+    void *omi_init_caller;
+    /** Priority of the owner, as boosted; 0 if not held */
+    uint8_t omi_owner_prio;
+    /** Number of tasks waiting for the mutex */
+    uint8_t omi_waiters;
+    /** Nesting level, 0 if not held */
+    uint16_t omi_level;
+    /** Snapshot of the statistics */
+    struct os_mutex_stats omi_stats;
+};
+#endif
+
 /**
  * OS mutex structure
  */
@@ -46,6 +87,14 @@ struct os_mutex {
     uint16_t    mu_level;
     /** Task that owns the mutex */
     struct os_task *mu_owner;
+#if MYNEWT_VAL(OS_MUTEX_STATS)
+    struct os_mutex_stats mu_stats;
+    /** os_cputime at which the current owner acquired the mutex */
+    uint32_t mu_acq_time;
+    const char *mu_name;
+    void *mu_init_caller;
+    STAILQ_ENTRY(os_mutex) mu_stats_next;
+#endif
 };
 
 /*
@@ -122,6 +171,50 @@ static inline uint16_t os_mutex_get_level(struct os_mutex *mu)
     return mu->mu_level;
 }
 
+#if MYNEWT_VAL(OS_MUTEX_STATS)
+/**
+ * Add a mutex to the list walked by os_mutex_info_get_next().  Statistics
+ * are kept for every mutex, but only registered ones can be read out.  Call
+ * after os_mutex_init(); registering a mutex again only changes its name.
+ * A registered mutex must be unlinked with os_mutex_stats_unlink() before
+ * its memory is freed or goes out of scope.
+ *
+ * @param mu Pointer to mutex.
+ * @param name Name of the mutex; must stay valid as long as the mutex.
+ */
+void os_mutex_stats_register(struct os_mutex *mu, const char *name);
+
+/**
+ * Walk the list of registered mutexes.
+ *
+ * @param mu The previously returned mutex, or NULL to start from the
+ *           beginning of the list.
+ * @param omi Filled with information about the returned mutex.
+ *
+ * @return The next mutex, or NULL at the end of the list.
+ */
+struct os_mutex *os_mutex_info_get_next(struct os_mutex *mu,
+                                        struct os_mutex_info *omi);
+
+/**
+ * Clear the statistics of a mutex.
+ *
+ * @param mu The mutex to reset, or NULL to reset all registered mutexes.
+ */
+void os_mutex_stats_reset(struct os_mutex *mu);
+
+/**
+ * Remove a mutex from the list walked by os_mutex_info_get_next().  Does
+ * nothing if the mutex is not registered.
+ *
+ * @param mu Pointer to mutex.
+ */
+void os_mutex_stats_unlink(struct os_mutex *mu);
+#else
+#define os_mutex_stats_register(mu, name) ((void)(mu), (void)(name))
+#define os_mutex_stats_unlink(mu) ((void)(mu))
+#endif
+
 #ifdef __cplusplus
 }
 #endif
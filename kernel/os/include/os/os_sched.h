@@ -92,6 +92,7 @@ struct os_task *os_sched_next_task(void);
 void os_sched(struct os_task *);
 
 /** @cond INTERNAL_HIDDEN */
+void os_sched_init(void);
 void os_sched_os_timer_exp(void);
 os_error_t os_sched_insert(struct os_task *);
 int os_sched_sleep(struct os_task *, os_time_t nticks);
@@ -105,6 +105,10 @@ struct os_task {
     uint8_t t_flags;
     uint8_t t_lockcnt;
     uint8_t t_pad;
+#if MYNEWT_VAL(OS_SCHED_BITMAP)
+    /** Priority the task was inserted into the run list with */
+    uint8_t t_sched_prio;
+#endif
 
     /** Task name */
     const char *t_name;
@@ -129,9 +133,34 @@ struct os_task {
      */
     uint32_t t_ctx_sw_cnt;
 
+#if MYNEWT_VAL(OS_TASK_CPU_STATS)
+    /** Total run time in os_cputime ticks */
+    uint64_t t_cpu_time;
+    /** Number of times the task was switched out while ready to run */
+    uint32_t t_preempt_cnt;
+    /** Number of times the task was switched out because it blocked */
+    uint32_t t_voluntary_cnt;
+    /** os_cputime when the task last became ready to run */
+    uint32_t t_ready_time;
+    /** Longest time, in os_cputime ticks, spent waiting for the CPU */
+    uint32_t t_max_ready_latency;
+#endif
+
     STAILQ_ENTRY(os_task) t_os_task_list;
     TAILQ_ENTRY(os_task) t_os_list;
     SLIST_ENTRY(os_task) t_obj_list;
+#if MYNEWT_VAL(OS_MEMPOOL_CACHE)
+    /** Mempool caches to flush when the task is removed */
+    SLIST_HEAD(, os_mempool_cache) t_mempool_caches;
+#endif
+#if MYNEWT_VAL(OS_SCHED_SLEEP_HEAP)
+    /** Sleep heap linkage: leftmost child */
+    struct os_task *t_heap_child;
+    /** Sleep heap linkage: right sibling */
+    struct os_task *t_heap_next;
+    /** Sleep heap linkage: left sibling, or parent if leftmost child */
+    struct os_task *t_heap_prev;
+#endif
 };
 
 /** @cond INTERNAL_HIDDEN */
@@ -205,6 +234,16 @@ struct os_task_info {
     uint32_t oti_cswcnt;
     /** Task runtime */
     uint32_t oti_runtime;
+#if MYNEWT_VAL(OS_TASK_CPU_STATS)
+    /** Task run time in os_cputime ticks */
+    uint64_t oti_cputime;
+    /** Number of times the task was preempted */
+    uint32_t oti_preempt_cnt;
+    /** Number of times the task gave up the CPU by blocking */
+    uint32_t oti_voluntary_cnt;
+    /** Longest wait for the CPU after becoming ready, in os_cputime ticks */
+    uint32_t oti_max_ready_latency;
+#endif
     /** Last time this task checked in with sanity */
     os_time_t oti_last_checkin;
     /** Next time this task is scheduled to check-in with sanity */
@@ -223,6 +262,7 @@ struct os_task_info {
  * - Stack Size
  * - Context Switch Count
  * - Runtime
+ * - CPU time, switch counts and ready latency (OS_TASK_CPU_STATS)
  * - Last & Next Sanity checkin
  * - Task Name
  *
@@ -255,6 +295,7 @@ struct os_task *os_task_info_get_next(const struct os_task *,
  * - Stack Size
  * - Context Switch Count
  * - Runtime
+ * - CPU time, switch counts and ready latency (OS_TASK_CPU_STATS)
  * - Last & Next Sanity checkin
  * - Task Name
  *
@@ -263,6 +304,69 @@ struct os_task *os_task_info_get_next(const struct os_task *,
  */
 void os_task_info_get(const struct os_task *task, struct os_task_info *oti);
 
+#if MYNEWT_VAL(OS_TASK_CPU_STATS)
+/**
+ * Returns the share of CPU time spent in the idle task since the task CPU
+ * statistics were last reset (or since boot).
+ *
+ * @return Idle time in percent.
+ */
+int os_task_cpu_idle_pct(void);
+
+/**
+ * Clears CPU time, switch counters and maximum ready latency of all tasks.
+ */
+void os_task_cpu_stats_reset(void);
+#endif
+
+#if MYNEWT_VAL(OS_TASK_STACK_WATERMARK)
+/**
+ * Stack high-water marks of a task, as returned by
+ * os_task_stack_info_get_next().  All sizes are in os_stack_t units.
+ */
+struct os_task_stack_info {
+    /** Name of the task, or NULL if no such task is running */
+    const char *otsi_name;
+    /** Hash of the task name, identifies the task across reboots */
+    uint32_t otsi_name_hash;
+    /** Stack size of the task */
+    uint16_t otsi_stksize;
+    /** Highest stack usage seen since boot */
+    uint16_t otsi_hwm;
+    /** Highest stack usage seen over all boots since the last reset */
+    uint16_t otsi_hwm_max;
+    /** Suggested stack size: otsi_hwm_max plus a safety margin */
+    uint16_t otsi_recommended;
+};
+
+/**
+ * Scan part of a task stack for its high-water mark.  Each call looks at no
+ * more than OS_TASK_STACK_WATERMARK_SCAN_WORDS words, resuming where the
+ * previous call stopped, and moves on to the next task once a stack has been
+ * covered.  Called by the idle task along with the sanity checks.
+ */
+void os_task_stack_sample(void);
+
+/**
+ * Walk the stack high-water marks.  The maxima are kept in RAM that is not
+ * cleared on a soft reset, so tasks that are not running in this boot may
+ * be reported as well.  Start with idx 0 and pass the returned value back
+ * in to get the next entry.
+ *
+ * @param idx Position to continue the walk from.
+ * @param otsi Filled in with the next entry.
+ *
+ * @return The position to pass to the next call, or -1 at the end.
+ */
+int os_task_stack_info_get_next(int idx, struct os_task_stack_info *otsi);
+
+/**
+ * Forget the high-water marks of all boots and start again from the usage
+ * of this boot.
+ */
+void os_task_stack_reset(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -20,21 +20,36 @@
 #ifndef OS_TRACE_API_H
 #define OS_TRACE_API_H
 
+#include "syscfg/syscfg.h"
+
+/* Set if any trace backend is enabled and the trace hooks must be called. */
+#if MYNEWT_VAL(OS_SYSVIEW) || MYNEWT_VAL(OS_TRACE_RAM)
+#define OS_TRACE_ENABLED                1
+#else
+#define OS_TRACE_ENABLED                0
+#endif
+
 #ifdef __ASSEMBLER__
 
+#if MYNEWT_VAL(OS_TRACE_RAM)
+#define os_trace_isr_enter              os_trace_ram_isr_enter
+#define os_trace_isr_exit               os_trace_ram_isr_exit
+#define os_trace_task_start_exec        os_trace_ram_task_start_exec
+#else
 #define os_trace_isr_enter              SEGGER_SYSVIEW_RecordEnterISR
 #define os_trace_isr_exit               SEGGER_SYSVIEW_RecordExitISR
 #define os_trace_task_start_exec        SEGGER_SYSVIEW_OnTaskStartExec
+#endif
 
 #else
 
 #include <stdio.h>
 #include <string.h>
-#include "syscfg/syscfg.h"
 #if MYNEWT_VAL(OS_SYSVIEW)
 #include "sysview/vendor/SEGGER_SYSVIEW.h"
 #endif
 #include "os/os.h"
+#include "os/os_trace_ram.h"
 
 #define OS_TRACE_ID_EVENTQ_PUT                  (40)
 #define OS_TRACE_ID_EVENTQ_GET_NO_WAIT          (41)
@@ -204,7 +219,119 @@ os_trace_api_ret_u32(unsigned id, uint32_t ret)
 
 #endif /* MYNEWT_VAL(OS_SYSVIEW) && !defined(OS_TRACE_DISABLE_FILE_API) */
 
-#if !MYNEWT_VAL(OS_SYSVIEW)
+#if MYNEWT_VAL(OS_TRACE_RAM)
+
+static inline void
+os_trace_isr_enter(void)
+{
+    os_trace_ram_isr_enter();
+}
+
+static inline void
+os_trace_isr_exit(void)
+{
+    os_trace_ram_isr_exit();
+}
+
+static inline void
+os_trace_task_info(const struct os_task *t)
+{
+}
+
+static inline void
+os_trace_task_create(const struct os_task *t)
+{
+    os_trace_ram_record(OS_TRACE_RAM_T_TASK_CREATE, 0,
+                        (uint32_t)(uintptr_t)t, t->t_prio, 0);
+}
+
+static inline void
+os_trace_task_start_exec(const struct os_task *t)
+{
+    os_trace_ram_task_start_exec(t);
+}
+
+static inline void
+os_trace_task_stop_exec(void)
+{
+    os_trace_ram_record(OS_TRACE_RAM_T_TASK_STOP_EXEC, 0, 0, 0, 0);
+}
+
+static inline void
+os_trace_task_start_ready(const struct os_task *t)
+{
+    os_trace_ram_record(OS_TRACE_RAM_T_TASK_START_READY, 0,
+                        (uint32_t)(uintptr_t)t, 0, 0);
+}
+
+static inline void
+os_trace_task_stop_ready(const struct os_task *t, unsigned reason)
+{
+    os_trace_ram_record(OS_TRACE_RAM_T_TASK_STOP_READY, 0,
+                        (uint32_t)(uintptr_t)t, reason, 0);
+}
+
+static inline void
+os_trace_idle(void)
+{
+    os_trace_ram_record(OS_TRACE_RAM_T_IDLE, 0, 0, 0, 0);
+}
+
+static inline void
+os_trace_user_start(unsigned id)
+{
+    os_trace_ram_record(OS_TRACE_RAM_T_USER_START, 0, id, 0, 0);
+}
+
+static inline void
+os_trace_user_stop(unsigned id)
+{
+    os_trace_ram_record(OS_TRACE_RAM_T_USER_STOP, 0, id, 0, 0);
+}
+
+#endif /* MYNEWT_VAL(OS_TRACE_RAM) */
+
+#if MYNEWT_VAL(OS_TRACE_RAM) && !defined(OS_TRACE_DISABLE_FILE_API)
+
+static inline void
+os_trace_api_void(unsigned id)
+{
+    os_trace_ram_record(OS_TRACE_RAM_T_API_0, id, 0, 0, 0);
+}
+
+static inline void
+os_trace_api_u32(unsigned id, uint32_t p0)
+{
+    os_trace_ram_record(OS_TRACE_RAM_T_API_1, id, p0, 0, 0);
+}
+
+static inline void
+os_trace_api_u32x2(unsigned id, uint32_t p0, uint32_t p1)
+{
+    os_trace_ram_record(OS_TRACE_RAM_T_API_2, id, p0, p1, 0);
+}
+
+static inline void
+os_trace_api_u32x3(unsigned id, uint32_t p0, uint32_t p1, uint32_t p2)
+{
+    os_trace_ram_record(OS_TRACE_RAM_T_API_3, id, p0, p1, p2);
+}
+
+static inline void
+os_trace_api_ret(unsigned id)
+{
+    os_trace_ram_record(OS_TRACE_RAM_T_API_RET, id, 0, 0, 0);
+}
+
+static inline void
+os_trace_api_ret_u32(unsigned id, uint32_t ret)
+{
+    os_trace_ram_record(OS_TRACE_RAM_T_API_RET_U32, id, ret, 0, 0);
+}
+
+#endif /* MYNEWT_VAL(OS_TRACE_RAM) && !defined(OS_TRACE_DISABLE_FILE_API) */
+
+#if !OS_TRACE_ENABLED
 
 static inline void
 os_trace_isr_enter(void)
@@ -261,9 +388,9 @@ os_trace_user_stop(unsigned id)
 {
 }
 
-#endif /* !MYNEWT_VAL(OS_SYSVIEW) */
+#endif /* !OS_TRACE_ENABLED */
 
-#if !MYNEWT_VAL(OS_SYSVIEW) || defined(OS_TRACE_DISABLE_FILE_API)
+#if !OS_TRACE_ENABLED || defined(OS_TRACE_DISABLE_FILE_API)
 
 static inline void
 os_trace_api_void(unsigned id)
@@ -295,7 +422,7 @@ os_trace_api_ret_u32(unsigned id, uint32_t return_value)
 {
 }
 
-#endif /* !MYNEWT_VAL(OS_SYSVIEW) || defined(OS_TRACE_DISABLE_FILE_API) */
+#endif /* !OS_TRACE_ENABLED || defined(OS_TRACE_DISABLE_FILE_API) */
 
 #endif /* __ASSEMBLER__ */
 
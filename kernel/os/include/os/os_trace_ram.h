@@ -0,0 +1,194 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/**
+ * @addtogroup OSKernel
+ * @{
+ *   @defgroup OSTraceRam RAM trace buffer
+ *   @{
+ */
+
+#ifndef H_OS_TRACE_RAM_
+#define H_OS_TRACE_RAM_
+
+#include <stdint.h>
+#include "syscfg/syscfg.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if MYNEWT_VAL(OS_TRACE_RAM)
+
+struct os_task;
+
+/** Marks the start of the trace buffer, in RAM and in dumps */
+#define OS_TRACE_RAM_MAGIC              0x5452434d
+/** Marks the start of the task table which follows the buffer in dumps */
+#define OS_TRACE_RAM_TASK_MAGIC         0x4b545254
+#define OS_TRACE_RAM_VERSION            1
+
+/*
+ * Record types.  OS_TRACE_RAM_T_TIME carries the absolute timestamp in
+ * otr_arg[0]; it is written whenever the delta to the previous record does
+ * not fit in otr_dt.
+ */
+#define OS_TRACE_RAM_T_TIME             0
+#define OS_TRACE_RAM_T_ISR_ENTER        1
+#define OS_TRACE_RAM_T_ISR_EXIT         2
+#define OS_TRACE_RAM_T_TASK_CREATE      3
+#define OS_TRACE_RAM_T_TASK_START_EXEC  4
+#define OS_TRACE_RAM_T_TASK_STOP_EXEC   5
+#define OS_TRACE_RAM_T_TASK_START_READY 6
+#define OS_TRACE_RAM_T_TASK_STOP_READY  7
+#define OS_TRACE_RAM_T_IDLE             8
+#define OS_TRACE_RAM_T_USER_START       9
+#define OS_TRACE_RAM_T_USER_STOP        10
+/* API call with 0 to 3 arguments; otr_id is one of OS_TRACE_ID_* */
+#define OS_TRACE_RAM_T_API_0            11
+#define OS_TRACE_RAM_T_API_1            12
+#define OS_TRACE_RAM_T_API_2            13
+#define OS_TRACE_RAM_T_API_3            14
+#define OS_TRACE_RAM_T_API_RET          15
+#define OS_TRACE_RAM_T_API_RET_U32      16
+
+/** Set in oth_flags while events are being recorded */
+#define OS_TRACE_RAM_F_RUNNING          0x0001
+
+/**
+ * One trace record.  All fields are in the target's byte order.
+ */
+struct os_trace_ram_rec {
+    /** Timestamp delta to the previous record, in os_cputime ticks */
+    uint16_t otr_dt;
+    /** One of OS_TRACE_RAM_T_* */
+    uint8_t otr_type;
+    /** API or user event ID, if any */
+    uint8_t otr_id;
+    /** Event arguments */
+    uint32_t otr_arg[3];
+};
+
+/**
+ * Header of the trace buffer.  The records follow it directly, both in RAM
+ * and in dumps.  The buffer is a ring: the newest record is at index
+ * (oth_head - 1) % oth_num_recs.
+ */
+struct os_trace_ram_hdr {
+    /** OS_TRACE_RAM_MAGIC */
+    uint32_t oth_magic;
+    /** OS_TRACE_RAM_VERSION */
+    uint8_t oth_version;
+    /** sizeof(struct os_trace_ram_rec) */
+    uint8_t oth_rec_size;
+    /** OS_TRACE_RAM_F_* */
+    uint16_t oth_flags;
+    /** Size of the ring, in records */
+    uint32_t oth_num_recs;
+    /** Timestamp frequency, in Hz */
+    uint32_t oth_freq;
+    /** Number of records written since the buffer was last cleared */
+    uint32_t oth_head;
+    /** Absolute timestamp of the newest record */
+    uint32_t oth_last_ts;
+};
+
+/**
+ * Task table entry, as appended to dumps so that task addresses can be
+ * resolved to names.
+ */
+struct os_trace_ram_task {
+    uint32_t ott_task;
+    uint8_t ott_prio;
+    /** Task name, truncated and NUL padded */
+    char ott_name[11];
+};
+
+/**
+ * Append a record to the trace buffer.  Does nothing while recording is
+ * stopped.  May be called from interrupt context.
+ *
+ * @param type One of OS_TRACE_RAM_T_*
+ * @param id API or user event ID
+ * @param a0, a1, a2 Event arguments
+ */
+void os_trace_ram_record(uint8_t type, uint8_t id, uint32_t a0, uint32_t a1,
+                         uint32_t a2);
+
+/*
+ * Hooks called from the architecture's interrupt and context switch code.
+ */
+void os_trace_ram_isr_enter(void);
+void os_trace_ram_isr_exit(void);
+void os_trace_ram_task_start_exec(const struct os_task *t);
+
+/**
+ * Start recording events.
+ */
+void os_trace_ram_start(void);
+
+/**
+ * Stop recording events.  The buffer contents are kept.
+ */
+void os_trace_ram_stop(void);
+
+/**
+ * Check whether events are being recorded.
+ *
+ * @return 1 if recording, 0 if stopped.
+ */
+int os_trace_ram_running(void);
+
+/**
+ * Discard all recorded events.
+ */
+void os_trace_ram_clear(void);
+
+/**
+ * Get the size of a trace dump: the buffer header, the ring of records and
+ * a table of the current tasks.
+ *
+ * @return The dump size, in bytes.
+ */
+uint32_t os_trace_ram_dump_size(void);
+
+/**
+ * Read part of a trace dump.  Recording should be stopped while a dump is
+ * read in several parts, otherwise the parts will not be consistent.
+ *
+ * @param off Offset within the dump to read from.
+ * @param dst Buffer to read into.
+ * @param len Number of bytes to read.
+ *
+ * @return The number of bytes read; 0 at the end of the dump.
+ */
+uint32_t os_trace_ram_dump_read(uint32_t off, void *dst, uint32_t len);
+
+#endif /* MYNEWT_VAL(OS_TRACE_RAM) */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* H_OS_TRACE_RAM_ */
+
+/**
+ *   @} OSTraceRam
+ * @} OSKernel
+ */
@@ -0,0 +1,354 @@
+#! /usr/bin/env python3
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+#
+
+
+"""
+Convert an OS_TRACE_RAM trace buffer into Chrome trace event JSON, which
+can be opened in chrome://tracing or https://ui.perfetto.dev.
+
+The input may be any of:
+  - a console log containing the output of the 'trace dump' shell command,
+  - the raw dump read with the SMP OS group trace command (ID 10),
+  - a coredump file, in which the trace buffer is located by its magic.
+
+Targets are assumed to be little endian.
+"""
+
+import argparse
+import json
+import re
+import struct
+import sys
+
+TRACE_MAGIC = 0x5452434d
+TASK_MAGIC = 0x4b545254
+COREDUMP_MAGIC = 0x690c47c3
+COREDUMP_TLV_MEM = 2
+
+HDR_FMT = '<IBBHIIII'
+HDR_SIZE = struct.calcsize(HDR_FMT)
+REC_FMT = '<HBBIII'
+REC_SIZE = struct.calcsize(REC_FMT)
+TASK_FMT = '<IB11s'
+TASK_SIZE = struct.calcsize(TASK_FMT)
+
+(T_TIME, T_ISR_ENTER, T_ISR_EXIT, T_TASK_CREATE, T_TASK_START_EXEC,
+ T_TASK_STOP_EXEC, T_TASK_START_READY, T_TASK_STOP_READY, T_IDLE,
+ T_USER_START, T_USER_STOP, T_API_0, T_API_1, T_API_2, T_API_3,
+ T_API_RET, T_API_RET_U32) = range(17)
+
+# OS_TRACE_ID_* from os/os_trace_api.h
+API_NAMES = {
+    40: 'os_eventq_put',
+    41: 'os_eventq_get_no_wait',
+    42: 'os_eventq_get',
+    43: 'os_eventq_remove',
+    44: 'os_eventq_poll_0timo',
+    45: 'os_eventq_poll',
+    50: 'os_mutex_init',
+    51: 'os_mutex_release',
+    52: 'os_mutex_pend',
+    60: 'os_sem_init',
+    61: 'os_sem_release',
+    62: 'os_sem_pend',
+    70: 'os_callout_init',
+    71: 'os_callout_stop',
+    72: 'os_callout_reset',
+    73: 'os_callout_tick',
+    80: 'os_memblock_get',
+    81: 'os_memblock_put_from_cb',
+    82: 'os_memblock_put',
+    90: 'os_mbuf_get',
+    91: 'os_mbuf_get_pkthdr',
+    92: 'os_mbuf_free',
+    93: 'os_mbuf_free_chain',
+}
+
+PID = 0
+TID_CPU = 0
+TID_ISR = 1
+
+
+def load_text(text):
+    """Collect the hex lines of a 'trace dump' from a console log."""
+    data = bytearray()
+    for line in text.splitlines():
+        m = re.search(r'\btr ([0-9a-fA-F]+)\s*$', line)
+        if m:
+            data += bytes.fromhex(m.group(1))
+    return bytes(data)
+
+
+def load_coredump(data):
+    """Locate the trace buffer in the memory sections of a coredump."""
+    _, size = struct.unpack_from('<II', data, 0)
+    mem = {}
+    off = 8
+    while off + 8 <= min(size, len(data)):
+        typ, _, tlen, addr = struct.unpack_from('<BBHI', data, off)
+        off += 8
+        if typ == COREDUMP_TLV_MEM:
+            mem[addr] = data[off:off + tlen]
+        off += tlen
+
+    # Join adjacent sections, as large areas are split over several TLVs.
+    areas = []
+    for addr in sorted(mem):
+        if areas and areas[-1][0] + len(areas[-1][1]) == addr:
+            areas[-1][1] += mem[addr]
+        else:
+            areas.append([addr, bytearray(mem[addr])])
+
+    magic = struct.pack('<I', TRACE_MAGIC)
+    for addr, area in areas:
+        pos = area.find(magic)
+        while pos >= 0:
+            if pos % 4 == 0 and pos + HDR_SIZE <= len(area):
+                hdr = struct.unpack_from(HDR_FMT, area, pos)
+                end = pos + HDR_SIZE + hdr[4] * REC_SIZE
+                if hdr[2] == REC_SIZE and hdr[4] > 0 and end <= len(area):
+                    return bytes(area[pos:end])
+            pos = area.find(magic, pos + 1)
+
+    raise ValueError('no trace buffer found in coredump')
+
+
+def load(path):
+    with open(path, 'rb') as f:
+        data = f.read()
+
+    if len(data) >= 4:
+        magic, = struct.unpack_from('<I', data, 0)
+        if magic == TRACE_MAGIC:
+            return data
+        if magic == COREDUMP_MAGIC:
+            return load_coredump(data)
+
+    data = load_text(data.decode('utf-8', 'replace'))
+    if not data:
+        raise ValueError('no trace dump found in %s' % path)
+    return data
+
+
+def parse(data):
+    """Split a dump into its header, records (oldest first) and tasks."""
+    (magic, version, rec_size, flags, num_recs, freq, head,
+     last_ts) = struct.unpack_from(HDR_FMT, data, 0)
+    if magic != TRACE_MAGIC or rec_size != REC_SIZE:
+        raise ValueError('bad trace header')
+    if version != 1:
+        raise ValueError('unsupported trace version %d' % version)
+
+    count = min(head, num_recs)
+    recs = []
+    for i in range(head - count, head):
+        recs.append(struct.unpack_from(REC_FMT, data,
+                                       HDR_SIZE + (i % num_recs) * REC_SIZE))
+
+    tasks = {}
+    off = HDR_SIZE + num_recs * REC_SIZE
+    if off + 8 <= len(data):
+        magic, cnt = struct.unpack_from('<II', data, off)
+        off += 8
+        if magic == TASK_MAGIC:
+            for i in range(cnt):
+                if off + TASK_SIZE > len(data):
+                    break
+                task, prio, name = struct.unpack_from(TASK_FMT, data, off)
+                tasks[task] = (prio, name.split(b'\0')[0].decode())
+                off += TASK_SIZE
+
+    return freq, recs, tasks
+
+
+def timestamps(recs):
+    """
+    Resolve the per record deltas into absolute tick counts.  Timestamp
+    records give the absolute time; records older than the first one are
+    resolved backwards from it.  A reboot restarts the clock, so the time
+    after one is laid out right after the time before it.
+    """
+    ts = [0] * len(recs)
+    first = None
+    for i, (dt, typ, _, a0, a1, _) in enumerate(recs):
+        if typ == T_TIME:
+            if first is None:
+                first = i
+                ts[i] = a0
+            elif a1:
+                ts[i] = ts[i - 1] + 1
+            else:
+                ts[i] = ts[i - 1] + ((a0 - ts[i - 1]) & 0xffffffff)
+        elif first is not None:
+            ts[i] = ts[i - 1] + dt
+
+    if first is None:
+        first = len(recs) - 1
+    for i in range(first, 0, -1):
+        ts[i - 1] = ts[i] - recs[i][0]
+
+    base = min(ts) if ts else 0
+    return [t - base for t in ts]
+
+
+class Converter:
+    def __init__(self, freq, tasks):
+        self.freq = freq
+        self.tasks = tasks
+        self.tids = {}
+        self.events = []
+        self.depth = {}
+        self.cur_task = None
+        self.cpu = None
+        self.isr = 0
+
+    def us(self, ticks):
+        return ticks * 1e6 / self.freq
+
+    def task_name(self, task):
+        if task in self.tasks:
+            return self.tasks[task][1]
+        return 'task 0x%08x' % task
+
+    def task_tid(self, task):
+        if task not in self.tids:
+            tid = len(self.tids) + 2
+            self.tids[task] = tid
+            self.meta(tid, self.task_name(task))
+        return self.tids[task]
+
+    def meta(self, tid, name):
+        self.events.append({'name': 'thread_name', 'ph': 'M', 'pid': PID,
+                            'tid': tid, 'args': {'name': name}})
+        self.events.append({'name': 'thread_sort_index', 'ph': 'M',
+                            'pid': PID, 'tid': tid, 'args': {'sort_index': tid}})
+
+    def ctx_tid(self):
+        if self.isr:
+            return TID_ISR
+        if self.cur_task is not None:
+            return self.task_tid(self.cur_task)
+        return TID_CPU
+
+    def emit(self, ph, name, t, tid, args=None, **kw):
+        ev = {'name': name, 'ph': ph, 'ts': self.us(t), 'pid': PID,
+              'tid': tid}
+        if args:
+            ev['args'] = args
+        ev.update(kw)
+        self.events.append(ev)
+
+    def begin(self, name, t, tid, args=None):
+        self.depth[tid] = self.depth.get(tid, 0) + 1
+        self.emit('B', name, t, tid, args)
+
+    def end(self, t, tid, args=None):
+        # The matching begin may have been overwritten in the ring.
+        if self.depth.get(tid, 0) == 0:
+            return
+        self.depth[tid] -= 1
+        self.emit('E', '', t, tid, args)
+
+    def cpu_switch(self, name, t):
+        if self.cpu is not None:
+            name0, t0 = self.cpu
+            self.emit('X', name0, t0, TID_CPU, dur=self.us(t - t0))
+        self.cpu = (name, t) if name is not None else None
+
+    def record(self, rec, t):
+        dt, typ, rid, a0, a1, a2 = rec
+        if typ == T_TIME:
+            if a1:
+                self.emit('i', 'reboot', t, TID_CPU, s='g')
+                self.cpu_switch(None, t)
+                self.cur_task = None
+                self.isr = 0
+        elif typ == T_ISR_ENTER:
+            self.isr += 1
+            self.begin('isr', t, TID_ISR)
+        elif typ == T_ISR_EXIT:
+            self.isr = max(self.isr - 1, 0)
+            self.end(t, TID_ISR)
+        elif typ == T_TASK_CREATE:
+            self.emit('i', 'create', t, self.task_tid(a0), {'prio': a1})
+        elif typ == T_TASK_START_EXEC:
+            self.cur_task = a0
+            self.task_tid(a0)
+            self.cpu_switch(self.task_name(a0), t)
+        elif typ == T_TASK_STOP_EXEC:
+            self.cur_task = None
+            self.cpu_switch(None, t)
+        elif typ == T_TASK_START_READY:
+            self.emit('i', 'ready', t, self.task_tid(a0))
+        elif typ == T_TASK_STOP_READY:
+            self.emit('i', 'blocked', t, self.task_tid(a0), {'reason': a1})
+        elif typ == T_IDLE:
+            self.emit('i', 'sleep', t, TID_CPU)
+        elif typ == T_USER_START:
+            self.begin('user %u' % a0, t, self.ctx_tid())
+        elif typ == T_USER_STOP:
+            self.end(t, self.ctx_tid())
+        elif T_API_0 <= typ <= T_API_3:
+            args = {}
+            for n, a in enumerate((a0, a1, a2)[:typ - T_API_0]):
+                args['p%d' % n] = '0x%x' % a
+            self.begin(API_NAMES.get(rid, 'api %u' % rid), t, self.ctx_tid(),
+                       args)
+        elif typ == T_API_RET:
+            self.end(t, self.ctx_tid())
+        elif typ == T_API_RET_U32:
+            self.end(t, self.ctx_tid(), {'ret': '0x%x' % a0})
+
+    def convert(self, recs, ts):
+        self.meta(TID_CPU, 'CPU')
+        self.meta(TID_ISR, 'ISR')
+        for task in sorted(self.tasks, key=lambda k: self.tasks[k][0]):
+            self.task_tid(task)
+        for rec, t in zip(recs, ts):
+            self.record(rec, t)
+        if ts:
+            self.cpu_switch(None, ts[-1])
+        return {'traceEvents': self.events, 'displayTimeUnit': 'ns'}
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Convert an OS_TRACE_RAM dump to Chrome trace JSON')
+    parser.add_argument('input',
+                        help='console log, raw SMP dump or coredump file')
+    parser.add_argument('-o', '--output', default='-',
+                        help='output file (default: stdout)')
+    args = parser.parse_args()
+
+    try:
+        freq, recs, tasks = parse(load(args.input))
+    except (ValueError, struct.error) as e:
+        sys.exit('%s: %s' % (args.input, e))
+
+    trace = Converter(freq, tasks).convert(recs, timestamps(recs))
+
+    if args.output == '-':
+        json.dump(trace, sys.stdout)
+    else:
+        with open(args.output, 'w') as f:
+            json.dump(trace, f)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,128 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ * 
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <string.h>
+#include "os/mynewt.h"
+#include "testutil/testutil.h"
+#include "os_opt_test_priv.h"
+
+/*
+ * Tests for kernel features which are off by default.  The package enables
+ * all of them, including the alternative scheduler and callout data
+ * structures, so the scheduler and callout tests are repeated here.
+ */
+
+static os_membuf_t os_mbuf_membuf[OS_MEMPOOL_SIZE(MBUF_TEST_POOL_BUF_SIZE,
+        MBUF_TEST_POOL_BUF_COUNT)];
+
+struct os_mbuf_pool os_mbuf_pool;
+struct os_mempool os_mbuf_mempool;
+uint8_t os_mbuf_test_data[MBUF_TEST_DATA_LEN];
+
+void
+os_mbuf_test_setup(void)
+{
+    int rc;
+    int i;
+
+    rc = os_mempool_init(&os_mbuf_mempool, MBUF_TEST_POOL_BUF_COUNT,
+            MBUF_TEST_POOL_BUF_SIZE, &os_mbuf_membuf[0], "mbuf_pool");
+    TEST_ASSERT_FATAL(rc == 0, "Error creating memory pool %d", rc);
+
+    rc = os_mbuf_pool_init(&os_mbuf_pool, &os_mbuf_mempool,
+            MBUF_TEST_POOL_BUF_SIZE, MBUF_TEST_POOL_BUF_COUNT);
+    TEST_ASSERT_FATAL(rc == 0, "Error creating mbuf pool %d", rc);
+
+    for (i = 0; i < sizeof os_mbuf_test_data; i++) {
+        os_mbuf_test_data[i] = i;
+    }
+}
+
+void
+os_mbuf_test_misc_assert_sane(struct os_mbuf *om, void *data,
+                              int buflen, int pktlen, int pkthdr_len)
+{
+    uint8_t *data_min;
+    uint8_t *data_max;
+    int totlen;
+    int i;
+
+    TEST_ASSERT_FATAL(om != NULL);
+
+    if (OS_MBUF_IS_PKTHDR(om)) {
+        TEST_ASSERT(OS_MBUF_PKTLEN(om) == pktlen);
+    }
+
+    totlen = 0;
+    for (i = 0; om != NULL; i++) {
+        if (i == 0) {
+            TEST_ASSERT(om->om_len == buflen);
+            TEST_ASSERT(om->om_pkthdr_len == pkthdr_len);
+        }
+
+        data_min = om->om_databuf + om->om_pkthdr_len;
+        data_max = om->om_databuf + om->om_omp->omp_databuf_len - om->om_len;
+        TEST_ASSERT(om->om_data >= data_min && om->om_data <= data_max);
+
+        if (data != NULL) {
+            TEST_ASSERT(memcmp(om->om_data, data + totlen, om->om_len) == 0);
+        }
+
+        totlen += om->om_len;
+        om = SLIST_NEXT(om, om_next);
+    }
+
+    TEST_ASSERT(totlen == pktlen);
+}
+
+TEST_CASE_DECL(event_test_stats)
+TEST_CASE_DECL(os_mempool_test_cache)
+TEST_CASE_DECL(os_mbuf_test_msys_fallback)
+TEST_CASE_DECL(os_mbuf_test_clone)
+TEST_CASE_DECL(os_mbuf_test_clone_notify)
+TEST_CASE_DECL(os_mutex_test_stats)
+TEST_CASE_DECL(os_heap_test_track)
+TEST_CASE_DECL(os_task_test_stack_watermark)
+TEST_CASE_DECL(os_trace_test_ram)
+TEST_CASE_DECL(os_sched_test_order)
+TEST_CASE_DECL(os_sched_test_sleep)
+TEST_CASE_DECL(os_callout_test_bench)
+
+TEST_SUITE(os_opt_test_suite)
+{
+    event_test_stats();
+    os_mempool_test_cache();
+    os_mbuf_test_msys_fallback();
+    os_mbuf_test_clone();
+    os_mbuf_test_clone_notify();
+    os_mutex_test_stats();
+    os_heap_test_track();
+    os_task_test_stack_watermark();
+    os_trace_test_ram();
+    os_sched_test_order();
+    os_sched_test_sleep();
+    os_callout_test_bench();
+}
+
+int
+main(int argc, char **argv)
+{
+    os_opt_test_suite();
+    return tu_any_failed;
+}
@@ -0,0 +1,107 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <string.h>
+#include "os_opt_test_priv.h"
+
+static struct os_eventq etst_evq;
+
+static int
+event_test_stats_registered(struct os_eventq *evq)
+{
+    struct os_eventq_info oei;
+    struct os_eventq *cur;
+    int cnt;
+
+    cnt = 0;
+    cur = NULL;
+    while (1) {
+        cur = os_eventq_info_get_next(cur, &oei);
+        if (cur == NULL) {
+            break;
+        }
+        if (cur == evq) {
+            cnt++;
+        }
+    }
+
+    return cnt;
+}
+
+/**
+ * Tests the per-queue depth and wait statistics and the queue registry.
+ */
+TEST_CASE_SELF(event_test_stats)
+{
+    struct os_eventq_stats *es;
+    struct os_eventq evq;
+    struct os_event ev[3];
+    int i;
+
+    memset(ev, 0, sizeof ev);
+
+    /* Re-initializing a queue must not link it into the registry twice. */
+    os_eventq_init(&etst_evq);
+    os_eventq_init(&etst_evq);
+    TEST_ASSERT(event_test_stats_registered(&etst_evq) == 1);
+    TEST_ASSERT(event_test_stats_registered(os_eventq_dflt_get()) == 1);
+
+    /* A queue which goes out of scope is taken off the registry. */
+    os_eventq_init(&evq);
+    TEST_ASSERT(event_test_stats_registered(&evq) == 1);
+    os_eventq_stats_unlink(&evq);
+    TEST_ASSERT(event_test_stats_registered(&evq) == 0);
+    os_eventq_stats_unlink(&evq);
+
+    es = &etst_evq.evq_stats;
+    for (i = 0; i < 3; i++) {
+        os_eventq_put(&etst_evq, &ev[i]);
+    }
+    /* Already queued; not counted again. */
+    os_eventq_put(&etst_evq, &ev[0]);
+    TEST_ASSERT(es->es_depth == 3);
+    TEST_ASSERT(es->es_max_depth == 3);
+    TEST_ASSERT(es->es_puts == 3);
+
+    /* Dequeued within the same tick. */
+    TEST_ASSERT_FATAL(os_eventq_get_no_wait(&etst_evq) == &ev[0]);
+    TEST_ASSERT(es->es_depth == 2);
+    TEST_ASSERT(es->es_wait_hist[0] == 1);
+    TEST_ASSERT(es->es_max_wait == 0);
+
+    /* Waited one OS tick. */
+    os_time_advance(1);
+    TEST_ASSERT_FATAL(os_eventq_get_no_wait(&etst_evq) == &ev[1]);
+    TEST_ASSERT(es->es_depth == 1);
+    TEST_ASSERT(es->es_max_wait > 0);
+    TEST_ASSERT(es->es_wait_hist[0] == 1);
+
+    /* Removal lowers the depth but does not count as a wait. */
+    os_eventq_remove(&etst_evq, &ev[2]);
+    TEST_ASSERT(es->es_depth == 0);
+    TEST_ASSERT(es->es_max_depth == 3);
+
+    os_eventq_stats_reset(&etst_evq);
+    TEST_ASSERT(es->es_max_depth == 0);
+    TEST_ASSERT(es->es_puts == 0);
+    TEST_ASSERT(es->es_max_wait == 0);
+    for (i = 0; i < OS_EVENTQ_WAIT_HIST_BUCKETS; i++) {
+        TEST_ASSERT(es->es_wait_hist[i] == 0);
+    }
+}
@@ -0,0 +1,129 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include "os_opt_test_priv.h"
+
+/*
+ * Arms and cancels a large number of callouts, then lets the rest expire.
+ * Verifies every remaining callout fires exactly once, in expiry order and in
+ * arming order within a tick, and reports the time spent in the callout API.
+ */
+
+#define OCTB_NUM_CALLOUTS   1024
+#define OCTB_NUM_ROUNDS     16
+
+static struct os_callout octb_callouts[OCTB_NUM_CALLOUTS];
+static struct os_eventq octb_evq;
+static uint32_t octb_seed = 0xabcdef01;
+
+static os_time_t
+octb_rand_ticks(void)
+{
+    octb_seed = octb_seed * 1103515245 + 12345;
+
+    /* Mix short timers with ones spanning several wheel levels. */
+    switch ((octb_seed >> 8) & 3) {
+    case 0:
+        return 1 + ((octb_seed >> 16) % 32);
+    case 1:
+        return 1 + ((octb_seed >> 16) % 1000);
+    default:
+        return 1 + ((octb_seed >> 12) % 100000);
+    }
+}
+
+static void
+octb_event_cb(struct os_event *ev)
+{
+}
+
+TEST_CASE_SELF(os_callout_test_bench)
+{
+    struct os_callout *prev;
+    struct os_callout *c;
+    struct os_event *ev;
+    clock_t arm_clk;
+    clock_t tick_clk;
+    clock_t start;
+    os_time_t end;
+    int fired;
+    int round;
+    int rc;
+    int i;
+
+    os_eventq_init(&octb_evq);
+    for (i = 0; i < OCTB_NUM_CALLOUTS; i++) {
+        os_callout_init(&octb_callouts[i], &octb_evq, octb_event_cb, NULL);
+    }
+
+    arm_clk = 0;
+    tick_clk = 0;
+
+    for (round = 0; round < OCTB_NUM_ROUNDS; round++) {
+        /* Arm everything, then cancel every other callout. */
+        start = clock();
+        for (i = 0; i < OCTB_NUM_CALLOUTS; i++) {
+            rc = os_callout_reset(&octb_callouts[i], octb_rand_ticks());
+            TEST_ASSERT_FATAL(rc == 0);
+        }
+        for (i = 0; i < OCTB_NUM_CALLOUTS; i += 2) {
+            os_callout_stop(&octb_callouts[i]);
+        }
+        arm_clk += clock() - start;
+
+        /* Advance time in uneven steps until all callouts have expired. */
+        end = os_time_get() + 100001;
+        fired = 0;
+        prev = NULL;
+        while (OS_TIME_TICK_LT(os_time_get(), end)) {
+            /* Expires the callouts as well, as the OS has been started. */
+            start = clock();
+            os_time_advance(1 + (os_time_get() % 97));
+            tick_clk += clock() - start;
+
+            while ((ev = os_eventq_get_no_wait(&octb_evq)) != NULL) {
+                c = (struct os_callout *)ev;
+                TEST_ASSERT_FATAL((c - octb_callouts) % 2 == 1);
+                TEST_ASSERT_FATAL(OS_TIME_TICK_GEQ(os_time_get(), c->c_ticks));
+                if (prev) {
+                    TEST_ASSERT(OS_TIME_TICK_GEQ(c->c_ticks, prev->c_ticks));
+                    /* Same expiry; they were armed in array order. */
+                    if (c->c_ticks == prev->c_ticks) {
+                        TEST_ASSERT(c > prev);
+                    }
+                }
+                prev = c;
+                fired++;
+            }
+        }
+        TEST_ASSERT_FATAL(fired == OCTB_NUM_CALLOUTS / 2);
+
+        for (i = 0; i < OCTB_NUM_CALLOUTS; i++) {
+            TEST_ASSERT(!os_callout_queued(&octb_callouts[i]));
+        }
+    }
+
+    printf("callout bench: %d callouts x %d rounds; "
+           "arm/stop %lu us, tick %lu us\n",
+           OCTB_NUM_CALLOUTS, OCTB_NUM_ROUNDS,
+           (unsigned long)(arm_clk * 1000000 / CLOCKS_PER_SEC),
+           (unsigned long)(tick_clk * 1000000 / CLOCKS_PER_SEC));
+}
@@ -0,0 +1,211 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "os_opt_test_priv.h"
+
+#define OHTT_NUM_FILL   (MYNEWT_VAL(OS_HEAP_TRACK_ENTRIES) + 2)
+
+static void *ohtt_fill[OHTT_NUM_FILL];
+
+static void * __attribute__((noinline))
+ohtt_alloc_a(size_t size)
+{
+    return os_malloc(size);
+}
+
+static void * __attribute__((noinline))
+ohtt_alloc_b(size_t size)
+{
+    return os_malloc(size);
+}
+
+static int
+ohtt_alloc_find(void *ptr, struct os_heap_alloc_info *ohai)
+{
+    int idx;
+
+    idx = 0;
+    while (1) {
+        idx = os_heap_alloc_info_get_next(idx, ohai);
+        if (idx < 0) {
+            return -1;
+        }
+        if (ohai->ohai_ptr == ptr) {
+            return 0;
+        }
+    }
+}
+
+static int
+ohtt_site_find(void *caller, struct os_heap_site_info *ohsi)
+{
+    int found;
+    int idx;
+
+    found = 0;
+    idx = 0;
+    while (1) {
+        idx = os_heap_site_info_get_next(idx, ohsi);
+        if (idx < 0) {
+            break;
+        }
+        if (ohsi->ohsi_caller == caller) {
+            /* Each site must be reported exactly once. */
+            TEST_ASSERT(!found);
+            found = 1;
+        }
+    }
+    if (!found) {
+        return -1;
+    }
+
+    idx = 0;
+    while (1) {
+        idx = os_heap_site_info_get_next(idx, ohsi);
+        if (ohsi->ohsi_caller == caller) {
+            return 0;
+        }
+    }
+}
+
+TEST_CASE_SELF(os_heap_test_track)
+{
+    struct os_heap_alloc_info ohai;
+    struct os_heap_site_info ohsi;
+    struct os_heap_stats base;
+    struct os_heap_stats ohs;
+    struct os_task *t;
+    void *caller_a;
+    void *caller_b;
+    void *a[3];
+    void *b[2];
+    uint32_t bytes;
+    int rc;
+    int i;
+
+    os_heap_stats_reset();
+    os_heap_stats_get(&base);
+    TEST_ASSERT(base.ohs_allocs == 0);
+    TEST_ASSERT(base.ohs_peak_bytes == base.ohs_cur_bytes);
+
+    for (i = 0; i < 3; i++) {
+        a[i] = ohtt_alloc_a(10 * (i + 1));
+        TEST_ASSERT_FATAL(a[i] != NULL);
+    }
+    b[0] = ohtt_alloc_b(100);
+    b[1] = ohtt_alloc_b(200);
+    TEST_ASSERT_FATAL(b[0] != NULL && b[1] != NULL);
+
+    os_heap_stats_get(&ohs);
+    TEST_ASSERT(ohs.ohs_cur_bytes == base.ohs_cur_bytes + 360);
+    TEST_ASSERT(ohs.ohs_cur_blocks == base.ohs_cur_blocks + 5);
+    TEST_ASSERT(ohs.ohs_peak_bytes == ohs.ohs_cur_bytes);
+    TEST_ASSERT(ohs.ohs_allocs == 5);
+    TEST_ASSERT(ohs.ohs_alloc_bytes == 360);
+    TEST_ASSERT(ohs.ohs_frees == 0);
+
+    /* Each allocation records its size, caller and task. */
+    rc = ohtt_alloc_find(a[1], &ohai);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(ohai.ohai_size == 20);
+    t = os_sched_get_current_task();
+    TEST_ASSERT(ohai.ohai_prio == (t != NULL ? t->t_prio : OS_IDLE_PRIO));
+    caller_a = ohai.ohai_caller;
+
+    rc = ohtt_alloc_find(a[2], &ohai);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(ohai.ohai_caller == caller_a);
+
+    rc = ohtt_alloc_find(b[0], &ohai);
+    TEST_ASSERT_FATAL(rc == 0);
+    caller_b = ohai.ohai_caller;
+    TEST_ASSERT(caller_b != caller_a);
+
+    /* Allocations are grouped by call site. */
+    rc = ohtt_site_find(caller_a, &ohsi);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(ohsi.ohsi_blocks == 3);
+    TEST_ASSERT(ohsi.ohsi_bytes == 60);
+
+    rc = ohtt_site_find(caller_b, &ohsi);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(ohsi.ohsi_blocks == 2);
+    TEST_ASSERT(ohsi.ohsi_bytes == 300);
+
+    /* A reallocated block moves to the realloc() call site. */
+    b[0] = os_realloc(b[0], 150);
+    TEST_ASSERT_FATAL(b[0] != NULL);
+    rc = ohtt_alloc_find(b[0], &ohai);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(ohai.ohai_size == 150);
+    TEST_ASSERT(ohai.ohai_caller != caller_b);
+
+    rc = ohtt_site_find(caller_b, &ohsi);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(ohsi.ohsi_blocks == 1);
+    TEST_ASSERT(ohsi.ohsi_bytes == 200);
+
+    os_heap_stats_get(&ohs);
+    TEST_ASSERT(ohs.ohs_cur_bytes == base.ohs_cur_bytes + 410);
+    TEST_ASSERT(ohs.ohs_allocs == 6);
+    TEST_ASSERT(ohs.ohs_frees == 1);
+
+    for (i = 0; i < 3; i++) {
+        os_free(a[i]);
+    }
+    os_free(b[0]);
+    os_free(b[1]);
+    os_free(NULL);
+
+    os_heap_stats_get(&ohs);
+    TEST_ASSERT(ohs.ohs_cur_bytes == base.ohs_cur_bytes);
+    TEST_ASSERT(ohs.ohs_cur_blocks == base.ohs_cur_blocks);
+    TEST_ASSERT(ohs.ohs_peak_bytes == base.ohs_cur_bytes + 410);
+    TEST_ASSERT(ohs.ohs_frees == 6);
+    rc = ohtt_site_find(caller_a, &ohsi);
+    TEST_ASSERT(rc == -1);
+
+    /*
+     * Overflow the tracking table; the excess is counted as untracked.
+     * Freeing every other block exercises removal from the middle of probe
+     * sequences.
+     */
+    bytes = 0;
+    for (i = 0; i < OHTT_NUM_FILL; i++) {
+        ohtt_fill[i] = os_malloc(i + 1);
+        TEST_ASSERT_FATAL(ohtt_fill[i] != NULL);
+        bytes += i + 1;
+    }
+    os_heap_stats_get(&ohs);
+    TEST_ASSERT(ohs.ohs_cur_blocks == MYNEWT_VAL(OS_HEAP_TRACK_ENTRIES));
+    TEST_ASSERT(ohs.ohs_untracked == base.ohs_cur_blocks + 2);
+
+    for (i = 0; i < OHTT_NUM_FILL; i += 2) {
+        os_free(ohtt_fill[i]);
+    }
+    for (i = 1; i < OHTT_NUM_FILL; i += 2) {
+        os_free(ohtt_fill[i]);
+    }
+
+    os_heap_stats_get(&ohs);
+    TEST_ASSERT(ohs.ohs_cur_bytes == base.ohs_cur_bytes);
+    TEST_ASSERT(ohs.ohs_cur_blocks == base.ohs_cur_blocks);
+    TEST_ASSERT(ohs.ohs_peak_blocks == MYNEWT_VAL(OS_HEAP_TRACK_ENTRIES));
+    TEST_ASSERT(ohs.ohs_alloc_bytes == 510 + bytes);
+}
@@ -0,0 +1,165 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include "os_opt_test_priv.h"
+
+/* Clone headers only need room for a packet header. */
+#define OMTCL_HDR_BUF_SIZE      \
+    (sizeof(struct os_mbuf) + sizeof(struct os_mbuf_pkthdr) + 8)
+#define OMTCL_HDR_BUF_COUNT     8
+
+static os_membuf_t omtcl_hdr_membuf[
+    OS_MEMPOOL_SIZE(OMTCL_HDR_BUF_COUNT, OMTCL_HDR_BUF_SIZE)];
+static struct os_mempool omtcl_hdr_mempool;
+static struct os_mbuf_pool omtcl_hdr_pool;
+
+TEST_CASE_SELF(os_mbuf_test_clone)
+{
+    struct os_mbuf *clone2;
+    struct os_mbuf *clone;
+    struct os_mbuf *cur;
+    struct os_mbuf *om;
+    uint8_t buf[600];
+    int num_free;
+    int rc;
+
+    os_mbuf_test_setup();
+
+    rc = os_mempool_init(&omtcl_hdr_mempool, OMTCL_HDR_BUF_COUNT,
+                         OMTCL_HDR_BUF_SIZE, omtcl_hdr_membuf, "clone_hdrs");
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = os_mbuf_pool_init(&omtcl_hdr_pool, &omtcl_hdr_mempool,
+                           OMTCL_HDR_BUF_SIZE, OMTCL_HDR_BUF_COUNT);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    om = os_mbuf_get_pkthdr(&os_mbuf_pool, 4);
+    TEST_ASSERT_FATAL(om != NULL);
+    memset(OS_MBUF_USRHDR(om), 0xa5, 4);
+    rc = os_mbuf_append(om, os_mbuf_test_data, 600);
+    TEST_ASSERT_FATAL(rc == 0);
+    num_free = os_mbuf_mempool.mp_num_free;
+
+    /* A clone references the data, it does not copy it. */
+    clone = os_mbuf_clone(om, &omtcl_hdr_pool);
+    TEST_ASSERT_FATAL(clone != NULL);
+    TEST_ASSERT(os_mbuf_mempool.mp_num_free == num_free);
+    TEST_ASSERT(OS_MBUF_PKTLEN(clone) == 600);
+    TEST_ASSERT(OS_MBUF_USRHDR_LEN(clone) == 4);
+    TEST_ASSERT(memcmp(OS_MBUF_USRHDR(clone), OS_MBUF_USRHDR(om), 4) == 0);
+    TEST_ASSERT(os_mbuf_cmpf(clone, 0, os_mbuf_test_data, 600) == 0);
+    for (cur = clone; cur != NULL; cur = SLIST_NEXT(cur, om_next)) {
+        TEST_ASSERT(OS_MBUF_IS_SHARED(cur));
+        TEST_ASSERT(OS_MBUF_LEADINGSPACE(cur) == 0);
+        TEST_ASSERT(OS_MBUF_TRAILINGSPACE(cur) == 0);
+    }
+    TEST_ASSERT(OS_MBUF_IS_SHARED(om));
+    TEST_ASSERT(om->om_data == clone->om_data);
+
+    /* A clone of a clone references the original buffers. */
+    clone2 = os_mbuf_clone(clone, &omtcl_hdr_pool);
+    TEST_ASSERT_FATAL(clone2 != NULL);
+    TEST_ASSERT(clone2->om_shared == om);
+    TEST_ASSERT(om->om_refcnt == 3);
+
+    /*
+     * Writing to one chain copies the written mbuf only.  The clone's own
+     * buffer is too small to hold the data, so a buffer is taken from the
+     * pool of the original.
+     */
+    rc = os_mbuf_copyinto(clone, 10, "clone", 5);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(os_mbuf_mempool.mp_num_free == num_free - 1);
+    TEST_ASSERT(os_mbuf_cmpf(clone, 10, "clone", 5) == 0);
+    TEST_ASSERT(os_mbuf_cmpf(om, 0, os_mbuf_test_data, 600) == 0);
+    TEST_ASSERT(os_mbuf_cmpf(clone2, 0, os_mbuf_test_data, 600) == 0);
+    TEST_ASSERT(om->om_refcnt == 2);
+
+    /* The copy is the clone's alone, so it may grow into its buffer. */
+    TEST_ASSERT(!OS_MBUF_IS_SHARED(clone));
+    TEST_ASSERT(OS_MBUF_LEADINGSPACE(clone) == 0);
+    TEST_ASSERT(OS_MBUF_TRAILINGSPACE(clone) ==
+                os_mbuf_pool.omp_databuf_len - clone->om_len);
+
+    rc = os_mbuf_copyinto(om, 20, "orig", 4);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(os_mbuf_mempool.mp_num_free == num_free - 2);
+    TEST_ASSERT(os_mbuf_cmpf(om, 20, "orig", 4) == 0);
+    TEST_ASSERT(os_mbuf_cmpf(clone2, 0, os_mbuf_test_data, 600) == 0);
+
+    /* Appending and prepending never touch shared buffers. */
+    rc = os_mbuf_append(om, "tail", 4);
+    TEST_ASSERT_FATAL(rc == 0);
+    om = os_mbuf_prepend(om, 3);
+    TEST_ASSERT_FATAL(om != NULL);
+    rc = os_mbuf_copyinto(om, 0, "hd:", 3);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(OS_MBUF_PKTLEN(om) == 607);
+    TEST_ASSERT(os_mbuf_cmpf(om, 0, "hd:", 3) == 0);
+    TEST_ASSERT(os_mbuf_cmpf(om, 603, "tail", 4) == 0);
+    TEST_ASSERT(os_mbuf_cmpf(clone2, 0, os_mbuf_test_data, 600) == 0);
+
+    /* Trimming a clone leaves the original alone. */
+    os_mbuf_adj(clone2, 100);
+    os_mbuf_adj(clone2, -100);
+    TEST_ASSERT(OS_MBUF_PKTLEN(clone2) == 400);
+    TEST_ASSERT(os_mbuf_cmpf(clone2, 0, os_mbuf_test_data + 100, 400) == 0);
+
+    /* Freeing the original keeps the referenced buffers alive. */
+    os_mbuf_free_chain(om);
+    TEST_ASSERT(os_mbuf_cmpf(clone2, 0, os_mbuf_test_data + 100, 400) == 0);
+    os_mbuf_copydata(clone, 0, 600, buf);
+    TEST_ASSERT(memcmp(buf + 10, "clone", 5) == 0);
+
+    /* Unsharing gives every mbuf of the chain writable data. */
+    rc = os_mbuf_unshare(clone2);
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = os_mbuf_copyinto(clone2, 0, "unshared", 8);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(os_mbuf_cmpf(clone2, 8, os_mbuf_test_data + 108, 392) == 0);
+    TEST_ASSERT(os_mbuf_cmpf(clone, 0, buf, 600) == 0);
+
+    os_mbuf_free_chain(clone);
+    os_mbuf_free_chain(clone2);
+
+    /* Every buffer is back in its pool. */
+    TEST_ASSERT(os_mbuf_mempool.mp_num_free == MBUF_TEST_POOL_BUF_COUNT);
+    TEST_ASSERT(omtcl_hdr_mempool.mp_num_free == OMTCL_HDR_BUF_COUNT);
+
+    /* A clone with room of its own copies into its own buffer. */
+    om = os_mbuf_get_pkthdr(&os_mbuf_pool, 0);
+    TEST_ASSERT_FATAL(om != NULL);
+    rc = os_mbuf_append(om, os_mbuf_test_data, 100);
+    TEST_ASSERT_FATAL(rc == 0);
+    clone = os_mbuf_clone(om, &os_mbuf_pool);
+    TEST_ASSERT_FATAL(clone != NULL);
+    num_free = os_mbuf_mempool.mp_num_free;
+
+    rc = os_mbuf_copyinto(clone, 0, "own", 3);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(os_mbuf_mempool.mp_num_free == num_free);
+    TEST_ASSERT(!OS_MBUF_IS_SHARED(clone));
+    TEST_ASSERT(!OS_MBUF_IS_SHARED(om));
+    os_mbuf_test_misc_assert_sane(clone, NULL, 100, 100,
+                                  sizeof(struct os_mbuf_pkthdr));
+    TEST_ASSERT(os_mbuf_cmpf(clone, 3, os_mbuf_test_data + 3, 97) == 0);
+    TEST_ASSERT(os_mbuf_cmpf(om, 0, os_mbuf_test_data, 100) == 0);
+
+    os_mbuf_free_chain(om);
+    os_mbuf_free_chain(clone);
+    TEST_ASSERT(os_mbuf_mempool.mp_num_free == MBUF_TEST_POOL_BUF_COUNT);
+}
@@ -0,0 +1,141 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include <stdio.h>
+#include "os_opt_test_priv.h"
+
+/*
+ * Compares the memory needed to send one notification to N observers when
+ * each notification carries an os_mbuf_dup() of the payload against an
+ * os_mbuf_clone() of it.
+ */
+
+#define OMTCN_NUM_OBSERVERS     8
+#define OMTCN_PAYLOAD_LEN       400
+#define OMTCN_COAP_HDR_LEN      16
+
+#define OMTCN_DATA_BUF_SIZE     256
+#define OMTCN_DATA_BUF_COUNT    32
+#define OMTCN_HDR_BUF_SIZE      \
+    (sizeof(struct os_mbuf) + sizeof(struct os_mbuf_pkthdr) + 8)
+#define OMTCN_HDR_BUF_COUNT     32
+
+static os_membuf_t omtcn_data_membuf[
+    OS_MEMPOOL_SIZE(OMTCN_DATA_BUF_COUNT, OMTCN_DATA_BUF_SIZE)];
+static struct os_mempool omtcn_data_mempool;
+static struct os_mbuf_pool omtcn_data_pool;
+
+static os_membuf_t omtcn_hdr_membuf[
+    OS_MEMPOOL_SIZE(OMTCN_HDR_BUF_COUNT, OMTCN_HDR_BUF_SIZE)];
+static struct os_mempool omtcn_hdr_mempool;
+static struct os_mbuf_pool omtcn_hdr_pool;
+
+static int
+omtcn_bytes_used(void)
+{
+    return (OMTCN_DATA_BUF_COUNT - omtcn_data_mempool.mp_num_free) *
+           OS_MEMPOOL_BYTES(1, OMTCN_DATA_BUF_SIZE) +
+           (OMTCN_HDR_BUF_COUNT - omtcn_hdr_mempool.mp_num_free) *
+           OS_MEMPOOL_BYTES(1, OMTCN_HDR_BUF_SIZE);
+}
+
+/*
+ * Builds one notification per observer the way coap_notify_observers() does:
+ * a freshly serialized header followed by a copy of the payload.  Returns
+ * the bytes of pool memory in use once the payload itself has been freed.
+ */
+static int
+omtcn_notify(int clone)
+{
+    struct os_mbuf *notes[OMTCN_NUM_OBSERVERS];
+    struct os_mbuf *payload;
+    struct os_mbuf *copy;
+    int used;
+    int rc;
+    int i;
+
+    payload = os_mbuf_get_pkthdr(&omtcn_data_pool, 0);
+    TEST_ASSERT_FATAL(payload != NULL);
+    rc = os_mbuf_append(payload, os_mbuf_test_data, OMTCN_PAYLOAD_LEN);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    for (i = 0; i < OMTCN_NUM_OBSERVERS; i++) {
+        notes[i] = os_mbuf_get_pkthdr(&omtcn_data_pool, 0);
+        TEST_ASSERT_FATAL(notes[i] != NULL);
+        rc = os_mbuf_append(notes[i], os_mbuf_test_data + 512,
+                            OMTCN_COAP_HDR_LEN);
+        TEST_ASSERT_FATAL(rc == 0);
+
+        if (clone) {
+            copy = os_mbuf_clone(payload, &omtcn_hdr_pool);
+        } else {
+            copy = os_mbuf_dup(payload);
+        }
+        TEST_ASSERT_FATAL(copy != NULL);
+        os_mbuf_concat(notes[i], copy);
+    }
+
+    os_mbuf_free_chain(payload);
+    used = omtcn_bytes_used();
+
+    for (i = 0; i < OMTCN_NUM_OBSERVERS; i++) {
+        TEST_ASSERT(OS_MBUF_PKTLEN(notes[i]) ==
+                    OMTCN_COAP_HDR_LEN + OMTCN_PAYLOAD_LEN);
+        TEST_ASSERT(os_mbuf_cmpf(notes[i], 0, os_mbuf_test_data + 512,
+                                 OMTCN_COAP_HDR_LEN) == 0);
+        TEST_ASSERT(os_mbuf_cmpf(notes[i], OMTCN_COAP_HDR_LEN,
+                                 os_mbuf_test_data, OMTCN_PAYLOAD_LEN) == 0);
+        os_mbuf_free_chain(notes[i]);
+    }
+
+    TEST_ASSERT(omtcn_data_mempool.mp_num_free == OMTCN_DATA_BUF_COUNT);
+    TEST_ASSERT(omtcn_hdr_mempool.mp_num_free == OMTCN_HDR_BUF_COUNT);
+
+    return used;
+}
+
+TEST_CASE_SELF(os_mbuf_test_clone_notify)
+{
+    int clone_bytes;
+    int dup_bytes;
+    int rc;
+
+    os_mbuf_test_setup();
+
+    rc = os_mempool_init(&omtcn_data_mempool, OMTCN_DATA_BUF_COUNT,
+                         OMTCN_DATA_BUF_SIZE, omtcn_data_membuf, "notify_data");
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = os_mbuf_pool_init(&omtcn_data_pool, &omtcn_data_mempool,
+                           OMTCN_DATA_BUF_SIZE, OMTCN_DATA_BUF_COUNT);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    rc = os_mempool_init(&omtcn_hdr_mempool, OMTCN_HDR_BUF_COUNT,
+                         OMTCN_HDR_BUF_SIZE, omtcn_hdr_membuf, "notify_hdr");
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = os_mbuf_pool_init(&omtcn_hdr_pool, &omtcn_hdr_mempool,
+                           OMTCN_HDR_BUF_SIZE, OMTCN_HDR_BUF_COUNT);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    dup_bytes = omtcn_notify(0);
+    clone_bytes = omtcn_notify(1);
+    TEST_ASSERT(clone_bytes < dup_bytes);
+
+    printf("notify %d observers, %d byte payload: os_mbuf_dup %d bytes, "
+           "os_mbuf_clone %d bytes\n", OMTCN_NUM_OBSERVERS, OMTCN_PAYLOAD_LEN,
+           dup_bytes, clone_bytes);
+}
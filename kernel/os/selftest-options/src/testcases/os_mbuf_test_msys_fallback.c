@@ -0,0 +1,101 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "os_opt_test_priv.h"
+
+#define OMTMF_LARGE_BUF_SIZE    512
+#define OMTMF_LARGE_BUF_COUNT   2
+
+static os_membuf_t omtmf_large_membuf[
+    OS_MEMPOOL_SIZE(OMTMF_LARGE_BUF_COUNT, OMTMF_LARGE_BUF_SIZE)];
+static struct os_mempool omtmf_large_mempool;
+static struct os_mbuf_pool omtmf_large_pool;
+
+static struct os_mbuf *omtmf_mbufs[MBUF_TEST_POOL_BUF_COUNT +
+                                   OMTMF_LARGE_BUF_COUNT];
+
+static void
+omtmf_free_all(int cnt)
+{
+    int rc;
+    int i;
+
+    for (i = 0; i < cnt; i++) {
+        rc = os_mbuf_free_chain(omtmf_mbufs[i]);
+        TEST_ASSERT_FATAL(rc == 0);
+    }
+}
+
+TEST_CASE_SELF(os_mbuf_test_msys_fallback)
+{
+    int rc;
+    int i;
+
+    os_mbuf_test_setup();
+
+    rc = os_mempool_init(&omtmf_large_mempool, OMTMF_LARGE_BUF_COUNT,
+                         OMTMF_LARGE_BUF_SIZE, omtmf_large_membuf,
+                         "mbuf_large");
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = os_mbuf_pool_init(&omtmf_large_pool, &omtmf_large_mempool,
+                           OMTMF_LARGE_BUF_SIZE, OMTMF_LARGE_BUF_COUNT);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    os_msys_reset();
+    os_msys_register(&omtmf_large_pool);
+    os_msys_register(&os_mbuf_pool);
+    TEST_ASSERT(os_msys_pool_get_next(NULL) == &os_mbuf_pool);
+
+    /* Small requests go to the small pool, then spill into the large one. */
+    for (i = 0; i < MBUF_TEST_POOL_BUF_COUNT + OMTMF_LARGE_BUF_COUNT; i++) {
+        omtmf_mbufs[i] = os_msys_get(64, 0);
+        TEST_ASSERT_FATAL(omtmf_mbufs[i] != NULL);
+        if (i < MBUF_TEST_POOL_BUF_COUNT) {
+            TEST_ASSERT(omtmf_mbufs[i]->om_omp == &os_mbuf_pool);
+        } else {
+            TEST_ASSERT(omtmf_mbufs[i]->om_omp == &omtmf_large_pool);
+        }
+    }
+    TEST_ASSERT(os_mbuf_pool.omp_stats.omps_miss == OMTMF_LARGE_BUF_COUNT);
+    TEST_ASSERT(omtmf_large_pool.omp_stats.omps_fallback ==
+                OMTMF_LARGE_BUF_COUNT);
+
+    /* Everything is in use. */
+    TEST_ASSERT(os_msys_get(64, 0) == NULL);
+    TEST_ASSERT(os_mbuf_pool.omp_stats.omps_fail == 1);
+
+    omtmf_free_all(MBUF_TEST_POOL_BUF_COUNT + OMTMF_LARGE_BUF_COUNT);
+    TEST_ASSERT(os_msys_num_free() ==
+                MBUF_TEST_POOL_BUF_COUNT + OMTMF_LARGE_BUF_COUNT);
+
+    /* Large packets never fall back to a smaller pool. */
+    for (i = 0; i < OMTMF_LARGE_BUF_COUNT; i++) {
+        omtmf_mbufs[i] = os_msys_get_pkthdr(400, 0);
+        TEST_ASSERT_FATAL(omtmf_mbufs[i] != NULL);
+        TEST_ASSERT(omtmf_mbufs[i]->om_omp == &omtmf_large_pool);
+    }
+    TEST_ASSERT(os_msys_get_pkthdr(400, 0) == NULL);
+    TEST_ASSERT(omtmf_large_pool.omp_stats.omps_miss == 1);
+    TEST_ASSERT(omtmf_large_pool.omp_stats.omps_fail == 1);
+    TEST_ASSERT(os_mbuf_pool.omp_stats.omps_fallback == 0);
+
+    omtmf_free_all(OMTMF_LARGE_BUF_COUNT);
+    TEST_ASSERT(os_msys_num_free() ==
+                MBUF_TEST_POOL_BUF_COUNT + OMTMF_LARGE_BUF_COUNT);
+}
@@ -0,0 +1,96 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "taskpool/taskpool.h"
+#include "os_opt_test_priv.h"
+
+#define OMTC_NUM_TASKS      3
+#define OMTC_NUM_BLOCKS     10
+#define OMTC_BLOCK_SIZE     80
+/* Sized so that caches plus blocks in use never exceed OMTC_NUM_BLOCKS. */
+#define OMTC_CACHE_SIZE     2
+#define OMTC_NUM_ROUNDS     100
+
+static os_membuf_t omtc_membuf[OS_MEMPOOL_SIZE(OMTC_NUM_BLOCKS,
+                                               OMTC_BLOCK_SIZE)];
+static struct os_mempool omtc_mempool;
+static struct os_mempool_cache omtc_caches[OMTC_NUM_TASKS];
+static int omtc_next_cache;
+
+static void
+omtc_task_handler(void *arg)
+{
+    struct os_mempool_cache *mc;
+    void *blocks[3];
+    os_sr_t sr;
+    int round;
+    int rc;
+    int i;
+
+    OS_ENTER_CRITICAL(sr);
+    mc = &omtc_caches[omtc_next_cache++];
+    OS_EXIT_CRITICAL(sr);
+
+    rc = os_mempool_cache_init(mc, &omtc_mempool, OMTC_CACHE_SIZE,
+                               os_sched_get_current_task());
+    TEST_ASSERT_FATAL(rc == 0);
+
+    for (round = 0; round < OMTC_NUM_ROUNDS; round++) {
+        for (i = 0; i < 3; i++) {
+            blocks[i] = os_mempool_cache_get(mc);
+            TEST_ASSERT_FATAL(blocks[i] != NULL);
+            memset(blocks[i], 0xa5, OMTC_BLOCK_SIZE);
+        }
+        for (i = 0; i < 3; i++) {
+            rc = os_mempool_cache_put(mc, blocks[i]);
+            TEST_ASSERT_FATAL(rc == 0);
+        }
+
+        /* Let the other tasks at the pool. */
+        os_time_delay(1);
+    }
+
+    /* Exit with blocks still cached; removing the task must return them. */
+    TEST_ASSERT(mc->mc_cnt > 0);
+    TEST_ASSERT(mc->mc_hits > 0);
+}
+
+TEST_CASE_TASK(os_mempool_test_cache)
+{
+    int rc;
+    int i;
+
+    rc = os_mempool_init(&omtc_mempool, OMTC_NUM_BLOCKS, OMTC_BLOCK_SIZE,
+                         omtc_membuf, "TestMemPool");
+    TEST_ASSERT_FATAL(rc == 0);
+
+    omtc_next_cache = 0;
+    for (i = 0; i < OMTC_NUM_TASKS; i++) {
+        taskpool_alloc_assert(omtc_task_handler,
+                              MYNEWT_VAL(OS_MAIN_TASK_PRIO) + 1 + i);
+    }
+    taskpool_wait_assert(OS_TICKS_PER_SEC * 10);
+
+    TEST_ASSERT(omtc_mempool.mp_num_free == OMTC_NUM_BLOCKS);
+    TEST_ASSERT(os_mempool_is_sane(&omtc_mempool));
+    for (i = 0; i < OMTC_NUM_TASKS; i++) {
+        TEST_ASSERT(omtc_caches[i].mc_cnt == 0);
+        TEST_ASSERT(omtc_caches[i].mc_task == NULL);
+    }
+}
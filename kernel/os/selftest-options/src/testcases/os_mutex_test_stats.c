@@ -0,0 +1,143 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <string.h>
+#include "os/mynewt.h"
+#include "taskpool/taskpool.h"
+#include "os_opt_test_priv.h"
+
+#define OTMS_HOLD_TICKS     (OS_TICKS_PER_SEC / 10)
+
+static struct os_mutex otms_mutex;
+static volatile int otms_held;
+
+static void
+otms_holder_handler(void *arg)
+{
+    os_error_t err;
+
+    err = os_mutex_pend(&otms_mutex, OS_TIMEOUT_NEVER);
+    TEST_ASSERT(err == OS_OK);
+
+    otms_held = 1;
+    os_time_delay(OTMS_HOLD_TICKS);
+
+    err = os_mutex_release(&otms_mutex);
+    TEST_ASSERT(err == OS_OK);
+}
+
+static int
+otms_info_find(struct os_mutex_info *omi)
+{
+    struct os_mutex *mu;
+
+    mu = NULL;
+    while ((mu = os_mutex_info_get_next(mu, omi)) != NULL) {
+        if (mu == &otms_mutex) {
+            return 0;
+        }
+    }
+    return -1;
+}
+
+static void
+otms_info_get(struct os_mutex_info *omi)
+{
+    TEST_ASSERT_FATAL(otms_info_find(omi) == 0);
+}
+
+TEST_CASE_TASK(os_mutex_test_stats)
+{
+    struct os_mutex_info omi;
+    struct os_task *t;
+    os_error_t err;
+
+    t = os_sched_get_current_task();
+    otms_held = 0;
+
+    err = os_mutex_init(&otms_mutex);
+    TEST_ASSERT_FATAL(err == OS_OK);
+
+    /* Only registered mutexes are listed. */
+    TEST_ASSERT(otms_info_find(&omi) != 0);
+    os_mutex_stats_register(&otms_mutex, "otms");
+    os_mutex_stats_register(&otms_mutex, "otms");
+
+    otms_info_get(&omi);
+    TEST_ASSERT(omi.omi_name != NULL && !strcmp(omi.omi_name, "otms"));
+    TEST_ASSERT(omi.omi_init_caller != NULL);
+    TEST_ASSERT(omi.omi_stats.ms_acquired == 0);
+
+    /* Nested pends count as one uncontended acquisition. */
+    TEST_ASSERT(os_mutex_pend(&otms_mutex, 0) == OS_OK);
+    TEST_ASSERT(os_mutex_pend(&otms_mutex, 0) == OS_OK);
+    TEST_ASSERT(os_mutex_release(&otms_mutex) == OS_OK);
+    TEST_ASSERT(os_mutex_release(&otms_mutex) == OS_OK);
+
+    otms_info_get(&omi);
+    TEST_ASSERT(omi.omi_stats.ms_acquired == 1);
+    TEST_ASSERT(omi.omi_stats.ms_contended == 0);
+    TEST_ASSERT(omi.omi_level == 0);
+
+    /* A lower priority task takes the mutex and holds on to it. */
+    taskpool_alloc_assert(otms_holder_handler,
+                          MYNEWT_VAL(OS_MAIN_TASK_PRIO) + 3);
+    while (otms_held == 0) {
+        os_time_delay(1);
+    }
+
+    otms_info_get(&omi);
+    TEST_ASSERT(omi.omi_level == 1);
+    TEST_ASSERT(omi.omi_owner_prio == MYNEWT_VAL(OS_MAIN_TASK_PRIO) + 3);
+
+    /* Failed try-lock. */
+    err = os_mutex_pend(&otms_mutex, 0);
+    TEST_ASSERT(err == OS_TIMEOUT);
+
+    /* Blocking pend; the holder inherits our priority until it releases. */
+    err = os_mutex_pend(&otms_mutex, OS_TIMEOUT_NEVER);
+    TEST_ASSERT(err == OS_OK);
+
+    otms_info_get(&omi);
+    TEST_ASSERT(omi.omi_level == 1);
+    TEST_ASSERT(omi.omi_owner_prio == t->t_prio);
+    TEST_ASSERT(omi.omi_waiters == 0);
+    TEST_ASSERT(omi.omi_stats.ms_acquired == 3);
+    TEST_ASSERT(omi.omi_stats.ms_contended == 2);
+    TEST_ASSERT(omi.omi_stats.ms_timeouts == 1);
+    TEST_ASSERT(omi.omi_stats.ms_boosts == 1);
+    TEST_ASSERT(omi.omi_stats.ms_max_wait > 0);
+    TEST_ASSERT(omi.omi_stats.ms_total_wait >= omi.omi_stats.ms_max_wait);
+    TEST_ASSERT(omi.omi_stats.ms_max_hold > 0);
+
+    err = os_mutex_release(&otms_mutex);
+    TEST_ASSERT(err == OS_OK);
+
+    taskpool_wait_assert(OS_TICKS_PER_SEC);
+
+    os_mutex_stats_reset(&otms_mutex);
+    otms_info_get(&omi);
+    TEST_ASSERT(omi.omi_stats.ms_acquired == 0);
+    TEST_ASSERT(omi.omi_stats.ms_contended == 0);
+    TEST_ASSERT(omi.omi_stats.ms_total_wait == 0);
+    TEST_ASSERT(omi.omi_stats.ms_max_hold == 0);
+
+    os_mutex_stats_unlink(&otms_mutex);
+    TEST_ASSERT(otms_info_find(&omi) != 0);
+}
@@ -0,0 +1,142 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "os_opt_test_priv.h"
+
+/*
+ * Puts a set of dummy tasks through thousands of random sleep / wakeup
+ * cycles and verifies that the scheduler always reports the earliest
+ * wakeup time and wakes up exactly the tasks whose timer has expired.
+ */
+
+#define OSTS_NUM_TASKS      64
+#define OSTS_NUM_CYCLES     20000
+
+static struct os_task osts_tasks[OSTS_NUM_TASKS];
+static uint32_t osts_seed = 0x2468ace0;
+
+static uint32_t
+osts_rand(void)
+{
+    osts_seed = osts_seed * 1103515245 + 12345;
+    return osts_seed >> 8;
+}
+
+static void
+osts_verify(void)
+{
+    struct os_task *t;
+    os_time_t expected;
+    os_time_t now;
+    os_time_t rt;
+    int i;
+
+    now = os_time_get();
+    expected = OS_TIMEOUT_NEVER;
+    for (i = 0; i < OSTS_NUM_TASKS; i++) {
+        t = &osts_tasks[i];
+        if (t->t_state != OS_TASK_SLEEP ||
+            (t->t_flags & OS_TASK_FLAG_NO_TIMEOUT)) {
+            continue;
+        }
+        TEST_ASSERT_FATAL(OS_TIME_TICK_GT(t->t_next_wakeup, now));
+        rt = t->t_next_wakeup - now;
+        if (rt < expected) {
+            expected = rt;
+        }
+    }
+
+    TEST_ASSERT_FATAL(os_sched_wakeup_ticks(now) == expected);
+}
+
+TEST_CASE_SELF(os_sched_test_sleep)
+{
+    os_time_t wakeup[OSTS_NUM_TASKS];
+    struct os_task *t;
+    os_time_t nticks;
+    os_sr_t sr;
+    int cycle;
+    int i;
+
+    OS_ENTER_CRITICAL(sr);
+
+    memset(osts_tasks, 0, sizeof osts_tasks);
+    for (i = 0; i < OSTS_NUM_TASKS; i++) {
+        t = &osts_tasks[i];
+        t->t_state = OS_TASK_READY;
+        t->t_prio = OS_IDLE_PRIO - 1;
+        TEST_ASSERT_FATAL(os_sched_insert(t) == 0);
+    }
+
+    for (cycle = 0; cycle < OSTS_NUM_CYCLES; cycle++) {
+        t = &osts_tasks[osts_rand() % OSTS_NUM_TASKS];
+
+        switch (osts_rand() % 4) {
+        case 0:
+        case 1:
+            /* Put a ready task to sleep. */
+            if (t->t_state == OS_TASK_READY) {
+                if (osts_rand() % 8 == 0) {
+                    nticks = OS_TIMEOUT_NEVER;
+                } else {
+                    nticks = 1 + osts_rand() % 50;
+                }
+                os_sched_sleep(t, nticks);
+            }
+            break;
+
+        case 2:
+            /* Wake a sleeping task before its timer expires. */
+            if (t->t_state == OS_TASK_SLEEP) {
+                os_sched_wakeup(t);
+            }
+            break;
+
+        default:
+            /* Let time pass; only expired tasks may be woken up. */
+            for (i = 0; i < OSTS_NUM_TASKS; i++) {
+                wakeup[i] = osts_tasks[i].t_next_wakeup;
+            }
+            os_time_advance(1 + osts_rand() % 8);
+            os_sched_os_timer_exp();
+            for (i = 0; i < OSTS_NUM_TASKS; i++) {
+                if (osts_tasks[i].t_state == OS_TASK_READY &&
+                    wakeup[i] != 0) {
+                    TEST_ASSERT_FATAL(
+                        OS_TIME_TICK_GEQ(os_time_get(), wakeup[i]));
+                }
+            }
+            break;
+        }
+
+        osts_verify();
+    }
+
+    /* Remove the dummy tasks from the scheduler. */
+    for (i = 0; i < OSTS_NUM_TASKS; i++) {
+        t = &osts_tasks[i];
+        if (t->t_state == OS_TASK_SLEEP) {
+            os_sched_wakeup(t);
+        }
+        os_sched_sleep(t, OS_TIMEOUT_NEVER);
+        TAILQ_REMOVE(&g_os_sleep_list, t, t_os_list);
+    }
+
+    OS_EXIT_CRITICAL(sr);
+}
@@ -0,0 +1,131 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "os_opt_test_priv.h"
+
+/* Sized like the other test task stacks; the sim port runs signal handlers
+ * on the current task stack.
+ */
+#define OTTSW_STACK_SIZE    4096
+#define OTTSW_DEPTH         (OTTSW_STACK_SIZE / 2)
+
+static os_stack_t ottsw_stack[OTTSW_STACK_SIZE];
+static struct os_task ottsw_task;
+
+static void
+ottsw_task_handler(void *arg)
+{
+    while (1) {
+        os_time_delay(OS_TICKS_PER_SEC);
+    }
+}
+
+static void
+ottsw_sample_all(void)
+{
+    struct os_task *t;
+    uint32_t words;
+    int i;
+
+    /* Enough calls to scan every task stack in full, twice over. */
+    words = 0;
+    STAILQ_FOREACH(t, &g_os_task_list, t_os_task_list) {
+        words += t->t_stacksize;
+    }
+    for (i = 0; i <= 2 * words / MYNEWT_VAL(OS_TASK_STACK_WATERMARK_SCAN_WORDS);
+         i++) {
+        os_task_stack_sample();
+    }
+}
+
+static int
+ottsw_info_find(struct os_task_stack_info *otsi)
+{
+    int idx;
+
+    idx = 0;
+    while (1) {
+        idx = os_task_stack_info_get_next(idx, otsi);
+        if (idx < 0) {
+            return -1;
+        }
+        if (otsi->otsi_name == ottsw_task.t_name) {
+            return 0;
+        }
+    }
+}
+
+TEST_CASE_SELF(os_task_test_stack_watermark)
+{
+    struct os_task_stack_info otsi;
+    struct os_task_info oti;
+    uint32_t min_rec;
+    uint16_t used;
+    int rc;
+
+    /* Lower priority than the test task, so it stays at its initial frame
+     * for the duration of the test.
+     */
+    rc = os_task_init(&ottsw_task, "ottsw", ottsw_task_handler, NULL,
+                      TASK1_PRIO, OS_WAIT_FOREVER, ottsw_stack,
+                      OTTSW_STACK_SIZE);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    /* The initial frame is at least what os_task_info_get() measures. */
+    ottsw_sample_all();
+    os_task_info_get(&ottsw_task, &oti);
+    TEST_ASSERT_FATAL(oti.oti_stkusage < OTTSW_DEPTH);
+    rc = ottsw_info_find(&otsi);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(otsi.otsi_stksize == OTTSW_STACK_SIZE);
+    TEST_ASSERT(otsi.otsi_hwm >= oti.oti_stkusage);
+    TEST_ASSERT(otsi.otsi_hwm_max >= otsi.otsi_hwm);
+
+    /* Deeper use of the stack is picked up. */
+    ottsw_stack[OTTSW_STACK_SIZE - OTTSW_DEPTH] = ~OS_STACK_PATTERN;
+    os_task_info_get(&ottsw_task, &oti);
+    used = oti.oti_stkusage;
+    TEST_ASSERT_FATAL(used >= OTTSW_DEPTH);
+    ottsw_sample_all();
+    rc = ottsw_info_find(&otsi);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(otsi.otsi_hwm == used);
+    TEST_ASSERT(otsi.otsi_hwm_max >= used);
+
+    /* The recommendation adds the margin and rounds up. */
+    os_task_stack_reset();
+    rc = ottsw_info_find(&otsi);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(otsi.otsi_hwm_max == used);
+    min_rec = used * (100 + MYNEWT_VAL(OS_TASK_STACK_WATERMARK_MARGIN));
+    min_rec = (min_rec + 99) / 100;
+    TEST_ASSERT(otsi.otsi_recommended >= min_rec);
+    TEST_ASSERT(otsi.otsi_recommended < min_rec + 8);
+    TEST_ASSERT(otsi.otsi_recommended % 8 == 0);
+
+    /* High-water marks never go down. */
+    ottsw_stack[OTTSW_STACK_SIZE - OTTSW_DEPTH] = OS_STACK_PATTERN;
+    ottsw_sample_all();
+    rc = ottsw_info_find(&otsi);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(otsi.otsi_hwm == used);
+
+    rc = os_task_remove(&ottsw_task);
+    TEST_ASSERT(rc == 0);
+}
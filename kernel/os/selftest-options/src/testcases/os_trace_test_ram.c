@@ -0,0 +1,123 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "os_opt_test_priv.h"
+
+static void
+ottr_rec_read(uint32_t idx, struct os_trace_ram_rec *rec)
+{
+    uint32_t n;
+
+    n = os_trace_ram_dump_read(sizeof(struct os_trace_ram_hdr) +
+                               idx * sizeof(*rec), rec, sizeof(*rec));
+    TEST_ASSERT_FATAL(n == sizeof(*rec));
+}
+
+/* Find the next record of the given call on the test mutex. */
+static int
+ottr_find(uint32_t start, uint32_t head, uint8_t type, uint8_t id,
+          uint32_t arg0)
+{
+    struct os_trace_ram_rec rec;
+    uint32_t i;
+
+    for (i = start; i < head; i++) {
+        ottr_rec_read(i, &rec);
+        if (rec.otr_type == type && rec.otr_id == id &&
+            rec.otr_arg[0] == arg0) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+TEST_CASE_SELF(os_trace_test_ram)
+{
+    struct os_trace_ram_hdr hdr;
+    struct os_trace_ram_rec rec;
+    struct os_task_info oti;
+    struct os_mutex ottr_mu;
+    struct os_task *t;
+    uint32_t tasks;
+    uint32_t head;
+    uint32_t n;
+    int idx;
+
+    os_trace_ram_stop();
+    os_trace_ram_clear();
+    os_trace_ram_start();
+    TEST_ASSERT(os_trace_ram_running());
+
+    os_mutex_init(&ottr_mu);
+    os_mutex_pend(&ottr_mu, 0);
+    os_mutex_release(&ottr_mu);
+
+    os_trace_ram_stop();
+    TEST_ASSERT(!os_trace_ram_running());
+
+    n = os_trace_ram_dump_read(0, &hdr, sizeof(hdr));
+    TEST_ASSERT_FATAL(n == sizeof(hdr));
+    TEST_ASSERT(hdr.oth_magic == OS_TRACE_RAM_MAGIC);
+    TEST_ASSERT(hdr.oth_version == OS_TRACE_RAM_VERSION);
+    TEST_ASSERT(hdr.oth_rec_size == sizeof(rec));
+    TEST_ASSERT(hdr.oth_num_recs == MYNEWT_VAL(OS_TRACE_RAM_RECORDS));
+    TEST_ASSERT(!(hdr.oth_flags & OS_TRACE_RAM_F_RUNNING));
+
+    /* A timestamp, then a call and a return for each of the three APIs. */
+    TEST_ASSERT_FATAL(hdr.oth_head >= 7);
+    TEST_ASSERT_FATAL(hdr.oth_head <= hdr.oth_num_recs);
+
+    ottr_rec_read(0, &rec);
+    TEST_ASSERT(rec.otr_type == OS_TRACE_RAM_T_TIME);
+
+    idx = ottr_find(1, hdr.oth_head, OS_TRACE_RAM_T_API_1,
+                    OS_TRACE_ID_MUTEX_INIT, (uint32_t)(uintptr_t)&ottr_mu);
+    TEST_ASSERT_FATAL(idx > 0);
+    idx = ottr_find(idx, hdr.oth_head, OS_TRACE_RAM_T_API_2,
+                    OS_TRACE_ID_MUTEX_PEND, (uint32_t)(uintptr_t)&ottr_mu);
+    TEST_ASSERT_FATAL(idx > 0);
+    ottr_rec_read(idx, &rec);
+    TEST_ASSERT(rec.otr_arg[1] == 0);
+    idx = ottr_find(idx, hdr.oth_head, OS_TRACE_RAM_T_API_RET_U32,
+                    OS_TRACE_ID_MUTEX_PEND, OS_OK);
+    TEST_ASSERT_FATAL(idx > 0);
+    idx = ottr_find(idx, hdr.oth_head, OS_TRACE_RAM_T_API_1,
+                    OS_TRACE_ID_MUTEX_RELEASE, (uint32_t)(uintptr_t)&ottr_mu);
+    TEST_ASSERT_FATAL(idx > 0);
+
+    /* Nothing is recorded while stopped. */
+    head = hdr.oth_head;
+    os_mutex_release(&ottr_mu);
+    os_trace_ram_dump_read(0, &hdr, sizeof(hdr));
+    TEST_ASSERT(hdr.oth_head == head);
+
+    tasks = 0;
+    t = NULL;
+    while ((t = os_task_info_get_next(t, &oti)) != NULL) {
+        tasks++;
+    }
+    TEST_ASSERT(os_trace_ram_dump_size() ==
+                sizeof(hdr) + hdr.oth_num_recs * sizeof(rec) +
+                2 * sizeof(uint32_t) +
+                tasks * sizeof(struct os_trace_ram_task));
+
+    os_trace_ram_clear();
+    os_trace_ram_start();
+}
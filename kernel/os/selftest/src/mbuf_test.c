@@ -103,6 +103,7 @@ TEST_CASE_DECL(os_mbuf_test_adj)
 TEST_CASE_DECL(os_mbuf_test_get_pkthdr)
 TEST_CASE_DECL(os_mbuf_test_widen)
 TEST_CASE_DECL(os_mbuf_test_pack_chains)
+TEST_CASE_DECL(os_mbuf_test_cursor)
 
 TEST_SUITE(os_mbuf_test_suite)
 {
@@ -115,4 +116,5 @@ TEST_SUITE(os_mbuf_test_suite)
     os_mbuf_test_get_pkthdr();
     os_mbuf_test_widen();
     os_mbuf_test_pack_chains();
+    os_mbuf_test_cursor();
 }
@@ -68,8 +68,10 @@ os_test_all(void)
     os_sem_test_suite();
     os_mbuf_test_suite();
     os_eventq_test_suite();
+    os_evring_test_suite();
     os_callout_test_suite();
     os_time_test_suite();
+    os_sched_test_suite();
 
     return tu_case_failed;
 }
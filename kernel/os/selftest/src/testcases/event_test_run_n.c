@@ -0,0 +1,151 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "os_test_priv.h"
+
+#define ETRN_NUM_EVENTS     5
+
+static struct os_eventq etrn_evq;
+static struct os_event etrn_events[ETRN_NUM_EVENTS];
+static int etrn_order[ETRN_NUM_EVENTS * 2];
+static int etrn_num_run;
+static int etrn_nested;
+
+static void
+etrn_event_cb(struct os_event *ev)
+{
+    int idx;
+
+    idx = (int)(intptr_t)ev->ev_arg;
+    TEST_ASSERT_FATAL(etrn_num_run < ETRN_NUM_EVENTS * 2);
+    etrn_order[etrn_num_run++] = idx;
+
+    if (idx == 1) {
+        /* Waiting in the batch: still queued. */
+        TEST_ASSERT(OS_EVENT_QUEUED(&etrn_events[2]));
+        TEST_ASSERT(!OS_EVENT_QUEUED(&etrn_events[1]));
+
+        /* Already run: goes back on the queue for the next batch. */
+        os_eventq_put(&etrn_evq, &etrn_events[0]);
+        /* Waiting in the batch: ignored. */
+        os_eventq_put(&etrn_evq, &etrn_events[2]);
+        /* Waiting in the batch: must not run. */
+        os_eventq_remove(&etrn_evq, &etrn_events[3]);
+    }
+}
+
+static void
+etrn_nest_cb(struct os_event *ev)
+{
+    int idx;
+
+    idx = (int)(intptr_t)ev->ev_arg;
+    TEST_ASSERT_FATAL(etrn_num_run < ETRN_NUM_EVENTS * 2);
+    etrn_order[etrn_num_run++] = idx;
+
+    if (idx == 1) {
+        os_eventq_put(&etrn_evq, &etrn_events[4]);
+        etrn_nested = os_eventq_run_n(&etrn_evq, 0);
+
+        /* The outer batch is still there after the nested call. */
+        TEST_ASSERT(OS_EVENT_QUEUED(&etrn_events[3]));
+        os_eventq_remove(&etrn_evq, &etrn_events[3]);
+        TEST_ASSERT(!OS_EVENT_QUEUED(&etrn_events[3]));
+    } else if (idx == 4) {
+        /* Waiting in the outer batch. */
+        TEST_ASSERT(OS_EVENT_QUEUED(&etrn_events[2]));
+    }
+}
+
+static void
+etrn_put_all(void)
+{
+    int i;
+
+    for (i = 0; i < ETRN_NUM_EVENTS; i++) {
+        os_eventq_put(&etrn_evq, &etrn_events[i]);
+    }
+}
+
+/**
+ * Tests os_eventq_run_n(): batch bounds, put / remove of events which are
+ * waiting in a batch, and nested calls from a callback.
+ */
+TEST_CASE_TASK(event_test_run_n)
+{
+    int cnt;
+    int i;
+
+    os_eventq_init(&etrn_evq);
+    for (i = 0; i < ETRN_NUM_EVENTS; i++) {
+        etrn_events[i].ev_cb = etrn_event_cb;
+        etrn_events[i].ev_arg = (void *)(intptr_t)i;
+    }
+
+    etrn_put_all();
+    cnt = os_eventq_run_n(&etrn_evq, 0);
+    TEST_ASSERT_FATAL(cnt == 4);
+    TEST_ASSERT(etrn_order[0] == 0);
+    TEST_ASSERT(etrn_order[1] == 1);
+    TEST_ASSERT(etrn_order[2] == 2);
+    TEST_ASSERT(etrn_order[3] == 4);
+    TEST_ASSERT(!OS_EVENT_QUEUED(&etrn_events[3]));
+
+    /* Event 0 was re-posted during the batch. */
+    TEST_ASSERT(OS_EVENT_QUEUED(&etrn_events[0]));
+    cnt = os_eventq_run_n(&etrn_evq, 0);
+    TEST_ASSERT_FATAL(cnt == 1);
+    TEST_ASSERT(etrn_order[4] == 0);
+    TEST_ASSERT(os_eventq_get_no_wait(&etrn_evq) == NULL);
+
+    /* A limited batch leaves the rest on the queue, in order. */
+    for (i = 0; i < ETRN_NUM_EVENTS; i++) {
+        etrn_events[i].ev_arg = (void *)(intptr_t)(i + ETRN_NUM_EVENTS);
+    }
+    etrn_num_run = 0;
+    etrn_put_all();
+    cnt = os_eventq_run_n(&etrn_evq, 2);
+    TEST_ASSERT_FATAL(cnt == 2);
+    cnt = os_eventq_run_n(&etrn_evq, 1);
+    TEST_ASSERT_FATAL(cnt == 1);
+    cnt = os_eventq_run_n(&etrn_evq, 0);
+    TEST_ASSERT_FATAL(cnt == 2);
+    for (i = 0; i < ETRN_NUM_EVENTS; i++) {
+        TEST_ASSERT(etrn_order[i] == i + ETRN_NUM_EVENTS);
+    }
+
+    /* A nested call leaves the outer batch intact. */
+    for (i = 0; i < ETRN_NUM_EVENTS; i++) {
+        etrn_events[i].ev_cb = etrn_nest_cb;
+        etrn_events[i].ev_arg = (void *)(intptr_t)i;
+    }
+    etrn_num_run = 0;
+    for (i = 0; i < 4; i++) {
+        os_eventq_put(&etrn_evq, &etrn_events[i]);
+    }
+    cnt = os_eventq_run_n(&etrn_evq, 0);
+    TEST_ASSERT_FATAL(cnt == 3);
+    TEST_ASSERT(etrn_nested == 1);
+    TEST_ASSERT_FATAL(etrn_num_run == 4);
+    TEST_ASSERT(etrn_order[0] == 0);
+    TEST_ASSERT(etrn_order[1] == 1);
+    TEST_ASSERT(etrn_order[2] == 4);
+    TEST_ASSERT(etrn_order[3] == 2);
+    TEST_ASSERT(os_eventq_get_no_wait(&etrn_evq) == NULL);
+}
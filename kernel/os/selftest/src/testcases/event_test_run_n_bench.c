@@ -0,0 +1,102 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include "os_test_priv.h"
+
+/*
+ * Compares event dispatch throughput of os_eventq_run() called once per
+ * event against os_eventq_run_n() draining the queue in batches.
+ */
+
+#define ETRB_NUM_EVENTS     64
+#define ETRB_NUM_ROUNDS     2000
+
+static struct os_eventq etrb_evq;
+static struct os_event etrb_events[ETRB_NUM_EVENTS];
+static uint32_t etrb_num_run;
+
+static void
+etrb_event_cb(struct os_event *ev)
+{
+    etrb_num_run++;
+}
+
+static void
+etrb_put_all(void)
+{
+    int i;
+
+    for (i = 0; i < ETRB_NUM_EVENTS; i++) {
+        os_eventq_put(&etrb_evq, &etrb_events[i]);
+    }
+}
+
+static double
+etrb_events_per_sec(clock_t clk)
+{
+    if (clk == 0) {
+        clk = 1;
+    }
+    return (double)ETRB_NUM_EVENTS * ETRB_NUM_ROUNDS * CLOCKS_PER_SEC / clk;
+}
+
+TEST_CASE_TASK(event_test_run_n_bench)
+{
+    clock_t single_clk;
+    clock_t batch_clk;
+    clock_t start;
+    int round;
+    int cnt;
+    int i;
+
+    os_eventq_init(&etrb_evq);
+    for (i = 0; i < ETRB_NUM_EVENTS; i++) {
+        etrb_events[i].ev_cb = etrb_event_cb;
+    }
+
+    single_clk = 0;
+    batch_clk = 0;
+    etrb_num_run = 0;
+
+    for (round = 0; round < ETRB_NUM_ROUNDS; round++) {
+        etrb_put_all();
+        start = clock();
+        for (i = 0; i < ETRB_NUM_EVENTS; i++) {
+            os_eventq_run(&etrb_evq);
+        }
+        single_clk += clock() - start;
+
+        etrb_put_all();
+        start = clock();
+        cnt = 0;
+        while (cnt < ETRB_NUM_EVENTS) {
+            cnt += os_eventq_run_n(&etrb_evq, 0);
+        }
+        batch_clk += clock() - start;
+        TEST_ASSERT_FATAL(cnt == ETRB_NUM_EVENTS);
+    }
+
+    TEST_ASSERT(etrb_num_run == 2 * ETRB_NUM_EVENTS * ETRB_NUM_ROUNDS);
+
+    printf("eventq dispatch: os_eventq_run %.0f ev/s, "
+           "os_eventq_run_n %.0f ev/s\n",
+           etrb_events_per_sec(single_clk), etrb_events_per_sec(batch_clk));
+}
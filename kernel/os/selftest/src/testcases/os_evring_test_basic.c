@@ -0,0 +1,70 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "os_test_priv.h"
+
+#define OETB_RING_SIZE  8
+
+static struct os_event *oetb_buf[OETB_RING_SIZE];
+static struct os_evring oetb_ring;
+static struct os_eventq oetb_evq;
+static struct os_event oetb_events[OETB_RING_SIZE + 1];
+
+TEST_CASE_SELF(os_evring_test_basic)
+{
+    struct os_event *ev;
+    int rc;
+    int i;
+
+    os_eventq_init(&oetb_evq);
+
+    /* Size must be a power of two. */
+    rc = os_evring_init(&oetb_ring, &oetb_evq, oetb_buf, 6);
+    TEST_ASSERT(rc == OS_EINVAL);
+
+    rc = os_evring_init(&oetb_ring, &oetb_evq, oetb_buf, OETB_RING_SIZE);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(os_evring_get(&oetb_ring) == NULL);
+
+    /* Fill the ring; one more must fail. */
+    for (i = 0; i < OETB_RING_SIZE; i++) {
+        rc = os_evring_put(&oetb_ring, &oetb_events[i]);
+        TEST_ASSERT_FATAL(rc == 0);
+    }
+    TEST_ASSERT(os_evring_count(&oetb_ring) == OETB_RING_SIZE);
+    rc = os_evring_put(&oetb_ring, &oetb_events[OETB_RING_SIZE]);
+    TEST_ASSERT(rc == OS_ENOMEM);
+    TEST_ASSERT(oetb_ring.er_drops == 1);
+
+    /* Events come out in order, across index wrap-around. */
+    for (i = 0; i < OETB_RING_SIZE / 2; i++) {
+        ev = os_evring_get(&oetb_ring);
+        TEST_ASSERT_FATAL(ev == &oetb_events[i]);
+    }
+    for (i = 0; i < OETB_RING_SIZE / 2; i++) {
+        rc = os_evring_put(&oetb_ring, &oetb_events[i]);
+        TEST_ASSERT_FATAL(rc == 0);
+    }
+    for (i = 0; i < OETB_RING_SIZE; i++) {
+        ev = os_evring_get(&oetb_ring);
+        TEST_ASSERT_FATAL(
+            ev == &oetb_events[(i + OETB_RING_SIZE / 2) % OETB_RING_SIZE]);
+    }
+    TEST_ASSERT(os_evring_get(&oetb_ring) == NULL);
+}
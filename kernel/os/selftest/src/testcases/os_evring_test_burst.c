@@ -0,0 +1,83 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "os_test_priv.h"
+
+/*
+ * A burst of events pushed into the ring must cost a single eventq put, and
+ * draining the queue must run every event callback in order.
+ */
+
+#define OETBU_RING_SIZE     32
+#define OETBU_BURST         20
+
+static struct os_event *oetbu_buf[OETBU_RING_SIZE];
+static struct os_evring oetbu_ring;
+static struct os_eventq oetbu_evq;
+static struct os_event oetbu_events[OETBU_BURST];
+static int oetbu_order[OETBU_BURST];
+static int oetbu_num_run;
+
+static void
+oetbu_event_cb(struct os_event *ev)
+{
+    TEST_ASSERT_FATAL(oetbu_num_run < OETBU_BURST);
+    oetbu_order[oetbu_num_run++] = (int)(uintptr_t)ev->ev_arg;
+}
+
+TEST_CASE_SELF(os_evring_test_burst)
+{
+    struct os_event *ev;
+    int round;
+    int rc;
+    int i;
+
+    os_eventq_init(&oetbu_evq);
+    rc = os_evring_init(&oetbu_ring, &oetbu_evq, oetbu_buf, OETBU_RING_SIZE);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    for (i = 0; i < OETBU_BURST; i++) {
+        oetbu_events[i].ev_cb = oetbu_event_cb;
+        oetbu_events[i].ev_arg = (void *)(uintptr_t)i;
+    }
+
+    for (round = 0; round < 3; round++) {
+        oetbu_num_run = 0;
+
+        for (i = 0; i < OETBU_BURST; i++) {
+            rc = os_evring_put(&oetbu_ring, &oetbu_events[i]);
+            TEST_ASSERT_FATAL(rc == 0);
+        }
+
+        /* Only the ring's drain event is on the queue. */
+        ev = os_eventq_get_no_wait(&oetbu_evq);
+        TEST_ASSERT_FATAL(ev == &oetbu_ring.er_ev);
+        TEST_ASSERT(os_eventq_get_no_wait(&oetbu_evq) == NULL);
+
+        ev->ev_cb(ev);
+        TEST_ASSERT_FATAL(oetbu_num_run == OETBU_BURST);
+        for (i = 0; i < OETBU_BURST; i++) {
+            TEST_ASSERT(oetbu_order[i] == i);
+        }
+        TEST_ASSERT(os_evring_count(&oetbu_ring) == 0);
+    }
+
+    /* Draining an empty ring is harmless. */
+    TEST_ASSERT(os_evring_drain(&oetbu_ring) == 0);
+}
@@ -0,0 +1,196 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include <limits.h>
+#include <stdio.h>
+#include <time.h>
+#include "os_test_priv.h"
+
+#define OMTC_PKT_LEN        1000
+#define OMTC_NUM_ROUNDS     200
+
+static struct os_mbuf *
+omtc_build_chain(void)
+{
+    struct os_mbuf *om;
+    int rc;
+
+    om = os_mbuf_get_pkthdr(&os_mbuf_pool, 0);
+    TEST_ASSERT_FATAL(om != NULL);
+
+    rc = os_mbuf_append(om, os_mbuf_test_data, OMTC_PKT_LEN);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT_FATAL(SLIST_NEXT(om, om_next) != NULL);
+
+    return om;
+}
+
+static double
+omtc_bytes_per_sec(clock_t clk)
+{
+    if (clk == 0) {
+        clk = 1;
+    }
+    return (double)OMTC_PKT_LEN * OMTC_NUM_ROUNDS * CLOCKS_PER_SEC / clk;
+}
+
+TEST_CASE_SELF(os_mbuf_test_cursor)
+{
+    struct os_mbuf_iovec iov[8];
+    struct os_mbuf_cursor omc;
+    struct os_mbuf *cur;
+    struct os_mbuf *om;
+    uint8_t buf[OMTC_PKT_LEN];
+    uint8_t *data;
+    clock_t copydata_clk;
+    clock_t cursor_clk;
+    clock_t start;
+    uint16_t mbuf_off;
+    int num_segs;
+    int round;
+    int total;
+    int len;
+    int off;
+    int rc;
+    int i;
+
+    os_mbuf_test_setup();
+    om = omtc_build_chain();
+
+    num_segs = 0;
+    for (cur = om; cur != NULL; cur = SLIST_NEXT(cur, om_next)) {
+        num_segs++;
+    }
+
+    os_mbuf_cursor_init(&omc, om);
+
+    /* Every offset, forward. */
+    for (off = 0; off < OMTC_PKT_LEN; off++) {
+        data = os_mbuf_cursor_seek(&omc, off, &len);
+        TEST_ASSERT_FATAL(data != NULL);
+        TEST_ASSERT_FATAL(*data == os_mbuf_test_data[off]);
+        TEST_ASSERT_FATAL(os_mbuf_off(om, off, &mbuf_off)->om_data +
+                          mbuf_off == data);
+        TEST_ASSERT_FATAL(len > 0 && off + len <= OMTC_PKT_LEN);
+    }
+
+    /* Every offset, backward. */
+    for (off = OMTC_PKT_LEN - 1; off >= 0; off--) {
+        data = os_mbuf_cursor_seek(&omc, off, NULL);
+        TEST_ASSERT_FATAL(data != NULL);
+        TEST_ASSERT_FATAL(*data == os_mbuf_test_data[off]);
+    }
+
+    /* Segment iteration visits each mbuf once. */
+    i = 0;
+    for (off = 0; off < OMTC_PKT_LEN; off += len) {
+        data = os_mbuf_cursor_seek(&omc, off, &len);
+        TEST_ASSERT_FATAL(data != NULL);
+        i++;
+    }
+    TEST_ASSERT(i == num_segs);
+
+    /* Out of bounds. */
+    TEST_ASSERT(os_mbuf_cursor_seek(&omc, OMTC_PKT_LEN, NULL) == NULL);
+    TEST_ASSERT(os_mbuf_cursor_seek(&omc, -1, NULL) == NULL);
+
+    /* Copy and compare ranges that straddle mbuf boundaries. */
+    for (off = 0; off < OMTC_PKT_LEN; off += 37) {
+        len = OMTC_PKT_LEN - off;
+        if (len > 300) {
+            len = 300;
+        }
+
+        memset(buf, 0, sizeof buf);
+        rc = os_mbuf_cursor_copydata(&omc, off, len, buf);
+        TEST_ASSERT_FATAL(rc == 0);
+        TEST_ASSERT_FATAL(memcmp(buf, os_mbuf_test_data + off, len) == 0);
+
+        rc = os_mbuf_cursor_cmpf(&omc, off, os_mbuf_test_data + off, len);
+        TEST_ASSERT_FATAL(rc == 0);
+    }
+
+    rc = os_mbuf_cursor_copydata(&omc, OMTC_PKT_LEN - 10, 11, buf);
+    TEST_ASSERT(rc == -1);
+    rc = os_mbuf_cursor_cmpf(&omc, OMTC_PKT_LEN - 10,
+                             os_mbuf_test_data + OMTC_PKT_LEN - 10, 11);
+    TEST_ASSERT(rc == INT_MAX);
+
+    buf[0] = os_mbuf_test_data[500] + 1;
+    rc = os_mbuf_cursor_cmpf(&omc, 500, buf, 1);
+    TEST_ASSERT(rc != 0 && rc != INT_MAX);
+
+    /* Iovec covering the whole packet. */
+    rc = os_mbuf_to_iovec(om, 0, OMTC_PKT_LEN, iov, 8);
+    TEST_ASSERT_FATAL(rc == num_segs);
+    total = 0;
+    for (i = 0; i < rc; i++) {
+        TEST_ASSERT(memcmp(iov[i].iov_base, os_mbuf_test_data + total,
+                           iov[i].iov_len) == 0);
+        total += iov[i].iov_len;
+    }
+    TEST_ASSERT(total == OMTC_PKT_LEN);
+
+    /* Iovec covering part of the packet. */
+    rc = os_mbuf_to_iovec(om, 100, 500, iov, 8);
+    TEST_ASSERT_FATAL(rc > 0);
+    total = 0;
+    for (i = 0; i < rc; i++) {
+        TEST_ASSERT(memcmp(iov[i].iov_base, os_mbuf_test_data + 100 + total,
+                           iov[i].iov_len) == 0);
+        total += iov[i].iov_len;
+    }
+    TEST_ASSERT(total == 500);
+
+    /* Truncated by iovcnt and by the end of the chain. */
+    rc = os_mbuf_to_iovec(om, 0, OMTC_PKT_LEN, iov, 1);
+    TEST_ASSERT(rc == 1);
+    TEST_ASSERT(iov[0].iov_len == om->om_len);
+    rc = os_mbuf_to_iovec(om, OMTC_PKT_LEN, 1, iov, 8);
+    TEST_ASSERT(rc == 0);
+
+    /*
+     * Benchmark: byte-at-a-time parsing through os_mbuf_copydata(), which
+     * walks the chain from the head every time, against a cursor.
+     */
+    copydata_clk = 0;
+    cursor_clk = 0;
+    for (round = 0; round < OMTC_NUM_ROUNDS; round++) {
+        start = clock();
+        for (off = 0; off < OMTC_PKT_LEN; off++) {
+            os_mbuf_copydata(om, off, 1, buf + off);
+        }
+        copydata_clk += clock() - start;
+
+        start = clock();
+        os_mbuf_cursor_init(&omc, om);
+        for (off = 0; off < OMTC_PKT_LEN; off++) {
+            os_mbuf_cursor_copydata(&omc, off, 1, buf + off);
+        }
+        cursor_clk += clock() - start;
+    }
+    TEST_ASSERT(memcmp(buf, os_mbuf_test_data, OMTC_PKT_LEN) == 0);
+
+    printf("mbuf read (%d bytes, %d mbufs): os_mbuf_copydata %.0f B/s, "
+           "cursor %.0f B/s\n", OMTC_PKT_LEN, num_segs,
+           omtc_bytes_per_sec(copydata_clk), omtc_bytes_per_sec(cursor_clk));
+    printf("mbuf tx: flatten copies %d bytes/packet, iovec copies 0 "
+           "(%d segments)\n", OMTC_PKT_LEN, num_segs);
+
+    os_mbuf_free_chain(om);
+}
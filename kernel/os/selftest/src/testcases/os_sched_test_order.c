@@ -0,0 +1,157 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "os_test_priv.h"
+
+/*
+ * Exercises the scheduler run list with a set of dummy tasks and verifies
+ * that the resulting order matches a reference model of the list based
+ * scheduler: sorted by priority, FIFO among tasks with equal priority.
+ */
+
+#define OSTO_NUM_TASKS      48
+#define OSTO_MAX_REF        (OSTO_NUM_TASKS + 16)
+
+static struct os_task osto_tasks[OSTO_NUM_TASKS];
+static struct os_task *osto_ref[OSTO_MAX_REF];
+static int osto_ref_cnt;
+static uint32_t osto_seed = 0x12345678;
+
+static uint8_t
+osto_rand_prio(void)
+{
+    osto_seed = osto_seed * 1103515245 + 12345;
+
+    /* Keep clear of the idle task priority. */
+    return (osto_seed >> 16) % OS_IDLE_PRIO;
+}
+
+static void
+osto_ref_insert(struct os_task *t)
+{
+    int i;
+
+    TEST_ASSERT_FATAL(osto_ref_cnt < OSTO_MAX_REF);
+
+    for (i = 0; i < osto_ref_cnt; i++) {
+        if (t->t_prio < osto_ref[i]->t_prio) {
+            break;
+        }
+    }
+    memmove(&osto_ref[i + 1], &osto_ref[i],
+            (osto_ref_cnt - i) * sizeof osto_ref[0]);
+    osto_ref[i] = t;
+    osto_ref_cnt++;
+}
+
+static void
+osto_ref_remove(struct os_task *t)
+{
+    int i;
+
+    for (i = 0; i < osto_ref_cnt; i++) {
+        if (osto_ref[i] == t) {
+            memmove(&osto_ref[i], &osto_ref[i + 1],
+                    (osto_ref_cnt - i - 1) * sizeof osto_ref[0]);
+            osto_ref_cnt--;
+            return;
+        }
+    }
+    TEST_ASSERT_FATAL(0, "task not in reference list");
+}
+
+static void
+osto_verify(void)
+{
+    struct os_task *t;
+    int i;
+
+    i = 0;
+    TAILQ_FOREACH(t, &g_os_run_list, t_os_list) {
+        TEST_ASSERT_FATAL(i < osto_ref_cnt);
+        TEST_ASSERT_FATAL(t == osto_ref[i], "run list mismatch at %d", i);
+        i++;
+    }
+    TEST_ASSERT_FATAL(i == osto_ref_cnt);
+    TEST_ASSERT(os_sched_next_task() == TAILQ_FIRST(&g_os_run_list));
+}
+
+TEST_CASE_SELF(os_sched_test_order)
+{
+    struct os_task *t;
+    os_sr_t sr;
+    int i;
+
+    OS_ENTER_CRITICAL(sr);
+
+    /* Seed the reference model with tasks already ready to run. */
+    osto_ref_cnt = 0;
+    TAILQ_FOREACH(t, &g_os_run_list, t_os_list) {
+        TEST_ASSERT_FATAL(osto_ref_cnt < OSTO_MAX_REF);
+        osto_ref[osto_ref_cnt++] = t;
+    }
+
+    /* Insert; include a few priorities shared with the existing tasks. */
+    memset(osto_tasks, 0, sizeof osto_tasks);
+    for (i = 0; i < OSTO_NUM_TASKS; i++) {
+        t = &osto_tasks[i];
+        t->t_state = OS_TASK_READY;
+        if (i % 8 == 0) {
+            t->t_prio = MYNEWT_VAL(OS_MAIN_TASK_PRIO);
+        } else {
+            t->t_prio = osto_rand_prio();
+        }
+        TEST_ASSERT_FATAL(os_sched_insert(t) == 0);
+        osto_ref_insert(t);
+        osto_verify();
+    }
+
+    /* Change priorities of tasks in the run list. */
+    for (i = 0; i < OSTO_NUM_TASKS; i += 3) {
+        t = &osto_tasks[i];
+        t->t_prio = osto_rand_prio();
+        os_sched_resort(t);
+        osto_ref_remove(t);
+        osto_ref_insert(t);
+        osto_verify();
+    }
+
+    /* Put every other task to sleep, then wake them up in reverse order. */
+    for (i = 0; i < OSTO_NUM_TASKS; i += 2) {
+        os_sched_sleep(&osto_tasks[i], OS_TIMEOUT_NEVER);
+        osto_ref_remove(&osto_tasks[i]);
+        osto_verify();
+    }
+    for (i = OSTO_NUM_TASKS - 2; i >= 0; i -= 2) {
+        os_sched_wakeup(&osto_tasks[i]);
+        osto_ref_insert(&osto_tasks[i]);
+        osto_verify();
+    }
+
+    /* Remove the dummy tasks from the scheduler. */
+    for (i = 0; i < OSTO_NUM_TASKS; i++) {
+        t = &osto_tasks[i];
+        os_sched_sleep(t, OS_TIMEOUT_NEVER);
+        TAILQ_REMOVE(&g_os_sleep_list, t, t_os_list);
+        osto_ref_remove(t);
+        osto_verify();
+    }
+
+    OS_EXIT_CRITICAL(sr);
+}
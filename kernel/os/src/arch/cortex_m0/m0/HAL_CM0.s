@@ -103,7 +103,7 @@ SVC_Handler:
         .cantunwind
 
         PUSH    {R4,LR}
-#if MYNEWT_VAL(OS_SYSVIEW)
+#if OS_TRACE_ENABLED
         BL      os_trace_isr_enter
 #endif
 
@@ -119,7 +119,7 @@ SVC_Handler:
         BLX     R12                     /* Call SVC Function */
         MRS     R3,PSP                  /* Read PSP */
         STMIA   R3!,{R0-R2}             /* Store return values */
-#if MYNEWT_VAL(OS_SYSVIEW)
+#if OS_TRACE_ENABLED
         BL      os_trace_isr_exit
 #endif
         POP     {R4,PC}                 /* RETI */
@@ -140,7 +140,7 @@ SVC_User:
         MRS     R4,PSP                  /* Read PSP */
         STMIA   R4!,{R0-R3}             /* Function return values */
 SVC_Done:
-#if MYNEWT_VAL(OS_SYSVIEW)
+#if OS_TRACE_ENABLED
         BL      os_trace_isr_exit
 #endif
         POP     {R4,PC}                 /* RETI */
@@ -187,7 +187,7 @@ context_switch:
         SUBS    R0,R0,#32
         LDMIA   R0!,{R4-R7}         /* Restore New Context */
 
-#if MYNEWT_VAL(OS_SYSVIEW)
+#if OS_TRACE_ENABLED
         PUSH    {R4,LR}
         MOV     R0, R2
         BL      os_trace_task_start_exec
@@ -212,11 +212,11 @@ SysTick_Handler:
         .cantunwind
 
         PUSH    {R4,LR}                 /* Save EXC_RETURN */
-#if MYNEWT_VAL(OS_SYSVIEW)
+#if OS_TRACE_ENABLED
         BL      os_trace_isr_enter
 #endif
         BL      timer_handler
-#if MYNEWT_VAL(OS_SYSVIEW)
+#if OS_TRACE_ENABLED
         BL      os_trace_isr_exit
 #endif
         POP     {R4,PC}                 /* Restore EXC_RETURN */
@@ -249,7 +249,7 @@ os_default_irq_asm:
         .fnstart
         .cantunwind
 
-#if MYNEWT_VAL(OS_SYSVIEW)
+#if OS_TRACE_ENABLED
         PUSH    {R4,LR}
         BL      os_trace_isr_enter
 #endif
@@ -274,7 +274,7 @@ using_msp_as_sp:
         MOV     R1,R9
         MOV     R2,R10
         MOV     R3,R11
-#if MYNEWT_VAL(OS_SYSVIEW)
+#if OS_TRACE_ENABLED
         PUSH    {R0-R3}
 #else
         PUSH    {R0-R3, LR}
@@ -290,7 +290,7 @@ using_msp_as_sp:
         MOV     R9,R1
         MOV     R10,R2
         MOV     R11,R3
-#if MYNEWT_VAL(OS_SYSVIEW)
+#if OS_TRACE_ENABLED
         BL      os_trace_isr_exit
         POP     {R4,PC}
 #else
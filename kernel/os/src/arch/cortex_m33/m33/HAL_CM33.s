@@ -98,7 +98,7 @@ SVC_Handler:
         .fnstart
         .cantunwind
 
-#if MYNEWT_VAL(OS_SYSVIEW)
+#if OS_TRACE_ENABLED
         PUSH    {R4,LR}
         BL      os_trace_isr_enter
         POP     {R4,LR}
@@ -117,7 +117,7 @@ SVC_Handler:
         MRS     R12,PSP                 /* Read PSP */
         STM     R12,{R0-R2}             /* Store return values */
 
-#if MYNEWT_VAL(OS_SYSVIEW)
+#if OS_TRACE_ENABLED
         PUSH    {R4,LR}
         BL      os_trace_isr_exit
         POP     {R4,LR}
@@ -142,7 +142,7 @@ SVC_User:
         MRS     R12,PSP
         STM     R12,{R0-R3}             /* Function return values */
 SVC_Done:
-#if MYNEWT_VAL(OS_SYSVIEW)
+#if OS_TRACE_ENABLED
         BL      os_trace_isr_exit
 #endif
         POP     {R4,LR}                 /* Restore EXC_RETURN */
@@ -198,7 +198,7 @@ PendSV_Handler:
 #endif
         MSR     PSP,R12                 /* Write PSP */
 
-#if MYNEWT_VAL(OS_SYSVIEW)
+#if OS_TRACE_ENABLED
         PUSH    {R4,LR}
         MOV     R0, R2
         BL      os_trace_task_start_exec
@@ -222,11 +222,11 @@ SysTick_Handler:
         .cantunwind
 
         PUSH    {R4,LR}                 /* Save EXC_RETURN */
-#if MYNEWT_VAL(OS_SYSVIEW)
+#if OS_TRACE_ENABLED
         BL      os_trace_isr_enter
 #endif
         BL      timer_handler
-#if MYNEWT_VAL(OS_SYSVIEW)
+#if OS_TRACE_ENABLED
         BL      os_trace_isr_exit
 #endif
         POP     {R4,LR}                 /* Restore EXC_RETURN */
@@ -243,7 +243,7 @@ os_default_irq_asm:
         .fnstart
         .cantunwind
 
-#if MYNEWT_VAL(OS_SYSVIEW)
+#if OS_TRACE_ENABLED
         PUSH    {R4,LR}
         BL      os_trace_isr_enter
         POP     {R4,LR}
@@ -262,7 +262,7 @@ os_default_irq_asm:
         BL      os_default_irq
         POP     {R3-R11,LR}                 /* Restore EXC_RETURN */
 
-#if MYNEWT_VAL(OS_SYSVIEW)
+#if OS_TRACE_ENABLED
         PUSH    {R4,LR}
         BL      os_trace_isr_exit
         POP     {R4,LR}
@@ -180,7 +180,7 @@ PendSV_Handler:
 #endif
         MSR     PSP,R12                 /* Write PSP */
 
-#if MYNEWT_VAL(OS_SYSVIEW)
+#if OS_TRACE_ENABLED
         PUSH    {R4,LR}
         MOV     R0, R2
         BL      os_trace_task_start_exec
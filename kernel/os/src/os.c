@@ -114,6 +114,9 @@ os_idle_task(void *arg)
         now = os_time_get();
         if (OS_TIME_TICK_GEQ(now, sanity_last + sanity_itvl_ticks)) {
             os_sanity_run();
+#if MYNEWT_VAL(OS_TASK_STACK_WATERMARK)
+            os_task_stack_sample();
+#endif
             /* Tickle the watchdog after successfully running sanity */
             hal_watchdog_tickle();
 #if MYNEWT_VAL(OS_WATCHDOG_MONITOR)
@@ -178,7 +181,7 @@ os_main(void *arg)
 #else
     (void)fn;
     while (1) {
-        os_eventq_run(os_eventq_dflt_get());
+        os_eventq_run_n(os_eventq_dflt_get(), 0);
     }
 #endif
     assert(0);
@@ -230,9 +233,9 @@ os_init(int (*main_fn)(int argc, char **arg))
     SEGGER_RTT_Init();
 #endif
 
-    TAILQ_INIT(&g_callout_list);
+    os_callout_module_init();
     STAILQ_INIT(&g_os_task_list);
-    os_eventq_init(os_eventq_dflt_get());
+    os_eventq_module_init();
 
     /* Initialize device list. */
     os_dev_reset();
@@ -251,6 +254,11 @@ os_init(int (*main_fn)(int argc, char **arg))
     /* Call bsp related OS initializations */
     hal_bsp_init();
 
+#if MYNEWT_VAL(OS_TRACE_RAM)
+    /* Timestamps come from os_cputime, which the BSP has just set up. */
+    os_trace_ram_init();
+#endif
+
     err = (os_error_t) os_dev_initialize_all(OS_DEV_INIT_PRIMARY);
     assert(err == OS_OK);
 
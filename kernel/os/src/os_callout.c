@@ -26,8 +26,315 @@
 #include "os/mynewt.h"
 #include "os_priv.h"
 
+#if MYNEWT_VAL(OS_CALLOUT_WHEEL)
+
+/*
+ * Hierarchical timing wheel.
+ *
+ * Level n has OS_CALLOUT_WHEEL_SLOTS slots, each covering
+ * OS_CALLOUT_WHEEL_SLOTS^n ticks.  A callout is queued on the lowest level
+ * which can represent its distance from the wheel time.  When the wheel time
+ * crosses a slot boundary of level n > 0, the callouts in that slot are
+ * cascaded down to the lower levels.  Level 0 slots only ever hold callouts
+ * expiring at the same tick.
+ *
+ * Callouts expiring at the same tick fire in the order they were armed, as
+ * with the sorted list.  A callout cascaded down was armed further away from
+ * its expiry, and thus earlier, than any callout already in its new slot with
+ * the same expiry; so cascaded callouts go to the head of their new slot.
+ * Higher levels are armed earlier still and are cascaded last.
+ */
+#define OS_CALLOUT_WHEEL_BITS       (5)
+#define OS_CALLOUT_WHEEL_SLOTS      (1 << OS_CALLOUT_WHEEL_BITS)
+#define OS_CALLOUT_WHEEL_MASK       (OS_CALLOUT_WHEEL_SLOTS - 1)
+#define OS_CALLOUT_WHEEL_LEVELS     (6)
+
+/* Longest distance representable by the wheel; longer ones are clamped. */
+#define OS_CALLOUT_WHEEL_MAX_TICKS  \
+    ((1UL << (OS_CALLOUT_WHEEL_BITS * OS_CALLOUT_WHEEL_LEVELS)) - 1)
+
+static struct os_callout_list
+    os_callout_wheel[OS_CALLOUT_WHEEL_LEVELS][OS_CALLOUT_WHEEL_SLOTS];
+
+/* Bit n of level's map is set if slot n of that level is not empty. */
+static uint32_t os_callout_wheel_map[OS_CALLOUT_WHEEL_LEVELS];
+
+/* Next tick to be processed; everything before it has been expired. */
+static os_time_t os_callout_wheel_time;
+
+/*
+ * Returns the wheel slot for a callout, marking it as not empty.
+ */
+static struct os_callout_list *
+os_callout_wheel_slot(struct os_callout *c)
+{
+    os_time_t expires;
+    os_time_t delta;
+    int level;
+    int slot;
+
+    if (OS_TIME_TICK_LT(c->c_ticks, os_callout_wheel_time)) {
+        delta = 0;
+    } else {
+        delta = c->c_ticks - os_callout_wheel_time;
+        if (delta > OS_CALLOUT_WHEEL_MAX_TICKS) {
+            delta = OS_CALLOUT_WHEEL_MAX_TICKS;
+        }
+    }
+    expires = os_callout_wheel_time + delta;
+
+    if (delta < OS_CALLOUT_WHEEL_SLOTS) {
+        level = 0;
+    } else {
+        level = (31 - __builtin_clz(delta)) / OS_CALLOUT_WHEEL_BITS;
+    }
+    slot = (expires >> (level * OS_CALLOUT_WHEEL_BITS)) & OS_CALLOUT_WHEEL_MASK;
+
+    os_callout_wheel_map[level] |= 1UL << slot;
+    c->c_wheel_slot = level * OS_CALLOUT_WHEEL_SLOTS + slot;
+
+    return &os_callout_wheel[level][slot];
+}
+
+static void
+os_callout_insert(struct os_callout *c)
+{
+    TAILQ_INSERT_TAIL(os_callout_wheel_slot(c), c, c_next);
+}
+
+static void
+os_callout_remove(struct os_callout *c)
+{
+    struct os_callout_list *head;
+    int level;
+    int slot;
+
+    level = c->c_wheel_slot / OS_CALLOUT_WHEEL_SLOTS;
+    slot = c->c_wheel_slot % OS_CALLOUT_WHEEL_SLOTS;
+    head = &os_callout_wheel[level][slot];
+
+    TAILQ_REMOVE(head, c, c_next);
+    c->c_next.tqe_prev = NULL;
+    if (TAILQ_EMPTY(head)) {
+        os_callout_wheel_map[level] &= ~(1UL << slot);
+    }
+}
+
+/*
+ * Sets wheel time to 't' and cascades the higher level slots whose period
+ * starts at 't'.
+ */
+static void
+os_callout_wheel_advance(os_time_t t)
+{
+    struct os_callout_list *head;
+    struct os_callout *c;
+    int shift;
+    int level;
+    int slot;
+
+    os_callout_wheel_time = t;
+
+    for (level = 1; level < OS_CALLOUT_WHEEL_LEVELS; level++) {
+        shift = level * OS_CALLOUT_WHEEL_BITS;
+        if (t & ((1UL << shift) - 1)) {
+            break;
+        }
+
+        slot = (t >> shift) & OS_CALLOUT_WHEEL_MASK;
+        head = &os_callout_wheel[level][slot];
+        /* Back to front, so each slot keeps the order of its callouts. */
+        while ((c = TAILQ_LAST(head, os_callout_list)) != NULL) {
+            TAILQ_REMOVE(head, c, c_next);
+            TAILQ_INSERT_HEAD(os_callout_wheel_slot(c), c, c_next);
+        }
+        os_callout_wheel_map[level] &= ~(1UL << slot);
+    }
+}
+
+/*
+ * Returns number of ticks from 'from' until the wheel has work to do, either
+ * expiring a level 0 slot or cascading a higher level slot.  Returns
+ * OS_TIMEOUT_NEVER if the wheel is empty.
+ */
+static os_time_t
+os_callout_wheel_next(os_time_t from)
+{
+    os_time_t offset;
+    os_time_t best;
+    os_time_t dist;
+    uint32_t map;
+    int shift;
+    int level;
+    int idx;
+
+    best = OS_TIMEOUT_NEVER;
+    for (level = 0; level < OS_CALLOUT_WHEEL_LEVELS; level++) {
+        map = os_callout_wheel_map[level];
+        if (!map) {
+            continue;
+        }
+
+        /* Slots of this level are only looked at on their period boundary. */
+        shift = level * OS_CALLOUT_WHEEL_BITS;
+        offset = (0 - from) & ((1UL << shift) - 1);
+        idx = ((from + offset) >> shift) & OS_CALLOUT_WHEEL_MASK;
+        if (idx) {
+            map = (map >> idx) | (map << (OS_CALLOUT_WHEEL_SLOTS - idx));
+        }
+
+        dist = offset + ((os_time_t)__builtin_ctz(map) << shift);
+        if (dist < best) {
+            best = dist;
+        }
+    }
+
+    return best;
+}
+
+/*
+ * Removes and returns the next callout which has expired at 'now', or NULL
+ * if there are none.
+ */
+static struct os_callout *
+os_callout_next_expired(os_time_t now)
+{
+    struct os_callout *c;
+    os_time_t next;
+
+    while (!OS_TIME_TICK_GT(os_callout_wheel_time, now)) {
+        c = TAILQ_FIRST(
+            &os_callout_wheel[0][os_callout_wheel_time & OS_CALLOUT_WHEEL_MASK]);
+        if (c) {
+            os_callout_remove(c);
+            return c;
+        }
+
+        /* Skip straight to the next tick with something to do. */
+        next = os_callout_wheel_next(os_callout_wheel_time + 1);
+        if (next == OS_TIMEOUT_NEVER ||
+            OS_TIME_TICK_GT(os_callout_wheel_time + 1 + next, now)) {
+            os_callout_wheel_advance(now + 1);
+            break;
+        }
+        os_callout_wheel_advance(os_callout_wheel_time + 1 + next);
+    }
+
+    return NULL;
+}
+
+static os_time_t
+os_callout_first_ticks(os_time_t now)
+{
+    os_time_t next;
+    os_time_t t;
+
+    next = os_callout_wheel_next(os_callout_wheel_time);
+    if (next == OS_TIMEOUT_NEVER) {
+        return OS_TIMEOUT_NEVER;
+    }
+
+    /*
+     * For a callout on a higher level this is the time it gets cascaded,
+     * which is never later than when it expires.
+     */
+    t = os_callout_wheel_time + next;
+    if (OS_TIME_TICK_GEQ(t, now)) {
+        return t - now;
+    } else {
+        return 0;   /* callout time is in the past */
+    }
+}
+
+void
+os_callout_module_init(void)
+{
+    int level;
+    int slot;
+
+    for (level = 0; level < OS_CALLOUT_WHEEL_LEVELS; level++) {
+        for (slot = 0; slot < OS_CALLOUT_WHEEL_SLOTS; slot++) {
+            TAILQ_INIT(&os_callout_wheel[level][slot]);
+        }
+        os_callout_wheel_map[level] = 0;
+    }
+    os_callout_wheel_time = os_time_get();
+}
+
+#else
+
 struct os_callout_list g_callout_list;
 
+static void
+os_callout_insert(struct os_callout *c)
+{
+    struct os_callout *entry;
+
+    TAILQ_FOREACH(entry, &g_callout_list, c_next) {
+        if (OS_TIME_TICK_LT(c->c_ticks, entry->c_ticks)) {
+            break;
+        }
+    }
+
+    if (entry) {
+        TAILQ_INSERT_BEFORE(entry, c, c_next);
+    } else {
+        TAILQ_INSERT_TAIL(&g_callout_list, c, c_next);
+    }
+}
+
+static void
+os_callout_remove(struct os_callout *c)
+{
+    TAILQ_REMOVE(&g_callout_list, c, c_next);
+    c->c_next.tqe_prev = NULL;
+}
+
+static struct os_callout *
+os_callout_next_expired(os_time_t now)
+{
+    struct os_callout *c;
+
+    c = TAILQ_FIRST(&g_callout_list);
+    if (c) {
+        if (OS_TIME_TICK_GEQ(now, c->c_ticks)) {
+            os_callout_remove(c);
+        } else {
+            c = NULL;
+        }
+    }
+
+    return c;
+}
+
+static os_time_t
+os_callout_first_ticks(os_time_t now)
+{
+    struct os_callout *c;
+    os_time_t rt;
+
+    c = TAILQ_FIRST(&g_callout_list);
+    if (c != NULL) {
+        if (OS_TIME_TICK_GEQ(c->c_ticks, now)) {
+            rt = c->c_ticks - now;
+        } else {
+            rt = 0;     /* callout time is in the past */
+        }
+    } else {
+        rt = OS_TIMEOUT_NEVER;
+    }
+
+    return (rt);
+}
+
+void
+os_callout_module_init(void)
+{
+    TAILQ_INIT(&g_callout_list);
+}
+
+#endif
+
 void os_callout_init(struct os_callout *c, struct os_eventq *evq,
                      os_event_fn *ev_cb, void *ev_arg)
 {
@@ -51,8 +358,7 @@ os_callout_stop(struct os_callout *c)
     OS_ENTER_CRITICAL(sr);
 
     if (os_callout_queued(c)) {
-        TAILQ_REMOVE(&g_callout_list, c, c_next);
-        c->c_next.tqe_prev = NULL;
+        os_callout_remove(c);
     }
 
     if (c->c_evq) {
@@ -67,7 +373,6 @@ os_callout_stop(struct os_callout *c)
 int
 os_callout_reset(struct os_callout *c, os_time_t ticks)
 {
-    struct os_callout *entry;
     os_sr_t sr;
     int ret;
 
@@ -90,19 +395,7 @@ os_callout_reset(struct os_callout *c, os_time_t ticks)
     }
 
     c->c_ticks = os_time_get() + ticks;
-
-    entry = NULL;
-    TAILQ_FOREACH(entry, &g_callout_list, c_next) {
-        if (OS_TIME_TICK_LT(c->c_ticks, entry->c_ticks)) {
-            break;
-        }
-    }
-
-    if (entry) {
-        TAILQ_INSERT_BEFORE(entry, c, c_next);
-    } else {
-        TAILQ_INSERT_TAIL(&g_callout_list, c, c_next);
-    }
+    os_callout_insert(c);
 
     OS_EXIT_CRITICAL(sr);
 
@@ -133,15 +426,7 @@ os_callout_tick(void)
 
     while (1) {
         OS_ENTER_CRITICAL(sr);
-        c = TAILQ_FIRST(&g_callout_list);
-        if (c) {
-            if (OS_TIME_TICK_GEQ(now, c->c_ticks)) {
-                TAILQ_REMOVE(&g_callout_list, c, c_next);
-                c->c_next.tqe_prev = NULL;
-            } else {
-                c = NULL;
-            }
-        }
+        c = os_callout_next_expired(now);
         OS_EXIT_CRITICAL(sr);
 
         if (c) {
@@ -169,23 +454,9 @@ os_callout_tick(void)
 os_time_t
 os_callout_wakeup_ticks(os_time_t now)
 {
-    os_time_t rt;
-    struct os_callout *c;
-
     OS_ASSERT_CRITICAL();
 
-    c = TAILQ_FIRST(&g_callout_list);
-    if (c != NULL) {
-        if (OS_TIME_TICK_GEQ(c->c_ticks, now)) {
-            rt = c->c_ticks - now;
-        } else {
-            rt = 0;     /* callout time is in the past */
-        }
-    } else {
-        rt = OS_TIMEOUT_NEVER;
-    }
-
-    return (rt);
+    return os_callout_first_ticks(now);
 }
 
 
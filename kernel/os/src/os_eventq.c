@@ -24,14 +24,124 @@
 #define OS_TRACE_DISABLE_FILE_API
 #endif
 #include "os/mynewt.h"
+#include "os_priv.h"
 
 static struct os_eventq os_eventq_main;
 
+#if MYNEWT_VAL(OS_EVENTQ_STATS)
+static STAILQ_HEAD(, os_eventq) os_eventq_list =
+    STAILQ_HEAD_INITIALIZER(os_eventq_list);
+
+static void
+os_eventq_stats_put(struct os_eventq *evq, struct os_event *ev)
+{
+    struct os_eventq_stats *es;
+
+    es = &evq->evq_stats;
+    ev->ev_enq_time = os_cputime_get32();
+    es->es_puts++;
+    es->es_depth++;
+    if (es->es_depth > es->es_max_depth) {
+        es->es_max_depth = es->es_depth;
+    }
+}
+
+static void
+os_eventq_stats_get(struct os_eventq *evq, struct os_event *ev)
+{
+    struct os_eventq_stats *es;
+    uint32_t wait;
+    int bucket;
+
+    es = &evq->evq_stats;
+    es->es_depth--;
+
+    wait = os_cputime_get32() - ev->ev_enq_time;
+    if (wait > es->es_max_wait) {
+        es->es_max_wait = wait;
+    }
+    if (wait == 0) {
+        bucket = 0;
+    } else {
+        bucket = 32 - __builtin_clz(wait);
+        if (bucket >= OS_EVENTQ_WAIT_HIST_BUCKETS) {
+            bucket = OS_EVENTQ_WAIT_HIST_BUCKETS - 1;
+        }
+    }
+    es->es_wait_hist[bucket]++;
+}
+
+void
+os_eventq_stats_unlink(struct os_eventq *evq)
+{
+    struct os_eventq *cur;
+    os_sr_t sr;
+
+    OS_ENTER_CRITICAL(sr);
+    STAILQ_FOREACH(cur, &os_eventq_list, evq_stats_next) {
+        if (cur == evq) {
+            STAILQ_REMOVE(&os_eventq_list, evq, os_eventq, evq_stats_next);
+            break;
+        }
+    }
+    OS_EXIT_CRITICAL(sr);
+}
+#else
+#define os_eventq_stats_put(evq, ev)
+#define os_eventq_stats_get(evq, ev)
+#endif
+
+/*
+ * Events taken off a queue by os_eventq_run_n().  An event is waiting in the
+ * batch from orb_pos on; its ev_queued stays set until the event is claimed
+ * by moving orb_pos past it.  Nested calls on the same queue link their
+ * batches through orb_outer.
+ */
+struct os_eventq_run_batch {
+    struct os_event *orb_ev[MYNEWT_VAL(OS_EVENTQ_RUN_N_BATCH)];
+    uint16_t orb_pos;
+    uint16_t orb_cnt;
+    struct os_eventq_run_batch *orb_outer;
+};
+
+/*
+ * Returns the slot of an event waiting in a batch os_eventq_run_n() is
+ * running, or NULL.  Must be called with interrupts disabled.
+ */
+static struct os_event **
+os_eventq_run_slot(struct os_eventq *evq, struct os_event *ev)
+{
+    struct os_eventq_run_batch *orb;
+    int i;
+
+    for (orb = evq->evq_run_batch; orb != NULL; orb = orb->orb_outer) {
+        for (i = orb->orb_pos; i < orb->orb_cnt; i++) {
+            if (orb->orb_ev[i] == ev) {
+                return &orb->orb_ev[i];
+            }
+        }
+    }
+    return NULL;
+}
+
 void
 os_eventq_init(struct os_eventq *evq)
 {
+#if MYNEWT_VAL(OS_EVENTQ_STATS)
+    os_sr_t sr;
+
+    /* The queue may be re-initialized; don't link it in twice. */
+    OS_ENTER_CRITICAL(sr);
+    os_eventq_stats_unlink(evq);
+#endif
+
     memset(evq, 0, sizeof(*evq));
     STAILQ_INIT(&evq->evq_list);
+
+#if MYNEWT_VAL(OS_EVENTQ_STATS)
+    STAILQ_INSERT_TAIL(&os_eventq_list, evq, evq_stats_next);
+    OS_EXIT_CRITICAL(sr);
+#endif
 }
 
 int
@@ -52,7 +162,7 @@ os_eventq_put(struct os_eventq *evq, struct os_event *ev)
 
     OS_ENTER_CRITICAL(sr);
 
-    /* Do not queue if already queued */
+    /* Do not queue if already queued, or waiting to be run */
     if (OS_EVENT_QUEUED(ev)) {
         OS_EXIT_CRITICAL(sr);
         os_trace_api_ret(OS_TRACE_ID_EVENTQ_PUT);
@@ -62,6 +172,7 @@ os_eventq_put(struct os_eventq *evq, struct os_event *ev)
     /* Queue the event */
     ev->ev_queued = 1;
     STAILQ_INSERT_TAIL(&evq->evq_list, ev, ev_next);
+    os_eventq_stats_put(evq, ev);
 
     resched = 0;
     if (evq->evq_task) {
@@ -92,14 +203,24 @@ struct os_event *
 os_eventq_get_no_wait(struct os_eventq *evq)
 {
     struct os_event *ev;
+#if MYNEWT_VAL(OS_EVENTQ_STATS)
+    os_sr_t sr;
+#endif
 
     os_trace_api_u32(OS_TRACE_ID_EVENTQ_GET_NO_WAIT, (uint32_t)evq);
 
+#if MYNEWT_VAL(OS_EVENTQ_STATS)
+    OS_ENTER_CRITICAL(sr);
+#endif
     ev = STAILQ_FIRST(&evq->evq_list);
     if (ev) {
         STAILQ_REMOVE(&evq->evq_list, ev, os_event, ev_next);
         ev->ev_queued = 0;
+        os_eventq_stats_get(evq, ev);
     }
+#if MYNEWT_VAL(OS_EVENTQ_STATS)
+    OS_EXIT_CRITICAL(sr);
+#endif
 
     os_trace_api_ret_u32(OS_TRACE_ID_EVENTQ_GET_NO_WAIT, (uint32_t)ev);
 
@@ -133,6 +254,7 @@ pull_one:
     if (ev) {
         STAILQ_REMOVE(&evq->evq_list, ev, os_event, ev_next);
         ev->ev_queued = 0;
+        os_eventq_stats_get(evq, ev);
         t->t_flags &= ~OS_TASK_FLAG_EVQ_WAIT;
     } else {
         evq->evq_task = t;
@@ -179,16 +301,14 @@ os_eventq_mon_find(struct os_eventq *evq, struct os_event *ev)
 }
 #endif
 
-void
-os_eventq_run(struct os_eventq *evq)
+static void
+os_eventq_run_ev(struct os_eventq *evq, struct os_event *ev)
 {
-    struct os_event *ev;
 #if MYNEWT_VAL(OS_EVENTQ_MONITOR)
     struct os_eventq_mon *mon;
     uint32_t ticks;
 #endif
 
-    ev = os_eventq_get(evq);
     assert(ev->ev_cb != NULL);
 #if MYNEWT_VAL(OS_EVENTQ_MONITOR)
     ticks = os_cputime_get32();
@@ -215,6 +335,86 @@ os_eventq_run(struct os_eventq *evq)
 #endif
 }
 
+void
+os_eventq_run(struct os_eventq *evq)
+{
+    struct os_event *ev;
+
+    ev = os_eventq_get(evq);
+    os_eventq_run_ev(evq, ev);
+}
+
+int
+os_eventq_run_n(struct os_eventq *evq, int max)
+{
+    struct os_eventq_run_batch orb;
+    struct os_event *ev;
+    os_sr_t sr;
+    int limit;
+    int cnt;
+    int i;
+
+    /* Wait for work, and make sure the calling task owns the queue. */
+    ev = os_eventq_get(evq);
+    os_eventq_run_ev(evq, ev);
+    cnt = 1;
+
+    limit = MYNEWT_VAL(OS_EVENTQ_RUN_N_BATCH);
+    if (max > 0 && max - 1 < limit) {
+        limit = max - 1;
+    }
+    if (limit == 0) {
+        return cnt;
+    }
+
+    /*
+     * Take what is pending now off the queue in one go.  The batch is
+     * published so that os_eventq_remove() can still find the events which
+     * have not been started.
+     */
+    orb.orb_cnt = 0;
+    OS_ENTER_CRITICAL(sr);
+    while (orb.orb_cnt < limit) {
+        ev = STAILQ_FIRST(&evq->evq_list);
+        if (ev == NULL) {
+            break;
+        }
+        STAILQ_REMOVE_HEAD(&evq->evq_list, ev_next);
+        os_eventq_stats_get(evq, ev);
+        orb.orb_ev[orb.orb_cnt++] = ev;
+    }
+    orb.orb_pos = 0;
+    orb.orb_outer = evq->evq_run_batch;
+    evq->evq_run_batch = &orb;
+    OS_EXIT_CRITICAL(sr);
+
+    /*
+     * os_eventq_remove() clears the slots of events which are not claimed
+     * yet.  Claiming an event and clearing its ev_queued is done with
+     * interrupts disabled, so it is never seen half done.
+     */
+    for (i = 0; i < orb.orb_cnt; i++) {
+        OS_ENTER_CRITICAL(sr);
+        orb.orb_pos = i + 1;
+        ev = orb.orb_ev[i];
+        if (ev != NULL) {
+            ev->ev_queued = 0;
+        }
+        OS_EXIT_CRITICAL(sr);
+
+        if (ev != NULL) {
+            os_eventq_run_ev(evq, ev);
+            cnt++;
+        }
+    }
+
+    OS_ENTER_CRITICAL(sr);
+    evq->evq_run_batch = orb.orb_outer;
+    OS_EXIT_CRITICAL(sr);
+
+    return cnt;
+}
+
 static struct os_event *
 os_eventq_poll_0timo(struct os_eventq **evq, int nevqs)
 {
@@ -233,6 +433,7 @@ os_eventq_poll_0timo(struct os_eventq **evq, int nevqs)
         if (ev) {
             STAILQ_REMOVE(&evq[i]->evq_list, ev, os_event, ev_next);
             ev->ev_queued = 0;
+            os_eventq_stats_get(evq[i], ev);
             break;
         }
     }
@@ -271,6 +472,7 @@ os_eventq_poll(struct os_eventq **evq, int nevqs, os_time_t timo)
         if (ev) {
             STAILQ_REMOVE(&evq[i]->evq_list, ev, os_event, ev_next);
             ev->ev_queued = 0;
+            os_eventq_stats_get(evq[i], ev);
             /* Reset the items that already have an evq task set. */
             for (j = 0; j < i; j++) {
                 evq[j]->evq_task = NULL;
@@ -302,6 +504,7 @@ os_eventq_poll(struct os_eventq **evq, int nevqs, os_time_t timo)
             if (ev) {
                 STAILQ_REMOVE(&evq[i]->evq_list, ev, os_event, ev_next);
                 ev->ev_queued = 0;
+                os_eventq_stats_get(evq[i], ev);
             }
         }
         evq[i]->evq_task = NULL;
@@ -317,13 +520,22 @@ has_event:
 void
 os_eventq_remove(struct os_eventq *evq, struct os_event *ev)
 {
+    struct os_event **slot;
     os_sr_t sr;
 
     os_trace_api_u32x2(OS_TRACE_ID_EVENTQ_REMOVE, (uint32_t)evq, (uint32_t)ev);
 
     OS_ENTER_CRITICAL(sr);
     if (OS_EVENT_QUEUED(ev)) {
-        STAILQ_REMOVE(&evq->evq_list, ev, os_event, ev_next);
+        slot = os_eventq_run_slot(evq, ev);
+        if (slot != NULL) {
+            *slot = NULL;
+        } else {
+            STAILQ_REMOVE(&evq->evq_list, ev, os_event, ev_next);
+#if MYNEWT_VAL(OS_EVENTQ_STATS)
+            evq->evq_stats.es_depth--;
+#endif
+        }
     }
     ev->ev_queued = 0;
     OS_EXIT_CRITICAL(sr);
@@ -337,6 +549,66 @@ os_eventq_dflt_get(void)
     return &os_eventq_main;
 }
 
+#if MYNEWT_VAL(OS_EVENTQ_STATS)
+struct os_eventq *
+os_eventq_info_get_next(struct os_eventq *evq, struct os_eventq_info *oei)
+{
+    struct os_eventq *cur;
+    os_sr_t sr;
+
+    OS_ENTER_CRITICAL(sr);
+
+    if (evq == NULL) {
+        cur = STAILQ_FIRST(&os_eventq_list);
+    } else {
+        cur = STAILQ_NEXT(evq, evq_stats_next);
+    }
+
+    if (cur != NULL) {
+        oei->oei_stats = cur->evq_stats;
+        oei->oei_owner[0] = '\0';
+        if (cur->evq_owner != NULL) {
+            strncat(oei->oei_owner, cur->evq_owner->t_name,
+                    sizeof(oei->oei_owner) - 1);
+        }
+    }
+
+    OS_EXIT_CRITICAL(sr);
+
+    return cur;
+}
+
+void
+os_eventq_stats_reset(struct os_eventq *evq)
+{
+    struct os_eventq_stats *es;
+    struct os_eventq *cur;
+    os_sr_t sr;
+
+    OS_ENTER_CRITICAL(sr);
+    STAILQ_FOREACH(cur, &os_eventq_list, evq_stats_next) {
+        if (evq != NULL && cur != evq) {
+            continue;
+        }
+        es = &cur->evq_stats;
+        es->es_max_depth = es->es_depth;
+        es->es_puts = 0;
+        es->es_max_wait = 0;
+        memset(es->es_wait_hist, 0, sizeof(es->es_wait_hist));
+    }
+    OS_EXIT_CRITICAL(sr);
+}
+#endif
+
+void
+os_eventq_module_init(void)
+{
+#if MYNEWT_VAL(OS_EVENTQ_STATS)
+    STAILQ_INIT(&os_eventq_list);
+#endif
+    os_eventq_init(&os_eventq_main);
+}
+
 /**
  * [DEPRECATED - packages should manually enqueue start events to the default
  * task instead of calling this function]
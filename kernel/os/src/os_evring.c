@@ -0,0 +1,119 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <assert.h>
+#include <string.h>
+#include "os/mynewt.h"
+
+/*
+ * The producer runs in interrupt context and the consumer in a task on the
+ * same core, so only the compiler must be kept from reordering the buffer
+ * access and the index update.
+ */
+#define OS_EVRING_BARRIER()     __asm__ volatile("" ::: "memory")
+
+static void
+os_evring_event_cb(struct os_event *ev)
+{
+    os_evring_drain(ev->ev_arg);
+}
+
+int
+os_evring_init(struct os_evring *er, struct os_eventq *evq,
+               struct os_event **buf, uint16_t size)
+{
+    if (evq == NULL || buf == NULL || size == 0 || (size & (size - 1))) {
+        return OS_EINVAL;
+    }
+
+    memset(er, 0, sizeof(*er));
+    er->er_ev.ev_cb = os_evring_event_cb;
+    er->er_ev.ev_arg = er;
+    er->er_evq = evq;
+    er->er_buf = buf;
+    er->er_size = size;
+
+    return OS_OK;
+}
+
+int
+os_evring_put(struct os_evring *er, struct os_event *ev)
+{
+    uint16_t head;
+
+    head = er->er_head;
+    if ((uint16_t)(head - er->er_tail) == er->er_size) {
+        er->er_drops++;
+        return OS_ENOMEM;
+    }
+
+    er->er_buf[head & (er->er_size - 1)] = ev;
+    OS_EVRING_BARRIER();
+    er->er_head = head + 1;
+
+    /* Only the first event of a burst needs to wake up the consumer. */
+    if (!er->er_posted) {
+        er->er_posted = 1;
+        os_eventq_put(er->er_evq, &er->er_ev);
+    }
+
+    return OS_OK;
+}
+
+struct os_event *
+os_evring_get(struct os_evring *er)
+{
+    struct os_event *ev;
+    uint16_t tail;
+
+    tail = er->er_tail;
+    if (tail == er->er_head) {
+        return NULL;
+    }
+
+    OS_EVRING_BARRIER();
+    ev = er->er_buf[tail & (er->er_size - 1)];
+    OS_EVRING_BARRIER();
+    er->er_tail = tail + 1;
+
+    return ev;
+}
+
+int
+os_evring_drain(struct os_evring *er)
+{
+    struct os_event *ev;
+    int cnt;
+
+    /*
+     * Clear the flag before looking at the ring; an event pushed after this
+     * point posts the drain event again, at worst causing an empty drain.
+     */
+    er->er_posted = 0;
+    OS_EVRING_BARRIER();
+
+    cnt = 0;
+    while ((ev = os_evring_get(er)) != NULL) {
+        assert(ev->ev_cb != NULL);
+        ev->ev_cb(ev);
+        cnt++;
+    }
+
+    return cnt;
+}
@@ -24,6 +24,25 @@
 static struct os_mutex os_malloc_mutex;
 #endif
 
+#if MYNEWT_VAL(OS_HEAP_TRACK)
+#define OS_HEAP_TRACK_SIZE_MAX  0xffffff
+
+/*
+ * Live allocations are kept in an open addressed hash table keyed by pointer,
+ * using linear probing.
+ */
+struct os_heap_track_entry {
+    void *ohte_ptr;
+    void *ohte_caller;
+    uint32_t ohte_size:24;
+    uint32_t ohte_prio:8;
+};
+
+static struct os_heap_track_entry
+    os_heap_track_tbl[MYNEWT_VAL(OS_HEAP_TRACK_ENTRIES)];
+static struct os_heap_stats os_heap_stats;
+#endif
+
 static void
 os_malloc_lock(void)
 {
@@ -50,6 +69,206 @@ os_malloc_unlock(void)
 #endif
 }
 
+#if MYNEWT_VAL(OS_HEAP_TRACK)
+static int
+os_heap_track_hash(const void *ptr)
+{
+    return (((uintptr_t)ptr >> 3) * 2654435761u) %
+           MYNEWT_VAL(OS_HEAP_TRACK_ENTRIES);
+}
+
+static int
+os_heap_track_find(const void *ptr)
+{
+    int i;
+    int n;
+
+    i = os_heap_track_hash(ptr);
+    for (n = 0; n < MYNEWT_VAL(OS_HEAP_TRACK_ENTRIES); n++) {
+        if (os_heap_track_tbl[i].ohte_ptr == ptr) {
+            return i;
+        }
+        if (os_heap_track_tbl[i].ohte_ptr == NULL) {
+            break;
+        }
+        i = (i + 1) % MYNEWT_VAL(OS_HEAP_TRACK_ENTRIES);
+    }
+
+    return -1;
+}
+
+static void
+os_heap_track_add(void *ptr, size_t size, void *caller)
+{
+    struct os_heap_track_entry *ohte;
+    struct os_task *t;
+    int i;
+
+    if (ptr == NULL) {
+        os_heap_stats.ohs_fails++;
+        return;
+    }
+
+    os_heap_stats.ohs_allocs++;
+    os_heap_stats.ohs_alloc_bytes += size;
+
+    if (os_heap_stats.ohs_cur_blocks == MYNEWT_VAL(OS_HEAP_TRACK_ENTRIES)) {
+        os_heap_stats.ohs_untracked++;
+        return;
+    }
+
+    i = os_heap_track_hash(ptr);
+    while (os_heap_track_tbl[i].ohte_ptr != NULL) {
+        i = (i + 1) % MYNEWT_VAL(OS_HEAP_TRACK_ENTRIES);
+    }
+
+    if (size > OS_HEAP_TRACK_SIZE_MAX) {
+        size = OS_HEAP_TRACK_SIZE_MAX;
+    }
+    t = os_sched_get_current_task();
+
+    ohte = &os_heap_track_tbl[i];
+    ohte->ohte_ptr = ptr;
+    ohte->ohte_caller = caller;
+    ohte->ohte_size = size;
+    ohte->ohte_prio = t != NULL ? t->t_prio : OS_IDLE_PRIO;
+
+    os_heap_stats.ohs_cur_bytes += size;
+    if (os_heap_stats.ohs_cur_bytes > os_heap_stats.ohs_peak_bytes) {
+        os_heap_stats.ohs_peak_bytes = os_heap_stats.ohs_cur_bytes;
+    }
+    os_heap_stats.ohs_cur_blocks++;
+    if (os_heap_stats.ohs_cur_blocks > os_heap_stats.ohs_peak_blocks) {
+        os_heap_stats.ohs_peak_blocks = os_heap_stats.ohs_cur_blocks;
+    }
+}
+
+static void
+os_heap_track_remove(void *ptr)
+{
+    int home;
+    int i;
+    int j;
+
+    os_heap_stats.ohs_frees++;
+
+    i = os_heap_track_find(ptr);
+    if (i < 0) {
+        /* Untracked, or allocated with plain malloc(). */
+        return;
+    }
+
+    os_heap_stats.ohs_cur_bytes -= os_heap_track_tbl[i].ohte_size;
+    os_heap_stats.ohs_cur_blocks--;
+
+    /*
+     * Shift following entries of the probe sequence back into the hole, so
+     * that lookups never stop early at an empty slot.
+     */
+    os_heap_track_tbl[i].ohte_ptr = NULL;
+    j = i;
+    while (1) {
+        j = (j + 1) % MYNEWT_VAL(OS_HEAP_TRACK_ENTRIES);
+        if (os_heap_track_tbl[j].ohte_ptr == NULL) {
+            break;
+        }
+        home = os_heap_track_hash(os_heap_track_tbl[j].ohte_ptr);
+        if (i <= j ? (i < home && home <= j) : (i < home || home <= j)) {
+            continue;
+        }
+        os_heap_track_tbl[i] = os_heap_track_tbl[j];
+        os_heap_track_tbl[j].ohte_ptr = NULL;
+        i = j;
+    }
+}
+
+void
+os_heap_stats_get(struct os_heap_stats *ohs)
+{
+    os_malloc_lock();
+    *ohs = os_heap_stats;
+    os_malloc_unlock();
+}
+
+void
+os_heap_stats_reset(void)
+{
+    os_malloc_lock();
+    os_heap_stats.ohs_peak_bytes = os_heap_stats.ohs_cur_bytes;
+    os_heap_stats.ohs_peak_blocks = os_heap_stats.ohs_cur_blocks;
+    os_heap_stats.ohs_allocs = 0;
+    os_heap_stats.ohs_frees = 0;
+    os_heap_stats.ohs_alloc_bytes = 0;
+    os_heap_stats.ohs_fails = 0;
+    os_heap_stats.ohs_untracked = 0;
+    os_malloc_unlock();
+}
+
+int
+os_heap_alloc_info_get_next(int idx, struct os_heap_alloc_info *ohai)
+{
+    struct os_heap_track_entry *ohte;
+
+    os_malloc_lock();
+    for (; idx >= 0 && idx < MYNEWT_VAL(OS_HEAP_TRACK_ENTRIES); idx++) {
+        ohte = &os_heap_track_tbl[idx];
+        if (ohte->ohte_ptr != NULL) {
+            ohai->ohai_ptr = ohte->ohte_ptr;
+            ohai->ohai_caller = ohte->ohte_caller;
+            ohai->ohai_size = ohte->ohte_size;
+            ohai->ohai_prio = ohte->ohte_prio;
+            os_malloc_unlock();
+            return idx + 1;
+        }
+    }
+    os_malloc_unlock();
+
+    return -1;
+}
+
+int
+os_heap_site_info_get_next(int idx, struct os_heap_site_info *ohsi)
+{
+    void *caller;
+    int i;
+
+    os_malloc_lock();
+    for (; idx >= 0 && idx < MYNEWT_VAL(OS_HEAP_TRACK_ENTRIES); idx++) {
+        if (os_heap_track_tbl[idx].ohte_ptr == NULL) {
+            continue;
+        }
+
+        /* Report each call site at its first entry in the table only. */
+        caller = os_heap_track_tbl[idx].ohte_caller;
+        for (i = 0; i < idx; i++) {
+            if (os_heap_track_tbl[i].ohte_ptr != NULL &&
+                os_heap_track_tbl[i].ohte_caller == caller) {
+                break;
+            }
+        }
+        if (i < idx) {
+            continue;
+        }
+
+        ohsi->ohsi_caller = caller;
+        ohsi->ohsi_blocks = 0;
+        ohsi->ohsi_bytes = 0;
+        for (i = idx; i < MYNEWT_VAL(OS_HEAP_TRACK_ENTRIES); i++) {
+            if (os_heap_track_tbl[i].ohte_ptr != NULL &&
+                os_heap_track_tbl[i].ohte_caller == caller) {
+                ohsi->ohsi_blocks++;
+                ohsi->ohsi_bytes += os_heap_track_tbl[i].ohte_size;
+            }
+        }
+        os_malloc_unlock();
+        return idx + 1;
+    }
+    os_malloc_unlock();
+
+    return -1;
+}
+#endif
+
 void *
 os_malloc(size_t size)
 {
@@ -57,6 +276,9 @@ os_malloc(size_t size)
 
     os_malloc_lock();
     ptr = malloc(size);
+#if MYNEWT_VAL(OS_HEAP_TRACK)
+    os_heap_track_add(ptr, size, __builtin_return_address(0));
+#endif
     os_malloc_unlock();
 
     return ptr;
@@ -66,6 +288,11 @@ void
 os_free(void *mem)
 {
     os_malloc_lock();
+#if MYNEWT_VAL(OS_HEAP_TRACK)
+    if (mem != NULL) {
+        os_heap_track_remove(mem);
+    }
+#endif
     free(mem);
     os_malloc_unlock();
 }
@@ -77,6 +304,15 @@ os_realloc(void *ptr, size_t size)
 
     os_malloc_lock();
     new_ptr = realloc(ptr, size);
+#if MYNEWT_VAL(OS_HEAP_TRACK)
+    /* A failed realloc() leaves the old block alone, unless size is 0. */
+    if (ptr != NULL && (new_ptr != NULL || size == 0)) {
+        os_heap_track_remove(ptr);
+    }
+    if (new_ptr != NULL || size != 0) {
+        os_heap_track_add(new_ptr, size, __builtin_return_address(0));
+    }
+#endif
     os_malloc_unlock();
 
     return new_ptr;
@@ -115,6 +115,9 @@ os_mbuf_pool_init(struct os_mbuf_pool *omp, struct os_mempool *mp,
 {
     omp->omp_databuf_len = buf_len - sizeof(struct os_mbuf);
     omp->omp_pool = mp;
+#if MYNEWT_VAL(MSYS_STATS)
+    memset(&omp->omp_stats, 0, sizeof(omp->omp_stats));
+#endif
 
     return (0);
 }
@@ -143,6 +146,10 @@ os_mbuf_get(struct os_mbuf_pool *omp, uint16_t leadingspace)
     om->om_len = 0;
     om->om_data = (&om->om_databuf[0] + leadingspace);
     om->om_omp = omp;
+#if MYNEWT_VAL(OS_MBUF_CLONE)
+    om->om_shared = NULL;
+    om->om_refcnt = 1;
+#endif
 
 done:
     os_trace_api_ret_u32(OS_TRACE_ID_MBUF_GET, (uint32_t)om);
@@ -182,6 +189,75 @@ done:
     return om;
 }
 
+#if MYNEWT_VAL(OS_MBUF_CLONE)
+/*
+ * Drops a reference to an mbuf's buffer.  The buffer goes back to its pool
+ * with the last reference.
+ */
+static int
+os_mbuf_unref(struct os_mbuf *om)
+{
+    uint16_t refcnt;
+    os_sr_t sr;
+
+    if (om->om_omp == NULL) {
+        return 0;
+    }
+
+    OS_ENTER_CRITICAL(sr);
+    assert(om->om_refcnt > 0);
+    refcnt = --om->om_refcnt;
+    OS_EXIT_CRITICAL(sr);
+
+    if (refcnt > 0) {
+        return 0;
+    }
+
+    return os_memblock_put(om->om_omp->omp_pool, om);
+}
+
+/*
+ * Gives an mbuf a private copy of its data if other mbufs reference the
+ * buffer the data lives in.
+ */
+static int
+os_mbuf_cow(struct os_mbuf *om)
+{
+    struct os_mbuf *owner;
+    struct os_mbuf *buf;
+    uint8_t *dst;
+
+    owner = OS_MBUF_BUF_OWNER(om);
+    if (owner->om_refcnt == 1) {
+        return 0;
+    }
+
+    if (om->om_shared != NULL && om->om_refcnt == 1 &&
+        om->om_omp->omp_databuf_len - om->om_pkthdr_len >= om->om_len) {
+
+        /* The data fits in this mbuf's own buffer, which is unused. */
+        buf = NULL;
+        dst = om->om_databuf + om->om_pkthdr_len;
+    } else {
+        /* The owner's pool is guaranteed to fit the data. */
+        buf = os_mbuf_get(owner->om_omp, 0);
+        if (buf == NULL) {
+            return OS_ENOMEM;
+        }
+        dst = buf->om_databuf;
+    }
+
+    memcpy(dst, om->om_data, om->om_len);
+    om->om_data = dst;
+    if (om->om_shared != NULL) {
+        os_mbuf_unref(om->om_shared);
+    }
+    om->om_shared = buf;
+
+    return 0;
+}
+#endif
+
 int
 os_mbuf_free(struct os_mbuf *om)
 {
@@ -189,12 +265,27 @@ os_mbuf_free(struct os_mbuf *om)
 
     os_trace_api_u32(OS_TRACE_ID_MBUF_FREE, (uint32_t)om);
 
+#if MYNEWT_VAL(OS_MBUF_CLONE)
+    if (om->om_shared != NULL) {
+        rc = os_mbuf_unref(om->om_shared);
+        if (rc != 0) {
+            goto done;
+        }
+        om->om_shared = NULL;
+    }
+
+    rc = os_mbuf_unref(om);
+    if (rc != 0) {
+        goto done;
+    }
+#else
     if (om->om_omp != NULL) {
         rc = os_memblock_put(om->om_omp->omp_pool, om);
         if (rc != 0) {
             goto done;
         }
     }
+#endif
 
     rc = 0;
 
@@ -408,6 +499,83 @@ err:
     return (NULL);
 }
 
+struct os_mbuf *
+os_mbuf_clone(struct os_mbuf *om, struct os_mbuf_pool *omp)
+{
+#if MYNEWT_VAL(OS_MBUF_CLONE)
+    struct os_mbuf *owner;
+    struct os_mbuf *head;
+    struct os_mbuf *copy;
+    struct os_mbuf *prev;
+    os_sr_t sr;
+
+    head = NULL;
+    prev = NULL;
+
+    for (; om != NULL; om = SLIST_NEXT(om, om_next)) {
+        if (head == NULL && OS_MBUF_IS_PKTHDR(om)) {
+            if (omp != NULL) {
+                copy = os_mbuf_get_pkthdr(omp, OS_MBUF_USRHDR_LEN(om));
+            } else {
+                copy = os_msys_get_pkthdr(0, OS_MBUF_USRHDR_LEN(om));
+            }
+            if (copy != NULL) {
+                _os_mbuf_copypkthdr(copy, om);
+            }
+        } else {
+            if (omp != NULL) {
+                copy = os_mbuf_get(omp, 0);
+            } else {
+                copy = os_msys_get(0, 0);
+            }
+        }
+        if (copy == NULL) {
+            os_mbuf_free_chain(head);
+            return NULL;
+        }
+
+        /* Reference the buffer the data lives in, not a clone of it. */
+        owner = OS_MBUF_BUF_OWNER(om);
+        OS_ENTER_CRITICAL(sr);
+        owner->om_refcnt++;
+        OS_EXIT_CRITICAL(sr);
+
+        copy->om_shared = owner;
+        copy->om_data = om->om_data;
+        copy->om_len = om->om_len;
+        copy->om_flags = om->om_flags;
+
+        if (prev != NULL) {
+            SLIST_NEXT(prev, om_next) = copy;
+        } else {
+            head = copy;
+        }
+        prev = copy;
+    }
+
+    return head;
+#else
+    return os_mbuf_dup(om);
+#endif
+}
+
+int
+os_mbuf_unshare(struct os_mbuf *om)
+{
+#if MYNEWT_VAL(OS_MBUF_CLONE)
+    int rc;
+
+    for (; om != NULL; om = SLIST_NEXT(om, om_next)) {
+        rc = os_mbuf_cow(om);
+        if (rc != 0) {
+            return rc;
+        }
+    }
+#endif
+
+    return 0;
+}
+
 struct os_mbuf *
 os_mbuf_off(const struct os_mbuf *om, int off, uint16_t *out_off)
 {
@@ -584,6 +752,136 @@ os_mbuf_cmpf(const struct os_mbuf *om, int off, const void *data, int len)
     }
 }
 
+void
+os_mbuf_cursor_init(struct os_mbuf_cursor *omc, struct os_mbuf *om)
+{
+    omc->omc_head = om;
+    omc->omc_om = om;
+    omc->omc_base = 0;
+}
+
+uint8_t *
+os_mbuf_cursor_seek(struct os_mbuf_cursor *omc, int off, int *out_len)
+{
+    struct os_mbuf *om;
+    int base;
+
+    if (off < 0) {
+        return NULL;
+    }
+
+    if (off < omc->omc_base || omc->omc_om == NULL) {
+        om = omc->omc_head;
+        base = 0;
+    } else {
+        om = omc->omc_om;
+        base = omc->omc_base;
+    }
+
+    while (om != NULL && off >= base + om->om_len) {
+        base += om->om_len;
+        om = SLIST_NEXT(om, om_next);
+    }
+
+    if (om == NULL) {
+        return NULL;
+    }
+
+    omc->omc_om = om;
+    omc->omc_base = base;
+
+    if (out_len != NULL) {
+        *out_len = base + om->om_len - off;
+    }
+    return om->om_data + (off - base);
+}
+
+int
+os_mbuf_cursor_copydata(struct os_mbuf_cursor *omc, int off, int len,
+                        void *dst)
+{
+    uint8_t *udst;
+    uint8_t *src;
+    int chunk_sz;
+
+    udst = dst;
+    while (len > 0) {
+        src = os_mbuf_cursor_seek(omc, off, &chunk_sz);
+        if (src == NULL) {
+            return -1;
+        }
+
+        chunk_sz = min(chunk_sz, len);
+        memcpy(udst, src, chunk_sz);
+
+        udst += chunk_sz;
+        off += chunk_sz;
+        len -= chunk_sz;
+    }
+
+    return 0;
+}
+
+int
+os_mbuf_cursor_cmpf(struct os_mbuf_cursor *omc, int off, const void *data,
+                    int len)
+{
+    const uint8_t *udata;
+    uint8_t *src;
+    int chunk_sz;
+    int rc;
+
+    udata = data;
+    while (len > 0) {
+        src = os_mbuf_cursor_seek(omc, off, &chunk_sz);
+        if (src == NULL) {
+            return INT_MAX;
+        }
+
+        chunk_sz = min(chunk_sz, len);
+        rc = memcmp(src, udata, chunk_sz);
+        if (rc != 0) {
+            return rc;
+        }
+
+        udata += chunk_sz;
+        off += chunk_sz;
+        len -= chunk_sz;
+    }
+
+    return 0;
+}
+
+int
+os_mbuf_to_iovec(struct os_mbuf *om, int off, int len,
+                 struct os_mbuf_iovec *iov, int iovcnt)
+{
+    struct os_mbuf_cursor omc;
+    uint8_t *src;
+    int chunk_sz;
+    int cnt;
+
+    os_mbuf_cursor_init(&omc, om);
+
+    cnt = 0;
+    while (len > 0 && cnt < iovcnt) {
+        src = os_mbuf_cursor_seek(&omc, off, &chunk_sz);
+        if (src == NULL) {
+            break;
+        }
+
+        chunk_sz = min(chunk_sz, len);
+        iov[cnt].iov_base = src;
+        iov[cnt].iov_len = chunk_sz;
+        cnt++;
+
+        off += chunk_sz;
+        len -= chunk_sz;
+    }
+
+    return cnt;
+}
+
 int
 os_mbuf_cmpm(const struct os_mbuf *om1, uint16_t offset1,
              const struct os_mbuf *om2, uint16_t offset2,
@@ -730,6 +1028,12 @@ os_mbuf_copyinto(struct os_mbuf *om, int off, const void *src, int len)
     while (1) {
         copylen = min(cur->om_len - cur_off, len);
         if (copylen > 0) {
+#if MYNEWT_VAL(OS_MBUF_CLONE)
+            rc = os_mbuf_cow(cur);
+            if (rc != 0) {
+                return rc;
+            }
+#endif
             memcpy(cur->om_data + cur_off, sptr, copylen);
             sptr += copylen;
             len -= copylen;
@@ -1026,6 +1330,11 @@ os_mbuf_widen(struct os_mbuf *om, uint16_t off, uint16_t len)
     }
     edge_om->om_len = sub_off;
 
+    /* The append may have chained another mbuf. */
+    while (SLIST_NEXT(prev, om_next) != NULL) {
+        prev = SLIST_NEXT(prev, om_next);
+    }
+
     /* Insert the gap into the chain. */
     SLIST_NEXT(prev, om_next) = SLIST_NEXT(edge_om, om_next);
     SLIST_NEXT(edge_om, om_next) = first_new;
@@ -1063,10 +1372,7 @@ os_mbuf_pack_chains(struct os_mbuf *m1, struct os_mbuf *m2)
     while (1) {
         /* If there is leading space in the mbuf, move data up */
         if (OS_MBUF_LEADINGSPACE(cur)) {
-            dptr = &cur->om_databuf[0];
-            if (OS_MBUF_IS_PKTHDR(cur)) {
-                dptr += cur->om_pkthdr_len;
-            }
+            dptr = cur->om_data - OS_MBUF_LEADINGSPACE(cur);
             memmove(dptr, cur->om_data, cur->om_len);
             cur->om_data = dptr;
         }
@@ -442,6 +442,193 @@ done:
     return ret;
 }
 
+#if MYNEWT_VAL(OS_MEMPOOL_CACHE)
+os_error_t
+os_mempool_cache_init(struct os_mempool_cache *mc, struct os_mempool *mp,
+                      uint16_t size, struct os_task *task)
+{
+    struct os_mempool_ext *mpe;
+    os_sr_t sr;
+
+    if ((mc == NULL) || (mp == NULL) || (size == 0)) {
+        return OS_INVALID_PARM;
+    }
+
+    /* Blocks put through a cache would bypass the put callback. */
+    if (mp->mp_flags & OS_MEMPOOL_F_EXT) {
+        mpe = (struct os_mempool_ext *)mp;
+        if (mpe->mpe_put_cb != NULL) {
+            return OS_INVALID_PARM;
+        }
+    }
+
+    memset(mc, 0, sizeof(*mc));
+    mc->mc_pool = mp;
+    mc->mc_size = size;
+    mc->mc_batch = (size + 1) / 2;
+    SLIST_INIT(&mc->mc_blocks);
+
+    if (task != NULL) {
+        mc->mc_task = task;
+        OS_ENTER_CRITICAL(sr);
+        SLIST_INSERT_HEAD(&task->t_mempool_caches, mc, mc_next);
+        OS_EXIT_CRITICAL(sr);
+    }
+
+    return OS_OK;
+}
+
+static void
+os_mempool_cache_refill(struct os_mempool_cache *mc)
+{
+    struct os_memblock *first;
+    struct os_memblock *last;
+    struct os_mempool *mp;
+    os_sr_t sr;
+    int cnt;
+
+    mp = mc->mc_pool;
+    last = NULL;
+
+    /* Unlink up to a batch of blocks from the head of the free list. */
+    OS_ENTER_CRITICAL(sr);
+    first = SLIST_FIRST(mp);
+    for (cnt = 0; cnt < mc->mc_batch && cnt < mp->mp_num_free; cnt++) {
+        last = (last == NULL) ? first : SLIST_NEXT(last, mb_next);
+    }
+    if (cnt > 0) {
+        SLIST_FIRST(mp) = SLIST_NEXT(last, mb_next);
+        mp->mp_num_free -= cnt;
+        if (mp->mp_min_free > mp->mp_num_free) {
+            mp->mp_min_free = mp->mp_num_free;
+        }
+    }
+    OS_EXIT_CRITICAL(sr);
+
+    if (cnt > 0) {
+        SLIST_NEXT(last, mb_next) = SLIST_FIRST(&mc->mc_blocks);
+        SLIST_FIRST(&mc->mc_blocks) = first;
+        mc->mc_cnt += cnt;
+        mc->mc_refills++;
+    }
+}
+
+static void
+os_mempool_cache_flush_n(struct os_mempool_cache *mc, int cnt)
+{
+    struct os_memblock *first;
+    struct os_memblock *last;
+    struct os_mempool *mp;
+    os_sr_t sr;
+    int i;
+
+    mp = mc->mc_pool;
+
+    /* Unlink the blocks from the cache, then splice them into the pool. */
+    first = SLIST_FIRST(&mc->mc_blocks);
+    last = first;
+    for (i = 1; i < cnt; i++) {
+        last = SLIST_NEXT(last, mb_next);
+    }
+    SLIST_FIRST(&mc->mc_blocks) = SLIST_NEXT(last, mb_next);
+    mc->mc_cnt -= cnt;
+
+    OS_ENTER_CRITICAL(sr);
+    SLIST_NEXT(last, mb_next) = SLIST_FIRST(mp);
+    SLIST_FIRST(mp) = first;
+    mp->mp_num_free += cnt;
+    OS_EXIT_CRITICAL(sr);
+
+    mc->mc_flushes++;
+}
+
+void *
+os_mempool_cache_get(struct os_mempool_cache *mc)
+{
+    struct os_memblock *block;
+
+    block = SLIST_FIRST(&mc->mc_blocks);
+    if (block == NULL) {
+        os_mempool_cache_refill(mc);
+        block = SLIST_FIRST(&mc->mc_blocks);
+        if (block == NULL) {
+            return NULL;
+        }
+    } else {
+        mc->mc_hits++;
+    }
+
+    SLIST_FIRST(&mc->mc_blocks) = SLIST_NEXT(block, mb_next);
+    mc->mc_cnt--;
+
+    os_mempool_poison_check(mc->mc_pool, block);
+    os_mempool_guard_check(mc->mc_pool, block);
+
+    return block;
+}
+
+os_error_t
+os_mempool_cache_put(struct os_mempool_cache *mc, void *block_addr)
+{
+    struct os_memblock *block;
+
+    if ((mc == NULL) || (block_addr == NULL)) {
+        return OS_INVALID_PARM;
+    }
+
+#if MYNEWT_VAL(OS_MEMPOOL_CHECK)
+    assert(os_memblock_from(mc->mc_pool, block_addr));
+
+    /* Check for duplicate free. */
+    SLIST_FOREACH(block, &mc->mc_blocks, mb_next) {
+        assert(block != (struct os_memblock *)block_addr);
+    }
+#endif
+
+    os_mempool_guard_check(mc->mc_pool, block_addr);
+    os_mempool_poison(mc->mc_pool, block_addr);
+
+    if (mc->mc_cnt >= mc->mc_size) {
+        os_mempool_cache_flush_n(mc, mc->mc_batch);
+    }
+
+    block = block_addr;
+    SLIST_NEXT(block, mb_next) = SLIST_FIRST(&mc->mc_blocks);
+    SLIST_FIRST(&mc->mc_blocks) = block;
+    mc->mc_cnt++;
+
+    return OS_OK;
+}
+
+void
+os_mempool_cache_flush(struct os_mempool_cache *mc)
+{
+    os_sr_t sr;
+
+    if (mc->mc_cnt > 0) {
+        os_mempool_cache_flush_n(mc, mc->mc_cnt);
+    }
+
+    if (mc->mc_task != NULL) {
+        OS_ENTER_CRITICAL(sr);
+        SLIST_REMOVE(&mc->mc_task->t_mempool_caches, mc, os_mempool_cache,
+                     mc_next);
+        OS_EXIT_CRITICAL(sr);
+        mc->mc_task = NULL;
+    }
+}
+
+void
+os_mempool_cache_task_flush(struct os_task *t)
+{
+    struct os_mempool_cache *mc;
+
+    while ((mc = SLIST_FIRST(&t->t_mempool_caches)) != NULL) {
+        os_mempool_cache_flush(mc);
+    }
+}
+#endif
+
 struct os_mempool *
 os_mempool_info_get_next(struct os_mempool *mp, struct os_mempool_info *omi)
 {
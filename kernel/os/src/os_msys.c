@@ -55,6 +55,12 @@ static struct os_mempool os_msys_2_mempool;
 static struct os_sanity_check os_msys_sc;
 #endif
 
+#if MYNEWT_VAL(MSYS_STATS)
+#define OS_MSYS_STATS_INC(omp, field)   ((omp)->omp_stats.field++)
+#else
+#define OS_MSYS_STATS_INC(omp, field)
+#endif
+
 int
 os_msys_register(struct os_mbuf_pool *new_pool)
 {
@@ -112,6 +118,56 @@ os_msys_find_pool(uint16_t dsize)
     return (pool);
 }
 
+static struct os_mbuf *
+os_msys_pool_get(struct os_mbuf_pool *pool, uint16_t len, int pkthdr)
+{
+    if (pkthdr) {
+        return os_mbuf_get_pkthdr(pool, len);
+    } else {
+        return os_mbuf_get(pool, len);
+    }
+}
+
+/**
+ * Allocates from the best fit pool.  If it is empty and MSYS_FALLBACK is
+ * enabled, falls back to the larger pools.
+ *
+ * @param pool                  The best fit pool.
+ * @param len                   Leading space, or user header length if
+ *                                  pkthdr is set.
+ * @param pkthdr                Whether to allocate a packet header mbuf.
+ */
+static struct os_mbuf *
+os_msys_get_fallback(struct os_mbuf_pool *pool, uint16_t len, int pkthdr)
+{
+    struct os_mbuf *m;
+#if MYNEWT_VAL(MSYS_FALLBACK)
+    struct os_mbuf_pool *alt;
+#endif
+
+    m = os_msys_pool_get(pool, len, pkthdr);
+    if (m != NULL) {
+        return m;
+    }
+    OS_MSYS_STATS_INC(pool, omps_miss);
+
+#if MYNEWT_VAL(MSYS_FALLBACK)
+    /* Pools are sorted by block size; all the following ones are larger. */
+    for (alt = STAILQ_NEXT(pool, omp_next);
+         alt != NULL;
+         alt = STAILQ_NEXT(alt, omp_next)) {
+
+        m = os_msys_pool_get(alt, len, pkthdr);
+        if (m != NULL) {
+            OS_MSYS_STATS_INC(alt, omps_fallback);
+            return m;
+        }
+    }
+#endif
+
+    OS_MSYS_STATS_INC(pool, omps_fail);
+    return NULL;
+}
 
 struct os_mbuf *
 os_msys_get(uint16_t dsize, uint16_t leadingspace)
@@ -132,7 +188,7 @@ os_msys_get(uint16_t dsize, uint16_t leadingspace)
         goto err;
     }
 
-    m = os_mbuf_get(pool, leadingspace);
+    m = os_msys_get_fallback(pool, leadingspace, 0);
     return (m);
 err:
     return (NULL);
@@ -160,7 +216,7 @@ os_msys_get_pkthdr(uint16_t dsize, uint16_t user_hdr_len)
         goto err;
     }
 
-    m = os_mbuf_get_pkthdr(pool, user_hdr_len);
+    m = os_msys_get_fallback(pool, user_hdr_len, 1);
     return (m);
 err:
     return (NULL);
@@ -194,6 +250,16 @@ os_msys_num_free(void)
     return total;
 }
 
+struct os_mbuf_pool *
+os_msys_pool_get_next(struct os_mbuf_pool *omp)
+{
+    if (omp == NULL) {
+        return STAILQ_FIRST(&g_msys_pool_list);
+    } else {
+        return STAILQ_NEXT(omp, omp_next);
+    }
+}
+
 #if OS_MSYS_SANITY_ENABLED
 
 /**
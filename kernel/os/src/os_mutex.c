@@ -22,8 +22,61 @@
 #if !MYNEWT_VAL(OS_SYSVIEW_TRACE_MUTEX)
 #define OS_TRACE_DISABLE_FILE_API
 #endif
+#include <string.h>
 #include "os/mynewt.h"
 
+#if MYNEWT_VAL(OS_MUTEX_STATS)
+static STAILQ_HEAD(, os_mutex) os_mutex_list =
+    STAILQ_HEAD_INITIALIZER(os_mutex_list);
+
+static void
+os_mutex_stats_acquired(struct os_mutex *mu)
+{
+    mu->mu_stats.ms_acquired++;
+    mu->mu_acq_time = os_cputime_get32();
+}
+
+static void
+os_mutex_stats_released(struct os_mutex *mu)
+{
+    uint32_t hold;
+
+    hold = os_cputime_get32() - mu->mu_acq_time;
+    if (hold > mu->mu_stats.ms_max_hold) {
+        mu->mu_stats.ms_max_hold = hold;
+    }
+}
+
+static void
+os_mutex_stats_waited(struct os_mutex *mu, uint32_t start)
+{
+    uint32_t wait;
+
+    wait = os_cputime_get32() - start;
+    mu->mu_stats.ms_total_wait += wait;
+    if (wait > mu->mu_stats.ms_max_wait) {
+        mu->mu_stats.ms_max_wait = wait;
+    }
+}
+
+/* Must be called with interrupts disabled. */
+static int
+os_mutex_stats_linked(const struct os_mutex *mu)
+{
+    struct os_mutex *cur;
+
+    STAILQ_FOREACH(cur, &os_mutex_list, mu_stats_next) {
+        if (cur == mu) {
+            return 1;
+        }
+    }
+    return 0;
+}
+#else
+#define os_mutex_stats_acquired(mu)
+#define os_mutex_stats_released(mu)
+#endif
+
 os_error_t
 os_mutex_init(struct os_mutex *mu)
 {
@@ -36,6 +89,12 @@ os_mutex_init(struct os_mutex *mu)
 
     os_trace_api_u32(OS_TRACE_ID_MUTEX_INIT, (uint32_t)mu);
 
+#if MYNEWT_VAL(OS_MUTEX_STATS)
+    /* A registered mutex stays registered when it is re-initialized. */
+    memset(&mu->mu_stats, 0, sizeof(mu->mu_stats));
+    mu->mu_init_caller = __builtin_return_address(0);
+#endif
+
     /* Initialize to 0 */
     mu->mu_prio = 0;
     mu->mu_level = 0;
@@ -90,6 +149,7 @@ os_mutex_release(struct os_mutex *mu)
 
     /* Decrement nesting level (this effectively sets nesting level to 0) */
     --mu->mu_level;
+    os_mutex_stats_released(mu);
 
     /* Restore owner task's priority; resort list if different  */
     if (current->t_prio != mu->mu_prio) {
@@ -107,6 +167,7 @@ os_mutex_release(struct os_mutex *mu)
         /* Set mutex internals */
         mu->mu_level = 1;
         mu->mu_prio = rdy->t_prio;
+        os_mutex_stats_acquired(mu);
     }
 
     /* Set new owner of mutex (or NULL if not owned) */
@@ -144,6 +205,9 @@ os_mutex_pend(struct os_mutex *mu, os_time_t timeout)
     struct os_task *current;
     struct os_task *entry;
     struct os_task *last;
+#if MYNEWT_VAL(OS_MUTEX_STATS)
+    uint32_t start;
+#endif
 
     os_trace_api_u32x2(OS_TRACE_ID_MUTEX_PEND, (uint32_t)mu, (uint32_t)timeout);
 
@@ -168,6 +232,7 @@ os_mutex_pend(struct os_mutex *mu, os_time_t timeout)
         mu->mu_prio  = current->t_prio;
         current->t_lockcnt++;
         mu->mu_level = 1;
+        os_mutex_stats_acquired(mu);
         OS_EXIT_CRITICAL(sr);
         ret = OS_OK;
         goto done;
@@ -181,8 +246,16 @@ os_mutex_pend(struct os_mutex *mu, os_time_t timeout)
         goto done;
     }
 
+#if MYNEWT_VAL(OS_MUTEX_STATS)
+    mu->mu_stats.ms_contended++;
+    start = os_cputime_get32();
+#endif
+
     /* Mutex is not owned by us. If timeout is 0, return immediately */
     if (timeout == 0) {
+#if MYNEWT_VAL(OS_MUTEX_STATS)
+        mu->mu_stats.ms_timeouts++;
+#endif
         OS_EXIT_CRITICAL(sr);
         ret = OS_TIMEOUT;
         goto done;
@@ -192,6 +265,9 @@ os_mutex_pend(struct os_mutex *mu, os_time_t timeout)
     if (mu->mu_owner->t_prio > current->t_prio) {
         mu->mu_owner->t_prio = current->t_prio;
         os_sched_resort(mu->mu_owner);
+#if MYNEWT_VAL(OS_MUTEX_STATS)
+        mu->mu_stats.ms_boosts++;
+#endif
     }
 
     /* Link current task to tasks waiting for mutex */
@@ -222,6 +298,12 @@ os_mutex_pend(struct os_mutex *mu, os_time_t timeout)
 
     OS_ENTER_CRITICAL(sr);
     current->t_flags &= ~OS_TASK_FLAG_MUTEX_WAIT;
+#if MYNEWT_VAL(OS_MUTEX_STATS)
+    os_mutex_stats_waited(mu, start);
+    if (mu->mu_owner != current) {
+        mu->mu_stats.ms_timeouts++;
+    }
+#endif
     OS_EXIT_CRITICAL(sr);
 
     /* If we are owner we did not time out. */
@@ -236,3 +318,80 @@ done:
     return ret;
 }
 
+#if MYNEWT_VAL(OS_MUTEX_STATS)
+void
+os_mutex_stats_register(struct os_mutex *mu, const char *name)
+{
+    os_sr_t sr;
+
+    OS_ENTER_CRITICAL(sr);
+    mu->mu_name = name;
+    if (!os_mutex_stats_linked(mu)) {
+        STAILQ_INSERT_TAIL(&os_mutex_list, mu, mu_stats_next);
+    }
+    OS_EXIT_CRITICAL(sr);
+}
+
+void
+os_mutex_stats_unlink(struct os_mutex *mu)
+{
+    os_sr_t sr;
+
+    OS_ENTER_CRITICAL(sr);
+    if (os_mutex_stats_linked(mu)) {
+        STAILQ_REMOVE(&os_mutex_list, mu, os_mutex, mu_stats_next);
+    }
+    OS_EXIT_CRITICAL(sr);
+}
+
+struct os_mutex *
+os_mutex_info_get_next(struct os_mutex *mu, struct os_mutex_info *omi)
+{
+    struct os_mutex *cur;
+    struct os_task *t;
+    os_sr_t sr;
+
+    OS_ENTER_CRITICAL(sr);
+
+    if (mu == NULL) {
+        cur = STAILQ_FIRST(&os_mutex_list);
+    } else {
+        cur = STAILQ_NEXT(mu, mu_stats_next);
+    }
+
+    if (cur != NULL) {
+        omi->omi_name = cur->mu_name;
+        omi->omi_init_caller = cur->mu_init_caller;
+        omi->omi_level = cur->mu_level;
+        omi->omi_owner_prio = 0;
+        if (cur->mu_level != 0) {
+            omi->omi_owner_prio = cur->mu_owner->t_prio;
+        }
+        omi->omi_waiters = 0;
+        SLIST_FOREACH(t, &cur->mu_head, t_obj_list) {
+            omi->omi_waiters++;
+        }
+        omi->omi_stats = cur->mu_stats;
+    }
+
+    OS_EXIT_CRITICAL(sr);
+
+    return cur;
+}
+
+void
+os_mutex_stats_reset(struct os_mutex *mu)
+{
+    struct os_mutex *cur;
+    os_sr_t sr;
+
+    OS_ENTER_CRITICAL(sr);
+    STAILQ_FOREACH(cur, &os_mutex_list, mu_stats_next) {
+        if (mu != NULL && cur != mu) {
+            continue;
+        }
+        memset(&cur->mu_stats, 0, sizeof(cur->mu_stats));
+    }
+    OS_EXIT_CRITICAL(sr);
+}
+#endif
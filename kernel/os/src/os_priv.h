@@ -37,8 +37,16 @@ extern struct os_task_list g_os_sleep_list;
 extern struct os_task_stailq g_os_task_list;
 extern struct os_callout_list g_callout_list;
 
+void os_callout_module_init(void);
+void os_eventq_module_init(void);
 void os_mempool_module_init(void);
+#if MYNEWT_VAL(OS_MEMPOOL_CACHE)
+void os_mempool_cache_task_flush(struct os_task *t);
+#endif
 void os_msys_init(void);
+#if MYNEWT_VAL(OS_TRACE_RAM)
+void os_trace_ram_init(void);
+#endif
 
 /**
  * Prints information about a crash to the console.  This functionality is
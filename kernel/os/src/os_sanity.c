@@ -196,6 +196,7 @@ os_sanity_init(void)
     if (rc != 0) {
         goto err;
     }
+    os_mutex_stats_register(&g_os_sanity_check_mu, "os_sanity");
 
     return (0);
 err:
@@ -18,6 +18,7 @@
  */
 
 #include <assert.h>
+#include <string.h>
 #include "os/mynewt.h"
 #include "os_priv.h"
 
@@ -29,6 +30,340 @@ struct os_task *g_current_task;
 extern os_time_t g_os_time;
 os_time_t g_os_last_ctx_sw_time;
 
+#if MYNEWT_VAL(OS_TASK_CPU_STATS)
+/* os_cputime of the last context switch */
+uint32_t g_os_last_cpu_sw_time;
+#endif
+
+#if MYNEWT_VAL(OS_SCHED_BITMAP)
+/*
+ * Ready bitmap scheduler.
+ *
+ * g_os_run_list is still kept sorted by priority (the context switch code
+ * picks the head of the list), but the insertion point is found using a
+ * bitmap of priorities which have ready tasks and a pointer to the last
+ * ready task of each priority.  Tasks of the same priority form a FIFO
+ * segment of the run list.  Bit (p % 32) of word (p / 32) is set if
+ * priority p has at least one ready task; bit n of the group mask is set if
+ * word n is non-zero.
+ */
+#define OS_SCHED_PRIO_WORDS     (256 / 32)
+
+static uint32_t os_sched_prio_map[OS_SCHED_PRIO_WORDS];
+static uint8_t os_sched_prio_grp;
+static struct os_task *os_sched_prio_tail[256];
+
+static inline int
+os_sched_msb(uint32_t val)
+{
+    return 31 - __builtin_clz(val);
+}
+
+/*
+ * Returns the highest numbered priority less than or equal to 'prio' which
+ * has ready tasks, or -1 if there is no such priority.
+ */
+static int
+os_sched_prio_find_leq(uint8_t prio)
+{
+    uint32_t word;
+    uint32_t grp;
+    int idx;
+    int bit;
+
+    idx = prio >> 5;
+    bit = prio & 31;
+
+    word = os_sched_prio_map[idx];
+    if (bit != 31) {
+        word &= (1UL << (bit + 1)) - 1;
+    }
+    if (word) {
+        return (idx << 5) + os_sched_msb(word);
+    }
+
+    grp = os_sched_prio_grp & ((1UL << idx) - 1);
+    if (!grp) {
+        return -1;
+    }
+    idx = os_sched_msb(grp);
+
+    return (idx << 5) + os_sched_msb(os_sched_prio_map[idx]);
+}
+
+static void
+os_sched_ready_insert(struct os_task *t)
+{
+    int prio;
+
+    prio = os_sched_prio_find_leq(t->t_prio);
+    if (prio < 0) {
+        TAILQ_INSERT_HEAD(&g_os_run_list, t, t_os_list);
+    } else {
+        TAILQ_INSERT_AFTER(&g_os_run_list, os_sched_prio_tail[prio], t,
+                           t_os_list);
+    }
+
+    t->t_sched_prio = t->t_prio;
+    os_sched_prio_tail[t->t_prio] = t;
+    os_sched_prio_map[t->t_prio >> 5] |= 1UL << (t->t_prio & 31);
+    os_sched_prio_grp |= 1 << (t->t_prio >> 5);
+}
+
+static void
+os_sched_ready_remove(struct os_task *t)
+{
+    struct os_task *prev;
+    uint8_t prio;
+
+    /*
+     * Priority might have been changed while the task was in the run list
+     * (see os_sched_resort()); use the one the task was inserted with.
+     */
+    prio = t->t_sched_prio;
+    if (os_sched_prio_tail[prio] == t) {
+        prev = TAILQ_PREV(t, os_task_list, t_os_list);
+        if (prev && prev->t_sched_prio == prio) {
+            os_sched_prio_tail[prio] = prev;
+        } else {
+            os_sched_prio_tail[prio] = NULL;
+            os_sched_prio_map[prio >> 5] &= ~(1UL << (prio & 31));
+            if (!os_sched_prio_map[prio >> 5]) {
+                os_sched_prio_grp &= ~(1 << (prio >> 5));
+            }
+        }
+    }
+    TAILQ_REMOVE(&g_os_run_list, t, t_os_list);
+}
+
+#else
+
+static void
+os_sched_ready_insert(struct os_task *t)
+{
+    struct os_task *entry;
+
+    TAILQ_FOREACH(entry, &g_os_run_list, t_os_list) {
+        if (t->t_prio < entry->t_prio) {
+            break;
+        }
+    }
+    if (entry) {
+        TAILQ_INSERT_BEFORE(entry, t, t_os_list);
+    } else {
+        TAILQ_INSERT_TAIL(&g_os_run_list, t, t_os_list);
+    }
+}
+
+static void
+os_sched_ready_remove(struct os_task *t)
+{
+    TAILQ_REMOVE(&g_os_run_list, t, t_os_list);
+}
+#endif
+
+#if MYNEWT_VAL(OS_SCHED_SLEEP_HEAP)
+/*
+ * Tasks sleeping with a timeout are kept in a pairing heap ordered by
+ * t_next_wakeup; g_os_sleep_list only holds tasks sleeping forever.
+ * Each node points to its leftmost child, to its right sibling, and either
+ * to its left sibling or, for the leftmost child, to its parent.
+ */
+static struct os_task *os_sched_sleep_heap;
+
+static struct os_task *
+os_sched_heap_meld(struct os_task *a, struct os_task *b)
+{
+    struct os_task *tmp;
+
+    /* On a tie the task already in the heap stays on top. */
+    if (OS_TIME_TICK_LT(b->t_next_wakeup, a->t_next_wakeup)) {
+        tmp = a;
+        a = b;
+        b = tmp;
+    }
+
+    b->t_heap_prev = a;
+    b->t_heap_next = a->t_heap_child;
+    if (b->t_heap_next) {
+        b->t_heap_next->t_heap_prev = b;
+    }
+    a->t_heap_child = b;
+
+    return a;
+}
+
+/*
+ * Two-pass pairing of a sibling list, starting at 'first'.  Returns the new
+ * subtree root.
+ */
+static struct os_task *
+os_sched_heap_merge_pairs(struct os_task *first)
+{
+    struct os_task *pairs;
+    struct os_task *next;
+    struct os_task *a;
+    struct os_task *b;
+
+    /* Meld siblings pairwise left to right, collecting them in reverse. */
+    pairs = NULL;
+    while (first) {
+        a = first;
+        b = a->t_heap_next;
+        if (b) {
+            first = b->t_heap_next;
+            b->t_heap_next = NULL;
+            b->t_heap_prev = NULL;
+        } else {
+            first = NULL;
+        }
+        a->t_heap_next = NULL;
+        a->t_heap_prev = NULL;
+        if (b) {
+            a = os_sched_heap_meld(a, b);
+        }
+        a->t_heap_next = pairs;
+        pairs = a;
+    }
+
+    /* Meld the pairs right to left. */
+    a = NULL;
+    while (pairs) {
+        next = pairs->t_heap_next;
+        pairs->t_heap_next = NULL;
+        a = a ? os_sched_heap_meld(a, pairs) : pairs;
+        pairs = next;
+    }
+
+    return a;
+}
+
+static void
+os_sched_sleep_insert(struct os_task *t)
+{
+    if (t->t_flags & OS_TASK_FLAG_NO_TIMEOUT) {
+        TAILQ_INSERT_TAIL(&g_os_sleep_list, t, t_os_list);
+        return;
+    }
+
+    t->t_heap_child = NULL;
+    t->t_heap_next = NULL;
+    t->t_heap_prev = NULL;
+    if (os_sched_sleep_heap) {
+        os_sched_sleep_heap = os_sched_heap_meld(os_sched_sleep_heap, t);
+    } else {
+        os_sched_sleep_heap = t;
+    }
+}
+
+static void
+os_sched_sleep_remove(struct os_task *t)
+{
+    struct os_task *sub;
+
+    if (t->t_flags & OS_TASK_FLAG_NO_TIMEOUT) {
+        TAILQ_REMOVE(&g_os_sleep_list, t, t_os_list);
+        return;
+    }
+
+    if (t == os_sched_sleep_heap) {
+        os_sched_sleep_heap = os_sched_heap_merge_pairs(t->t_heap_child);
+        return;
+    }
+
+    /* Unlink from the sibling list, then meld the children back in. */
+    if (t->t_heap_prev->t_heap_child == t) {
+        t->t_heap_prev->t_heap_child = t->t_heap_next;
+    } else {
+        t->t_heap_prev->t_heap_next = t->t_heap_next;
+    }
+    if (t->t_heap_next) {
+        t->t_heap_next->t_heap_prev = t->t_heap_prev;
+    }
+
+    sub = os_sched_heap_merge_pairs(t->t_heap_child);
+    if (sub) {
+        os_sched_sleep_heap = os_sched_heap_meld(os_sched_sleep_heap, sub);
+    }
+}
+
+/*
+ * Returns the sleeping task with the earliest wakeup time, or NULL if no
+ * task is sleeping with a timeout.
+ */
+static struct os_task *
+os_sched_sleep_first(void)
+{
+    return os_sched_sleep_heap;
+}
+
+#else
+
+static void
+os_sched_sleep_insert(struct os_task *t)
+{
+    struct os_task *entry;
+
+    if (t->t_flags & OS_TASK_FLAG_NO_TIMEOUT) {
+        TAILQ_INSERT_TAIL(&g_os_sleep_list, t, t_os_list);
+        return;
+    }
+
+    TAILQ_FOREACH(entry, &g_os_sleep_list, t_os_list) {
+        if ((entry->t_flags & OS_TASK_FLAG_NO_TIMEOUT) ||
+                OS_TIME_TICK_GT(entry->t_next_wakeup, t->t_next_wakeup)) {
+            break;
+        }
+    }
+    if (entry) {
+        TAILQ_INSERT_BEFORE(entry, t, t_os_list);
+    } else {
+        TAILQ_INSERT_TAIL(&g_os_sleep_list, t, t_os_list);
+    }
+}
+
+static void
+os_sched_sleep_remove(struct os_task *t)
+{
+    TAILQ_REMOVE(&g_os_sleep_list, t, t_os_list);
+}
+
+static struct os_task *
+os_sched_sleep_first(void)
+{
+    struct os_task *t;
+
+    t = TAILQ_FIRST(&g_os_sleep_list);
+    if (t && (t->t_flags & OS_TASK_FLAG_NO_TIMEOUT)) {
+        t = NULL;
+    }
+
+    return t;
+}
+#endif
+
+/**
+ * os sched init
+ *
+ * Empties the run and sleep lists.  Only needed when the OS is restarted
+ * (e.g. by the simulator between unit tests); the lists are statically
+ * initialized otherwise.
+ */
+void
+os_sched_init(void)
+{
+    TAILQ_INIT(&g_os_run_list);
+    TAILQ_INIT(&g_os_sleep_list);
+#if MYNEWT_VAL(OS_SCHED_BITMAP)
+    memset(os_sched_prio_map, 0, sizeof os_sched_prio_map);
+    memset(os_sched_prio_tail, 0, sizeof os_sched_prio_tail);
+    os_sched_prio_grp = 0;
+#endif
+#if MYNEWT_VAL(OS_SCHED_SLEEP_HEAP)
+    os_sched_sleep_heap = NULL;
+#endif
+}
+
 /**
  * os sched insert
  *
@@ -43,7 +378,6 @@ os_time_t g_os_last_ctx_sw_time;
 os_error_t
 os_sched_insert(struct os_task *t)
 {
-    struct os_task *entry;
     os_sr_t sr;
     os_error_t rc;
 
@@ -52,18 +386,11 @@ os_sched_insert(struct os_task *t)
         goto err;
     }
 
-    entry = NULL;
     OS_ENTER_CRITICAL(sr);
-    TAILQ_FOREACH(entry, &g_os_run_list, t_os_list) {
-        if (t->t_prio < entry->t_prio) {
-            break;
-        }
-    }
-    if (entry) {
-        TAILQ_INSERT_BEFORE(entry, (struct os_task *) t, t_os_list);
-    } else {
-        TAILQ_INSERT_TAIL(&g_os_run_list, (struct os_task *) t, t_os_list);
-    }
+#if MYNEWT_VAL(OS_TASK_CPU_STATS)
+    t->t_ready_time = os_cputime_get32();
+#endif
+    os_sched_ready_insert(t);
     OS_EXIT_CRITICAL(sr);
 
     return (0);
@@ -71,6 +398,38 @@ err:
     return (rc);
 }
 
+#if MYNEWT_VAL(OS_TASK_CPU_STATS)
+static void
+os_sched_cpu_stats_sw(struct os_task *next_t)
+{
+    struct os_task *cur;
+    uint32_t latency;
+    uint32_t now;
+
+    cur = g_current_task;
+    now = os_cputime_get32();
+    cur->t_cpu_time += (uint32_t)(now - g_os_last_cpu_sw_time);
+    g_os_last_cpu_sw_time = now;
+
+    if (next_t == cur) {
+        return;
+    }
+
+    if (cur->t_state == OS_TASK_READY) {
+        /* Still runnable; it is waiting for the CPU again from now on. */
+        cur->t_preempt_cnt++;
+        cur->t_ready_time = now;
+    } else {
+        cur->t_voluntary_cnt++;
+    }
+
+    latency = now - next_t->t_ready_time;
+    if (latency > next_t->t_max_ready_latency) {
+        next_t->t_max_ready_latency = latency;
+    }
+}
+#endif
+
 void
 os_sched_ctx_sw_hook(struct os_task *next_t)
 {
@@ -84,6 +443,9 @@ os_sched_ctx_sw_hook(struct os_task *next_t)
     for (i = 0; i < MYNEWT_VAL(OS_CTX_SW_STACK_GUARD); i++) {
         assert(stack[i] == OS_STACK_PATTERN);
     }
+#endif
+#if MYNEWT_VAL(OS_TASK_CPU_STATS)
+    os_sched_cpu_stats_sw(next_t);
 #endif
     next_t->t_ctx_sw_cnt++;
 #if MYNEWT_VAL(OS_TASK_RUN_TIME_CPUTIME)
@@ -148,29 +510,13 @@ os_sched(struct os_task *next_t)
 int
 os_sched_sleep(struct os_task *t, os_time_t nticks)
 {
-    struct os_task *entry;
-
-    entry = NULL;
-
-    TAILQ_REMOVE(&g_os_run_list, t, t_os_list);
+    os_sched_ready_remove(t);
     t->t_state = OS_TASK_SLEEP;
     t->t_next_wakeup = os_time_get() + nticks;
     if (nticks == OS_TIMEOUT_NEVER) {
         t->t_flags |= OS_TASK_FLAG_NO_TIMEOUT;
-        TAILQ_INSERT_TAIL(&g_os_sleep_list, t, t_os_list);
-    } else {
-        TAILQ_FOREACH(entry, &g_os_sleep_list, t_os_list) {
-            if ((entry->t_flags & OS_TASK_FLAG_NO_TIMEOUT) ||
-                    OS_TIME_TICK_GT(entry->t_next_wakeup, t->t_next_wakeup)) {
-                break;
-            }
-        }
-        if (entry) {
-            TAILQ_INSERT_BEFORE(entry, t, t_os_list);
-        } else {
-            TAILQ_INSERT_TAIL(&g_os_sleep_list, t, t_os_list);
-        }
     }
+    os_sched_sleep_insert(t);
 
     os_trace_task_stop_ready(t, OS_TASK_SLEEP);
     return (0);
@@ -194,9 +540,9 @@ os_sched_remove(struct os_task *t)
 {
 
     if (t->t_state == OS_TASK_SLEEP) {
-        TAILQ_REMOVE(&g_os_sleep_list, t, t_os_list);
+        os_sched_sleep_remove(t);
     } else if (t->t_state == OS_TASK_READY) {
-        TAILQ_REMOVE(&g_os_run_list, t, t_os_list);
+        os_sched_ready_remove(t);
     }
     t->t_next_wakeup = 0;
     t->t_flags |= OS_TASK_FLAG_NO_TIMEOUT;
@@ -236,10 +582,10 @@ os_sched_wakeup(struct os_task *t)
     }
 
     /* Remove task from sleep list */
+    os_sched_sleep_remove(t);
     t->t_state = OS_TASK_READY;
     t->t_next_wakeup = 0;
     t->t_flags &= ~OS_TASK_FLAG_NO_TIMEOUT;
-    TAILQ_REMOVE(&g_os_sleep_list, t, t_os_list);
     os_sched_insert(t);
 
     os_trace_task_start_ready(t);
@@ -260,7 +606,6 @@ void
 os_sched_os_timer_exp(void)
 {
     struct os_task *t;
-    struct os_task *next;
     os_time_t now;
     os_sr_t sr;
 
@@ -271,19 +616,12 @@ os_sched_os_timer_exp(void)
     /*
      * Wakeup any tasks that have their sleep timer expired
      */
-    t = TAILQ_FIRST(&g_os_sleep_list);
-    while (t) {
-        /* If task waiting forever, do not check next wakeup time */
-        if (t->t_flags & OS_TASK_FLAG_NO_TIMEOUT) {
-            break;
-        }
-        next = TAILQ_NEXT(t, t_os_list);
+    while ((t = os_sched_sleep_first()) != NULL) {
         if (OS_TIME_TICK_GEQ(now, t->t_next_wakeup)) {
             os_sched_wakeup(t);
         } else {
             break;
         }
-        t = next;
     }
 
     OS_EXIT_CRITICAL(sr);
@@ -301,8 +639,8 @@ os_sched_wakeup_ticks(os_time_t now)
 
     OS_ASSERT_CRITICAL();
 
-    t = TAILQ_FIRST(&g_os_sleep_list);
-    if (t == NULL || (t->t_flags & OS_TASK_FLAG_NO_TIMEOUT)) {
+    t = os_sched_sleep_first();
+    if (t == NULL) {
         rt = OS_TIMEOUT_NEVER;
     } else if (OS_TIME_TICK_GEQ(t->t_next_wakeup, now)) {
         rt = t->t_next_wakeup - now;
@@ -346,7 +684,7 @@ void
 os_sched_resort(struct os_task *t)
 {
     if (t->t_state == OS_TASK_READY) {
-        TAILQ_REMOVE(&g_os_run_list, t, t_os_list);
-        os_sched_insert(t);
+        os_sched_ready_remove(t);
+        os_sched_ready_insert(t);
     }
 }
@@ -171,6 +171,14 @@ os_task_remove(struct os_task *t)
     OS_ENTER_CRITICAL(sr);
     rc = os_sched_remove(t);
     OS_EXIT_CRITICAL(sr);
+
+#if MYNEWT_VAL(OS_MEMPOOL_CACHE)
+    /* The task can no longer use its caches; hand the blocks back. */
+    if (rc == OS_OK) {
+        os_mempool_cache_task_flush(t);
+    }
+#endif
+
     return rc;
 }
 
@@ -179,6 +187,9 @@ os_task_info_get(const struct os_task *task, struct os_task_info *oti)
 {
     os_stack_t *bottom;
     os_stack_t *top;
+#if MYNEWT_VAL(OS_TASK_CPU_STATS)
+    os_sr_t sr;
+#endif
 
     oti->oti_prio = task->t_prio;
     oti->oti_taskid = task->t_taskid;
@@ -197,6 +208,15 @@ os_task_info_get(const struct os_task *task, struct os_task_info *oti)
     oti->oti_stksize = task->t_stacksize;
     oti->oti_cswcnt = task->t_ctx_sw_cnt;
     oti->oti_runtime = task->t_run_time;
+#if MYNEWT_VAL(OS_TASK_CPU_STATS)
+    /* The 64-bit CPU time takes more than one load on 32-bit targets. */
+    OS_ENTER_CRITICAL(sr);
+    oti->oti_cputime = task->t_cpu_time;
+    oti->oti_preempt_cnt = task->t_preempt_cnt;
+    oti->oti_voluntary_cnt = task->t_voluntary_cnt;
+    oti->oti_max_ready_latency = task->t_max_ready_latency;
+    OS_EXIT_CRITICAL(sr);
+#endif
     oti->oti_last_checkin = task->t_sanity_check.sc_checkin_last;
     oti->oti_next_checkin = task->t_sanity_check.sc_checkin_last +
                             task->t_sanity_check.sc_checkin_itvl;
@@ -222,3 +242,46 @@ os_task_info_get_next(const struct os_task *prev, struct os_task_info *oti)
     return next;
 }
 
+#if MYNEWT_VAL(OS_TASK_CPU_STATS)
+int
+os_task_cpu_idle_pct(void)
+{
+    struct os_task *t;
+    uint64_t total;
+    uint64_t idle;
+    os_sr_t sr;
+
+    total = 0;
+    idle = 0;
+
+    OS_ENTER_CRITICAL(sr);
+    STAILQ_FOREACH(t, &g_os_task_list, t_os_task_list) {
+        total += t->t_cpu_time;
+        if (t == &g_idle_task) {
+            idle = t->t_cpu_time;
+        }
+    }
+    OS_EXIT_CRITICAL(sr);
+
+    if (total == 0) {
+        return 0;
+    }
+    return (int)(idle * 100 / total);
+}
+
+void
+os_task_cpu_stats_reset(void)
+{
+    struct os_task *t;
+    os_sr_t sr;
+
+    OS_ENTER_CRITICAL(sr);
+    STAILQ_FOREACH(t, &g_os_task_list, t_os_task_list) {
+        t->t_cpu_time = 0;
+        t->t_preempt_cnt = 0;
+        t->t_voluntary_cnt = 0;
+        t->t_max_ready_latency = 0;
+    }
+    OS_EXIT_CRITICAL(sr);
+}
+#endif
@@ -0,0 +1,305 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <string.h>
+#include "os/mynewt.h"
+#include "bsp/bsp.h"
+
+#if MYNEWT_VAL(OS_TASK_STACK_WATERMARK)
+
+#ifndef bssnz_t
+/* Without a no-init section the maxima only cover the current boot. */
+#define bssnz_t
+#endif
+
+#define OS_TASK_STACK_MAGIC         0x4d575453  /* "STWM" */
+
+/* Recommended stack sizes are rounded up to a multiple of this. */
+#define OS_TASK_STACK_ROUND         8
+
+#define OS_TASK_STACK_ENTRIES       MYNEWT_VAL(OS_TASK_STACK_WATERMARK_ENTRIES)
+
+struct os_task_stack_entry {
+    /* Hash of the task name; 0 marks a free entry. */
+    uint32_t otse_name_hash;
+    uint16_t otse_stksize;
+    uint16_t otse_hwm;
+    uint16_t otse_hwm_max;
+    uint16_t otse_pad;
+};
+
+/*
+ * High-water marks, kept across soft resets.  The table is only trusted if
+ * the magic and checksum match; otherwise it is cleared on first use.
+ */
+bssnz_t static struct {
+    uint32_t magic;
+    uint32_t cksum;
+    struct os_task_stack_entry entries[OS_TASK_STACK_ENTRIES];
+} os_task_stack_persist;
+
+static uint8_t os_task_stack_inited;
+
+/* Task whose stack is being scanned, and the next word to look at. */
+static struct os_task *os_task_stack_cur;
+static uint16_t os_task_stack_pos;
+
+static uint32_t
+os_task_stack_fnv(uint32_t hash, const uint8_t *data, int len)
+{
+    while (len-- > 0) {
+        hash ^= *data++;
+        hash *= 16777619;
+    }
+    return hash;
+}
+
+static uint32_t
+os_task_stack_cksum(void)
+{
+    return os_task_stack_fnv(2166136261u,
+                             (const uint8_t *)os_task_stack_persist.entries,
+                             sizeof(os_task_stack_persist.entries));
+}
+
+static uint32_t
+os_task_stack_name_hash(const char *name)
+{
+    uint32_t hash;
+
+    hash = os_task_stack_fnv(2166136261u, (const uint8_t *)name,
+                             strlen(name));
+    return hash != 0 ? hash : 1;
+}
+
+/* Must be called with interrupts disabled. */
+static void
+os_task_stack_init(void)
+{
+    int i;
+
+    if (os_task_stack_inited) {
+        return;
+    }
+    os_task_stack_inited = 1;
+
+    if (os_task_stack_persist.magic != OS_TASK_STACK_MAGIC ||
+        os_task_stack_persist.cksum != os_task_stack_cksum()) {
+        memset(&os_task_stack_persist, 0, sizeof(os_task_stack_persist));
+        os_task_stack_persist.magic = OS_TASK_STACK_MAGIC;
+    }
+
+    /* A new boot; only the maxima carry over. */
+    for (i = 0; i < OS_TASK_STACK_ENTRIES; i++) {
+        os_task_stack_persist.entries[i].otse_hwm = 0;
+    }
+    os_task_stack_persist.cksum = os_task_stack_cksum();
+}
+
+/*
+ * Finds or claims the entry for a task, keeping the table checksum valid.
+ * Must be called with interrupts disabled.
+ */
+static struct os_task_stack_entry *
+os_task_stack_entry_get(const struct os_task *t)
+{
+    struct os_task_stack_entry *free_otse;
+    struct os_task_stack_entry *otse;
+    uint32_t hash;
+    int i;
+
+    hash = os_task_stack_name_hash(t->t_name);
+    free_otse = NULL;
+    for (i = 0; i < OS_TASK_STACK_ENTRIES; i++) {
+        otse = &os_task_stack_persist.entries[i];
+        if (otse->otse_name_hash == hash) {
+            if (otse->otse_stksize != t->t_stacksize) {
+                otse->otse_stksize = t->t_stacksize;
+                os_task_stack_persist.cksum = os_task_stack_cksum();
+            }
+            return otse;
+        }
+        if (otse->otse_name_hash == 0 && free_otse == NULL) {
+            free_otse = otse;
+        }
+    }
+
+    if (free_otse != NULL) {
+        free_otse->otse_name_hash = hash;
+        free_otse->otse_stksize = t->t_stacksize;
+        os_task_stack_persist.cksum = os_task_stack_cksum();
+    }
+    return free_otse;
+}
+
+/*
+ * Returns the task to continue scanning, starting over from the first task
+ * if the current one has been removed.  Must be called with interrupts
+ * disabled.
+ */
+static struct os_task *
+os_task_stack_cur_get(void)
+{
+    struct os_task *t;
+
+    STAILQ_FOREACH(t, &g_os_task_list, t_os_task_list) {
+        if (t == os_task_stack_cur) {
+            return t;
+        }
+    }
+
+    os_task_stack_cur = STAILQ_FIRST(&g_os_task_list);
+    os_task_stack_pos = 0;
+    return os_task_stack_cur;
+}
+
+void
+os_task_stack_sample(void)
+{
+    struct os_task_stack_entry *otse;
+    struct os_task *t;
+    os_stack_t *bottom;
+    os_stack_t *end;
+    os_stack_t *p;
+    uint16_t used;
+    int budget;
+    os_sr_t sr;
+
+    budget = MYNEWT_VAL(OS_TASK_STACK_WATERMARK_SCAN_WORDS);
+    while (budget > 0) {
+        OS_ENTER_CRITICAL(sr);
+        os_task_stack_init();
+        t = os_task_stack_cur_get();
+        otse = t != NULL ? os_task_stack_entry_get(t) : NULL;
+        if (otse == NULL) {
+            OS_EXIT_CRITICAL(sr);
+            if (t == NULL) {
+                return;
+            }
+            /* No room to remember this task. */
+            goto next;
+        }
+
+        /*
+         * Only the part of the stack below the known high-water mark can
+         * change; scan it from the bottom for the first used word.
+         */
+        bottom = t->t_stackbottom;
+        end = bottom + t->t_stacksize - otse->otse_hwm;
+        OS_EXIT_CRITICAL(sr);
+
+        p = bottom + os_task_stack_pos;
+        while (p < end && budget > 0 && *p == OS_STACK_PATTERN) {
+            p++;
+            budget--;
+        }
+
+        if (p < end && *p == OS_STACK_PATTERN) {
+            /* Out of budget; resume here next time. */
+            os_task_stack_pos = p - bottom;
+            return;
+        }
+
+        if (p < end) {
+            used = bottom + t->t_stacksize - p;
+            OS_ENTER_CRITICAL(sr);
+            if (used > otse->otse_hwm) {
+                otse->otse_hwm = used;
+            }
+            if (used > otse->otse_hwm_max) {
+                otse->otse_hwm_max = used;
+            }
+            os_task_stack_persist.cksum = os_task_stack_cksum();
+            OS_EXIT_CRITICAL(sr);
+        }
+
+next:
+        OS_ENTER_CRITICAL(sr);
+        os_task_stack_cur = STAILQ_NEXT(t, t_os_task_list);
+        os_task_stack_pos = 0;
+        OS_EXIT_CRITICAL(sr);
+
+        if (os_task_stack_cur == NULL) {
+            /* All tasks covered; start over on the next call. */
+            return;
+        }
+    }
+}
+
+int
+os_task_stack_info_get_next(int idx, struct os_task_stack_info *otsi)
+{
+    struct os_task_stack_entry *otse;
+    struct os_task *t;
+    uint32_t size;
+    os_sr_t sr;
+
+    OS_ENTER_CRITICAL(sr);
+    os_task_stack_init();
+    for (; idx >= 0 && idx < OS_TASK_STACK_ENTRIES; idx++) {
+        otse = &os_task_stack_persist.entries[idx];
+        if (otse->otse_name_hash != 0) {
+            break;
+        }
+    }
+    if (idx < 0 || idx >= OS_TASK_STACK_ENTRIES) {
+        OS_EXIT_CRITICAL(sr);
+        return -1;
+    }
+
+    otsi->otsi_name = NULL;
+    otsi->otsi_name_hash = otse->otse_name_hash;
+    otsi->otsi_stksize = otse->otse_stksize;
+    otsi->otsi_hwm = otse->otse_hwm;
+    otsi->otsi_hwm_max = otse->otse_hwm_max;
+    STAILQ_FOREACH(t, &g_os_task_list, t_os_task_list) {
+        if (os_task_stack_name_hash(t->t_name) == otse->otse_name_hash) {
+            otsi->otsi_name = t->t_name;
+            break;
+        }
+    }
+    OS_EXIT_CRITICAL(sr);
+
+    size = otsi->otsi_hwm_max *
+           (100 + MYNEWT_VAL(OS_TASK_STACK_WATERMARK_MARGIN));
+    size = (size + 99) / 100;
+    size = (size + OS_TASK_STACK_ROUND - 1) & ~(OS_TASK_STACK_ROUND - 1);
+    otsi->otsi_recommended = size > UINT16_MAX ? UINT16_MAX : size;
+
+    return idx + 1;
+}
+
+void
+os_task_stack_reset(void)
+{
+    struct os_task_stack_entry *otse;
+    os_sr_t sr;
+    int i;
+
+    OS_ENTER_CRITICAL(sr);
+    os_task_stack_init();
+    for (i = 0; i < OS_TASK_STACK_ENTRIES; i++) {
+        otse = &os_task_stack_persist.entries[i];
+        otse->otse_hwm_max = otse->otse_hwm;
+    }
+    os_task_stack_persist.cksum = os_task_stack_cksum();
+    OS_EXIT_CRITICAL(sr);
+}
+
+#endif
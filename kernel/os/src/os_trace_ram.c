@@ -0,0 +1,299 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <string.h>
+#include "os/mynewt.h"
+#include "bsp/bsp.h"
+#include "os_priv.h"
+
+#if MYNEWT_VAL(OS_TRACE_RAM)
+
+#ifndef bssnz_t
+/* Without a no-init section the trace does not survive a reset. */
+#define bssnz_t
+#endif
+
+#define OS_TRACE_RAM_RECS           MYNEWT_VAL(OS_TRACE_RAM_RECORDS)
+
+#if (OS_TRACE_RAM_RECS & (OS_TRACE_RAM_RECS - 1)) != 0
+#error "OS_TRACE_RAM_RECORDS must be a power of two"
+#endif
+
+/*
+ * The trace buffer.  It is kept across soft resets, so that the events
+ * leading up to a crash can be read out after the reboot; a coredump also
+ * contains it, and a decoder can find it there by its magic.
+ */
+bssnz_t struct {
+    struct os_trace_ram_hdr hdr;
+    struct os_trace_ram_rec recs[OS_TRACE_RAM_RECS];
+} os_trace_ram;
+
+/*
+ * Whether records are being written.  Kept outside the buffer so that a
+ * stale header left over from before a reset is not written to before it
+ * has been checked.
+ */
+static uint8_t os_trace_ram_on;
+
+/*
+ * Set once a timestamp record has been written since recording started,
+ * and the deltas in later records can be resolved.
+ */
+static uint8_t os_trace_ram_synced;
+
+/* Set until the first timestamp record after boot has been written. */
+static uint8_t os_trace_ram_booted;
+
+static struct os_trace_ram_rec *
+os_trace_ram_next(void)
+{
+    struct os_trace_ram_rec *rec;
+
+    rec = &os_trace_ram.recs[os_trace_ram.hdr.oth_head &
+                             (OS_TRACE_RAM_RECS - 1)];
+    os_trace_ram.hdr.oth_head++;
+
+    return rec;
+}
+
+void
+os_trace_ram_record(uint8_t type, uint8_t id, uint32_t a0, uint32_t a1,
+                    uint32_t a2)
+{
+    struct os_trace_ram_rec *rec;
+    uint32_t now;
+    uint32_t dt;
+    os_sr_t sr;
+
+    if (!os_trace_ram_on) {
+        return;
+    }
+
+    /*
+     * The few stores below are done with interrupts disabled, as the
+     * SystemView backend does; this keeps the records in timestamp order
+     * without needing exclusive access instructions, which Cortex-M0 lacks.
+     */
+    OS_ENTER_CRITICAL(sr);
+
+    now = os_cputime_get32();
+    dt = now - os_trace_ram.hdr.oth_last_ts;
+    if (!os_trace_ram_synced || dt > UINT16_MAX) {
+        rec = os_trace_ram_next();
+        rec->otr_dt = 0;
+        rec->otr_type = OS_TRACE_RAM_T_TIME;
+        rec->otr_id = 0;
+        rec->otr_arg[0] = now;
+        rec->otr_arg[1] = os_trace_ram_booted;
+        rec->otr_arg[2] = 0;
+        os_trace_ram_synced = 1;
+        os_trace_ram_booted = 0;
+        dt = 0;
+    }
+    os_trace_ram.hdr.oth_last_ts = now;
+
+    rec = os_trace_ram_next();
+    rec->otr_dt = dt;
+    rec->otr_type = type;
+    rec->otr_id = id;
+    rec->otr_arg[0] = a0;
+    rec->otr_arg[1] = a1;
+    rec->otr_arg[2] = a2;
+
+    OS_EXIT_CRITICAL(sr);
+}
+
+void
+os_trace_ram_isr_enter(void)
+{
+    os_trace_ram_record(OS_TRACE_RAM_T_ISR_ENTER, 0, 0, 0, 0);
+}
+
+void
+os_trace_ram_isr_exit(void)
+{
+    os_trace_ram_record(OS_TRACE_RAM_T_ISR_EXIT, 0, 0, 0, 0);
+}
+
+void
+os_trace_ram_task_start_exec(const struct os_task *t)
+{
+    os_trace_ram_record(OS_TRACE_RAM_T_TASK_START_EXEC, 0,
+                        (uint32_t)(uintptr_t)t, t->t_prio, 0);
+}
+
+void
+os_trace_ram_start(void)
+{
+    os_sr_t sr;
+
+    OS_ENTER_CRITICAL(sr);
+    os_trace_ram_synced = 0;
+    os_trace_ram.hdr.oth_flags |= OS_TRACE_RAM_F_RUNNING;
+    os_trace_ram_on = 1;
+    OS_EXIT_CRITICAL(sr);
+}
+
+void
+os_trace_ram_stop(void)
+{
+    os_sr_t sr;
+
+    OS_ENTER_CRITICAL(sr);
+    os_trace_ram_on = 0;
+    os_trace_ram.hdr.oth_flags &= ~OS_TRACE_RAM_F_RUNNING;
+    OS_EXIT_CRITICAL(sr);
+}
+
+int
+os_trace_ram_running(void)
+{
+    return os_trace_ram_on;
+}
+
+void
+os_trace_ram_clear(void)
+{
+    os_sr_t sr;
+
+    OS_ENTER_CRITICAL(sr);
+    os_trace_ram.hdr.oth_head = 0;
+    os_trace_ram_synced = 0;
+    OS_EXIT_CRITICAL(sr);
+}
+
+static int
+os_trace_ram_task_cnt(void)
+{
+    struct os_task *t;
+    int cnt;
+
+    cnt = 0;
+    STAILQ_FOREACH(t, &g_os_task_list, t_os_task_list) {
+        cnt++;
+    }
+
+    return cnt;
+}
+
+uint32_t
+os_trace_ram_dump_size(void)
+{
+    return sizeof(os_trace_ram) + 2 * sizeof(uint32_t) +
+           os_trace_ram_task_cnt() * sizeof(struct os_trace_ram_task);
+}
+
+/*
+ * Fill in the part of the task table, as it appears in a dump, which
+ * starts at the given offset.
+ */
+static uint32_t
+os_trace_ram_dump_tasks(uint32_t off, uint8_t *dst, uint32_t len)
+{
+    struct os_trace_ram_task ott;
+    struct os_task *t;
+    uint32_t tbl_hdr[2];
+    uint32_t pos;
+    uint32_t cnt;
+    uint32_t n;
+
+    tbl_hdr[0] = OS_TRACE_RAM_TASK_MAGIC;
+    tbl_hdr[1] = os_trace_ram_task_cnt();
+
+    cnt = 0;
+    if (off < sizeof(tbl_hdr)) {
+        n = min(len, sizeof(tbl_hdr) - off);
+        memcpy(dst, (uint8_t *)tbl_hdr + off, n);
+        cnt += n;
+        off += n;
+    }
+
+    pos = sizeof(tbl_hdr);
+    STAILQ_FOREACH(t, &g_os_task_list, t_os_task_list) {
+        if (cnt == len) {
+            break;
+        }
+        if (off < pos + sizeof(ott)) {
+            memset(&ott, 0, sizeof(ott));
+            ott.ott_task = (uint32_t)(uintptr_t)t;
+            ott.ott_prio = t->t_prio;
+            strncpy(ott.ott_name, t->t_name, sizeof(ott.ott_name) - 1);
+
+            n = min(len - cnt, pos + sizeof(ott) - off);
+            memcpy(dst + cnt, (uint8_t *)&ott + (off - pos), n);
+            cnt += n;
+            off += n;
+        }
+        pos += sizeof(ott);
+    }
+
+    return cnt;
+}
+
+uint32_t
+os_trace_ram_dump_read(uint32_t off, void *dst, uint32_t len)
+{
+    uint32_t cnt;
+    uint32_t n;
+
+    cnt = 0;
+    if (off < sizeof(os_trace_ram)) {
+        n = min(len, sizeof(os_trace_ram) - off);
+        memcpy(dst, (uint8_t *)&os_trace_ram + off, n);
+        cnt += n;
+        off += n;
+    }
+    if (cnt < len) {
+        cnt += os_trace_ram_dump_tasks(off - sizeof(os_trace_ram),
+                                       (uint8_t *)dst + cnt, len - cnt);
+    }
+
+    return cnt;
+}
+
+void
+os_trace_ram_init(void)
+{
+    struct os_trace_ram_hdr *hdr;
+
+    hdr = &os_trace_ram.hdr;
+
+    /* Keep the records from before a reset if the header looks sane. */
+    if (hdr->oth_magic != OS_TRACE_RAM_MAGIC ||
+        hdr->oth_version != OS_TRACE_RAM_VERSION ||
+        hdr->oth_rec_size != sizeof(struct os_trace_ram_rec) ||
+        hdr->oth_num_recs != OS_TRACE_RAM_RECS) {
+
+        memset(hdr, 0, sizeof(*hdr));
+        hdr->oth_magic = OS_TRACE_RAM_MAGIC;
+        hdr->oth_version = OS_TRACE_RAM_VERSION;
+        hdr->oth_rec_size = sizeof(struct os_trace_ram_rec);
+        hdr->oth_num_recs = OS_TRACE_RAM_RECS;
+    }
+    hdr->oth_freq = MYNEWT_VAL(OS_CPUTIME_FREQ);
+    hdr->oth_flags &= ~OS_TRACE_RAM_F_RUNNING;
+    os_trace_ram_booted = 1;
+
+#if MYNEWT_VAL(OS_TRACE_RAM_AUTOSTART)
+    os_trace_ram_start();
+#endif
+}
+
+#endif
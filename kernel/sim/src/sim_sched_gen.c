@@ -76,6 +76,7 @@ sim_switch_tasks(void)
     os_sched_ctx_sw_hook(next_t);
 
     os_sched_set_current_task(next_t);
+    os_trace_task_start_exec(next_t);
 
     sf = (struct stack_frame *) next_t->t_stackptr;
     sim_longjmp(sf->sf_jb, 1);
@@ -121,6 +122,24 @@ sim_tick(void)
     }
 }
 
+/**
+ * Idle handling for the virtual clock.  Every task is idle, so nothing can
+ * happen until the next wakeup: advance OS time straight to it.  A request
+ * to idle for less than a tick advances time by a single tick, just like
+ * the real timer would.
+ */
+void
+sim_tick_virtual(os_time_t ticks)
+{
+    OS_ASSERT_CRITICAL();
+
+    if (ticks == 0) {
+        ticks = 1;
+    }
+    os_time_advance(ticks);
+}
+
+#if !MYNEWT_VAL(MCU_NATIVE_VIRTUAL_TIME)
 static void
 sim_start_timer(void)
 {
@@ -136,6 +155,7 @@ sim_start_timer(void)
     rc = setitimer(ITIMER_REAL, &it, NULL);
     assert(rc == 0);
 }
+#endif
 
 static void
 sim_stop_timer(void)
@@ -202,11 +222,17 @@ sim_os_start(void)
     OS_ENTER_CRITICAL(sr);
     assert(sr == 0);
 
-    /* Enable the interrupt sources */
+    /*
+     * Enable the interrupt sources.  The virtual clock has none; time is
+     * advanced by the idle task.
+     */
+#if !MYNEWT_VAL(MCU_NATIVE_VIRTUAL_TIME)
     sim_start_timer();
+#endif
 
     t = os_sched_next_task();
     os_sched_set_current_task(t);
+    os_trace_task_start_exec(t);
 
     g_os_started = 1;
 
@@ -235,8 +261,7 @@ sim_os_init(void)
     g_current_task = NULL;
 
     STAILQ_INIT(&g_os_task_list);
-    TAILQ_INIT(&g_os_run_list);
-    TAILQ_INIT(&g_os_sleep_list);
+    os_sched_init();
 
     sim_signals_init();
 
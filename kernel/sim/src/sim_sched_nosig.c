@@ -151,6 +151,13 @@ sig_handler_alrm(int sig)
     sigaddset(&suspsigs, sig);
 }
 
+#if MYNEWT_VAL(MCU_NATIVE_VIRTUAL_TIME)
+void
+sim_tick_idle(os_time_t ticks)
+{
+    sim_tick_virtual(ticks);
+}
+#else
 void
 sim_tick_idle(os_time_t ticks)
 {
@@ -200,6 +207,7 @@ sim_tick_idle(os_time_t ticks)
         assert(rc == 0);
     }
 }
+#endif
 
 void
 sim_signals_init(void)
@@ -162,6 +162,13 @@ static struct {
 
 #define NUMSIGS     (sizeof(signals)/sizeof(signals[0]))
 
+#if MYNEWT_VAL(MCU_NATIVE_VIRTUAL_TIME)
+void
+sim_tick_idle(os_time_t ticks)
+{
+    sim_tick_virtual(ticks);
+}
+#else
 void
 sim_tick_idle(os_time_t ticks)
 {
@@ -217,6 +224,7 @@ sim_tick_idle(os_time_t ticks)
         assert(rc == 0);
     }
 }
+#endif
 
 void
 sim_signals_init(void)
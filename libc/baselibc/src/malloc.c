@@ -8,8 +8,12 @@
 #include <stdlib.h>
 #include <assert.h>
 #include <stdint.h>
+#include "syscfg/syscfg.h"
 #include "malloc.h"
 
+/* See malloc_tlsf.c for the BASELIBC_MALLOC_TLSF implementation. */
+#if !MYNEWT_VAL(BASELIBC_MALLOC_TLSF)
+
 /* Both the arena list and the free memory list are double linked
    list with head node.  This the head node. Note that the arena list
    is sorted in order of address. */
@@ -274,3 +278,5 @@ void set_malloc_locking(malloc_lock_t lock, malloc_unlock_t unlock)
     else
         malloc_unlock = &malloc_unlock_nop;
 }
+
+#endif
@@ -0,0 +1,517 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * malloc_tlsf.c
+ *
+ * Two-level segregated fit malloc()/free()/realloc().
+ *
+ * Free blocks are kept in one list per size class.  The first level splits
+ * sizes by powers of two, the second level splits every power of two into
+ * TLSF_SL_COUNT equal classes; sizes below TLSF_SMALL_SIZE map linearly into
+ * the first row.  Two levels of bitmaps record which lists are non-empty,
+ * so finding a fitting block, splitting it and merging a freed block with
+ * its physical neighbours all take constant time, however fragmented the
+ * heap is.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include "syscfg/syscfg.h"
+
+#if MYNEWT_VAL(BASELIBC_MALLOC_TLSF)
+
+#define TLSF_SL_LOG2        4
+#define TLSF_SL_COUNT       (1 << TLSF_SL_LOG2)
+
+/*
+ * Block header.  The free list links are only valid in free blocks; in used
+ * blocks they are the first bytes of the payload.
+ */
+struct tlsf_block {
+    /* Physically preceding block; NULL for the first block of a region */
+    struct tlsf_block *prev_phys;
+    /* Size of the payload, with TLSF_F_FREE in the low bit */
+    size_t size;
+
+    struct tlsf_block *next_free;
+    struct tlsf_block *prev_free;
+};
+
+#define TLSF_F_FREE         1
+
+/* The header size is also the alignment of every block and payload. */
+#define TLSF_HDR_SIZE       offsetof(struct tlsf_block, next_free)
+#define TLSF_ALIGN          TLSF_HDR_SIZE
+#define TLSF_ALIGN_LOG2     (sizeof(void *) == 8 ? 4 : 3)
+#define TLSF_MIN_SIZE       (sizeof(struct tlsf_block) - TLSF_HDR_SIZE)
+
+#define TLSF_FL_SHIFT       (TLSF_SL_LOG2 + TLSF_ALIGN_LOG2)
+#define TLSF_SMALL_SIZE     ((size_t)1 << TLSF_FL_SHIFT)
+#define TLSF_FL_MAX         MYNEWT_VAL(BASELIBC_MALLOC_TLSF_MAX_LOG2)
+#define TLSF_FL_COUNT       (TLSF_FL_MAX - TLSF_FL_SHIFT + 1)
+
+/* No region, and hence no block, is larger than this. */
+#define TLSF_REGION_MAX     ((size_t)1 << TLSF_FL_MAX)
+
+static uint32_t tlsf_fl_bitmap;
+static uint32_t tlsf_sl_bitmap[TLSF_FL_COUNT];
+static struct tlsf_block *tlsf_lists[TLSF_FL_COUNT][TLSF_SL_COUNT];
+
+/* Sentinel at the end of the most recently added region, and its length */
+static struct tlsf_block *tlsf_tail;
+static size_t tlsf_tail_len;
+
+static size_t tlsf_free_bytes;
+
+static bool malloc_lock_nop() {return true;}
+static void malloc_unlock_nop() {}
+
+static malloc_lock_t malloc_lock = &malloc_lock_nop;
+static malloc_unlock_t malloc_unlock = &malloc_unlock_nop;
+
+static inline int
+tlsf_fls(size_t val)
+{
+    return 31 - __builtin_clz((uint32_t)val);
+}
+
+static inline size_t
+tlsf_size(const struct tlsf_block *b)
+{
+    return b->size & ~(size_t)TLSF_F_FREE;
+}
+
+static inline bool
+tlsf_is_free(const struct tlsf_block *b)
+{
+    return b->size & TLSF_F_FREE;
+}
+
+static inline void *
+tlsf_payload(struct tlsf_block *b)
+{
+    return (uint8_t *)b + TLSF_HDR_SIZE;
+}
+
+static inline struct tlsf_block *
+tlsf_block(void *ptr)
+{
+    return (struct tlsf_block *)((uint8_t *)ptr - TLSF_HDR_SIZE);
+}
+
+static inline struct tlsf_block *
+tlsf_next(struct tlsf_block *b)
+{
+    return (struct tlsf_block *)((uint8_t *)tlsf_payload(b) + tlsf_size(b));
+}
+
+/* Converts a request into a payload size. */
+static inline size_t
+tlsf_adjust(size_t size)
+{
+    size = (size + TLSF_ALIGN - 1) & ~(TLSF_ALIGN - 1);
+    if (size < TLSF_MIN_SIZE) {
+        size = TLSF_MIN_SIZE;
+    }
+
+    return size;
+}
+
+/* Rounds a size up to the smallest size of the next class. */
+static inline size_t
+tlsf_round(size_t size)
+{
+    size_t mask;
+
+    if (size >= TLSF_SMALL_SIZE) {
+        mask = ((size_t)1 << (tlsf_fls(size) - TLSF_SL_LOG2)) - 1;
+        size = (size + mask) & ~mask;
+    }
+
+    return size;
+}
+
+static void
+tlsf_mapping(size_t size, int *fl, int *sl)
+{
+    int f;
+
+    if (size < TLSF_SMALL_SIZE) {
+        *fl = 0;
+        *sl = size >> TLSF_ALIGN_LOG2;
+    } else {
+        f = tlsf_fls(size);
+        *fl = f - TLSF_FL_SHIFT + 1;
+        *sl = (size >> (f - TLSF_SL_LOG2)) ^ TLSF_SL_COUNT;
+    }
+}
+
+static void
+tlsf_insert(struct tlsf_block *b)
+{
+    struct tlsf_block **head;
+    int fl;
+    int sl;
+
+    tlsf_mapping(tlsf_size(b), &fl, &sl);
+    head = &tlsf_lists[fl][sl];
+
+    b->prev_free = NULL;
+    b->next_free = *head;
+    if (*head != NULL) {
+        (*head)->prev_free = b;
+    }
+    *head = b;
+
+    tlsf_fl_bitmap |= 1U << fl;
+    tlsf_sl_bitmap[fl] |= 1U << sl;
+
+    b->size |= TLSF_F_FREE;
+    tlsf_free_bytes += tlsf_size(b);
+}
+
+static void
+tlsf_remove(struct tlsf_block *b)
+{
+    int fl;
+    int sl;
+
+    tlsf_mapping(tlsf_size(b), &fl, &sl);
+
+    if (b->prev_free != NULL) {
+        b->prev_free->next_free = b->next_free;
+    } else {
+        tlsf_lists[fl][sl] = b->next_free;
+        if (b->next_free == NULL) {
+            tlsf_sl_bitmap[fl] &= ~(1U << sl);
+            if (tlsf_sl_bitmap[fl] == 0) {
+                tlsf_fl_bitmap &= ~(1U << fl);
+            }
+        }
+    }
+    if (b->next_free != NULL) {
+        b->next_free->prev_free = b->prev_free;
+    }
+
+    b->size &= ~(size_t)TLSF_F_FREE;
+    tlsf_free_bytes -= tlsf_size(b);
+}
+
+/* Finds a free block of at least size bytes; size must be adjusted. */
+static struct tlsf_block *
+tlsf_find(size_t size)
+{
+    uint32_t map;
+    int fl;
+    int sl;
+
+    size = tlsf_round(size);
+    if (size >= TLSF_REGION_MAX) {
+        return NULL;
+    }
+    tlsf_mapping(size, &fl, &sl);
+
+    map = tlsf_sl_bitmap[fl] & (~0U << sl);
+    if (map == 0) {
+        map = tlsf_fl_bitmap & (~0U << (fl + 1));
+        if (map == 0) {
+            return NULL;
+        }
+        fl = __builtin_ctz(map);
+        map = tlsf_sl_bitmap[fl];
+    }
+    sl = __builtin_ctz(map);
+
+    return tlsf_lists[fl][sl];
+}
+
+/* Merges a block which is not on a free list with its free neighbours. */
+static void
+tlsf_release(struct tlsf_block *b)
+{
+    struct tlsf_block *prev;
+    struct tlsf_block *next;
+
+    prev = b->prev_phys;
+    if (prev != NULL && tlsf_is_free(prev)) {
+        tlsf_remove(prev);
+        prev->size += TLSF_HDR_SIZE + tlsf_size(b);
+        b = prev;
+        tlsf_next(b)->prev_phys = b;
+    }
+
+    next = tlsf_next(b);
+    if (tlsf_is_free(next)) {
+        tlsf_remove(next);
+        b->size += TLSF_HDR_SIZE + tlsf_size(next);
+        tlsf_next(b)->prev_phys = b;
+    }
+
+    tlsf_insert(b);
+}
+
+/* Gives the tail of a used block back if it can form a block of its own. */
+static void
+tlsf_trim(struct tlsf_block *b, size_t size)
+{
+    struct tlsf_block *rest;
+    size_t cur;
+
+    cur = tlsf_size(b);
+    if (cur < size + sizeof(struct tlsf_block)) {
+        return;
+    }
+
+    rest = (struct tlsf_block *)((uint8_t *)tlsf_payload(b) + size);
+    rest->prev_phys = b;
+    rest->size = cur - size - TLSF_HDR_SIZE;
+    b->size = size;
+    tlsf_next(rest)->prev_phys = rest;
+
+    tlsf_release(rest);
+}
+
+/*
+ * Adds an aligned region to the heap.  A region which starts where the
+ * previous one ends (consecutive _sbrk() calls) extends it instead, so that
+ * blocks can merge across the boundary.
+ */
+static void
+tlsf_add_region(uint8_t *start, size_t len)
+{
+    struct tlsf_block *sentinel;
+    struct tlsf_block *b;
+
+    if (tlsf_tail != NULL && start == tlsf_payload(tlsf_tail) &&
+        len >= TLSF_HDR_SIZE + TLSF_MIN_SIZE &&
+        tlsf_tail_len + len <= TLSF_REGION_MAX) {
+
+        /* The old sentinel becomes the header of the new block. */
+        b = tlsf_tail;
+        b->size = len - TLSF_HDR_SIZE;
+        tlsf_tail_len += len;
+    } else {
+        if (len < 2 * TLSF_HDR_SIZE + TLSF_MIN_SIZE) {
+            return;
+        }
+        b = (struct tlsf_block *)start;
+        b->prev_phys = NULL;
+        b->size = len - 2 * TLSF_HDR_SIZE;
+        tlsf_tail_len = len;
+    }
+
+    /* A zero sized used block ends the region and is never merged. */
+    sentinel = tlsf_next(b);
+    sentinel->prev_phys = b;
+    sentinel->size = 0;
+    tlsf_tail = sentinel;
+
+    tlsf_release(b);
+}
+
+static void
+tlsf_add_block(void *buf, size_t size)
+{
+    uintptr_t start;
+    uintptr_t end;
+    size_t len;
+
+    start = ((uintptr_t)buf + TLSF_ALIGN - 1) & ~(uintptr_t)(TLSF_ALIGN - 1);
+    end = ((uintptr_t)buf + size) & ~(uintptr_t)(TLSF_ALIGN - 1);
+    if (end <= start) {
+        return;
+    }
+
+    while (start < end) {
+        len = end - start;
+        if (len > TLSF_REGION_MAX) {
+            len = TLSF_REGION_MAX;
+        }
+        tlsf_add_region((uint8_t *)start, len);
+        start += len;
+    }
+}
+
+void *malloc(size_t size)
+{
+    struct tlsf_block *b;
+    void *more_mem;
+    size_t req;
+    extern void *_sbrk(int incr);
+
+    if (size == 0 || size > TLSF_REGION_MAX) {
+        return NULL;
+    }
+
+    size = tlsf_adjust(size);
+    req = tlsf_round(size) + 2 * TLSF_HDR_SIZE;
+    if (req > TLSF_REGION_MAX) {
+        return NULL;
+    }
+
+    if (!malloc_lock())
+        return NULL;
+
+    b = tlsf_find(size);
+    if (b == NULL) {
+        more_mem = _sbrk(req);
+        if (more_mem != (void *)-1) {
+            tlsf_add_block(more_mem, req);
+            b = tlsf_find(size);
+        }
+    }
+    if (b != NULL) {
+        tlsf_remove(b);
+        tlsf_trim(b, size);
+    }
+
+    malloc_unlock();
+
+    return b != NULL ? tlsf_payload(b) : NULL;
+}
+
+/* Call this to give malloc some memory to allocate from */
+void add_malloc_block(void *buf, size_t size)
+{
+    if (!malloc_lock())
+        return;
+
+    tlsf_add_block(buf, size);
+
+    malloc_unlock();
+}
+
+void free(void *ptr)
+{
+    struct tlsf_block *b;
+
+    if (!ptr)
+        return;
+
+    b = tlsf_block(ptr);
+    assert(!tlsf_is_free(b));
+
+    if (!malloc_lock())
+        return;
+
+    tlsf_release(b);
+
+    malloc_unlock();
+}
+
+void *realloc(void *ptr, size_t size)
+{
+    struct tlsf_block *next;
+    struct tlsf_block *b;
+    void *newptr;
+    size_t cur;
+
+    if (!ptr)
+        return malloc(size);
+
+    if (size == 0) {
+        free(ptr);
+        return NULL;
+    }
+
+    /* A failed realloc() leaves the original block alone. */
+    if (size > TLSF_REGION_MAX)
+        return NULL;
+
+    size = tlsf_adjust(size);
+    b = tlsf_block(ptr);
+
+    if (!malloc_lock())
+        return NULL;
+
+    /* Grow in place by taking over a free successor. */
+    cur = tlsf_size(b);
+    next = tlsf_next(b);
+    if (cur < size && tlsf_is_free(next) &&
+        cur + TLSF_HDR_SIZE + tlsf_size(next) >= size) {
+
+        tlsf_remove(next);
+        b->size += TLSF_HDR_SIZE + tlsf_size(next);
+        tlsf_next(b)->prev_phys = b;
+        cur = tlsf_size(b);
+    }
+
+    if (cur >= size) {
+        tlsf_trim(b, size);
+        malloc_unlock();
+        return ptr;
+    }
+
+    malloc_unlock();
+
+    newptr = malloc(size);
+    if (newptr) {
+        memcpy(newptr, ptr, cur);
+        free(ptr);
+    }
+
+    return newptr;
+}
+
+void get_malloc_memory_status(size_t *free_bytes, size_t *largest_block)
+{
+    struct tlsf_block *b;
+    int fl;
+    int sl;
+
+    *free_bytes = 0;
+    *largest_block = 0;
+
+    if (!malloc_lock())
+        return;
+
+    *free_bytes = tlsf_free_bytes;
+
+    /* The largest block is in the highest non-empty class. */
+    if (tlsf_fl_bitmap != 0) {
+        fl = tlsf_fls(tlsf_fl_bitmap);
+        sl = tlsf_fls(tlsf_sl_bitmap[fl]);
+        for (b = tlsf_lists[fl][sl]; b != NULL; b = b->next_free) {
+            if (tlsf_size(b) > *largest_block) {
+                *largest_block = tlsf_size(b);
+            }
+        }
+    }
+
+    malloc_unlock();
+}
+
+void set_malloc_locking(malloc_lock_t lock, malloc_unlock_t unlock)
+{
+    if (lock)
+        malloc_lock = lock;
+    else
+        malloc_lock = &malloc_lock_nop;
+
+    if (unlock)
+        malloc_unlock = unlock;
+    else
+        malloc_unlock = &malloc_unlock_nop;
+}
+
+#endif
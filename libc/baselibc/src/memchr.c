@@ -4,15 +4,32 @@
 
 #include <stddef.h>
 #include <string.h>
+#include "memword.h"
 
 void *memchr(const void *s, int c, size_t n)
 {
 	const unsigned char *sp = s;
+	const memword_t *w;
+	memword_t k;
 
-	while (n--) {
-		if (*sp == (unsigned char)c)
+	c = (unsigned char)c;
+
+	for (; !MEMWORD_ALIGNED(sp) && n; sp++, n--) {
+		if (*sp == c)
+			return (void *)sp;
+	}
+
+	/* XOR turns matching bytes into zero bytes. */
+	k = MEMWORD_ONES * c;
+	w = (const memword_t *)sp;
+	for (; n >= MEMWORD_SIZE; w++, n -= MEMWORD_SIZE) {
+		if (MEMWORD_HASZERO(*w ^ k))
+			break;
+	}
+
+	for (sp = (const unsigned char *)w; n; sp++, n--) {
+		if (*sp == c)
 			return (void *)sp;
-		sp++;
 	}
 
 	return NULL;
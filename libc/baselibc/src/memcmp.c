@@ -3,6 +3,7 @@
  */
 
 #include <string.h>
+#include "memword.h"
 
 int memcmp(const void *s1, const void *s2, size_t n)
 {
@@ -44,6 +45,25 @@ int memcmp(const void *s1, const void *s2, size_t n)
 #else
 	const unsigned char *c1 = s1, *c2 = s2;
 
+	/*
+	 * Skip over equal words when both buffers share the same alignment;
+	 * the differing word, if any, is resolved byte by byte below.
+	 */
+	if (n >= MEMWORD_SIZE &&
+	    MEMWORD_ALIGNED((uintptr_t)c1 ^ (uintptr_t)c2)) {
+		for (; !MEMWORD_ALIGNED(c1); n--) {
+			d = (int)*c1++ - (int)*c2++;
+			if (d)
+				return d;
+		}
+		for (; n >= MEMWORD_SIZE; n -= MEMWORD_SIZE) {
+			if (*(const memword_t *)c1 != *(const memword_t *)c2)
+				break;
+			c1 += MEMWORD_SIZE;
+			c2 += MEMWORD_SIZE;
+		}
+	}
+
 	while (n--) {
 		d = (int)*c1++ - (int)*c2++;
 		if (d)
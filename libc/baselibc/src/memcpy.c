@@ -4,6 +4,7 @@
 
 #include <string.h>
 #include <stdint.h>
+#include "memword.h"
 
 void *memcpy(void *dst, const void *src, size_t n)
 {
@@ -19,11 +20,10 @@ void *memcpy(void *dst, const void *src, size_t n)
 	asm volatile ("cld ; rep ; movsq ; movl %3,%%ecx ; rep ; movsb":"+c"
 		      (nq), "+S"(p), "+D"(q)
 		      :"r"((uint32_t) (n & 7)));
-#elif defined(__arm__)
+#elif defined(__arm__) && defined(__ARM_FEATURE_UNALIGNED)
         (void)p;
         (void)q;
 
-#if defined(__ARM_FEATURE_UNALIGNED)
         /*
          * We can speed up a bit by moving 32-bit words if unaligned access is
          * supported (e.g. Cortex-M3/4/7/33).
@@ -36,7 +36,6 @@ void *memcpy(void *dst, const void *src, size_t n)
              "       bpl  loop1         \n"
              "       add  r2, #4        \n"
             );
-#endif
 
         asm (".syntax unified           \n"
              "       b    test2         \n"
@@ -46,6 +45,36 @@ void *memcpy(void *dst, const void *src, size_t n)
              "       bpl  loop2         \n"
             );
 #else
+	/*
+	 * Without unaligned access, words can only be moved when source and
+	 * destination share the same alignment.
+	 */
+	if (n >= 2 * MEMWORD_SIZE &&
+	    MEMWORD_ALIGNED((uintptr_t)p ^ (uintptr_t)q)) {
+		const memword_t *wp;
+		memword_t *wq;
+
+		for (; !MEMWORD_ALIGNED(q); n--) {
+			*q++ = *p++;
+		}
+
+		wp = (const memword_t *)p;
+		wq = (memword_t *)q;
+		for (; n >= 4 * MEMWORD_SIZE; n -= 4 * MEMWORD_SIZE) {
+			wq[0] = wp[0];
+			wq[1] = wp[1];
+			wq[2] = wp[2];
+			wq[3] = wp[3];
+			wp += 4;
+			wq += 4;
+		}
+		for (; n >= MEMWORD_SIZE; n -= MEMWORD_SIZE) {
+			*wq++ = *wp++;
+		}
+		p = (const char *)wp;
+		q = (char *)wq;
+	}
+
 	while (n--) {
 		*q++ = *p++;
 	}
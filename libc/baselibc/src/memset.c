@@ -4,6 +4,7 @@
 
 #include <string.h>
 #include <stdint.h>
+#include "memword.h"
 
 #if defined(__arm__)
 #include <mcu/cmsis_nvic.h>
@@ -67,6 +68,28 @@ void *memset(void *dst, int c, size_t n)
                   : "r3", "r4", "memory"
                  );
 #else
+	if (n >= 2 * MEMWORD_SIZE) {
+		memword_t w = MEMWORD_ONES * (unsigned char)c;
+		memword_t *wq;
+
+		for (; !MEMWORD_ALIGNED(q); n--) {
+			*q++ = c;
+		}
+
+		wq = (memword_t *)q;
+		for (; n >= 4 * MEMWORD_SIZE; n -= 4 * MEMWORD_SIZE) {
+			wq[0] = w;
+			wq[1] = w;
+			wq[2] = w;
+			wq[3] = w;
+			wq += 4;
+		}
+		for (; n >= MEMWORD_SIZE; n -= MEMWORD_SIZE) {
+			*wq++ = w;
+		}
+		q = (char *)wq;
+	}
+
 	while (n--) {
 		*q++ = c;
 	}
@@ -0,0 +1,28 @@
+/*
+ * memword.h
+ *
+ * Helpers for the word-at-a-time string and memory functions.
+ */
+
+#ifndef MEMWORD_H
+#define MEMWORD_H
+
+#include <stdint.h>
+
+/* Machine word, allowed to alias any other type. */
+typedef unsigned long __attribute__((__may_alias__)) memword_t;
+
+#define MEMWORD_SIZE	sizeof(memword_t)
+#define MEMWORD_MASK	(MEMWORD_SIZE - 1)
+
+/* 0x01 and 0x80 repeated in every byte of a word. */
+#define MEMWORD_ONES	((memword_t)-1 / 0xff)
+#define MEMWORD_HIGHS	(MEMWORD_ONES * 0x80)
+
+/* Non-zero if any byte of word x is zero. */
+#define MEMWORD_HASZERO(x) \
+	(((x) - MEMWORD_ONES) & ~(x) & MEMWORD_HIGHS)
+
+#define MEMWORD_ALIGNED(p)	(((uintptr_t)(p) & MEMWORD_MASK) == 0)
+
+#endif /* MEMWORD_H */
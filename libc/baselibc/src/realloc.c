@@ -5,8 +5,12 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "syscfg/syscfg.h"
 #include "malloc.h"
 
+/* See malloc_tlsf.c for the BASELIBC_MALLOC_TLSF implementation. */
+#if !MYNEWT_VAL(BASELIBC_MALLOC_TLSF)
+
 /* FIXME: This is cheesy, it should be fixed later */
 
 void *realloc(void *ptr, size_t size)
@@ -49,3 +53,5 @@ void *realloc(void *ptr, size_t size)
 		return newptr;
 	}
 }
+
+#endif
@@ -3,11 +3,26 @@
  */
 
 #include <string.h>
+#include "memword.h"
 
 size_t strlen(const char *s)
 {
 	const char *ss = s;
-	while (*ss)
-		ss++;
+	const memword_t *w;
+
+	for (; !MEMWORD_ALIGNED(ss); ss++) {
+		if (!*ss)
+			return ss - s;
+	}
+
+	/*
+	 * Aligned word reads never cross into another page or memory region,
+	 * so reading past the terminator within the last word is harmless.
+	 */
+	for (w = (const memword_t *)ss; !MEMWORD_HASZERO(*w); w++)
+		;
+
+	for (ss = (const char *)w; *ss; ss++)
+		;
 	return ss - s;
 }
@@ -33,6 +33,12 @@ extern "C" {
 #define SMP_ID_MPSTATS         3
 #define SMP_ID_DATETIME_STR    4
 #define SMP_ID_RESET           5
+#define SMP_ID_TASKCPU         6
+#define SMP_ID_EVQSTATS        7
+#define SMP_ID_HEAPSTATS       8
+#define SMP_ID_STACKSTATS      9
+#define SMP_ID_TRACE           10
+#define SMP_ID_MUTEXSTATS      11
 
 void smp_os_groups_register(void);
 
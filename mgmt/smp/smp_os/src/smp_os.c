@@ -19,6 +19,7 @@
 
 #include <assert.h>
 #include <string.h>
+#include <limits.h>
 
 #include "os/mynewt.h"
 
@@ -43,6 +44,24 @@ static int smp_def_console_echo(struct mgmt_ctxt *cb);
 static int smp_def_mpstat_read(struct mgmt_ctxt *cb);
 static int smp_datetime_get(struct mgmt_ctxt *cb);
 static int smp_datetime_set(struct mgmt_ctxt *cb);
+#if MYNEWT_VAL(OS_TASK_CPU_STATS)
+static int smp_def_taskcpu_read(struct mgmt_ctxt *cb);
+#endif
+#if MYNEWT_VAL(OS_EVENTQ_STATS)
+static int smp_def_evqstat_read(struct mgmt_ctxt *cb);
+#endif
+#if MYNEWT_VAL(OS_HEAP_TRACK)
+static int smp_def_heapstat_read(struct mgmt_ctxt *cb);
+#endif
+#if MYNEWT_VAL(OS_TASK_STACK_WATERMARK)
+static int smp_def_stackstat_read(struct mgmt_ctxt *cb);
+#endif
+#if MYNEWT_VAL(OS_TRACE_RAM)
+static int smp_def_trace_read(struct mgmt_ctxt *cb);
+#endif
+#if MYNEWT_VAL(OS_MUTEX_STATS)
+static int smp_def_mutexstat_read(struct mgmt_ctxt *cb);
+#endif
 
 static const struct mgmt_handler smp_def_group_handlers[] = {
     [SMP_ID_CONS_ECHO_CTRL] = {
@@ -54,6 +73,36 @@ static const struct mgmt_handler smp_def_group_handlers[] = {
     [SMP_ID_DATETIME_STR] = {
         smp_datetime_get, smp_datetime_set
     },
+#if MYNEWT_VAL(OS_TASK_CPU_STATS)
+    [SMP_ID_TASKCPU] = {
+        smp_def_taskcpu_read, NULL
+    },
+#endif
+#if MYNEWT_VAL(OS_EVENTQ_STATS)
+    [SMP_ID_EVQSTATS] = {
+        smp_def_evqstat_read, NULL
+    },
+#endif
+#if MYNEWT_VAL(OS_HEAP_TRACK)
+    [SMP_ID_HEAPSTATS] = {
+        smp_def_heapstat_read, NULL
+    },
+#endif
+#if MYNEWT_VAL(OS_TASK_STACK_WATERMARK)
+    [SMP_ID_STACKSTATS] = {
+        smp_def_stackstat_read, NULL
+    },
+#endif
+#if MYNEWT_VAL(OS_TRACE_RAM)
+    [SMP_ID_TRACE] = {
+        smp_def_trace_read, NULL
+    },
+#endif
+#if MYNEWT_VAL(OS_MUTEX_STATS)
+    [SMP_ID_MUTEXSTATS] = {
+        smp_def_mutexstat_read, NULL
+    },
+#endif
 };
 
 #define SMP_DEF_GROUP_SZ                                               \
@@ -136,6 +185,379 @@ smp_def_mpstat_read(struct mgmt_ctxt *cb)
     return (0);
 }
 
+#if MYNEWT_VAL(OS_TASK_CPU_STATS)
+static int
+smp_def_taskcpu_read(struct mgmt_ctxt *cb)
+{
+    struct os_task *prev_task;
+    struct os_task_info oti;
+    CborError g_err = CborNoError;
+    CborEncoder tasks;
+    CborEncoder task;
+
+    g_err |= cbor_encode_text_stringz(&cb->encoder, "rc");
+    g_err |= cbor_encode_int(&cb->encoder, MGMT_ERR_EOK);
+    g_err |= cbor_encode_text_stringz(&cb->encoder, "idle");
+    g_err |= cbor_encode_uint(&cb->encoder, os_task_cpu_idle_pct());
+    g_err |= cbor_encode_text_stringz(&cb->encoder, "tasks");
+    g_err |= cbor_encoder_create_map(&cb->encoder, &tasks,
+                                     CborIndefiniteLength);
+
+    prev_task = NULL;
+    while (1) {
+        prev_task = os_task_info_get_next(prev_task, &oti);
+        if (prev_task == NULL) {
+            break;
+        }
+
+        g_err |= cbor_encode_text_stringz(&tasks, oti.oti_name);
+        g_err |= cbor_encoder_create_map(&tasks, &task, CborIndefiniteLength);
+        g_err |= cbor_encode_text_stringz(&task, "prio");
+        g_err |= cbor_encode_uint(&task, oti.oti_prio);
+        g_err |= cbor_encode_text_stringz(&task, "cputime");
+        g_err |= cbor_encode_uint(&task,
+                    os_cputime_ticks_to_usecs64(oti.oti_cputime));
+        g_err |= cbor_encode_text_stringz(&task, "preempt");
+        g_err |= cbor_encode_uint(&task, oti.oti_preempt_cnt);
+        g_err |= cbor_encode_text_stringz(&task, "block");
+        g_err |= cbor_encode_uint(&task, oti.oti_voluntary_cnt);
+        g_err |= cbor_encode_text_stringz(&task, "maxlat");
+        g_err |= cbor_encode_uint(&task,
+                    os_cputime_ticks_to_usecs(oti.oti_max_ready_latency));
+        g_err |= cbor_encoder_close_container(&tasks, &task);
+    }
+
+    g_err |= cbor_encoder_close_container(&cb->encoder, &tasks);
+
+    if (g_err) {
+        return MGMT_ERR_ENOMEM;
+    }
+    return (0);
+}
+#endif
+
+#if MYNEWT_VAL(OS_EVENTQ_STATS)
+static int
+smp_def_evqstat_read(struct mgmt_ctxt *cb)
+{
+    struct os_eventq_info oei;
+    struct os_eventq *evq;
+    CborError g_err = CborNoError;
+    CborEncoder evqs;
+    CborEncoder queue;
+    CborEncoder hist;
+    int i;
+
+    g_err |= cbor_encode_text_stringz(&cb->encoder, "rc");
+    g_err |= cbor_encode_int(&cb->encoder, MGMT_ERR_EOK);
+    g_err |= cbor_encode_text_stringz(&cb->encoder, "evqs");
+    g_err |= cbor_encoder_create_array(&cb->encoder, &evqs,
+                                       CborIndefiniteLength);
+
+    evq = NULL;
+    while (1) {
+        evq = os_eventq_info_get_next(evq, &oei);
+        if (evq == NULL) {
+            break;
+        }
+
+        g_err |= cbor_encoder_create_map(&evqs, &queue, CborIndefiniteLength);
+        g_err |= cbor_encode_text_stringz(&queue, "owner");
+        g_err |= cbor_encode_text_stringz(&queue, oei.oei_owner);
+        g_err |= cbor_encode_text_stringz(&queue, "dflt");
+        g_err |= cbor_encode_boolean(&queue, evq == os_eventq_dflt_get());
+        g_err |= cbor_encode_text_stringz(&queue, "depth");
+        g_err |= cbor_encode_uint(&queue, oei.oei_stats.es_depth);
+        g_err |= cbor_encode_text_stringz(&queue, "max");
+        g_err |= cbor_encode_uint(&queue, oei.oei_stats.es_max_depth);
+        g_err |= cbor_encode_text_stringz(&queue, "puts");
+        g_err |= cbor_encode_uint(&queue, oei.oei_stats.es_puts);
+        g_err |= cbor_encode_text_stringz(&queue, "maxwait");
+        g_err |= cbor_encode_uint(&queue,
+                    os_cputime_ticks_to_usecs(oei.oei_stats.es_max_wait));
+        g_err |= cbor_encode_text_stringz(&queue, "hist");
+        g_err |= cbor_encoder_create_array(&queue, &hist,
+                                           OS_EVENTQ_WAIT_HIST_BUCKETS);
+        for (i = 0; i < OS_EVENTQ_WAIT_HIST_BUCKETS; i++) {
+            g_err |= cbor_encode_uint(&hist, oei.oei_stats.es_wait_hist[i]);
+        }
+        g_err |= cbor_encoder_close_container(&queue, &hist);
+        g_err |= cbor_encoder_close_container(&evqs, &queue);
+    }
+
+    g_err |= cbor_encoder_close_container(&cb->encoder, &evqs);
+
+    if (g_err) {
+        return MGMT_ERR_ENOMEM;
+    }
+    return (0);
+}
+#endif
+
+#if MYNEWT_VAL(OS_HEAP_TRACK)
+static int
+smp_def_heapstat_read(struct mgmt_ctxt *cb)
+{
+    struct os_heap_site_info ohsi;
+    struct os_heap_stats ohs;
+    CborError g_err = CborNoError;
+    CborEncoder sites;
+    CborEncoder site;
+    int idx;
+
+    os_heap_stats_get(&ohs);
+
+    g_err |= cbor_encode_text_stringz(&cb->encoder, "rc");
+    g_err |= cbor_encode_int(&cb->encoder, MGMT_ERR_EOK);
+    g_err |= cbor_encode_text_stringz(&cb->encoder, "bytes");
+    g_err |= cbor_encode_uint(&cb->encoder, ohs.ohs_cur_bytes);
+    g_err |= cbor_encode_text_stringz(&cb->encoder, "peak");
+    g_err |= cbor_encode_uint(&cb->encoder, ohs.ohs_peak_bytes);
+    g_err |= cbor_encode_text_stringz(&cb->encoder, "blocks");
+    g_err |= cbor_encode_uint(&cb->encoder, ohs.ohs_cur_blocks);
+    g_err |= cbor_encode_text_stringz(&cb->encoder, "peakblocks");
+    g_err |= cbor_encode_uint(&cb->encoder, ohs.ohs_peak_blocks);
+    g_err |= cbor_encode_text_stringz(&cb->encoder, "allocs");
+    g_err |= cbor_encode_uint(&cb->encoder, ohs.ohs_allocs);
+    g_err |= cbor_encode_text_stringz(&cb->encoder, "frees");
+    g_err |= cbor_encode_uint(&cb->encoder, ohs.ohs_frees);
+    g_err |= cbor_encode_text_stringz(&cb->encoder, "allocbytes");
+    g_err |= cbor_encode_uint(&cb->encoder, ohs.ohs_alloc_bytes);
+    g_err |= cbor_encode_text_stringz(&cb->encoder, "fails");
+    g_err |= cbor_encode_uint(&cb->encoder, ohs.ohs_fails);
+    g_err |= cbor_encode_text_stringz(&cb->encoder, "untracked");
+    g_err |= cbor_encode_uint(&cb->encoder, ohs.ohs_untracked);
+    g_err |= cbor_encode_text_stringz(&cb->encoder, "sites");
+    g_err |= cbor_encoder_create_array(&cb->encoder, &sites,
+                                       CborIndefiniteLength);
+
+    idx = 0;
+    while (1) {
+        idx = os_heap_site_info_get_next(idx, &ohsi);
+        if (idx < 0) {
+            break;
+        }
+
+        g_err |= cbor_encoder_create_map(&sites, &site, CborIndefiniteLength);
+        g_err |= cbor_encode_text_stringz(&site, "caller");
+        g_err |= cbor_encode_uint(&site, (uintptr_t)ohsi.ohsi_caller);
+        g_err |= cbor_encode_text_stringz(&site, "blocks");
+        g_err |= cbor_encode_uint(&site, ohsi.ohsi_blocks);
+        g_err |= cbor_encode_text_stringz(&site, "bytes");
+        g_err |= cbor_encode_uint(&site, ohsi.ohsi_bytes);
+        g_err |= cbor_encoder_close_container(&sites, &site);
+    }
+
+    g_err |= cbor_encoder_close_container(&cb->encoder, &sites);
+
+    if (g_err) {
+        return MGMT_ERR_ENOMEM;
+    }
+    return (0);
+}
+#endif
+
+#if MYNEWT_VAL(OS_TASK_STACK_WATERMARK)
+static int
+smp_def_stackstat_read(struct mgmt_ctxt *cb)
+{
+    struct os_task_stack_info otsi;
+    CborError g_err = CborNoError;
+    CborEncoder tasks;
+    CborEncoder task;
+    int idx;
+
+    g_err |= cbor_encode_text_stringz(&cb->encoder, "rc");
+    g_err |= cbor_encode_int(&cb->encoder, MGMT_ERR_EOK);
+    g_err |= cbor_encode_text_stringz(&cb->encoder, "wordsz");
+    g_err |= cbor_encode_uint(&cb->encoder, sizeof(os_stack_t));
+    g_err |= cbor_encode_text_stringz(&cb->encoder, "tasks");
+    g_err |= cbor_encoder_create_array(&cb->encoder, &tasks,
+                                       CborIndefiniteLength);
+
+    idx = 0;
+    while (1) {
+        idx = os_task_stack_info_get_next(idx, &otsi);
+        if (idx < 0) {
+            break;
+        }
+
+        g_err |= cbor_encoder_create_map(&tasks, &task, CborIndefiniteLength);
+        if (otsi.otsi_name != NULL) {
+            g_err |= cbor_encode_text_stringz(&task, "name");
+            g_err |= cbor_encode_text_stringz(&task, otsi.otsi_name);
+        }
+        g_err |= cbor_encode_text_stringz(&task, "hash");
+        g_err |= cbor_encode_uint(&task, otsi.otsi_name_hash);
+        g_err |= cbor_encode_text_stringz(&task, "stksz");
+        g_err |= cbor_encode_uint(&task, otsi.otsi_stksize);
+        g_err |= cbor_encode_text_stringz(&task, "hwm");
+        g_err |= cbor_encode_uint(&task, otsi.otsi_hwm);
+        g_err |= cbor_encode_text_stringz(&task, "max");
+        g_err |= cbor_encode_uint(&task, otsi.otsi_hwm_max);
+        g_err |= cbor_encode_text_stringz(&task, "rec");
+        g_err |= cbor_encode_uint(&task, otsi.otsi_recommended);
+        g_err |= cbor_encoder_close_container(&tasks, &task);
+    }
+
+    g_err |= cbor_encoder_close_container(&cb->encoder, &tasks);
+
+    if (g_err) {
+        return MGMT_ERR_ENOMEM;
+    }
+    return (0);
+}
+#endif
+
+#if MYNEWT_VAL(OS_MUTEX_STATS)
+static int
+smp_def_mutexstat_read(struct mgmt_ctxt *cb)
+{
+    struct os_mutex_info omi;
+    struct os_mutex *mu;
+    CborError g_err = CborNoError;
+    CborEncoder mutexes;
+    CborEncoder mutex;
+
+    g_err |= cbor_encode_text_stringz(&cb->encoder, "rc");
+    g_err |= cbor_encode_int(&cb->encoder, MGMT_ERR_EOK);
+    g_err |= cbor_encode_text_stringz(&cb->encoder, "mutexes");
+    g_err |= cbor_encoder_create_array(&cb->encoder, &mutexes,
+                                       CborIndefiniteLength);
+
+    mu = NULL;
+    while (1) {
+        mu = os_mutex_info_get_next(mu, &omi);
+        if (mu == NULL) {
+            break;
+        }
+
+        g_err |= cbor_encoder_create_map(&mutexes, &mutex,
+                                         CborIndefiniteLength);
+        if (omi.omi_name != NULL) {
+            g_err |= cbor_encode_text_stringz(&mutex, "name");
+            g_err |= cbor_encode_text_stringz(&mutex, omi.omi_name);
+        }
+        g_err |= cbor_encode_text_stringz(&mutex, "caller");
+        g_err |= cbor_encode_uint(&mutex, (uintptr_t)omi.omi_init_caller);
+        g_err |= cbor_encode_text_stringz(&mutex, "acq");
+        g_err |= cbor_encode_uint(&mutex, omi.omi_stats.ms_acquired);
+        g_err |= cbor_encode_text_stringz(&mutex, "cont");
+        g_err |= cbor_encode_uint(&mutex, omi.omi_stats.ms_contended);
+        g_err |= cbor_encode_text_stringz(&mutex, "tmo");
+        g_err |= cbor_encode_uint(&mutex, omi.omi_stats.ms_timeouts);
+        g_err |= cbor_encode_text_stringz(&mutex, "boost");
+        g_err |= cbor_encode_uint(&mutex, omi.omi_stats.ms_boosts);
+        g_err |= cbor_encode_text_stringz(&mutex, "maxwait");
+        g_err |= cbor_encode_uint(&mutex,
+                    os_cputime_ticks_to_usecs(omi.omi_stats.ms_max_wait));
+        g_err |= cbor_encode_text_stringz(&mutex, "wait");
+        g_err |= cbor_encode_uint(&mutex,
+                    os_cputime_ticks_to_usecs64(omi.omi_stats.ms_total_wait));
+        g_err |= cbor_encode_text_stringz(&mutex, "maxhold");
+        g_err |= cbor_encode_uint(&mutex,
+                    os_cputime_ticks_to_usecs(omi.omi_stats.ms_max_hold));
+        g_err |= cbor_encode_text_stringz(&mutex, "level");
+        g_err |= cbor_encode_uint(&mutex, omi.omi_level);
+        g_err |= cbor_encode_text_stringz(&mutex, "waiters");
+        g_err |= cbor_encode_uint(&mutex, omi.omi_waiters);
+        g_err |= cbor_encoder_close_container(&mutexes, &mutex);
+    }
+
+    g_err |= cbor_encoder_close_container(&cb->encoder, &mutexes);
+
+    if (g_err) {
+        return MGMT_ERR_ENOMEM;
+    }
+    return (0);
+}
+#endif
+
+#if MYNEWT_VAL(OS_TRACE_RAM)
+/* Bytes of trace dump returned per request. */
+#define SMP_DEF_TRACE_CHUNK     128
+
+/* Recording is restarted if the rest of a dump is not read in this time. */
+#define SMP_DEF_TRACE_TMO       (10 * OS_TICKS_PER_SEC)
+
+/* Set if recording is to be restarted once the whole dump has been read. */
+static uint8_t smp_def_trace_restart;
+static struct os_callout smp_def_trace_timer;
+
+static void
+smp_def_trace_resume(void)
+{
+    if (smp_def_trace_restart) {
+        smp_def_trace_restart = 0;
+        os_trace_ram_start();
+    }
+}
+
+static void
+smp_def_trace_timer_cb(struct os_event *ev)
+{
+    /* The client abandoned the dump. */
+    smp_def_trace_resume();
+}
+
+static int
+smp_def_trace_read(struct mgmt_ctxt *cb)
+{
+    unsigned long long off = UINT_MAX;
+    const struct cbor_attr_t attrs[2] = {
+        [0] = {
+            .attribute = "off",
+            .type = CborAttrUnsignedIntegerType,
+            .addr.uinteger = &off
+        },
+        [1] = { 0 },
+    };
+    uint8_t data[SMP_DEF_TRACE_CHUNK];
+    CborError g_err = CborNoError;
+    uint32_t size;
+    uint32_t len;
+    int rc;
+
+    rc = cbor_read_object(&cb->it, attrs);
+    if (rc || off == UINT_MAX) {
+        return MGMT_ERR_EINVAL;
+    }
+
+    /* Keep the buffer still while the dump is read out. */
+    if (off == 0 && os_trace_ram_running()) {
+        os_trace_ram_stop();
+        smp_def_trace_restart = 1;
+    }
+
+    size = os_trace_ram_dump_size();
+    len = os_trace_ram_dump_read(off, data, sizeof(data));
+    if (off + len >= size) {
+        os_callout_stop(&smp_def_trace_timer);
+        smp_def_trace_resume();
+    } else if (smp_def_trace_restart) {
+        os_callout_reset(&smp_def_trace_timer, SMP_DEF_TRACE_TMO);
+    }
+
+    g_err |= cbor_encode_text_stringz(&cb->encoder, "rc");
+    g_err |= cbor_encode_int(&cb->encoder, MGMT_ERR_EOK);
+    g_err |= cbor_encode_text_stringz(&cb->encoder, "off");
+    g_err |= cbor_encode_uint(&cb->encoder, off);
+    g_err |= cbor_encode_text_stringz(&cb->encoder, "data");
+    g_err |= cbor_encode_byte_string(&cb->encoder, data, len);
+
+    /* Only include length in first response. */
+    if (off == 0) {
+        g_err |= cbor_encode_text_stringz(&cb->encoder, "len");
+        g_err |= cbor_encode_uint(&cb->encoder, size);
+    }
+
+    if (g_err) {
+        return MGMT_ERR_ENOMEM;
+    }
+    return (0);
+}
+#endif
+
 static int
 smp_datetime_get(struct mgmt_ctxt *cb)
 {
@@ -222,5 +644,9 @@ smp_os_groups_register(void)
 void
 smp_os_pkg_init(void)
 {
+#if MYNEWT_VAL(OS_TRACE_RAM)
+    os_callout_init(&smp_def_trace_timer, os_eventq_dflt_get(),
+                    smp_def_trace_timer_cb, NULL);
+#endif
     smp_os_groups_register();
 }
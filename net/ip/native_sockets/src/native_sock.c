@@ -25,7 +25,9 @@
 #include <poll.h>
 #include <assert.h>
 #include <fcntl.h>
+#include <limits.h>
 #include <sys/ioctl.h>
+#include <sys/uio.h>
 #include <sys/un.h>
 #include <stdio.h>
 
@@ -36,6 +38,9 @@
 
 #include "native_sock_priv.h"
 
+/* Maximum number of mbuf segments passed to the kernel in one call. */
+#define NATIVE_SOCK_IOV_MAX     32
+
 static struct native_sock {
     struct mn_socket ns_sock;
     int ns_fd;
@@ -436,6 +441,29 @@ native_sock_listen(struct mn_socket *s, uint8_t qlen)
     return 0;
 }
 
+/*
+ * Describes the data of an mbuf chain as an array of NATIVE_SOCK_IOV_MAX
+ * iovecs, without copying.  Returns the number of entries used; *out_len is
+ * set to the number of bytes they cover.
+ */
+static int
+native_sock_mbuf_iov(struct os_mbuf *m, struct iovec *iov, int *out_len)
+{
+    struct os_mbuf_iovec omi[NATIVE_SOCK_IOV_MAX];
+    int cnt;
+    int i;
+
+    cnt = os_mbuf_to_iovec(m, 0, INT_MAX, omi, NATIVE_SOCK_IOV_MAX);
+    *out_len = 0;
+    for (i = 0; i < cnt; i++) {
+        iov[i].iov_base = omi[i].iov_base;
+        iov[i].iov_len = omi[i].iov_len;
+        *out_len += omi[i].iov_len;
+    }
+
+    return cnt;
+}
+
 /*
  * TX routine for stream sockets (TCP). The data to send is pointed
  * by ns_tx.
@@ -446,27 +474,34 @@ static int
 native_sock_stream_tx(struct native_sock *ns, int notify)
 {
     struct native_sock_state *nss = &native_sock_state;
+    struct iovec iov[NATIVE_SOCK_IOV_MAX];
     struct os_mbuf *m;
     struct os_mbuf *n;
+    int iovcnt;
+    int len;
     int rc;
 
     rc = 0;
 
     os_mutex_pend(&nss->mtx, OS_TIMEOUT_NEVER);
     while (ns->ns_tx && rc == 0) {
-        m = ns->ns_tx;
-        n = SLIST_NEXT(m, om_next);
+        iovcnt = native_sock_mbuf_iov(ns->ns_tx, iov, &len);
 
         errno = 0;
-        rc = write(ns->ns_fd, m->om_data, m->om_len);
-        if (rc == m->om_len) {
-            /* Complete write. */
-            ns->ns_tx = n;
-            os_mbuf_free(m);
-            rc = 0;
-        } else if (rc != -1) {
-            /* Partial write. */
-            os_mbuf_adj(m, m->om_len - rc);
+        rc = writev(ns->ns_fd, iov, iovcnt);
+        if (rc != -1) {
+            /* Free what was written, trim a partially written mbuf. */
+            m = ns->ns_tx;
+            while (m != NULL && rc >= m->om_len) {
+                rc -= m->om_len;
+                n = SLIST_NEXT(m, om_next);
+                os_mbuf_free(m);
+                m = n;
+            }
+            if (m != NULL && rc > 0) {
+                os_mbuf_adj(m, rc);
+            }
+            ns->ns_tx = m;
             rc = 0;
         } else {
             /* Error. */
@@ -517,7 +552,8 @@ native_sock_sendto(struct mn_socket *s, struct os_mbuf *m,
     struct sockaddr_storage ss;
     struct sockaddr *sa = (struct sockaddr *)&ss;
     uint8_t tmpbuf[MYNEWT_VAL(NATIVE_SOCKETS_MAX_UDP)];
-    struct os_mbuf *o;
+    struct iovec iov[NATIVE_SOCK_IOV_MAX];
+    struct msghdr msg;
     int sa_len;
     int off;
     int rc;
@@ -527,15 +563,24 @@ native_sock_sendto(struct mn_socket *s, struct os_mbuf *m,
         if (rc) {
             return rc;
         }
-        off = 0;
-        for (o = m; o; o = SLIST_NEXT(o, om_next)) {
-            if (off + o->om_len > sizeof(tmpbuf)) {
-                return MN_ENOBUFS;
-            }
-            os_mbuf_copydata(o, 0, o->om_len, &tmpbuf[off]);
-            off += o->om_len;
+        off = os_mbuf_len(m);
+        if (off > sizeof(tmpbuf)) {
+            return MN_ENOBUFS;
+        }
+
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_name = sa;
+        msg.msg_namelen = sa_len;
+        msg.msg_iov = iov;
+        msg.msg_iovlen = native_sock_mbuf_iov(m, iov, &rc);
+        if (rc != off) {
+            /* Too many segments; send a flat copy instead. */
+            os_mbuf_copydata(m, 0, off, tmpbuf);
+            iov[0].iov_base = tmpbuf;
+            iov[0].iov_len = off;
+            msg.msg_iovlen = 1;
         }
-        rc = sendto(ns->ns_fd, tmpbuf, off, 0, sa, sa_len);
+        rc = sendmsg(ns->ns_fd, &msg, 0);
         if (rc != off) {
             return native_sock_err_to_mn_err(errno);
         }
@@ -502,7 +502,7 @@ coap_send_message(struct os_mbuf *m, int dup)
     STATS_INC(coap_stats, oframe);
 
     if (dup) {
-        m = os_mbuf_dup(m);
+        m = os_mbuf_clone(m, NULL);
         if (!m) {
             STATS_INC(coap_stats, oerr);
             return;
@@ -1372,7 +1372,7 @@ coap_get_payload(struct coap_packet_rx *pkt, struct os_mbuf **mp, uint16_t *off)
 int
 coap_set_payload(coap_packet_t *pkt, struct os_mbuf *m, size_t length)
 {
-    pkt->payload_m = os_mbuf_dup(m);
+    pkt->payload_m = os_mbuf_clone(m, NULL);
     if (!pkt->payload_m) {
         return -1;
     }
@@ -32,6 +32,7 @@ extern "C" {
 #endif
 
 struct conf_store;
+struct conf_store_loc;
 
 /*
  * API for config storage.
@@ -42,6 +43,9 @@ struct conf_store_itf {
     int (*csi_save_start)(struct conf_store *cs);
     int (*csi_save)(struct conf_store *cs, const char *name, const char *value);
     int (*csi_save_end)(struct conf_store *cs);
+    /* Optional; reads back an entry recorded in the stored value index. */
+    int (*csi_read)(struct conf_store *cs, const struct conf_store_loc *loc,
+                    char *buf, int len);
 };
 
 struct conf_store {
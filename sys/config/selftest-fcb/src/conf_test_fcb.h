@@ -97,6 +97,9 @@ TEST_CASE_DECL(config_test_compress_reset)
 TEST_CASE_DECL(config_test_save_one_fcb)
 TEST_CASE_DECL(config_test_custom_compress)
 TEST_CASE_DECL(config_test_get_stored_fcb)
+TEST_CASE_DECL(config_test_compress_bench)
+TEST_CASE_DECL(config_test_compress_collide)
+TEST_CASE_DECL(config_test_stored_index)
 
 #ifdef __cplusplus
 }
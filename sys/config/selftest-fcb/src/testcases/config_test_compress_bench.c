@@ -0,0 +1,107 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include <stdlib.h>
+#include "conf_test_fcb.h"
+#include "config/config_generic_kv.h"
+
+/*
+ * Compresses a config FCB holding 1000 settings, some of them overwritten,
+ * and checks that the newest value of every setting survives.  The map
+ * size of this selftest makes the compression run in many batches.
+ */
+
+#define CTCB_NUM_SETTINGS   1000
+
+static int ctcb_gen[CTCB_NUM_SETTINGS];
+static int ctcb_seen[CTCB_NUM_SETTINGS];
+
+static void
+ctcb_save(struct conf_fcb *cf, int idx)
+{
+    char name[CONF_MAX_NAME_LEN];
+    char value[16];
+    int rc;
+
+    snprintf(name, sizeof(name), "bench/s%d", idx);
+    snprintf(value, sizeof(value), "%d", ctcb_gen[idx]);
+    rc = conf_fcb_kv_save(&cf->cf_fcb, name, value);
+    TEST_ASSERT_FATAL(rc == 0);
+}
+
+static int
+ctcb_verify_cb(struct fcb_entry *loc, void *arg)
+{
+    char buf[CONF_MAX_NAME_LEN + CONF_MAX_VAL_LEN + 32];
+    char *name;
+    char *val;
+    int idx;
+    int rc;
+
+    rc = flash_area_read(loc->fe_area, loc->fe_data_off, buf,
+                         loc->fe_data_len);
+    TEST_ASSERT_FATAL(rc == 0);
+    buf[loc->fe_data_len] = '\0';
+
+    rc = conf_line_parse(buf, &name, &val);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT_FATAL(sscanf(name, "bench/s%d", &idx) == 1);
+    TEST_ASSERT_FATAL(idx >= 0 && idx < CTCB_NUM_SETTINGS);
+
+    ctcb_seen[idx] = atoi(val);
+    return 0;
+}
+
+TEST_CASE_SELF(config_test_compress_bench)
+{
+    struct conf_fcb cf;
+    int rc;
+    int i;
+
+    config_wipe_srcs();
+    config_wipe_fcb(fcb_areas, sizeof(fcb_areas) / sizeof(fcb_areas[0]));
+
+    memset(&cf, 0, sizeof(cf));
+    cf.cf_fcb.f_magic = MYNEWT_VAL(CONFIG_FCB_MAGIC);
+    cf.cf_fcb.f_sectors = fcb_areas;
+    cf.cf_fcb.f_sector_cnt = sizeof(fcb_areas) / sizeof(fcb_areas[0]);
+
+    rc = conf_fcb_src(&cf);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    for (i = 0; i < CTCB_NUM_SETTINGS; i++) {
+        ctcb_gen[i] = 1;
+        ctcb_save(&cf, i);
+    }
+    /* Overwrite every third setting, so that the oldest sector holds a mix
+     * of stale and current values.
+     */
+    for (i = 0; i < CTCB_NUM_SETTINGS; i += 3) {
+        ctcb_gen[i]++;
+        ctcb_save(&cf, i);
+    }
+
+    conf_fcb_compress(&cf, NULL, NULL);
+
+    memset(ctcb_seen, 0, sizeof(ctcb_seen));
+    rc = fcb_walk(&cf.cf_fcb, NULL, ctcb_verify_cb, NULL);
+    TEST_ASSERT_FATAL(rc == 0);
+    for (i = 0; i < CTCB_NUM_SETTINGS; i++) {
+        TEST_ASSERT(ctcb_seen[i] == ctcb_gen[i]);
+    }
+}
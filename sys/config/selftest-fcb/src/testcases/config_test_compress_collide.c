@@ -0,0 +1,96 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include "conf_test_fcb.h"
+#include "config/config_generic_kv.h"
+
+/*
+ * These two names have the same conf_name_hash().  While compressing,
+ * the map entry for CTCC_NAME_B points at the newest CTCC_NAME_A, and
+ * the store has to be scanned to find out that CTCC_NAME_B is current.
+ */
+#define CTCC_NAME_A         "cmp/c422789"
+#define CTCC_NAME_B         "cmp/c639192"
+
+static int ctcc_cnt;
+static char ctcc_val_a[CONF_MAX_VAL_LEN];
+static char ctcc_val_b[CONF_MAX_VAL_LEN];
+
+static int
+ctcc_verify_cb(struct fcb_entry *loc, void *arg)
+{
+    char buf[CONF_MAX_NAME_LEN + CONF_MAX_VAL_LEN + 32];
+    char *name;
+    char *val;
+    int rc;
+
+    rc = flash_area_read(loc->fe_area, loc->fe_data_off, buf,
+                         loc->fe_data_len);
+    TEST_ASSERT_FATAL(rc == 0);
+    buf[loc->fe_data_len] = '\0';
+
+    rc = conf_line_parse(buf, &name, &val);
+    TEST_ASSERT_FATAL(rc == 0);
+    if (!strcmp(name, CTCC_NAME_A)) {
+        strcpy(ctcc_val_a, val);
+    } else {
+        TEST_ASSERT_FATAL(!strcmp(name, CTCC_NAME_B));
+        strcpy(ctcc_val_b, val);
+    }
+    ctcc_cnt++;
+    return 0;
+}
+
+TEST_CASE_SELF(config_test_compress_collide)
+{
+    struct conf_fcb cf;
+    int rc;
+
+    TEST_ASSERT_FATAL(conf_name_hash(CTCC_NAME_A) ==
+                      conf_name_hash(CTCC_NAME_B));
+
+    config_wipe_srcs();
+    config_wipe_fcb(fcb_areas, sizeof(fcb_areas) / sizeof(fcb_areas[0]));
+
+    memset(&cf, 0, sizeof(cf));
+    cf.cf_fcb.f_magic = MYNEWT_VAL(CONFIG_FCB_MAGIC);
+    cf.cf_fcb.f_sectors = fcb_areas;
+    cf.cf_fcb.f_sector_cnt = sizeof(fcb_areas) / sizeof(fcb_areas[0]);
+
+    rc = conf_fcb_src(&cf);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    rc = conf_fcb_kv_save(&cf.cf_fcb, CTCC_NAME_A, "1");
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = conf_fcb_kv_save(&cf.cf_fcb, CTCC_NAME_B, "1");
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = conf_fcb_kv_save(&cf.cf_fcb, CTCC_NAME_A, "2");
+    TEST_ASSERT_FATAL(rc == 0);
+
+    conf_fcb_compress(&cf, NULL, NULL);
+
+    /* The stale CTCC_NAME_A is dropped, the other two entries are kept. */
+    ctcc_cnt = 0;
+    memset(ctcc_val_a, 0, sizeof(ctcc_val_a));
+    memset(ctcc_val_b, 0, sizeof(ctcc_val_b));
+    rc = fcb_walk(&cf.cf_fcb, NULL, ctcc_verify_cb, NULL);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(ctcc_cnt == 2);
+    TEST_ASSERT(!strcmp(ctcc_val_a, "2"));
+    TEST_ASSERT(!strcmp(ctcc_val_b, "1"));
+}
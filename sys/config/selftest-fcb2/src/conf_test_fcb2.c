@@ -268,6 +268,7 @@ ctest_get_call_state(void)
 void config_wipe_srcs(void)
 {
     SLIST_INIT(&conf_load_srcs);
+    conf_index_init();
     conf_save_dst = NULL;
 }
 
@@ -387,6 +388,9 @@ TEST_SUITE(config_test_c3)
 
     config_test_compress_reset();
     config_test_custom_compress();
+    config_test_compress_bench();
+    config_test_compress_collide();
+    config_test_stored_index();
 }
 
 int
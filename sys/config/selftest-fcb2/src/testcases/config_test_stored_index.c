@@ -0,0 +1,151 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include <stdlib.h>
+#include "conf_test_fcb2.h"
+#include "config/config_generic_kv.h"
+
+/*
+ * Reads back settings through the stored value index, both when every name
+ * fits in it and when it has overflowed, across overwrites, deletes and
+ * compression.
+ */
+
+/* Twice the CONFIG_STORE_INDEX_SIZE of this test package. */
+#define CTSI_NUM_SETTINGS   64
+
+static int ctsi_val[CTSI_NUM_SETTINGS];
+
+static void
+ctsi_save(int idx, int val)
+{
+    char name[CONF_MAX_NAME_LEN];
+    char value[16];
+    int rc;
+
+    snprintf(name, sizeof(name), "index/s%d", idx);
+    if (val < 0) {
+        rc = conf_save_one(name, NULL);
+    } else {
+        snprintf(value, sizeof(value), "%d", val);
+        rc = conf_save_one(name, value);
+    }
+    TEST_ASSERT_FATAL(rc == 0);
+    ctsi_val[idx] = val;
+}
+
+static void
+ctsi_verify(int cnt)
+{
+    char name[CONF_MAX_NAME_LEN];
+    char value[16];
+    int rc;
+    int i;
+
+    for (i = 0; i < cnt; i++) {
+        snprintf(name, sizeof(name), "index/s%d", i);
+        rc = conf_get_stored_value(name, value, sizeof(value));
+        if (ctsi_val[i] < 0) {
+            /* Deleted; compression drops these altogether. */
+            TEST_ASSERT(rc == OS_ENOENT || (rc == 0 && value[0] == '\0'));
+        } else {
+            TEST_ASSERT_FATAL(rc == 0);
+            TEST_ASSERT(atoi(value) == ctsi_val[i]);
+        }
+    }
+    rc = conf_get_stored_value("index/none", value, sizeof(value));
+    TEST_ASSERT(rc == OS_ENOENT);
+}
+
+static int
+ctsi_count_cb(struct fcb2_entry *loc, void *arg)
+{
+    (*(int *)arg)++;
+    return 0;
+}
+
+TEST_CASE_SELF(config_test_stored_index)
+{
+    struct conf_fcb2 cf;
+    int cnt;
+    int cnt2;
+    int rc;
+    int i;
+
+    config_wipe_srcs();
+    config_wipe_fcb2(fcb_range, CONF_TEST_FCB_RANGE_CNT);
+
+    memset(&cf, 0, sizeof(cf));
+    cf.cf2_fcb.f_magic = MYNEWT_VAL(CONFIG_FCB_MAGIC);
+    cf.cf2_fcb.f_range_cnt = CONF_TEST_FCB_RANGE_CNT;
+    cf.cf2_fcb.f_sector_cnt = fcb_range[0].fsr_sector_count;
+    cf.cf2_fcb.f_ranges = fcb_range;
+
+    rc = conf_fcb2_src(&cf);
+    TEST_ASSERT(rc == 0);
+
+    rc = conf_fcb2_dst(&cf);
+    TEST_ASSERT(rc == 0);
+
+    /* Every name fits. */
+    for (i = 0; i < CTSI_NUM_SETTINGS / 2; i++) {
+        ctsi_save(i, i);
+    }
+    rc = conf_load();
+    TEST_ASSERT(rc == 0);
+    ctsi_verify(CTSI_NUM_SETTINGS / 2);
+
+    for (i = 0; i < CTSI_NUM_SETTINGS / 2; i += 3) {
+        ctsi_save(i, i + 1000);
+    }
+    ctsi_save(1, -1);
+    ctsi_verify(CTSI_NUM_SETTINGS / 2);
+
+    /* Saving the stored value again does not append. */
+    cnt = 0;
+    fcb2_walk(&cf.cf2_fcb, FCB2_SECTOR_OLDEST, ctsi_count_cb, &cnt);
+    ctsi_save(2, ctsi_val[2]);
+    cnt2 = 0;
+    fcb2_walk(&cf.cf2_fcb, FCB2_SECTOR_OLDEST, ctsi_count_cb, &cnt2);
+    TEST_ASSERT(cnt == cnt2);
+
+    /* A save that bypasses the config store is seen as well. */
+    rc = conf_fcb2_kv_save(&cf.cf2_fcb, "index/s3", "3000");
+    TEST_ASSERT(rc == 0);
+    ctsi_val[3] = 3000;
+    ctsi_verify(CTSI_NUM_SETTINGS / 2);
+
+    conf_fcb2_compress(&cf, NULL, NULL);
+    ctsi_verify(CTSI_NUM_SETTINGS / 2);
+
+    /* Index overflows; the rest is found by scanning. */
+    for (i = CTSI_NUM_SETTINGS / 2; i < CTSI_NUM_SETTINGS; i++) {
+        ctsi_save(i, i);
+    }
+    rc = conf_load();
+    TEST_ASSERT(rc == 0);
+    ctsi_verify(CTSI_NUM_SETTINGS);
+
+    for (i = 0; i < CTSI_NUM_SETTINGS; i += 5) {
+        ctsi_save(i, i + 2000);
+    }
+    ctsi_verify(CTSI_NUM_SETTINGS);
+
+    conf_fcb2_compress(&cf, NULL, NULL);
+    ctsi_verify(CTSI_NUM_SETTINGS);
+}
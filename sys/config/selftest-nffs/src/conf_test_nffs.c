@@ -218,6 +218,7 @@ TEST_SUITE(config_test_all)
 
     config_test_save_one_file();
     config_test_get_stored_file();
+    config_test_compress_file();
 }
 
 int
@@ -66,6 +66,7 @@ TEST_CASE_DECL(config_test_multiple_in_file);
 TEST_CASE_DECL(config_test_save_in_file);
 TEST_CASE_DECL(config_test_save_one_file);
 TEST_CASE_DECL(config_test_get_stored_file);
+TEST_CASE_DECL(config_test_compress_file);
 
 extern struct conf_handler config_test_handler;
 extern const struct nffs_area_desc config_nffs[];
@@ -0,0 +1,131 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+#include <stdlib.h>
+#include "conf_test_nffs.h"
+
+/*
+ * Saves enough lines to a config file to have it compressed several times.
+ * The map size of this selftest makes each compression run in batches.
+ */
+
+#define CTCF_NUM_SETTINGS   20
+#define CTCF_MAX_LINES      24
+
+/* These two names have the same conf_name_hash(). */
+#define CTCF_NAME_A         "cmp/c422789"
+#define CTCF_NAME_B         "cmp/c639192"
+
+static char ctcf_buf[1024];
+
+static void
+ctcf_save(const char *name, int val)
+{
+    char value[16];
+    int rc;
+
+    snprintf(value, sizeof(value), "%d", val);
+    rc = conf_save_one(name, value);
+    TEST_ASSERT_FATAL(rc == 0);
+}
+
+/*
+ * Returns the newest value stored for name in the file, or -1.
+ */
+static int
+ctcf_newest(const char *fname, const char *name, int *lines)
+{
+    char *line;
+    char *next;
+    char *name1;
+    char *val1;
+    uint32_t len;
+    int val;
+    int rc;
+
+    rc = fsutil_read_file(fname, 0, sizeof(ctcf_buf) - 1, ctcf_buf, &len);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT_FATAL(len < sizeof(ctcf_buf) - 1);
+    ctcf_buf[len] = '\0';
+
+    val = -1;
+    *lines = 0;
+    for (line = ctcf_buf; *line != '\0'; line = next) {
+        next = strchr(line, '\n');
+        TEST_ASSERT_FATAL(next);
+        *next++ = '\0';
+        (*lines)++;
+
+        rc = conf_line_parse(line, &name1, &val1);
+        TEST_ASSERT_FATAL(rc == 0);
+        if (!strcmp(name1, name)) {
+            val = atoi(val1);
+        }
+    }
+    return val;
+}
+
+TEST_CASE_SELF(config_test_compress_file)
+{
+    struct conf_file cf;
+    char name[CONF_MAX_NAME_LEN];
+    int lines;
+    int rc;
+    int i;
+
+    /* Drop the stores registered by earlier test cases. */
+    SLIST_INIT(&conf_load_srcs);
+    conf_save_dst = NULL;
+
+    rc = fs_mkdir("/config");
+    TEST_ASSERT(rc == 0 || rc == FS_EEXIST);
+
+    memset(&cf, 0, sizeof(cf));
+    cf.cf_name = "/config/cmp";
+    cf.cf_maxlines = CTCF_MAX_LINES;
+    rc = conf_file_src(&cf);
+    TEST_ASSERT(rc == 0);
+    rc = conf_file_dst(&cf);
+    TEST_ASSERT(rc == 0);
+
+    /*
+     * The first compression finds the map entry for CTCF_NAME_B pointing
+     * at the newest CTCF_NAME_A, and has to scan the file for CTCF_NAME_B.
+     */
+    ctcf_save(CTCF_NAME_A, 1);
+    ctcf_save(CTCF_NAME_B, 1);
+    ctcf_save(CTCF_NAME_A, 2);
+
+    for (i = 0; i < CTCF_NUM_SETTINGS; i++) {
+        snprintf(name, sizeof(name), "cmp/s%d", i);
+        ctcf_save(name, 1);
+    }
+    for (i = 0; i < CTCF_NUM_SETTINGS; i += 2) {
+        snprintf(name, sizeof(name), "cmp/s%d", i);
+        ctcf_save(name, 2);
+    }
+    TEST_ASSERT(cf.cf_lines < CTCF_MAX_LINES);
+
+    for (i = 0; i < CTCF_NUM_SETTINGS; i++) {
+        snprintf(name, sizeof(name), "cmp/s%d", i);
+        TEST_ASSERT(ctcf_newest(cf.cf_name, name, &lines) == 2 - i % 2);
+    }
+    TEST_ASSERT(ctcf_newest(cf.cf_name, CTCF_NAME_A, &lines) == 2);
+    TEST_ASSERT(ctcf_newest(cf.cf_name, CTCF_NAME_B, &lines) == 1);
+    TEST_ASSERT(lines == cf.cf_lines);
+}
@@ -45,6 +45,7 @@ conf_init(void)
     int rc;
 
     os_mutex_init(&conf_mtx);
+    os_mutex_stats_register(&conf_mtx, "conf");
 
     SLIST_INIT(&conf_handlers);
     conf_store_init();
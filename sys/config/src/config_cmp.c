@@ -0,0 +1,128 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "os/mynewt.h"
+
+#include <string.h>
+
+#include "config/config.h"
+#include "config_priv.h"
+
+uint32_t
+conf_name_hash(const char *name)
+{
+    uint32_t hash;
+
+    /* FNV-1a.  Zero marks an unused map slot, so it is never returned. */
+    hash = 2166136261UL;
+    while (*name != '\0') {
+        hash ^= (uint8_t)*name++;
+        hash *= 16777619UL;
+    }
+
+    return hash ? hash : 1;
+}
+
+#if MYNEWT_VAL(CONFIG_FCB) || MYNEWT_VAL(CONFIG_FCB2) || MYNEWT_VAL(CONFIG_NFFS)
+
+/*
+ * Map from setting name hash to the location of the most recent entry
+ * carrying that hash.  Compression inserts the entries it may copy, walks
+ * the store once to find the newest location of each, and then only copies
+ * entries that are still the newest.  If more entries are candidates for
+ * copying than fit, the store is compressed in several batches.  Callers
+ * hold conf_lock() for as long as the map is in use.
+ */
+#define CONF_CMP_MAP_SIZE       MYNEWT_VAL(CONFIG_COMPRESS_MAP_SIZE)
+
+#if CONF_CMP_MAP_SIZE > 0
+static struct conf_cmp_slot {
+    uint32_t ccs_hash;
+    struct conf_store_loc ccs_loc;
+} conf_cmp_slots[CONF_CMP_MAP_SIZE];
+#endif
+
+#if CONF_CMP_MAP_SIZE > 0
+static struct conf_cmp_slot *
+conf_cmp_map_find(uint32_t hash, bool insert)
+{
+    struct conf_cmp_slot *slot;
+    int idx;
+    int i;
+
+    idx = hash % CONF_CMP_MAP_SIZE;
+    for (i = 0; i < CONF_CMP_MAP_SIZE; i++) {
+        slot = &conf_cmp_slots[idx];
+        if (slot->ccs_hash == hash) {
+            return slot;
+        }
+        if (slot->ccs_hash == 0) {
+            if (!insert) {
+                return NULL;
+            }
+            slot->ccs_hash = hash;
+            return slot;
+        }
+        if (++idx == CONF_CMP_MAP_SIZE) {
+            idx = 0;
+        }
+    }
+
+    return NULL;
+}
+#endif
+
+void
+conf_cmp_map_clear(void)
+{
+#if CONF_CMP_MAP_SIZE > 0
+    memset(conf_cmp_slots, 0, sizeof(conf_cmp_slots));
+#endif
+}
+
+int
+conf_cmp_map_set(uint32_t hash, const struct conf_store_loc *loc, bool insert)
+{
+#if CONF_CMP_MAP_SIZE > 0
+    struct conf_cmp_slot *slot;
+
+    slot = conf_cmp_map_find(hash, insert);
+    if (slot) {
+        slot->ccs_loc = *loc;
+        return 0;
+    }
+#endif
+    return insert ? OS_ENOMEM : 0;
+}
+
+const struct conf_store_loc *
+conf_cmp_map_get(uint32_t hash)
+{
+#if CONF_CMP_MAP_SIZE > 0
+    struct conf_cmp_slot *slot;
+
+    slot = conf_cmp_map_find(hash, false);
+    if (slot) {
+        return &slot->ccs_loc;
+    }
+#endif
+    return NULL;
+}
+
+#endif
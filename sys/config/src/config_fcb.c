@@ -22,6 +22,7 @@
 #if MYNEWT_VAL(CONFIG_FCB)
 
 #include <fcb/fcb.h>
+#include <limits.h>
 #include <string.h>
 
 #include "config/config.h"
@@ -33,6 +34,7 @@
 #define CONF_FCB_VERS		1
 
 struct conf_fcb_load_cb_arg {
+    struct conf_store *cs;
     conf_store_load_cb cb;
     void *cb_arg;
 };
@@ -47,10 +49,13 @@ static int conf_fcb_load(struct conf_store *, conf_store_load_cb cb,
                          void *cb_arg);
 static int conf_fcb_save(struct conf_store *, const char *name,
                          const char *value);
+static int conf_fcb_read(struct conf_store *, const struct conf_store_loc *loc,
+                         char *buf, int len);
 
 static struct conf_store_itf conf_fcb_itf = {
     .csi_load = conf_fcb_load,
     .csi_save = conf_fcb_save,
+    .csi_read = conf_fcb_read,
 };
 
 int
@@ -83,6 +88,7 @@ conf_fcb_src(struct conf_fcb *cf)
         }
     }
 
+    os_mutex_stats_register(&cf->cf_fcb.f_mtx, "conf_fcb");
     cf->cf_store.cs_itf = &conf_fcb_itf;
     conf_src_register(&cf->cf_store);
 
@@ -92,17 +98,28 @@ conf_fcb_src(struct conf_fcb *cf)
 int
 conf_fcb_dst(struct conf_fcb *cf)
 {
+    os_mutex_stats_register(&cf->cf_fcb.f_mtx, "conf_fcb");
     cf->cf_store.cs_itf = &conf_fcb_itf;
     conf_dst_register(&cf->cf_store);
 
     return OS_OK;
 }
 
+static void
+conf_fcb_store_loc(struct fcb_entry *loc, struct conf_store_loc *sloc)
+{
+    sloc->csl_area = loc->fe_area;
+    sloc->csl_off = loc->fe_data_off;
+    sloc->csl_len = loc->fe_data_len;
+    sloc->csl_sector = 0;
+}
+
 static int
 conf_fcb_load_cb(struct fcb_entry *loc, void *arg)
 {
     struct conf_fcb_load_cb_arg *argp;
     char buf[CONF_MAX_NAME_LEN + CONF_MAX_VAL_LEN + 32];
+    struct conf_store_loc sloc;
     char *name_str;
     char *val_str;
     int rc;
@@ -125,6 +142,8 @@ conf_fcb_load_cb(struct fcb_entry *loc, void *arg)
     if (rc) {
         return 0;
     }
+    conf_fcb_store_loc(loc, &sloc);
+    conf_index_loaded(argp->cs, name_str, &sloc);
     argp->cb(name_str, val_str, argp->cb_arg);
     return 0;
 }
@@ -136,6 +155,7 @@ conf_fcb_load(struct conf_store *cs, conf_store_load_cb cb, void *cb_arg)
     struct conf_fcb_load_cb_arg arg;
     int rc;
 
+    arg.cs = cs;
     arg.cb = cb;
     arg.cb_arg = cb_arg;
     rc = fcb_walk(&cf->cf_fcb, 0, conf_fcb_load_cb, &arg);
@@ -145,6 +165,25 @@ conf_fcb_load(struct conf_store *cs, conf_store_load_cb cb, void *cb_arg)
     return OS_OK;
 }
 
+static int
+conf_fcb_read(struct conf_store *cs, const struct conf_store_loc *loc,
+              char *buf, int len)
+{
+    int rc;
+
+    if (loc->csl_len < len) {
+        len = loc->csl_len;
+    } else {
+        len--;
+    }
+    rc = flash_area_read(loc->csl_area, loc->csl_off, buf, len);
+    if (rc) {
+        return OS_EINVAL;
+    }
+    buf[len] = '\0';
+    return OS_OK;
+}
+
 static int
 conf_fcb_var_read(struct fcb_entry *loc, char *buf, char **name, char **val)
 {
@@ -159,6 +198,90 @@ conf_fcb_var_read(struct fcb_entry *loc, char *buf, char **name, char **val)
     return rc;
 }
 
+struct conf_fcb_cmp_map_arg {
+    struct fcb *fcb;
+    char *buf;
+    int seq;        /* Position of the next entry in the oldest sector. */
+    int start;      /* First oldest sector entry of this batch. */
+    int end;        /* First oldest sector entry that did not fit. */
+};
+
+/*
+ * First compression pass: insert this batch of oldest sector entries into
+ * the map, and record the newest location of every name in it.
+ */
+static int
+conf_fcb_cmp_map_cb(struct fcb_entry *loc, void *arg)
+{
+    struct conf_fcb_cmp_map_arg *argp = arg;
+    struct conf_store_loc sloc;
+    char *name, *val;
+    bool insert;
+    int seq;
+    int rc;
+
+    insert = false;
+    seq = 0;
+    if (loc->fe_area == argp->fcb->f_oldest) {
+        seq = argp->seq++;
+        insert = seq >= argp->start && seq < argp->end;
+    }
+
+    rc = conf_fcb_var_read(loc, argp->buf, &name, &val);
+    if (rc) {
+        return 0;
+    }
+    conf_fcb_store_loc(loc, &sloc);
+    rc = conf_cmp_map_set(conf_name_hash(name), &sloc, insert);
+    if (rc) {
+        argp->end = seq;
+    }
+    return 0;
+}
+
+/*
+ * Returns 1 if there is no entry for the same name after loc1.  buf is
+ * scratch space.
+ */
+static int
+conf_fcb_is_newest(struct fcb *fcb, struct fcb_entry *loc1,
+                   const char *name1, char *buf)
+{
+    const struct conf_store_loc *newest;
+    struct conf_store_loc sloc;
+    struct fcb_entry loc2;
+    char *name2, *val2;
+    int rc;
+
+    conf_fcb_store_loc(loc1, &sloc);
+    newest = conf_cmp_map_get(conf_name_hash(name1));
+    if (newest) {
+        if (conf_store_loc_eq(newest, &sloc)) {
+            return 1;
+        }
+        loc2.fe_area = newest->csl_area;
+        loc2.fe_data_off = newest->csl_off;
+        loc2.fe_data_len = newest->csl_len;
+        rc = conf_fcb_var_read(&loc2, buf, &name2, &val2);
+        if (rc == 0 && !strcmp(name1, name2)) {
+            return 0;
+        }
+        /* Hash collision; fall back to scanning. */
+    }
+
+    loc2 = *loc1;
+    while (fcb_getnext(fcb, &loc2) == 0) {
+        rc = conf_fcb_var_read(&loc2, buf, &name2, &val2);
+        if (rc) {
+            continue;
+        }
+        if (!strcmp(name1, name2)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
 static void
 conf_fcb_compress_internal(struct fcb *fcb,
                            int (*copy_or_not)(const char *name, const char *val,
@@ -168,87 +291,105 @@ conf_fcb_compress_internal(struct fcb *fcb,
     int rc;
     char buf1[CONF_MAX_NAME_LEN + CONF_MAX_VAL_LEN + 32];
     char buf2[CONF_MAX_NAME_LEN + CONF_MAX_VAL_LEN + 32];
+    struct conf_fcb_cmp_map_arg map_arg;
     struct fcb_entry loc1;
-    struct fcb_entry loc2;
+    struct fcb_iovec iov;
     char *name1, *val1;
-    char *name2, *val2;
-    int copy;
+    int start;
+    int end;
+    int seq;
 
     rc = fcb_append_to_scratch(fcb);
     if (rc) {
         return; /* XXX */
     }
 
-    loc1.fe_area = NULL;
-    loc1.fe_elem_off = 0;
-    while (fcb_getnext(fcb, &loc1) == 0) {
-        if (loc1.fe_area != fcb->f_oldest) {
-            break;
-        }
-        rc = conf_fcb_var_read(&loc1, buf1, &name1, &val1);
-        if (rc) {
-            continue;
-        }
-        if (!val1) {
-            continue;
+    conf_lock();
+
+    /* Entries are about to move. */
+    conf_index_reset();
+
+    start = 0;
+    do {
+        conf_cmp_map_clear();
+        map_arg.fcb = fcb;
+        map_arg.buf = buf2;
+        map_arg.seq = 0;
+        map_arg.start = start;
+        map_arg.end = INT_MAX;
+        fcb_walk(fcb, NULL, conf_fcb_cmp_map_cb, &map_arg);
+
+        end = map_arg.end;
+        if (end == start) {
+            /* Nothing fits in the map; scan for every entry instead. */
+            end = INT_MAX;
         }
-        loc2 = loc1;
-        copy = 1;
-        while (fcb_getnext(fcb, &loc2) == 0) {
-            rc = conf_fcb_var_read(&loc2, buf2, &name2, &val2);
+
+        seq = 0;
+        loc1.fe_area = NULL;
+        loc1.fe_elem_off = 0;
+        while (fcb_getnext(fcb, &loc1) == 0) {
+            if (loc1.fe_area != fcb->f_oldest || seq >= end) {
+                break;
+            }
+            if (seq++ < start) {
+                continue;
+            }
+            rc = conf_fcb_var_read(&loc1, buf1, &name1, &val1);
             if (rc) {
                 continue;
             }
-            if (!strcmp(name1, name2)) {
-                copy = 0;
-                break;
+            if (!val1) {
+                continue;
+            }
+            if (!conf_fcb_is_newest(fcb, &loc1, name1, buf2)) {
+                continue;
             }
-        }
-        if (!copy) {
-            continue;
-        }
 
-        if (copy_or_not) {
-            if (copy_or_not(name1, val1, cn_arg)) {
-                /* Copy rejected */
+            if (copy_or_not) {
+                if (copy_or_not(name1, val1, cn_arg)) {
+                    /* Copy rejected */
+                    continue;
+                }
+            }
+            /*
+             * Can't find one. Must copy.
+             */
+            rc = flash_area_read(loc1.fe_area, loc1.fe_data_off, buf1,
+              loc1.fe_data_len);
+            if (rc) {
+                continue;
+            }
+            iov.fi_data = buf1;
+            iov.fi_len = loc1.fe_data_len;
+            rc = fcb_append_iov(fcb, &iov, 1, NULL);
+            if (rc) {
                 continue;
             }
         }
-        /*
-         * Can't find one. Must copy.
-         */
-        rc = flash_area_read(loc1.fe_area, loc1.fe_data_off, buf1,
-          loc1.fe_data_len);
-        if (rc) {
-            continue;
-        }
-        rc = fcb_append(fcb, loc1.fe_data_len, &loc2);
-        if (rc) {
-            continue;
-        }
-        rc = flash_area_write(loc2.fe_area, loc2.fe_data_off, buf1,
-          loc1.fe_data_len);
-        if (rc) {
-            continue;
-        }
-        fcb_append_finish(fcb, &loc2);
-    }
+        start = end;
+    } while (end != INT_MAX);
+
     rc = fcb_rotate(fcb);
     if (rc) {
         /* XXXX */
         ;
     }
+
+    conf_unlock();
 }
 
 static int
-conf_fcb_append(struct fcb *fcb, char *buf, int len)
+conf_fcb_append(struct fcb *fcb, char *buf, int len, struct fcb_entry *loc)
 {
     int rc;
     int i;
-    struct fcb_entry loc;
+    struct fcb_iovec iov;
 
+    iov.fi_data = buf;
+    iov.fi_len = len;
     for (i = 0; i < 10; i++) {
-        rc = fcb_append(fcb, len, &loc);
+        rc = fcb_append_iov(fcb, &iov, 1, loc);
         if (rc != FCB_ERR_NOSPACE) {
             break;
         }
@@ -260,20 +401,41 @@ conf_fcb_append(struct fcb *fcb, char *buf, int len)
     if (rc) {
         return OS_EINVAL;
     }
-    rc = flash_area_write(loc.fe_area, loc.fe_data_off, buf, len);
-    if (rc) {
-        return OS_EINVAL;
-    }
-    fcb_append_finish(fcb, &loc);
     return OS_OK;
 }
 
+static int
+conf_fcb_line_save(struct fcb *fcb, const char *name, const char *value,
+                   struct fcb_entry *loc)
+{
+    char buf[CONF_MAX_NAME_LEN + CONF_MAX_VAL_LEN + 32];
+    int len;
+
+    if (!name) {
+        return OS_INVALID_PARM;
+    }
+
+    len = conf_line_make(buf, sizeof(buf), name, value);
+    if (len < 0 || len + 2 > sizeof(buf)) {
+        return OS_INVALID_PARM;
+    }
+    return conf_fcb_append(fcb, buf, len, loc);
+}
+
 static int
 conf_fcb_save(struct conf_store *cs, const char *name, const char *value)
 {
     struct conf_fcb *cf = (struct conf_fcb *)cs;
+    struct conf_store_loc sloc;
+    struct fcb_entry loc;
+    int rc;
 
-    return conf_fcb_kv_save(&cf->cf_fcb, name, value);
+    rc = conf_fcb_line_save(&cf->cf_fcb, name, value, &loc);
+    if (rc == 0) {
+        conf_fcb_store_loc(&loc, &sloc);
+        conf_index_saved(cs, name, &sloc);
+    }
+    return rc;
 }
 
 void
@@ -339,21 +501,38 @@ conf_fcb_kv_load(struct fcb *fcb, const char *name, char *value, size_t len)
     return OS_OK;
 }
 
-int
-conf_fcb_kv_save(struct fcb *fcb, const char *name, const char *value)
+/*
+ * Returns true if fcb is the flash of a registered config store.
+ */
+static bool
+conf_fcb_is_store(struct fcb *fcb)
 {
-    char buf[CONF_MAX_NAME_LEN + CONF_MAX_VAL_LEN + 32];
-    int len;
+    struct conf_store *cs;
 
-    if (!name) {
-        return OS_INVALID_PARM;
+    cs = conf_save_dst;
+    if (cs && cs->cs_itf == &conf_fcb_itf &&
+        &((struct conf_fcb *)cs)->cf_fcb == fcb) {
+        return true;
+    }
+    SLIST_FOREACH(cs, &conf_load_srcs, cs_next) {
+        if (cs->cs_itf == &conf_fcb_itf &&
+            &((struct conf_fcb *)cs)->cf_fcb == fcb) {
+            return true;
+        }
     }
+    return false;
+}
 
-    len = conf_line_make(buf, sizeof(buf), name, value);
-    if (len < 0 || len + 2 > sizeof(buf)) {
-        return OS_INVALID_PARM;
+int
+conf_fcb_kv_save(struct fcb *fcb, const char *name, const char *value)
+{
+    conf_lock();
+    if (conf_fcb_is_store(fcb)) {
+        /* This save bypasses the store, and so its index. */
+        conf_index_reset();
     }
-    return conf_fcb_append(fcb, buf, len);
+    conf_unlock();
+    return conf_fcb_line_save(fcb, name, value, NULL);
 }
 
 #endif
@@ -21,6 +21,7 @@
 
 #if MYNEWT_VAL(CONFIG_NFFS)
 
+#include <limits.h>
 #include <string.h>
 #include <assert.h>
 
@@ -34,10 +35,13 @@ static int conf_file_load(struct conf_store *, conf_store_load_cb cb,
                           void *cb_arg);
 static int conf_file_save(struct conf_store *, const char *name,
   const char *value);
+static int conf_file_read(struct conf_store *,
+  const struct conf_store_loc *loc, char *buf, int len);
 
 static struct conf_store_itf conf_file_itf = {
     .csi_load = conf_file_load,
     .csi_save = conf_file_save,
+    .csi_read = conf_file_read,
 };
 
 /*
@@ -109,6 +113,7 @@ conf_file_load(struct conf_store *cs, conf_store_load_cb cb, void *cb_arg)
 {
     struct conf_file *cf = (struct conf_file *)cs;
     struct fs_file *file;
+    struct conf_store_loc sloc;
     uint32_t loc;
     char tmpbuf[CONF_MAX_NAME_LEN + CONF_MAX_VAL_LEN + 32];
     char *name_str;
@@ -121,9 +126,11 @@ conf_file_load(struct conf_store *cs, conf_store_load_cb cb, void *cb_arg)
         return OS_EINVAL;
     }
 
+    memset(&sloc, 0, sizeof(sloc));
     loc = 0;
     lines = 0;
     while (1) {
+        sloc.csl_off = loc;
         rc = conf_getnext_line(file, tmpbuf, sizeof(tmpbuf), &loc);
         if (loc == 0) {
             break;
@@ -136,6 +143,7 @@ conf_file_load(struct conf_store *cs, conf_store_load_cb cb, void *cb_arg)
             continue;
         }
         lines++;
+        conf_index_loaded(cs, name_str, &sloc);
         cb(name_str, val_str, cb_arg);
     }
     fs_close(file);
@@ -143,6 +151,30 @@ conf_file_load(struct conf_store *cs, conf_store_load_cb cb, void *cb_arg)
     return OS_OK;
 }
 
+/*
+ * Reads back the line at an offset recorded by the stored value index.
+ */
+static int
+conf_file_read(struct conf_store *cs, const struct conf_store_loc *loc,
+               char *buf, int len)
+{
+    struct conf_file *cf = (struct conf_file *)cs;
+    struct fs_file *file;
+    uint32_t off;
+    int rc;
+
+    if (fs_open(cf->cf_name, FS_ACCESS_READ, &file) != FS_EOK) {
+        return OS_EINVAL;
+    }
+    off = loc->csl_off;
+    rc = conf_getnext_line(file, buf, len, &off);
+    fs_close(file);
+    if (rc < 0) {
+        return OS_EINVAL;
+    }
+    return OS_OK;
+}
+
 static void
 conf_tmpfile(char *dst, const char *src, char *pfx)
 {
@@ -159,6 +191,86 @@ conf_tmpfile(char *dst, const char *src, char *pfx)
     dst[len + pfx_len] = '\0';
 }
 
+/*
+ * First compression pass: insert the names of lines start and onwards into
+ * the map, and record the offset of the newest line for each of them.
+ * Returns the number of the first line that did not fit, or INT_MAX.
+ */
+static int
+conf_file_cmp_map(struct fs_file *rf, int start, char *buf, int blen)
+{
+    struct conf_store_loc sloc;
+    uint32_t loc;
+    char *name, *val;
+    int end;
+    int seq;
+    int len;
+    int rc;
+
+    conf_cmp_map_clear();
+    memset(&sloc, 0, sizeof(sloc));
+
+    loc = 0;
+    end = INT_MAX;
+    for (seq = 0; ; seq++) {
+        sloc.csl_off = loc;
+        len = conf_getnext_line(rf, buf, blen, &loc);
+        if (loc == 0 || len < 0) {
+            break;
+        }
+        rc = conf_line_parse(buf, &name, &val);
+        if (rc) {
+            continue;
+        }
+        rc = conf_cmp_map_set(conf_name_hash(name), &sloc,
+                              seq >= start && seq < end);
+        if (rc) {
+            end = seq;
+        }
+    }
+    return end;
+}
+
+/*
+ * Returns 1 if there is no line for the same name after the one at offset
+ * loc1 (which ends at next1).  buf is scratch space.
+ */
+static int
+conf_file_is_newest(struct fs_file *rf, uint32_t loc1, uint32_t next1,
+                    const char *name1, char *buf, int blen)
+{
+    const struct conf_store_loc *newest;
+    uint32_t loc2;
+    char *name2, *val2;
+    int rc;
+
+    newest = conf_cmp_map_get(conf_name_hash(name1));
+    if (newest) {
+        if (newest->csl_off == loc1) {
+            return 1;
+        }
+        loc2 = newest->csl_off;
+        if (conf_getnext_line(rf, buf, blen, &loc2) >= 0 &&
+            conf_line_parse(buf, &name2, &val2) == 0 &&
+            !strcmp(name1, name2)) {
+            return 0;
+        }
+        /* Hash collision; fall back to scanning. */
+    }
+
+    loc2 = next1;
+    while (conf_getnext_line(rf, buf, blen, &loc2) > 0) {
+        rc = conf_line_parse(buf, &name2, &val2);
+        if (rc) {
+            continue;
+        }
+        if (!strcmp(name1, name2)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
 /*
  * Try to compress configuration file by keeping unique names only.
  */
@@ -171,12 +283,13 @@ conf_file_compress(struct conf_file *cf)
     char tmp_file[CONF_FILE_NAME_MAX];
     char buf1[CONF_MAX_NAME_LEN + CONF_MAX_VAL_LEN + 32];
     char buf2[CONF_MAX_NAME_LEN + CONF_MAX_VAL_LEN + 32];
-    uint32_t loc1, loc2;
+    uint32_t loc1, next1;
     char *name1, *val1;
-    char *name2, *val2;
-    int copy;
-    int len, len2;
+    int len;
     int lines;
+    int start;
+    int end;
+    int seq;
 
     if (fs_open(cf->cf_name, FS_ACCESS_READ, &rf) != FS_EOK) {
         return;
@@ -187,52 +300,63 @@ conf_file_compress(struct conf_file *cf)
         return;
     }
 
-    loc1 = 0;
+    conf_lock();
+
+    /* Lines are about to move. */
+    conf_index_reset();
+
     lines = 0;
-    while (1) {
-        len = conf_getnext_line(rf, buf1, sizeof(buf1), &loc1);
-        if (loc1 == 0 || len < 0) {
-            break;
+    start = 0;
+    do {
+        end = conf_file_cmp_map(rf, start, buf1, sizeof(buf1));
+        if (end == start) {
+            /* Nothing fits in the map; scan for every line instead. */
+            end = INT_MAX;
         }
-        rc = conf_line_parse(buf1, &name1, &val1);
-        if (rc) {
-            continue;
-        }
-        if (!val1) {
-            continue;
-        }
-        loc2 = loc1;
-        copy = 1;
-        while ((len2 = conf_getnext_line(rf, buf2, sizeof(buf2), &loc2)) > 0) {
-            rc = conf_line_parse(buf2, &name2, &val2);
+
+        next1 = 0;
+        for (seq = 0; seq < end; seq++) {
+            loc1 = next1;
+            len = conf_getnext_line(rf, buf1, sizeof(buf1), &next1);
+            if (next1 == 0 || len < 0) {
+                break;
+            }
+            if (seq < start) {
+                continue;
+            }
+            rc = conf_line_parse(buf1, &name1, &val1);
             if (rc) {
                 continue;
             }
-            if (!strcmp(name1, name2)) {
-                copy = 0;
-                break;
+            if (!val1) {
+                continue;
+            }
+            if (!conf_file_is_newest(rf, loc1, next1, name1, buf2,
+                                     sizeof(buf2))) {
+                continue;
             }
-        }
-        if (!copy) {
-            continue;
-        }
 
-        /*
-         * Can't find one. Must copy.
-         */
-        len = conf_line_make(buf2, sizeof(buf2), name1, val1);
-        if (len < 0 || len + 2 > sizeof(buf2)) {
-            continue;
+            /*
+             * Can't find one. Must copy.
+             */
+            len = conf_line_make(buf2, sizeof(buf2), name1, val1);
+            if (len < 0 || len + 2 > sizeof(buf2)) {
+                continue;
+            }
+            buf2[len++] = '\n';
+            fs_write(wf, buf2, len);
+            lines++;
         }
-        buf2[len++] = '\n';
-        fs_write(wf, buf2, len);
-	lines++;
-    }
+        start = end;
+    } while (end != INT_MAX);
+
     fs_close(wf);
     fs_close(rf);
     fs_unlink(cf->cf_name);
     fs_rename(tmp_file, cf->cf_name);
     cf->cf_lines = lines;
+
+    conf_unlock();
     /*
      * XXX at conf_file_load(), look for .cmp if actual file does not
      * exist.
@@ -246,8 +370,10 @@ static int
 conf_file_save(struct conf_store *cs, const char *name, const char *value)
 {
     struct conf_file *cf = (struct conf_file *)cs;
+    struct conf_store_loc sloc;
     struct fs_file *file;
     char buf[CONF_MAX_NAME_LEN + CONF_MAX_VAL_LEN + 32];
+    uint32_t off;
     int len;
     int rc;
 
@@ -273,11 +399,14 @@ conf_file_save(struct conf_store *cs, const char *name, const char *value)
     if (fs_open(cf->cf_name, FS_ACCESS_WRITE | FS_ACCESS_APPEND, &file)) {
         return OS_EINVAL;
     }
-    if (fs_write(file, buf, len)) {
+    if (fs_filelen(file, &off) || fs_write(file, buf, len)) {
         rc = OS_EINVAL;
     } else {
         rc = 0;
         cf->cf_lines++;
+        memset(&sloc, 0, sizeof(sloc));
+        sloc.csl_off = off;
+        conf_index_saved(cs, name, &sloc);
     }
     fs_close(file);
     return rc;
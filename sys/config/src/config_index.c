@@ -0,0 +1,240 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <string.h>
+
+#include "os/mynewt.h"
+#include "config/config.h"
+#include "config/config_store.h"
+#include "config_priv.h"
+
+/*
+ * Map from setting name hash to the store and location of the newest entry
+ * carrying that hash.  The index is built while conf_load() replays the
+ * stores, and is only used if every source store implements csi_read.  As
+ * long as every name fits, a name missing from the index is not stored at
+ * all.  Callers hold conf_lock().
+ */
+#define CONF_INDEX_SIZE         MYNEWT_VAL(CONFIG_STORE_INDEX_SIZE)
+
+#if CONF_INDEX_SIZE > 0
+static struct conf_index_slot {
+    uint32_t cis_hash;
+    struct conf_store *cis_store;
+    struct conf_store_loc cis_loc;
+} conf_index_slots[CONF_INDEX_SIZE];
+
+static enum {
+    CONF_INDEX_OFF,             /* Not loaded, or a store can't read back */
+    CONF_INDEX_STALE,           /* Rebuilt on next use */
+    CONF_INDEX_BUILDING,
+    CONF_INDEX_VALID,
+} conf_index_state;
+static bool conf_index_full;
+
+static struct conf_index_slot *
+conf_index_find(uint32_t hash, bool insert)
+{
+    struct conf_index_slot *slot;
+    int idx;
+    int i;
+
+    idx = hash % CONF_INDEX_SIZE;
+    for (i = 0; i < CONF_INDEX_SIZE; i++) {
+        slot = &conf_index_slots[idx];
+        if (slot->cis_hash == hash) {
+            return slot;
+        }
+        if (slot->cis_hash == 0) {
+            if (!insert) {
+                return NULL;
+            }
+            slot->cis_hash = hash;
+            return slot;
+        }
+        if (++idx == CONF_INDEX_SIZE) {
+            idx = 0;
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * Returns true if an entry in store cs takes precedence over one in store
+ * cur, i.e. cs is a source store loaded no earlier than cur.
+ */
+static bool
+conf_index_overrides(struct conf_store *cs, struct conf_store *cur)
+{
+    struct conf_store *iter;
+    bool cur_seen;
+
+    cur_seen = (cur == NULL);
+    SLIST_FOREACH(iter, &conf_load_srcs, cs_next) {
+        if (iter == cur) {
+            cur_seen = true;
+        }
+        if (iter == cs) {
+            return cur_seen;
+        }
+    }
+    return false;
+}
+#endif
+
+void
+conf_index_init(void)
+{
+#if CONF_INDEX_SIZE > 0
+    conf_index_state = CONF_INDEX_OFF;
+#endif
+}
+
+/*
+ * Called before replaying every source store, and conf_index_done() after.
+ */
+void
+conf_index_start(void)
+{
+#if CONF_INDEX_SIZE > 0
+    struct conf_store *cs;
+
+    memset(conf_index_slots, 0, sizeof(conf_index_slots));
+    conf_index_full = false;
+    conf_index_state = CONF_INDEX_OFF;
+    SLIST_FOREACH(cs, &conf_load_srcs, cs_next) {
+        if (!cs->cs_itf->csi_read) {
+            return;
+        }
+    }
+    conf_index_state = CONF_INDEX_BUILDING;
+#endif
+}
+
+void
+conf_index_done(void)
+{
+#if CONF_INDEX_SIZE > 0
+    if (conf_index_state == CONF_INDEX_BUILDING) {
+        conf_index_state = CONF_INDEX_VALID;
+    }
+#endif
+}
+
+void
+conf_index_reset(void)
+{
+#if CONF_INDEX_SIZE > 0
+    if (conf_index_state != CONF_INDEX_OFF) {
+        conf_index_state = CONF_INDEX_STALE;
+    }
+#endif
+}
+
+#if CONF_INDEX_SIZE > 0
+static void
+conf_index_set(struct conf_store *cs, const char *name,
+               const struct conf_store_loc *loc)
+{
+    struct conf_index_slot *slot;
+    uint32_t hash;
+
+    hash = conf_name_hash(name);
+    slot = conf_index_find(hash, false);
+    if (!slot && conf_index_full) {
+        return;
+    }
+    if (!conf_index_overrides(cs, slot ? slot->cis_store : NULL)) {
+        return;
+    }
+    if (!slot) {
+        slot = conf_index_find(hash, true);
+        if (!slot) {
+            conf_index_full = true;
+            return;
+        }
+    }
+    slot->cis_store = cs;
+    slot->cis_loc = *loc;
+}
+#endif
+
+void
+conf_index_loaded(struct conf_store *cs, const char *name,
+                  const struct conf_store_loc *loc)
+{
+#if CONF_INDEX_SIZE > 0
+    if (conf_index_state == CONF_INDEX_BUILDING) {
+        conf_index_set(cs, name, loc);
+    }
+#endif
+}
+
+void
+conf_index_saved(struct conf_store *cs, const char *name,
+                 const struct conf_store_loc *loc)
+{
+#if CONF_INDEX_SIZE > 0
+    if (conf_index_state == CONF_INDEX_BUILDING ||
+        conf_index_state == CONF_INDEX_VALID) {
+        conf_index_set(cs, name, loc);
+    }
+#endif
+}
+
+int
+conf_index_load(const char *name, conf_store_load_cb cb, void *cb_arg)
+{
+#if CONF_INDEX_SIZE > 0
+    char buf[CONF_MAX_NAME_LEN + CONF_MAX_VAL_LEN + 32];
+    struct conf_index_slot *slot;
+    struct conf_store *cs;
+    char *name2, *val2;
+    int rc;
+
+    if (conf_index_state == CONF_INDEX_STALE) {
+        /* Rebuild from the scan the caller is about to do. */
+        conf_index_start();
+    }
+    if (conf_index_state != CONF_INDEX_VALID) {
+        return OS_ENOENT;
+    }
+
+    slot = conf_index_find(conf_name_hash(name), false);
+    if (!slot) {
+        /* Not stored, unless it did not fit. */
+        return conf_index_full ? OS_ENOENT : 0;
+    }
+    cs = slot->cis_store;
+    rc = cs->cs_itf->csi_read(cs, &slot->cis_loc, buf, sizeof(buf));
+    if (rc) {
+        return rc;
+    }
+    rc = conf_line_parse(buf, &name2, &val2);
+    if (rc || strcmp(name, name2)) {
+        /* Hash collision; scan instead. */
+        return OS_ENOENT;
+    }
+    cb(name2, val2, cb_arg);
+    return 0;
+#else
+    return OS_ENOENT;
+#endif
+}
@@ -20,6 +20,11 @@
 #ifndef __CONFIG_PRIV_H_
 #define __CONFIG_PRIV_H_
 
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "config/config_store.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -34,6 +39,50 @@ int conf_line_make2(char *dst, int dlen, const char *name, const char *value);
 struct conf_handler *conf_parse_and_lookup(char *name, int *name_argc,
                                            char *name_argv[]);
 
+/*
+ * Location of a stored config entry, as recorded while compressing a store
+ * or in the stored value index.  The meaning of the fields is up to the
+ * store.
+ */
+struct conf_store_loc {
+    void *csl_area;
+    uint32_t csl_off;
+    uint16_t csl_len;
+    uint16_t csl_sector;
+};
+
+uint32_t conf_name_hash(const char *name);
+void conf_cmp_map_clear(void);
+int conf_cmp_map_set(uint32_t hash, const struct conf_store_loc *loc,
+                     bool insert);
+const struct conf_store_loc *conf_cmp_map_get(uint32_t hash);
+
+static inline bool
+conf_store_loc_eq(const struct conf_store_loc *a, const struct conf_store_loc *b)
+{
+    return a->csl_area == b->csl_area && a->csl_off == b->csl_off &&
+           a->csl_sector == b->csl_sector;
+}
+
+/*
+ * Stored value index.  Stores implementing csi_read report the location of
+ * every entry they load or save with conf_index_loaded() and
+ * conf_index_saved(), and call conf_index_reset() when entries move or are
+ * written behind their back.  conf_index_load() returns 0 if it answered
+ * the lookup, calling cb for the newest entry of name if there is one;
+ * otherwise the caller scans every source store and then calls
+ * conf_index_done().
+ */
+void conf_index_init(void);
+void conf_index_start(void);
+void conf_index_done(void);
+void conf_index_reset(void);
+void conf_index_loaded(struct conf_store *cs, const char *name,
+                       const struct conf_store_loc *loc);
+void conf_index_saved(struct conf_store *cs, const char *name,
+                      const struct conf_store_loc *loc);
+int conf_index_load(const char *name, conf_store_load_cb cb, void *cb_arg);
+
 SLIST_HEAD(conf_store_head, conf_store);
 extern struct conf_store_head conf_load_srcs;
 SLIST_HEAD(conf_handler_head, conf_handler);
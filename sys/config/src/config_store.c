@@ -56,6 +56,7 @@ conf_src_register(struct conf_store *cs)
     } else {
         SLIST_INSERT_AFTER(prev, cs, cs_next);
     }
+    conf_index_reset();
 }
 
 void
@@ -89,8 +90,11 @@ conf_load_one(char *name)
      */
     conf_lock();
     conf_loading = true;
-    SLIST_FOREACH(cs, &conf_load_srcs, cs_next) {
-        cs->cs_itf->csi_load(cs, conf_load_cb, name);
+    if (conf_index_load(name, conf_load_cb, name)) {
+        SLIST_FOREACH(cs, &conf_load_srcs, cs_next) {
+            cs->cs_itf->csi_load(cs, conf_load_cb, name);
+        }
+        conf_index_done();
     }
     conf_loading = false;
     conf_unlock();
@@ -111,12 +115,14 @@ conf_load(void)
     conf_lock();
     conf_loaded = true;
     conf_loading = true;
+    conf_index_start();
     SLIST_FOREACH(cs, &conf_load_srcs, cs_next) {
         cs->cs_itf->csi_load(cs, conf_load_cb, NULL);
         if (SLIST_NEXT(cs, cs_next)) {
             conf_commit(NULL);
         }
     }
+    conf_index_done();
     conf_loading = false;
     conf_unlock();
     return conf_commit(NULL);
@@ -170,8 +176,11 @@ conf_get_stored_value(char *name, char *buf, int buf_len)
      * for every config store
      */
     conf_lock();
-    SLIST_FOREACH(cs, &conf_load_srcs, cs_next) {
-        cs->cs_itf->csi_load(cs, conf_get_value_cb, &cgva);
+    if (conf_index_load(name, conf_get_value_cb, &cgva)) {
+        SLIST_FOREACH(cs, &conf_load_srcs, cs_next) {
+            cs->cs_itf->csi_load(cs, conf_get_value_cb, &cgva);
+        }
+        conf_index_done();
     }
     conf_unlock();
 
@@ -231,8 +240,11 @@ conf_save_one(const char *name, char *value)
     cdca.name = name;
     cdca.val = value;
     cdca.is_dup = 0;
-    SLIST_FOREACH(cs, &conf_load_srcs, cs_next) {
-        cs->cs_itf->csi_load(cs, conf_dup_check_cb, &cdca);
+    if (conf_index_load(name, conf_dup_check_cb, &cdca)) {
+        SLIST_FOREACH(cs, &conf_load_srcs, cs_next) {
+            cs->cs_itf->csi_load(cs, conf_dup_check_cb, &cdca);
+        }
+        conf_index_done();
     }
     if (cdca.is_dup == 1) {
         rc = 0;
@@ -320,4 +332,5 @@ conf_store_init(void)
 {
     conf_loaded = false;
     SLIST_INIT(&conf_load_srcs);
+    conf_index_init();
 }
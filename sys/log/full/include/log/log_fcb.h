@@ -56,6 +56,27 @@ struct log_fcb_bset {
     int lfs_next;
 };
 
+/** Describes the first log entry held by one FCB sector. */
+struct log_fcb_sidx_ent {
+    /** Timestamp of the first log entry in the sector. */
+    int64_t lse_ts;
+
+    /** Index of the first log entry in the sector. */
+    uint32_t lse_index;
+
+    /** Nonzero if this entry reflects the current contents of the sector. */
+    uint8_t lse_valid;
+};
+
+/** A sector index table; entry i describes the FCB's i'th sector. */
+struct log_fcb_sidx {
+    /** Array of index entries. */
+    struct log_fcb_sidx_ent *lsi_ents;
+
+    /** The number of entries in the array. */
+    int lsi_cap;
+};
+
 /**
  * fcb_log is needed as the number of entries in a log
  */
@@ -72,6 +93,9 @@ struct fcb_log {
 #if MYNEWT_VAL(LOG_FCB_BOOKMARKS)
     struct log_fcb_bset fl_bset;
 #endif
+#if MYNEWT_VAL(LOG_FCB_SECTOR_INDEX)
+    struct log_fcb_sidx fl_sidx;
+#endif
 };
 
 #elif MYNEWT_VAL(LOG_FCB2)
@@ -161,6 +185,116 @@ void log_fcb_add_bmark(struct fcb_log *fcb_log, const struct fcb2_entry *entry,
 #endif
 #endif
 
+#if MYNEWT_VAL(LOG_FCB)
+struct log;
+
+/**
+ * @brief Finds the index of the oldest entry in an FCB log whose timestamp
+ * is greater than or equal to the one specified.
+ *
+ * Entry timestamps are assumed to be non-decreasing.  If the sector index is
+ * enabled, only the sector containing the result is scanned.
+ *
+ * @param log                   The log to search.
+ * @param ts                    The timestamp to look for.
+ * @param out_index             On success, the index of the found entry.
+ *
+ * @return                      0 if an entry was found;
+ *                              SYS_ENOENT if there are no suitable entries.
+ *                              Other error on failure.
+ */
+int log_fcb_find_ts(struct log *log, int64_t ts, uint32_t *out_index);
+#endif
+
+#if MYNEWT_VAL(LOG_FCB_SECTOR_INDEX)
+
+/**
+ * The sector index is an optimization for index and time lookups in large
+ * FCB-backed logs.  It records the index and timestamp of the first entry in
+ * every sector.  A lookup binary-searches the table for the sector that holds
+ * the requested entry and only walks the entries of that sector.
+ *
+ * The table is built at registration time by reading one entry header per
+ * sector.  Sectors that gain their first entry later are indexed on demand,
+ * and a sector's entry is dropped when the sector is rotated out.
+ */
+
+/**
+ * @brief Configures an fcb_log to use the specified buffer as its sector
+ * index.  This should be called before the log is registered.
+ *
+ * @param fcb_log               The log to configure.
+ * @param buf                   The buffer to use for the index.
+ * @param ent_count             The number of entries in the supplied buffer.
+ *                                  The index is unused if this is smaller
+ *                                  than the FCB's sector count.
+ */
+void log_fcb_init_sidx(struct fcb_log *fcb_log,
+                       struct log_fcb_sidx_ent *buf, int ent_count);
+
+/**
+ * @brief Invalidates all entries in an fcb_log's sector index.
+ *
+ * @param fcb_log               The fcb_log to clear.
+ */
+void log_fcb_clear_sidx(struct fcb_log *fcb_log);
+
+/**
+ * @brief Invalidates the index entry for the oldest FCB sector.  This is
+ * meant to get called just before the sector is rotated out.
+ *
+ * @param fcb_log               The fcb_log to operate on.
+ */
+void log_fcb_rotate_sidx(struct fcb_log *fcb_log);
+
+/**
+ * @brief Reads the first entry of every sector in use and records it in the
+ * log's sector index.
+ *
+ * @param log                   The log to index.
+ *
+ * @return                      0 on success; nonzero on failure.
+ */
+int log_fcb_fill_sidx(struct log *log);
+
+/**
+ * @brief Uses the sector index to find where a search for the specified
+ * entry index should begin.
+ *
+ * @param log                   The log to search.
+ * @param index                 The log entry index to look for.
+ * @param out_entry             On success, the first entry of the sector
+ *                                  that holds the requested index.
+ *
+ * @return                      0 on success;
+ *                              SYS_ENOENT if the index cannot be used and
+ *                                  the search should begin at the oldest
+ *                                  entry.
+ *                              Other error on failure.
+ */
+int log_fcb_sidx_find_index(struct log *log, uint32_t index,
+                            struct fcb_entry *out_entry);
+
+/**
+ * @brief Uses the sector index to find where a search for the specified
+ * timestamp should begin.
+ *
+ * @param log                   The log to search.
+ * @param ts                    The timestamp to look for.
+ * @param out_entry             On success, the first entry of the sector
+ *                                  that holds the requested timestamp.
+ *
+ * @return                      0 on success;
+ *                              SYS_ENOENT if the index cannot be used and
+ *                                  the search should begin at the oldest
+ *                                  entry.
+ *                              Other error on failure.
+ */
+int log_fcb_sidx_find_ts(struct log *log, int64_t ts,
+                         struct fcb_entry *out_entry);
+
+#endif
+
 #ifdef __cplusplus
 }
 #endif
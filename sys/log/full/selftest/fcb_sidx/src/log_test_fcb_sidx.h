@@ -0,0 +1,39 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef H_LOG_TEST_FCB_SIDX_
+#define H_LOG_TEST_FCB_SIDX_
+
+#include "os/mynewt.h"
+#include "testutil/testutil.h"
+
+void ltfsu_init(int sidx_count);
+void ltfsu_populate_log(int count, int body_len);
+void ltfsu_remount(void);
+void ltfsu_verify_log(uint32_t start_idx);
+void ltfsu_verify_all(void);
+void ltfsu_verify_sidx(bool filled);
+void ltfsu_verify_find_ts(void);
+
+TEST_CASE_DECL(log_test_case_fcb_sidx_walk);
+TEST_CASE_DECL(log_test_case_fcb_sidx_no_storage);
+TEST_CASE_DECL(log_test_case_fcb_sidx_remount);
+TEST_CASE_DECL(log_test_case_fcb_sidx_find_ts);
+
+#endif
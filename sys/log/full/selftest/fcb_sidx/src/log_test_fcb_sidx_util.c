@@ -0,0 +1,296 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "log_test_util/log_test_util.h"
+#include "log_test_fcb_sidx.h"
+
+#define LTFSU_MAX_ENTRIES       4096
+#define LTFSU_MAX_BODY_LEN      256
+#define LTFSU_SECTOR_CNT        4
+
+#define LTFSU_SECTOR_SIZE       (16 * 1024)
+
+/* Snapshot of the log contents, in order, as seen by a full walk. */
+static uint32_t ltfsu_idxs[LTFSU_MAX_ENTRIES];
+static int64_t ltfsu_tss[LTFSU_MAX_ENTRIES];
+static int ltfsu_num_entries;
+
+static struct fcb_log ltfsu_fcb_log;
+static struct log ltfsu_log;
+
+static struct log_fcb_sidx_ent ltfsu_sidx[LTFSU_SECTOR_CNT];
+
+static struct flash_area ltfsu_fcb_areas[LTFSU_SECTOR_CNT] = {
+    [0] = {
+        .fa_off = 0 * LTFSU_SECTOR_SIZE,
+        .fa_size = LTFSU_SECTOR_SIZE,
+    },
+    [1] = {
+        .fa_off = 1 * LTFSU_SECTOR_SIZE,
+        .fa_size = LTFSU_SECTOR_SIZE,
+    },
+    [2] = {
+        .fa_off = 2 * LTFSU_SECTOR_SIZE,
+        .fa_size = LTFSU_SECTOR_SIZE,
+    },
+    [3] = {
+        .fa_off = 3 * LTFSU_SECTOR_SIZE,
+        .fa_size = LTFSU_SECTOR_SIZE,
+    },
+};
+
+static int
+ltfsu_snapshot_walk(struct log *log, struct log_offset *log_offset,
+                    const struct log_entry_hdr *hdr, const void *dptr,
+                    uint16_t len)
+{
+    TEST_ASSERT_FATAL(ltfsu_num_entries < LTFSU_MAX_ENTRIES);
+
+    ltfsu_idxs[ltfsu_num_entries] = hdr->ue_index;
+    ltfsu_tss[ltfsu_num_entries] = hdr->ue_ts;
+    ltfsu_num_entries++;
+
+    return 0;
+}
+
+/**
+ * Records the full contents of the log so that later lookups can be checked
+ * against it.
+ */
+static void
+ltfsu_snapshot(void)
+{
+    struct log_offset log_offset;
+    int rc;
+
+    ltfsu_num_entries = 0;
+
+    log_offset = (struct log_offset) {
+        .lo_index = 0,
+        .lo_ts = 0,
+    };
+
+    rc = log_walk_body(&ltfsu_log, ltfsu_snapshot_walk, &log_offset);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT_FATAL(ltfsu_num_entries > 0);
+}
+
+void
+ltfsu_populate_log(int count, int body_len)
+{
+    uint8_t body[LTFSU_MAX_BODY_LEN];
+    int rc;
+    int i;
+
+    TEST_ASSERT_FATAL(body_len <= LTFSU_MAX_BODY_LEN);
+
+    for (i = 0; i < count; i++) {
+        /* Leave gaps in the index sequence. */
+        g_log_info.li_next_index += rand() % 10;
+
+        memset(body, i, body_len);
+        rc = log_append_body(&ltfsu_log, 0, 255, LOG_ETYPE_BINARY, body,
+                             body_len);
+        TEST_ASSERT_FATAL(rc == 0);
+    }
+
+    ltfsu_snapshot();
+}
+
+struct ltfsu_walk_arg {
+    int cur;
+};
+
+static int
+ltfsu_verify_log_walk(struct log *log, struct log_offset *log_offset,
+                      const struct log_entry_hdr *hdr, const void *dptr,
+                      uint16_t len)
+{
+    struct ltfsu_walk_arg *arg;
+
+    arg = log_offset->lo_arg;
+
+    TEST_ASSERT_FATAL(arg->cur < ltfsu_num_entries);
+    TEST_ASSERT_FATAL(hdr->ue_index == ltfsu_idxs[arg->cur]);
+
+    arg->cur++;
+
+    return 0;
+}
+
+void
+ltfsu_verify_log(uint32_t start_idx)
+{
+    struct ltfsu_walk_arg arg;
+    struct log_offset log_offset;
+    int rc;
+
+    /* The walk must begin at the first entry with a great enough index. */
+    arg.cur = 0;
+    while (arg.cur < ltfsu_num_entries && ltfsu_idxs[arg.cur] < start_idx) {
+        arg.cur++;
+    }
+
+    log_offset = (struct log_offset) {
+        .lo_arg = &arg,
+        .lo_index = start_idx,
+        .lo_ts = 0,
+        .lo_data_len = 0,
+    };
+
+    rc = log_walk_body(&ltfsu_log, ltfsu_verify_log_walk, &log_offset);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    TEST_ASSERT_FATAL(arg.cur == ltfsu_num_entries);
+}
+
+void
+ltfsu_verify_all(void)
+{
+    uint32_t last;
+    uint32_t idx;
+
+    last = ltfsu_idxs[ltfsu_num_entries - 1];
+    for (idx = 0; idx <= last + 1; idx++) {
+        ltfsu_verify_log(idx);
+    }
+}
+
+void
+ltfsu_verify_sidx(bool filled)
+{
+    struct log_entry_hdr hdr;
+    struct fcb_entry loc;
+    struct flash_area *fap;
+    struct fcb *fcb;
+    int i;
+    int rc;
+
+    fcb = &ltfsu_fcb_log.fl_fcb;
+
+    /* Every valid index entry must describe its sector's first entry.  After
+     * a fill, every sector in use must also be indexed.
+     */
+    fap = fcb->f_oldest;
+    while (1) {
+        i = fap - fcb->f_sectors;
+
+        memset(&loc, 0, sizeof loc);
+        loc.fe_area = fap;
+        rc = fcb_getnext(fcb, &loc);
+        if (rc == 0 && loc.fe_area == fap) {
+            rc = log_read_hdr(&ltfsu_log, &loc, &hdr);
+            TEST_ASSERT_FATAL(rc == 0);
+
+            if (filled) {
+                TEST_ASSERT(ltfsu_sidx[i].lse_valid);
+            }
+            if (ltfsu_sidx[i].lse_valid) {
+                TEST_ASSERT(hdr.ue_index == ltfsu_sidx[i].lse_index);
+                TEST_ASSERT(hdr.ue_ts == ltfsu_sidx[i].lse_ts);
+            }
+        }
+
+        if (fap == fcb->f_active.fe_area) {
+            break;
+        }
+        fap++;
+        if (fap == &fcb->f_sectors[fcb->f_sector_cnt]) {
+            fap = fcb->f_sectors;
+        }
+    }
+}
+
+void
+ltfsu_verify_find_ts(void)
+{
+    uint32_t idx;
+    int64_t ts;
+    int rc;
+    int i;
+    int j;
+
+    for (i = 0; i < ltfsu_num_entries; i++) {
+        ts = ltfsu_tss[i];
+
+        /* Expect the oldest entry carrying a timestamp >= ts. */
+        j = 0;
+        while (ltfsu_tss[j] < ts) {
+            j++;
+        }
+
+        rc = log_fcb_find_ts(&ltfsu_log, ts, &idx);
+        TEST_ASSERT_FATAL(rc == 0);
+        TEST_ASSERT_FATAL(idx == ltfsu_idxs[j]);
+    }
+
+    rc = log_fcb_find_ts(&ltfsu_log, ltfsu_tss[ltfsu_num_entries - 1] + 1,
+                         &idx);
+    TEST_ASSERT(rc == SYS_ENOENT);
+}
+
+void
+ltfsu_remount(void)
+{
+    int rc;
+
+    /* Forget everything held in RAM and rebuild it from flash, as would
+     * happen after a reboot.
+     */
+    log_fcb_clear_sidx(&ltfsu_fcb_log);
+
+    rc = fcb_init(&ltfsu_fcb_log.fl_fcb);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    rc = log_fcb_fill_sidx(&ltfsu_log);
+    TEST_ASSERT_FATAL(rc == 0);
+}
+
+void
+ltfsu_init(int sidx_count)
+{
+    int rc;
+    int i;
+
+    /* Ensure tests are repeatable. */
+    srand(0);
+
+    ltfsu_num_entries = 0;
+
+    ltfsu_fcb_log = (struct fcb_log) {
+        .fl_fcb.f_scratch_cnt = 1,
+        .fl_fcb.f_sectors = ltfsu_fcb_areas,
+        .fl_fcb.f_sector_cnt = LTFSU_SECTOR_CNT,
+        .fl_fcb.f_magic = 0x7EADBADF,
+        .fl_fcb.f_version = 0,
+    };
+
+    for (i = 0; i < LTFSU_SECTOR_CNT; i++) {
+        rc = flash_area_erase(&ltfsu_fcb_areas[i], 0,
+                              ltfsu_fcb_areas[i].fa_size);
+        TEST_ASSERT_FATAL(rc == 0);
+    }
+    rc = fcb_init(&ltfsu_fcb_log.fl_fcb);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    log_fcb_init_sidx(&ltfsu_fcb_log, ltfsu_sidx, sidx_count);
+
+    log_register("log", &ltfsu_log, &log_fcb_handler, &ltfsu_fcb_log,
+                 LOG_SYSLEVEL);
+}
@@ -27,9 +27,6 @@
 #include "fcb/fcb.h"
 #include "log/log.h"
 
-/* Assume the flash alignment requirement is no stricter than 8. */
-#define LOG_FCB_MAX_ALIGN   8
-
 static int log_fcb_rtr_erase(struct log *log);
 
 /**
@@ -46,7 +43,9 @@ static int log_fcb_rtr_erase(struct log *log);
  *
  * The "index" field corresponds to a log entry index.
  *
- * If bookmarks are enabled, this function uses them in the search.
+ * If the sector index is enabled, the search only walks the sector that holds
+ * the requested entry.  If bookmarks are enabled, this function uses them in
+ * the search.
  *
  * @return                      0 if an entry was found
  *                              SYS_ENOENT if there are no suitable entries.
@@ -58,6 +57,9 @@ log_fcb_find_gte(struct log *log, struct log_offset *log_offset,
 {
 #if MYNEWT_VAL(LOG_FCB_BOOKMARKS)
     const struct log_fcb_bmark *bmark;
+#endif
+#if MYNEWT_VAL(LOG_FCB_SECTOR_INDEX)
+    struct fcb_entry sidx_entry;
 #endif
     struct log_entry_hdr hdr;
     struct fcb_log *fcb_log;
@@ -95,10 +97,31 @@ log_fcb_find_gte(struct log *log, struct log_offset *log_offset,
         return SYS_ENOENT;
     }
 
+#if MYNEWT_VAL(LOG_FCB_SECTOR_INDEX)
+    rc = log_fcb_sidx_find_index(log, log_offset->lo_index, &sidx_entry);
+    if (rc == 0) {
+        *out_entry = sidx_entry;
+    } else if (rc != SYS_ENOENT) {
+        return rc;
+    }
+#endif
+
 #if MYNEWT_VAL(LOG_FCB_BOOKMARKS)
     bmark = log_fcb_closest_bmark(fcb_log, log_offset->lo_index);
     if (bmark != NULL) {
+#if MYNEWT_VAL(LOG_FCB_SECTOR_INDEX)
+        /* rc still holds the sector index result.  If the index was used,
+         * the bookmark only helps if it is past the start of the indexed
+         * sector.
+         */
+        if (rc != 0 ||
+            (bmark->lfb_entry.fe_area == out_entry->fe_area &&
+             bmark->lfb_entry.fe_elem_off > out_entry->fe_elem_off)) {
+            *out_entry = bmark->lfb_entry;
+        }
+#else
         *out_entry = bmark->lfb_entry;
+#endif
     }
 #endif
 
@@ -117,8 +140,60 @@ log_fcb_find_gte(struct log *log, struct log_offset *log_offset,
     return SYS_ENOENT;
 }
 
+int
+log_fcb_find_ts(struct log *log, int64_t ts, uint32_t *out_index)
+{
+    struct log_entry_hdr hdr;
+    struct fcb_entry loc;
+    struct fcb_log *fcb_log;
+    struct fcb *fcb;
+    int rc;
+
+    fcb_log = log->l_arg;
+    fcb = &fcb_log->fl_fcb;
+
+    rc = SYS_ENOENT;
+#if MYNEWT_VAL(LOG_FCB_SECTOR_INDEX)
+    rc = log_fcb_sidx_find_ts(log, ts, &loc);
+    if (rc != 0 && rc != SYS_ENOENT) {
+        return rc;
+    }
+#endif
+
+    /* Without a usable sector index, start from the oldest entry. */
+    if (rc != 0) {
+        memset(&loc, 0, sizeof loc);
+        rc = fcb_getnext(fcb, &loc);
+        if (rc == FCB_ERR_NOVAR) {
+            return SYS_ENOENT;
+        } else if (rc != 0) {
+            return SYS_EUNKNOWN;
+        }
+    }
+
+    do {
+        rc = log_read_hdr(log, &loc, &hdr);
+        if (rc != 0) {
+            return rc;
+        }
+
+        if (hdr.ue_ts >= ts) {
+            *out_index = hdr.ue_index;
+            return 0;
+        }
+    } while (fcb_getnext(fcb, &loc) == 0);
+
+    return SYS_ENOENT;
+}
+
+/**
+ * Appends an entry made up of the given buffers followed by the contents of
+ * an mbuf chain (may be NULL).  Old entries are erased as necessary to make
+ * room.
+ */
 static int
-log_fcb_start_append(struct log *log, int len, struct fcb_entry *loc)
+log_fcb_append_gather(struct log *log, const struct fcb_iovec *iov,
+                      int iovcnt, struct os_mbuf *om)
 {
     struct fcb *fcb;
     struct fcb_log *fcb_log;
@@ -132,7 +207,7 @@ log_fcb_start_append(struct log *log, int len, struct fcb_entry *loc)
     fcb = &fcb_log->fl_fcb;
 
     while (1) {
-        rc = fcb_append(fcb, len, loc);
+        rc = fcb_append_mbuf(fcb, iov, iovcnt, om, NULL);
         if (rc == 0) {
             break;
         }
@@ -169,6 +244,9 @@ log_fcb_start_append(struct log *log, int len, struct fcb_entry *loc)
         /* The FCB needs to be rotated. */
         log_fcb_rotate_bmarks(fcb_log);
 #endif
+#if MYNEWT_VAL(LOG_FCB_SECTOR_INDEX)
+        log_fcb_rotate_sidx(fcb_log);
+#endif
 
         rc = fcb_rotate(fcb);
         if (rc) {
@@ -192,107 +270,18 @@ err:
     return (rc);
 }
 
-/**
- * Calculates the number of message body bytes that should be included after
- * the entry header in the first write.  Inclusion of body bytes is necessary
- * to satisfy the flash hardware's write alignment restrictions.
- */
-static int
-log_fcb_hdr_body_bytes(uint8_t align, uint8_t hdr_len)
-{
-    uint8_t mod;
-
-    /* Assume power-of-two alignment for faster modulo calculation. */
-    assert((align & (align - 1)) == 0);
-
-    mod = hdr_len & (align - 1);
-    if (mod == 0) {
-        return 0;
-    }
-
-    return align - mod;
-}
-
 static int
 log_fcb_append_body(struct log *log, const struct log_entry_hdr *hdr,
                     const void *body, int body_len)
 {
-    uint8_t buf[LOG_BASE_ENTRY_HDR_SIZE + LOG_IMG_HASHLEN +
-                LOG_FCB_MAX_ALIGN - 1];
-    struct fcb *fcb;
-    struct fcb_entry loc;
-    struct fcb_log *fcb_log;
-    const uint8_t *u8p;
-    int hdr_alignment;
-    int chunk_sz;
-    int rc;
-    uint16_t hdr_len;
-
-    fcb_log = (struct fcb_log *)log->l_arg;
-    fcb = &fcb_log->fl_fcb;
-
-    if (fcb->f_align > LOG_FCB_MAX_ALIGN) {
-        return SYS_ENOTSUP;
-    }
-
-    hdr_len = log_hdr_len(hdr);
-
-    rc = log_fcb_start_append(log, hdr_len + body_len, &loc);
-    if (rc != 0) {
-        return rc;
-    }
-
-    /* Append the first chunk (header + x-bytes of body, where x is however
-     * many bytes are required to increase the chunk size up to a multiple of
-     * the flash alignment). If the hash flag is set, we have to account for
-     * appending the hash right after the header.
-     */
-    hdr_alignment = log_fcb_hdr_body_bytes(fcb->f_align, hdr_len);
-    if (hdr_alignment > body_len) {
-        chunk_sz = hdr_len + body_len;
-    } else {
-        chunk_sz = hdr_len + hdr_alignment;
-    }
-
-    /*
-     * Based on the flags being set in the log header, we need to write
-     * specific fields to the flash
-     */
-
-    u8p = body;
+    struct fcb_iovec iov[2];
 
-    memcpy(buf, hdr, LOG_BASE_ENTRY_HDR_SIZE);
-#if MYNEWT_VAL(LOG_VERSION) > 2
-    if (hdr->ue_flags & LOG_FLAGS_IMG_HASH) {
-        memcpy(buf + LOG_BASE_ENTRY_HDR_SIZE, hdr->ue_imghash, LOG_IMG_HASHLEN);
-    }
-#endif
-    memcpy(buf + hdr_len, u8p, hdr_alignment);
+    iov[0].fi_data = hdr;
+    iov[0].fi_len = log_hdr_len(hdr);
+    iov[1].fi_data = body;
+    iov[1].fi_len = body_len;
 
-    rc = flash_area_write(loc.fe_area, loc.fe_data_off, buf, chunk_sz);
-    if (rc != 0) {
-        return rc;
-    }
-
-    /* Append the remainder of the message body. */
-
-    u8p += hdr_alignment;
-    body_len -= hdr_alignment;
-
-    if (body_len > 0) {
-        rc = flash_area_write(loc.fe_area, loc.fe_data_off + chunk_sz, u8p,
-                              body_len);
-        if (rc != 0) {
-            return rc;
-        }
-    }
-
-    rc = fcb_append_finish(fcb, &loc);
-    if (rc != 0) {
-        return rc;
-    }
-
-    return 0;
+    return log_fcb_append_gather(log, iov, 2, NULL);
 }
 
 static int
@@ -306,80 +295,16 @@ log_fcb_append(struct log *log, void *buf, int len)
                                len - hdr_len);
 }
 
-static int
-log_fcb_write_mbuf(struct fcb_entry *loc, struct os_mbuf *om)
-{
-    int rc;
-
-    while (om) {
-        rc = flash_area_write(loc->fe_area, loc->fe_data_off, om->om_data,
-                              om->om_len);
-        if (rc != 0) {
-            return SYS_EIO;
-        }
-
-        loc->fe_data_off += om->om_len;
-        om = SLIST_NEXT(om, om_next);
-    }
-
-    return 0;
-}
-
 static int
 log_fcb_append_mbuf_body(struct log *log, const struct log_entry_hdr *hdr,
                          struct os_mbuf *om)
 {
-    struct fcb *fcb;
-    struct fcb_entry loc;
-    struct fcb_log *fcb_log;
-    int len;
-    int rc;
-
-    fcb_log = (struct fcb_log *)log->l_arg;
-    fcb = &fcb_log->fl_fcb;
-
-    /* This function expects to be able to write each mbuf without any
-     * buffering.
-     */
-    if (fcb->f_align != 1) {
-        return SYS_ENOTSUP;
-    }
-
-    len = log_hdr_len(hdr) + os_mbuf_len(om);
-    rc = log_fcb_start_append(log, len, &loc);
-    if (rc != 0) {
-        return rc;
-    }
-
-    rc = flash_area_write(loc.fe_area, loc.fe_data_off, hdr,
-                          LOG_BASE_ENTRY_HDR_SIZE);
-    if (rc != 0) {
-        return rc;
-    }
-    loc.fe_data_off += LOG_BASE_ENTRY_HDR_SIZE;
-
-#if MYNEWT_VAL(LOG_VERSION) > 2
-    if (hdr->ue_flags & LOG_FLAGS_IMG_HASH) {
-        /* Write LOG_IMG_HASHLEN bytes of image hash */
-        rc = flash_area_write(loc.fe_area, loc.fe_data_off, hdr->ue_imghash,
-                              LOG_IMG_HASHLEN);
-        if (rc != 0) {
-            return rc;
-        }
-        loc.fe_data_off += LOG_IMG_HASHLEN;
-    }
-#endif
-    rc = log_fcb_write_mbuf(&loc, om);
-    if (rc != 0) {
-        return rc;
-    }
+    struct fcb_iovec iov;
 
-    rc = fcb_append_finish(fcb, &loc);
-    if (rc != 0) {
-        return rc;
-    }
+    iov.fi_data = hdr;
+    iov.fi_len = log_hdr_len(hdr);
 
-    return 0;
+    return log_fcb_append_gather(log, &iov, 1, om);
 }
 
 static int
@@ -574,6 +499,9 @@ log_fcb_flush(struct log *log)
 #if MYNEWT_VAL(LOG_FCB_BOOKMARKS)
     log_fcb_clear_bmarks(fcb_log);
 #endif
+#if MYNEWT_VAL(LOG_FCB_SECTOR_INDEX)
+    log_fcb_clear_sidx(fcb_log);
+#endif
 
     return fcb_clear(fcb);
 }
@@ -581,15 +509,18 @@ log_fcb_flush(struct log *log)
 static int
 log_fcb_registered(struct log *log)
 {
-#if MYNEWT_VAL(LOG_STORAGE_WATERMARK)
     struct fcb_log *fl;
+#if MYNEWT_VAL(LOG_STORAGE_WATERMARK)
 #if MYNEWT_VAL(LOG_PERSIST_WATERMARK)
     struct fcb *fcb;
     struct fcb_entry loc;
+#endif
 #endif
 
     fl = (struct fcb_log *)log->l_arg;
+    os_mutex_stats_register(&fl->fl_fcb.f_mtx, log->l_name);
 
+#if MYNEWT_VAL(LOG_STORAGE_WATERMARK)
 #if MYNEWT_VAL(LOG_PERSIST_WATERMARK)
     fcb = &fl->fl_fcb;
 
@@ -606,7 +537,11 @@ log_fcb_registered(struct log *log)
     fl->fl_watermark_off = 0xffffffff;
 #endif
 #endif
+#if MYNEWT_VAL(LOG_FCB_SECTOR_INDEX)
+    return log_fcb_fill_sidx(log);
+#else
     return 0;
+#endif
 }
 
 #if MYNEWT_VAL(LOG_STORAGE_INFO)
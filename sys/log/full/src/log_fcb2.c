@@ -124,8 +124,14 @@ log_fcb2_find_gte(struct log *log, struct log_offset *log_offset,
     return SYS_ENOENT;
 }
 
+/**
+ * Appends an entry made up of the given buffers followed by the contents of
+ * an mbuf chain (may be NULL).  Old entries are erased as necessary to make
+ * room.
+ */
 static int
-log_fcb2_start_append(struct log *log, int len, struct fcb2_entry *loc)
+log_fcb2_append_gather(struct log *log, const struct fcb2_iovec *iov,
+                       int iovcnt, struct os_mbuf *om)
 {
     struct fcb2 *fcb;
     struct fcb_log *fcb_log;
@@ -141,7 +147,7 @@ log_fcb2_start_append(struct log *log, int len, struct fcb2_entry *loc)
     fcb = &fcb_log->fl_fcb;
 
     while (1) {
-        rc = fcb2_append(fcb, len, loc);
+        rc = fcb2_append_mbuf(fcb, iov, iovcnt, om, NULL);
         if (rc == 0) {
             break;
         }
@@ -196,97 +202,18 @@ err:
     return (rc);
 }
 
-/**
- * Calculates the number of message body bytes that should be included after
- * the entry header in the first write.  Inclusion of body bytes is necessary
- * to satisfy the flash hardware's write alignment restrictions.
- */
-static int
-log_fcb2_hdr_body_bytes(uint8_t align, uint8_t hdr_len)
-{
-    uint8_t mod;
-
-    /* Assume power-of-two alignment for faster modulo calculation. */
-    assert((align & (align - 1)) == 0);
-
-    mod = hdr_len & (align - 1);
-    if (mod == 0) {
-        return 0;
-    }
-
-    return align - mod;
-}
-
 static int
 log_fcb2_append_body(struct log *log, const struct log_entry_hdr *hdr,
                      const void *body, int body_len)
 {
-    uint8_t buf[LOG_BASE_ENTRY_HDR_SIZE + LOG_IMG_HASHLEN +
-                LOG_FCB2_MAX_ALIGN - 1];
-    struct fcb2_entry loc;
-    const uint8_t *u8p;
-    int hdr_alignment;
-    int chunk_sz;
-    int rc;
-    uint16_t hdr_len;
+    struct fcb2_iovec iov[2];
 
-    hdr_len = log_hdr_len(hdr);
+    iov[0].fi_data = hdr;
+    iov[0].fi_len = log_hdr_len(hdr);
+    iov[1].fi_data = body;
+    iov[1].fi_len = body_len;
 
-    rc = log_fcb2_start_append(log, hdr_len + body_len, &loc);
-    if (rc != 0) {
-        return rc;
-    }
-
-    /* Append the first chunk (header + x-bytes of body, where x is however
-     * many bytes are required to increase the chunk size up to a multiple of
-     * the flash alignment). If the hash flag is set, we have to account for
-     * appending the hash right after the header.
-     */
-    hdr_alignment = log_fcb2_hdr_body_bytes(loc.fe_range->fsr_align, hdr_len);
-    if (hdr_alignment > body_len) {
-        chunk_sz = hdr_len + body_len;
-    } else {
-        chunk_sz = hdr_len + hdr_alignment;
-    }
-
-    /*
-     * Based on the flags being set in the log header, we need to write
-     * specific fields to the flash
-     */
-
-    u8p = body;
-
-    memcpy(buf, hdr, LOG_BASE_ENTRY_HDR_SIZE);
-#if MYNEWT_VAL(LOG_VERSION) > 2
-    if (hdr->ue_flags & LOG_FLAGS_IMG_HASH) {
-        memcpy(buf + LOG_BASE_ENTRY_HDR_SIZE, hdr->ue_imghash, LOG_IMG_HASHLEN);
-    }
-#endif
-    memcpy(buf + hdr_len, u8p, hdr_alignment);
-
-    rc = fcb2_write(&loc, 0, buf, chunk_sz);
-    if (rc != 0) {
-        return rc;
-    }
-
-    /* Append the remainder of the message body. */
-
-    u8p += hdr_alignment;
-    body_len -= hdr_alignment;
-
-    if (body_len > 0) {
-        rc = fcb2_write(&loc, chunk_sz, u8p, body_len);
-        if (rc != 0) {
-            return rc;
-        }
-    }
-
-    rc = fcb2_append_finish(&loc);
-    if (rc != 0) {
-        return rc;
-    }
-
-    return 0;
+    return log_fcb2_append_gather(log, iov, 2, NULL);
 }
 
 static int
@@ -300,77 +227,16 @@ log_fcb2_append(struct log *log, void *buf, int len)
                                 len - hdr_len);
 }
 
-static int
-log_fcb2_write_mbuf(struct fcb2_entry *loc, struct os_mbuf *om, int off)
-{
-    int rc;
-
-    while (om) {
-        rc = fcb2_write(loc, off, om->om_data, om->om_len);
-        if (rc != 0) {
-            return SYS_EIO;
-        }
-
-        off += om->om_len;
-        om = SLIST_NEXT(om, om_next);
-    }
-
-    return 0;
-}
-
 static int
 log_fcb2_append_mbuf_body(struct log *log, const struct log_entry_hdr *hdr,
                           struct os_mbuf *om)
 {
-    struct fcb2_entry loc;
-    int len;
-    int rc;
-
-#if 0 /* XXXX */
-    fcb_log = (struct fcb_log *)log->l_arg;
-    fcb = &fcb_log->fl_fcb;
-
-    /* This function expects to be able to write each mbuf without any
-     * buffering.
-     */
-    if (fcb->f_align != 1) {
-        return SYS_ENOTSUP;
-    }
-#endif
-
-    len = log_hdr_len(hdr) + os_mbuf_len(om);
-    rc = log_fcb2_start_append(log, len, &loc);
-    if (rc != 0) {
-        return rc;
-    }
-
-    rc = fcb2_write(&loc, 0, hdr, LOG_BASE_ENTRY_HDR_SIZE);
-    if (rc != 0) {
-        return rc;
-    }
-    len = LOG_BASE_ENTRY_HDR_SIZE;
-
-#if MYNEWT_VAL(LOG_VERSION) > 2
-    if (hdr->ue_flags & LOG_FLAGS_IMG_HASH) {
-        /* Write LOG_IMG_HASHLEN bytes of image hash */
-        rc = fcb2_write(&loc, len, hdr->ue_imghash, LOG_IMG_HASHLEN);
-        if (rc != 0) {
-            return rc;
-        }
-        len += LOG_IMG_HASHLEN;
-    }
-#endif
-    rc = log_fcb2_write_mbuf(&loc, om, len);
-    if (rc != 0) {
-        return rc;
-    }
+    struct fcb2_iovec iov;
 
-    rc = fcb2_append_finish(&loc);
-    if (rc != 0) {
-        return rc;
-    }
+    iov.fi_data = hdr;
+    iov.fi_len = log_hdr_len(hdr);
 
-    return 0;
+    return log_fcb2_append_gather(log, &iov, 1, om);
 }
 
 static int
@@ -550,6 +416,7 @@ log_fcb2_registered(struct log *log)
 
     fl = (struct fcb_log *)log->l_arg;
     fcb = &fl->fl_fcb;
+    os_mutex_stats_register(&fcb->f_mtx, log->l_name);
 
     for (i = 0; i < fcb->f_range_cnt; i++) {
         if (fcb->f_ranges[i].fsr_align > LOG_FCB2_MAX_ALIGN) {
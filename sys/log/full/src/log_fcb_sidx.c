@@ -0,0 +1,288 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+#include <string.h>
+
+#include "os/mynewt.h"
+
+#if MYNEWT_VAL(LOG_FCB_SECTOR_INDEX)
+
+#include "log/log.h"
+
+static bool
+log_fcb_sidx_enabled(const struct fcb_log *fcb_log)
+{
+    return fcb_log->fl_sidx.lsi_ents != NULL &&
+           fcb_log->fl_sidx.lsi_cap >= fcb_log->fl_fcb.f_sector_cnt;
+}
+
+/**
+ * Returns the number of sectors from the oldest one up to and including the
+ * active one.
+ */
+static int
+log_fcb_sidx_span(const struct fcb *fcb)
+{
+    int oldest;
+    int active;
+
+    oldest = fcb->f_oldest - fcb->f_sectors;
+    active = fcb->f_active.fe_area - fcb->f_sectors;
+
+    return (active - oldest + fcb->f_sector_cnt) % fcb->f_sector_cnt + 1;
+}
+
+/**
+ * Maps a position in log order (0 = oldest sector) to a sector number.
+ */
+static int
+log_fcb_sidx_sector(const struct fcb *fcb, int pos)
+{
+    return (fcb->f_oldest - fcb->f_sectors + pos) % fcb->f_sector_cnt;
+}
+
+/**
+ * Reads the first entry of a sector.
+ *
+ * @return                      0 on success;
+ *                              SYS_ENOENT if the sector is empty;
+ *                              Other error on failure.
+ */
+static int
+log_fcb_sidx_read_first(struct log *log, struct flash_area *fap,
+                        struct fcb_entry *out_entry,
+                        struct log_entry_hdr *out_hdr)
+{
+    struct fcb_log *fcb_log;
+    int rc;
+
+    fcb_log = log->l_arg;
+
+    memset(out_entry, 0, sizeof *out_entry);
+    out_entry->fe_area = fap;
+
+    rc = fcb_getnext(&fcb_log->fl_fcb, out_entry);
+    if (rc == FCB_ERR_NOVAR) {
+        return SYS_ENOENT;
+    } else if (rc != 0) {
+        return SYS_EUNKNOWN;
+    }
+
+    /* fcb_getnext() moves on to the next sector if this one is empty. */
+    if (out_entry->fe_area != fap) {
+        return SYS_ENOENT;
+    }
+
+    return log_read_hdr(log, out_entry, out_hdr);
+}
+
+/**
+ * Returns the index entry for the sector at the given log position, reading
+ * the sector's first entry if it has not been indexed yet.
+ *
+ * @return                      0 on success;
+ *                              SYS_ENOENT if the sector is empty;
+ *                              Other error on failure.
+ */
+static int
+log_fcb_sidx_load(struct log *log, int pos,
+                  const struct log_fcb_sidx_ent **out_ent)
+{
+    struct log_fcb_sidx_ent *ent;
+    struct log_entry_hdr hdr;
+    struct fcb_entry entry;
+    struct fcb_log *fcb_log;
+    int sector;
+    int rc;
+
+    fcb_log = log->l_arg;
+    sector = log_fcb_sidx_sector(&fcb_log->fl_fcb, pos);
+    ent = &fcb_log->fl_sidx.lsi_ents[sector];
+
+    if (!ent->lse_valid) {
+        rc = log_fcb_sidx_read_first(log, &fcb_log->fl_fcb.f_sectors[sector],
+                                     &entry, &hdr);
+        if (rc != 0) {
+            return rc;
+        }
+
+        ent->lse_ts = hdr.ue_ts;
+        ent->lse_index = hdr.ue_index;
+        ent->lse_valid = 1;
+    }
+
+    *out_ent = ent;
+    return 0;
+}
+
+/**
+ * Binary-searches the sector index for the newest sector whose first entry
+ * comes strictly before the given index (or timestamp).  Entries at or
+ * after the key can only start in that sector or a later one.
+ */
+static int
+log_fcb_sidx_find(struct log *log, bool by_ts, uint32_t index, int64_t ts,
+                  struct fcb_entry *out_entry)
+{
+    const struct log_fcb_sidx_ent *ent;
+    struct log_entry_hdr hdr;
+    struct fcb_log *fcb_log;
+    struct fcb *fcb;
+    bool before;
+    int sector;
+    int lo;
+    int hi;
+    int mid;
+    int rc;
+
+    fcb_log = log->l_arg;
+    fcb = &fcb_log->fl_fcb;
+
+    if (!log_fcb_sidx_enabled(fcb_log)) {
+        return SYS_ENOENT;
+    }
+
+    /* Find the first position whose sector starts at or after the key; the
+     * sector preceding it is where the search begins.  An empty sector can
+     * only be the active one, so it is treated as starting after the key.
+     */
+    lo = 0;
+    hi = log_fcb_sidx_span(fcb);
+    while (lo < hi) {
+        mid = lo + (hi - lo) / 2;
+
+        rc = log_fcb_sidx_load(log, mid, &ent);
+        if (rc == 0) {
+            if (by_ts) {
+                before = ent->lse_ts < ts;
+            } else {
+                before = ent->lse_index < index;
+            }
+        } else if (rc == SYS_ENOENT) {
+            before = false;
+        } else {
+            return rc;
+        }
+
+        if (before) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    if (lo == 0) {
+        /* The key precedes the whole log. */
+        return SYS_ENOENT;
+    }
+
+    sector = log_fcb_sidx_sector(fcb, lo - 1);
+    rc = log_fcb_sidx_read_first(log, &fcb->f_sectors[sector], out_entry,
+                                 &hdr);
+    if (rc != 0) {
+        return rc;
+    }
+
+    /* The sector was erased behind our back; start over from scratch. */
+    if (hdr.ue_index != fcb_log->fl_sidx.lsi_ents[sector].lse_index) {
+        log_fcb_clear_sidx(fcb_log);
+        return SYS_ENOENT;
+    }
+
+    return 0;
+}
+
+void
+log_fcb_init_sidx(struct fcb_log *fcb_log,
+                  struct log_fcb_sidx_ent *buf, int ent_count)
+{
+    fcb_log->fl_sidx = (struct log_fcb_sidx) {
+        .lsi_ents = buf,
+        .lsi_cap = ent_count,
+    };
+
+    log_fcb_clear_sidx(fcb_log);
+}
+
+void
+log_fcb_clear_sidx(struct fcb_log *fcb_log)
+{
+    int i;
+
+    for (i = 0; i < fcb_log->fl_sidx.lsi_cap; i++) {
+        fcb_log->fl_sidx.lsi_ents[i].lse_valid = 0;
+    }
+}
+
+void
+log_fcb_rotate_sidx(struct fcb_log *fcb_log)
+{
+    struct fcb *fcb;
+
+    fcb = &fcb_log->fl_fcb;
+
+    if (log_fcb_sidx_enabled(fcb_log)) {
+        fcb_log->fl_sidx.lsi_ents[fcb->f_oldest - fcb->f_sectors].lse_valid = 0;
+    }
+}
+
+int
+log_fcb_fill_sidx(struct log *log)
+{
+    const struct log_fcb_sidx_ent *ent;
+    struct fcb_log *fcb_log;
+    int span;
+    int pos;
+    int rc;
+
+    fcb_log = log->l_arg;
+
+    if (!log_fcb_sidx_enabled(fcb_log)) {
+        return 0;
+    }
+
+    log_fcb_clear_sidx(fcb_log);
+
+    span = log_fcb_sidx_span(&fcb_log->fl_fcb);
+    for (pos = 0; pos < span; pos++) {
+        rc = log_fcb_sidx_load(log, pos, &ent);
+        if (rc != 0 && rc != SYS_ENOENT) {
+            return rc;
+        }
+    }
+
+    return 0;
+}
+
+int
+log_fcb_sidx_find_index(struct log *log, uint32_t index,
+                        struct fcb_entry *out_entry)
+{
+    return log_fcb_sidx_find(log, false, index, 0, out_entry);
+}
+
+int
+log_fcb_sidx_find_ts(struct log *log, int64_t ts,
+                     struct fcb_entry *out_entry)
+{
+    return log_fcb_sidx_find(log, true, 0, ts, out_entry);
+}
+
+#endif /* MYNEWT_VAL(LOG_FCB_SECTOR_INDEX) */
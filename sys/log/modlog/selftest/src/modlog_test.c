@@ -24,6 +24,7 @@ TEST_SUITE(modlog_test_suite_all)
 {
     modlog_test_case_append();
     modlog_test_case_basic();
+    modlog_test_case_bench();
     modlog_test_case_printf();
     modlog_test_case_prio_flat();
     modlog_test_case_prio_mbuf();
@@ -0,0 +1,171 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include "rwlock/rwlock.h"
+#include "taskpool/taskpool.h"
+#include "modlog_test.h"
+
+/*
+ * Measures modlog_append() throughput with several logging tasks while
+ * another task keeps registering and deleting a mapping.  The mapping list
+ * is walked without blocking; for comparison the same workload is also run
+ * with every append and every registry update wrapped in a readers-writer
+ * lock, which is how the list used to be protected.
+ */
+
+#define MLTB_NUM_LOGGERS        4
+#define MLTB_NUM_APPENDS        20000
+#define MLTB_APPENDS_PER_TICK   256
+#define MLTB_NUM_CHURNS         64
+
+#define MLTB_LOGGER_PRIO        20
+#define MLTB_CHURN_PRIO         (MLTB_LOGGER_PRIO + MLTB_NUM_LOGGERS)
+
+static struct log mltb_log;
+static uint32_t mltb_num_entries;
+static struct rwlock mltb_rwl;
+static bool mltb_use_rwlock;
+
+static int
+mltb_log_append_body(struct log *log, const struct log_entry_hdr *hdr,
+                     const void *buf, int len)
+{
+    os_sr_t sr;
+
+    OS_ENTER_CRITICAL(sr);
+    mltb_num_entries++;
+    OS_EXIT_CRITICAL(sr);
+
+    return 0;
+}
+
+static const struct log_handler mltb_handler = {
+    .log_type = LOG_TYPE_MEMORY,
+    .log_append_body = mltb_log_append_body,
+};
+
+static void
+mltb_logger(void *arg)
+{
+    uint8_t byte;
+    int rc;
+    int i;
+
+    byte = 'x';
+    for (i = 0; i < MLTB_NUM_APPENDS; i++) {
+        if (mltb_use_rwlock) {
+            rwlock_acquire_read(&mltb_rwl);
+        }
+        rc = modlog_append(1, LOG_LEVEL_INFO, LOG_ETYPE_STRING, &byte, 1);
+        if (mltb_use_rwlock) {
+            rwlock_release_read(&mltb_rwl);
+        }
+        TEST_ASSERT(rc == 0);
+
+        /* Let the other tasks interleave. */
+        if (i % MLTB_APPENDS_PER_TICK == 0) {
+            os_time_delay(1);
+        }
+    }
+}
+
+static void
+mltb_churn(void *arg)
+{
+    uint8_t handle;
+    int rc;
+    int i;
+
+    /* Module 0 sorts ahead of module 1, so every lookup walks past it. */
+    for (i = 0; i < MLTB_NUM_CHURNS; i++) {
+        if (mltb_use_rwlock) {
+            rwlock_acquire_write(&mltb_rwl);
+        }
+        rc = modlog_register(0, &mltb_log, LOG_LEVEL_INFO, &handle);
+        if (mltb_use_rwlock) {
+            rwlock_release_write(&mltb_rwl);
+        }
+        TEST_ASSERT_FATAL(rc == 0);
+
+        os_time_delay(1);
+
+        if (mltb_use_rwlock) {
+            rwlock_acquire_write(&mltb_rwl);
+        }
+        rc = modlog_delete(handle);
+        if (mltb_use_rwlock) {
+            rwlock_release_write(&mltb_rwl);
+        }
+        TEST_ASSERT_FATAL(rc == 0);
+    }
+}
+
+static double
+mltb_run(bool use_rwlock)
+{
+    clock_t clk;
+    int i;
+
+    mltb_use_rwlock = use_rwlock;
+    mltb_num_entries = 0;
+
+    clk = clock();
+
+    for (i = 0; i < MLTB_NUM_LOGGERS; i++) {
+        taskpool_alloc_assert(mltb_logger, MLTB_LOGGER_PRIO + i);
+    }
+    taskpool_alloc_assert(mltb_churn, MLTB_CHURN_PRIO);
+    taskpool_wait_assert(OS_TIMEOUT_NEVER);
+
+    clk = clock() - clk;
+    if (clk == 0) {
+        clk = 1;
+    }
+
+    TEST_ASSERT(mltb_num_entries == MLTB_NUM_LOGGERS * MLTB_NUM_APPENDS);
+
+    return (double)MLTB_NUM_LOGGERS * MLTB_NUM_APPENDS * CLOCKS_PER_SEC / clk;
+}
+
+TEST_CASE_TASK(modlog_test_case_bench)
+{
+    double rwlock_rate;
+    double rcu_rate;
+    int rc;
+
+    rc = log_register("bench", &mltb_log, &mltb_handler, NULL, 0);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    rc = rwlock_init(&mltb_rwl);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    rc = modlog_register(1, &mltb_log, LOG_LEVEL_DEBUG, NULL);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    rwlock_rate = mltb_run(true);
+    rcu_rate = mltb_run(false);
+
+    printf("modlog append, %d tasks: rwlock %.0f appends/s, "
+           "rcu %.0f appends/s\n",
+           MLTB_NUM_LOGGERS, rwlock_rate, rcu_rate);
+
+    modlog_clear();
+}
@@ -19,7 +19,7 @@
 
 #include <stdarg.h>
 #include "os/mynewt.h"
-#include "rwlock/rwlock.h"
+#include "rwlock/rcu.h"
 #include "log/log.h"
 #include "modlog/modlog.h"
 
@@ -37,7 +37,12 @@ static os_membuf_t modlog_mapping_buf[
                     sizeof (struct modlog_mapping))
 ];
 
-static struct rwlock modlog_rwl;
+/**
+ * Protects the mapping list.  Appends only read the list and never block on
+ * it; register and delete serialize on the write lock and wait out a grace
+ * period before freeing an unlinked mapping.
+ */
+static struct rcu modlog_rcu;
 
 SLIST_HEAD(modlog_list, modlog_mapping);
 
@@ -51,6 +56,11 @@ static struct modlog_list modlog_mappings =
  */
 static struct modlog_mapping *modlog_first_dflt;
 
+#define MODLOG_FIRST()          RCU_DEREFERENCE(SLIST_FIRST(&modlog_mappings))
+#define MODLOG_NEXT(mm)         RCU_DEREFERENCE(SLIST_NEXT((mm), next))
+#define MODLOG_FOREACH(mm)                                              \
+    for ((mm) = MODLOG_FIRST(); (mm) != NULL; (mm) = MODLOG_NEXT(mm))
+
 static struct modlog_mapping *
 modlog_alloc(void)
 {
@@ -95,7 +105,7 @@ modlog_find(uint8_t handle, struct modlog_mapping **out_prev)
     struct modlog_mapping *cur;
 
     prev = NULL;
-    SLIST_FOREACH(cur, &modlog_mappings, next) {
+    MODLOG_FOREACH(cur) {
         if (cur->desc.handle == handle) {
             break;
         }
@@ -117,7 +127,7 @@ modlog_find_by_module(uint8_t module, struct modlog_mapping **out_prev)
     struct modlog_mapping *cur;
 
     prev = NULL;
-    SLIST_FOREACH(cur, &modlog_mappings, next) {
+    MODLOG_FOREACH(cur) {
         if (cur->desc.module == module) {
             break;
         }
@@ -143,28 +153,38 @@ modlog_insert(struct modlog_mapping *mm)
     struct modlog_mapping *prev;
 
     modlog_find_by_module(mm->desc.module, &prev);
+
+    /* Readers may be walking the list; link the mapping in only after it is
+     * fully initialized.
+     */
     if (prev == NULL) {
-        SLIST_INSERT_HEAD(&modlog_mappings, mm, next);
+        SLIST_NEXT(mm, next) = SLIST_FIRST(&modlog_mappings);
+        RCU_ASSIGN_POINTER(SLIST_FIRST(&modlog_mappings), mm);
     } else {
-        SLIST_INSERT_AFTER(prev, mm, next);
+        SLIST_NEXT(mm, next) = SLIST_NEXT(prev, next);
+        RCU_ASSIGN_POINTER(SLIST_NEXT(prev, next), mm);
     }
 
     if (mm->desc.module == MODLOG_MODULE_DFLT) {
-        modlog_first_dflt = mm;
+        RCU_ASSIGN_POINTER(modlog_first_dflt, mm);
     }
 }
 
 static void
 modlog_remove(struct modlog_mapping *mm, struct modlog_mapping *prev)
 {
+    /* The removed mapping keeps its next pointer so that a reader which is
+     * currently on it can continue its walk.
+     */
     if (mm == modlog_first_dflt) {
-        modlog_first_dflt = SLIST_NEXT(mm, next);
+        RCU_ASSIGN_POINTER(modlog_first_dflt, SLIST_NEXT(mm, next));
     }
-        
+
     if (prev == NULL) {
-        SLIST_REMOVE_HEAD(&modlog_mappings, next);
+        RCU_ASSIGN_POINTER(SLIST_FIRST(&modlog_mappings),
+                           SLIST_NEXT(mm, next));
     } else {
-        SLIST_NEXT(prev, next) = SLIST_NEXT(mm, next);
+        RCU_ASSIGN_POINTER(SLIST_NEXT(prev, next), SLIST_NEXT(mm, next));
     }
 }
 
@@ -211,6 +231,7 @@ modlog_delete_no_lock(uint8_t handle)
     }
 
     modlog_remove(mm, prev);
+    rcu_synchronize(&modlog_rcu);
     modlog_free(mm);
 
     return 0;
@@ -254,15 +275,15 @@ modlog_append_no_lock(uint8_t module, uint8_t level, uint8_t etype,
                 return rc;
             }
 
-            mm = SLIST_NEXT(mm, next);
+            mm = MODLOG_NEXT(mm);
         }
         return 0;
     }
 
     /* No mappings match the specified module; write to the default set. */
-    for (mm = modlog_first_dflt;
+    for (mm = RCU_DEREFERENCE(modlog_first_dflt);
          mm != NULL;
-         mm = SLIST_NEXT(mm, next)) {
+         mm = MODLOG_NEXT(mm)) {
 
         rc = modlog_append_one(mm, module, level, etype, data, len);
         if (rc != 0) {
@@ -304,7 +325,7 @@ modlog_append_mbuf_no_lock(uint8_t module, uint8_t level, uint8_t etype,
     rc = 0;
 
     found = false;
-    SLIST_FOREACH(mm, &modlog_mappings, next) {
+    MODLOG_FOREACH(mm) {
         if (mm->desc.module == module) {
             found = true;
 
@@ -319,9 +340,9 @@ modlog_append_mbuf_no_lock(uint8_t module, uint8_t level, uint8_t etype,
 
     /* If no mappings match the specified module, write to the default set. */
     if (!found) {
-        for (mm = modlog_first_dflt;
+        for (mm = RCU_DEREFERENCE(modlog_first_dflt);
              mm != NULL;
-             mm = SLIST_NEXT(mm, next)) {
+             mm = MODLOG_NEXT(mm)) {
 
             rc = modlog_append_mbuf_one(mm, module, level, etype, om);
             if (rc != 0) {
@@ -342,9 +363,9 @@ modlog_foreach_no_lock(modlog_foreach_fn *fn, void *arg)
     struct modlog_mapping *cur;
     int rc;
 
-    cur = SLIST_FIRST(&modlog_mappings);
+    cur = MODLOG_FIRST();
     while (cur != NULL) {
-        next = SLIST_NEXT(cur, next);
+        next = MODLOG_NEXT(cur);
 
         rc = fn(&cur->desc, arg);
         if (rc != 0) {
@@ -361,9 +382,10 @@ int
 modlog_get(uint8_t handle, struct modlog_desc *out_desc)
 {
     struct modlog_mapping *mm;
+    uint8_t token;
     int rc;
 
-    rwlock_acquire_read(&modlog_rwl);
+    token = rcu_read_enter(&modlog_rcu);
 
     mm = modlog_find(handle, NULL);
     if (mm == NULL) {
@@ -375,7 +397,7 @@ modlog_get(uint8_t handle, struct modlog_desc *out_desc)
         rc = 0;
     }
 
-    rwlock_release_read(&modlog_rwl);
+    rcu_read_exit(&modlog_rcu, token);
 
     return rc;
 }
@@ -386,9 +408,9 @@ modlog_register(uint8_t module, struct log *log, uint8_t min_level,
 {
     int rc;
 
-    rwlock_acquire_write(&modlog_rwl);
+    rcu_write_lock(&modlog_rcu);
     rc = modlog_register_no_lock(module, log, min_level, out_handle);
-    rwlock_release_write(&modlog_rwl);
+    rcu_write_unlock(&modlog_rcu);
 
     return rc;
 }
@@ -398,9 +420,9 @@ modlog_delete(uint8_t handle)
 {
     int rc;
 
-    rwlock_acquire_write(&modlog_rwl);
+    rcu_write_lock(&modlog_rcu);
     rc = modlog_delete_no_lock(handle);
-    rwlock_release_write(&modlog_rwl);
+    rcu_write_unlock(&modlog_rcu);
 
     return rc;
 }
@@ -408,27 +430,39 @@ modlog_delete(uint8_t handle)
 void
 modlog_clear(void)
 {
+    struct modlog_mapping *next;
     struct modlog_mapping *mm;
 
-    rwlock_acquire_write(&modlog_rwl);
+    rcu_write_lock(&modlog_rcu);
+
+    /* Unlink the whole list at once, then free it after a single grace
+     * period.
+     */
+    mm = SLIST_FIRST(&modlog_mappings);
+    RCU_ASSIGN_POINTER(SLIST_FIRST(&modlog_mappings), NULL);
+    RCU_ASSIGN_POINTER(modlog_first_dflt, NULL);
+
+    rcu_synchronize(&modlog_rcu);
 
-    while ((mm = SLIST_FIRST(&modlog_mappings)) != NULL) {
-        modlog_remove(mm, NULL);
+    while (mm != NULL) {
+        next = SLIST_NEXT(mm, next);
         modlog_free(mm);
+        mm = next;
     }
 
-    rwlock_release_write(&modlog_rwl);
+    rcu_write_unlock(&modlog_rcu);
 }
 
 int
 modlog_append(uint8_t module, uint8_t level, uint8_t etype,
               void *data, uint16_t len)
 {
+    uint8_t token;
     int rc;
 
-    rwlock_acquire_read(&modlog_rwl);
+    token = rcu_read_enter(&modlog_rcu);
     rc = modlog_append_no_lock(module, level, etype, data, len);
-    rwlock_release_read(&modlog_rwl);
+    rcu_read_exit(&modlog_rcu, token);
 
     return rc;
 }
@@ -437,11 +471,12 @@ int
 modlog_append_mbuf(uint8_t module, uint8_t level, uint8_t etype,
                    struct os_mbuf *om)
 {
+    uint8_t token;
     int rc;
 
-    rwlock_acquire_read(&modlog_rwl);
+    token = rcu_read_enter(&modlog_rcu);
     rc = modlog_append_mbuf_no_lock(module, level, etype, om);
-    rwlock_release_read(&modlog_rwl);
+    rcu_read_exit(&modlog_rcu, token);
 
     return rc;
 }
@@ -449,11 +484,12 @@ modlog_append_mbuf(uint8_t module, uint8_t level, uint8_t etype,
 int
 modlog_foreach(modlog_foreach_fn *fn, void *arg)
 {
+    uint8_t token;
     int rc;
 
-    rwlock_acquire_read(&modlog_rwl);
+    token = rcu_read_enter(&modlog_rcu);
     rc = modlog_foreach_no_lock(fn, arg);
-    rwlock_release_read(&modlog_rwl);
+    rcu_read_exit(&modlog_rcu, token);
 
     return rc;
 }
@@ -491,7 +527,7 @@ modlog_init(void)
     SLIST_INIT(&modlog_mappings);
     modlog_first_dflt = NULL;
 
-    rc = rwlock_init(&modlog_rwl);
+    rc = rcu_init(&modlog_rcu);
     SYSINIT_PANIC_ASSERT(rc == 0);
 
     /* Register the default console mapping if configured. */
@@ -32,6 +32,39 @@
 
 #define SHELL_OS "os"
 
+#if MYNEWT_VAL(OS_TASK_CPU_STATS)
+static void
+shell_os_tasks_display_verbose(struct streamer *streamer, const char *name)
+{
+    struct os_task *prev_task;
+    struct os_task_info oti;
+
+    streamer_printf(streamer, "%8s %3s %12s %8s %8s %8s\n",
+      "task", "pri", "cputime(us)", "preempt", "block", "maxlat");
+    prev_task = NULL;
+    while (1) {
+        prev_task = os_task_info_get_next(prev_task, &oti);
+        if (prev_task == NULL) {
+            break;
+        }
+
+        if (name && strcmp(name, oti.oti_name)) {
+            continue;
+        }
+
+        streamer_printf(streamer, "%8s %3u %12llu %8lu %8lu %8lu\n",
+                oti.oti_name, oti.oti_prio,
+                (unsigned long long)os_cputime_ticks_to_usecs64(
+                    oti.oti_cputime),
+                (unsigned long)oti.oti_preempt_cnt,
+                (unsigned long)oti.oti_voluntary_cnt,
+                (unsigned long)os_cputime_ticks_to_usecs(
+                    oti.oti_max_ready_latency));
+    }
+    streamer_printf(streamer, "idle: %d%%\n", os_task_cpu_idle_pct());
+}
+#endif
+
 static int
 shell_os_tasks_display_cmd(const struct shell_cmd *cmd, int argc, char **argv,
                            struct streamer *streamer)
@@ -39,16 +72,33 @@ shell_os_tasks_display_cmd(const struct shell_cmd *cmd, int argc, char **argv,
     struct os_task *prev_task;
     struct os_task_info oti;
     char *name;
+    int verbose;
     int found;
+    int i;
 
     name = NULL;
+    verbose = 0;
     found = 0;
 
-    if (argc > 1 && strcmp(argv[1], "")) {
-        name = argv[1];
+    for (i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-v")) {
+            verbose = 1;
+        } else if (strcmp(argv[i], "")) {
+            name = argv[i];
+        }
     }
 
     streamer_printf(streamer, "Tasks: \n");
+
+    if (verbose) {
+#if MYNEWT_VAL(OS_TASK_CPU_STATS)
+        shell_os_tasks_display_verbose(streamer, name);
+#else
+        streamer_printf(streamer, "OS_TASK_CPU_STATS not enabled\n");
+#endif
+        return 0;
+    }
+
     prev_task = NULL;
     streamer_printf(streamer, "%8s %3s %3s %8s %8s %8s %8s %8s %8s %3s\n",
       "task", "pri", "tid", "runtime", "csw", "stksz", "stkuse",
@@ -89,6 +139,9 @@ shell_os_mpool_display_cmd(const struct shell_cmd *cmd, int argc, char **argv,
 {
     struct os_mempool *mp;
     struct os_mempool_info omi;
+#if MYNEWT_VAL(MSYS_STATS)
+    struct os_mbuf_pool *omp;
+#endif
     char *name;
     int found;
 
@@ -127,8 +180,404 @@ shell_os_mpool_display_cmd(const struct shell_cmd *cmd, int argc, char **argv,
                 name);
     }
 
+#if MYNEWT_VAL(MSYS_STATS)
+    if (name == NULL) {
+        streamer_printf(streamer, "Msys: \n");
+        streamer_printf(streamer, "%32s %8s %8s %8s\n",
+                        "name", "miss", "fallback", "fail");
+        omp = NULL;
+        while (1) {
+            omp = os_msys_pool_get_next(omp);
+            if (omp == NULL) {
+                break;
+            }
+
+            streamer_printf(streamer, "%32s %8lu %8lu %8lu\n",
+                            omp->omp_pool->name,
+                            (unsigned long)omp->omp_stats.omps_miss,
+                            (unsigned long)omp->omp_stats.omps_fallback,
+                            (unsigned long)omp->omp_stats.omps_fail);
+        }
+    }
+#endif
+
+    return 0;
+}
+
+#if MYNEWT_VAL(OS_EVENTQ_STATS)
+int
+shell_os_evq_display_cmd(const struct shell_cmd *cmd, int argc, char **argv,
+                         struct streamer *streamer)
+{
+    struct os_eventq_info oei;
+    struct os_eventq *evq;
+    int hist;
+    int i;
+
+    hist = 0;
+    if (argc > 1) {
+        if (!strcmp(argv[1], "reset")) {
+            os_eventq_stats_reset(NULL);
+            return 0;
+        } else if (!strcmp(argv[1], "-h")) {
+            hist = 1;
+        }
+    }
+
+    streamer_printf(streamer, "Event queues: \n");
+    streamer_printf(streamer, "%10s %8s %5s %5s %8s %10s\n",
+                    "evq", "owner", "depth", "max", "puts", "maxwait(us)");
+    evq = NULL;
+    while (1) {
+        evq = os_eventq_info_get_next(evq, &oei);
+        if (evq == NULL) {
+            break;
+        }
+
+        streamer_printf(streamer, "%10p %8s %5u %5u %8lu %10lu%s\n", evq,
+                        oei.oei_owner, oei.oei_stats.es_depth,
+                        oei.oei_stats.es_max_depth,
+                        (unsigned long)oei.oei_stats.es_puts,
+                        (unsigned long)os_cputime_ticks_to_usecs(
+                            oei.oei_stats.es_max_wait),
+                        evq == os_eventq_dflt_get() ? " (dflt)" : "");
+
+        if (hist) {
+            /* Bucket n holds waits shorter than 2^n cputime ticks. */
+            streamer_printf(streamer, "%10s", "");
+            for (i = 0; i < OS_EVENTQ_WAIT_HIST_BUCKETS; i++) {
+                streamer_printf(streamer, " %lu",
+                                (unsigned long)oei.oei_stats.es_wait_hist[i]);
+            }
+            streamer_printf(streamer, "\n");
+        }
+    }
+
+    return 0;
+}
+#endif
+
+#if MYNEWT_VAL(OS_MUTEX_STATS)
+/* Most mutexes shown by the mutex command. */
+#define SHELL_OS_MUTEX_MAX  16
+
+struct shell_os_mutex_snap {
+    struct os_mutex *mu;
+    struct os_mutex_info omi;
+};
+
+/* Kept off the shell task's stack. */
+static struct shell_os_mutex_snap shell_os_mutex_snaps[SHELL_OS_MUTEX_MAX];
+
+/*
+ * Whether mutex a sorts before mutex b: more contended pends first, then
+ * more total wait time.  The address breaks ties.
+ */
+static int
+shell_os_mutex_before(const struct shell_os_mutex_snap *a,
+                      const struct shell_os_mutex_snap *b)
+{
+    const struct os_mutex_stats *as;
+    const struct os_mutex_stats *bs;
+
+    as = &a->omi.omi_stats;
+    bs = &b->omi.omi_stats;
+    if (as->ms_contended != bs->ms_contended) {
+        return as->ms_contended > bs->ms_contended;
+    }
+    if (as->ms_total_wait != bs->ms_total_wait) {
+        return as->ms_total_wait > bs->ms_total_wait;
+    }
+    return (uintptr_t)a->mu > (uintptr_t)b->mu;
+}
+
+int
+shell_os_mutex_display_cmd(const struct shell_cmd *cmd, int argc, char **argv,
+                           struct streamer *streamer)
+{
+    struct shell_os_mutex_snap *snaps;
+    struct shell_os_mutex_snap tmp;
+    struct os_mutex_info omi;
+    struct os_mutex *mu;
+    uint64_t wait;
+    int skipped;
+    int num;
+    int i;
+    int j;
+    os_sr_t sr;
+
+    if (argc > 1 && !strcmp(argv[1], "reset")) {
+        os_mutex_stats_reset(NULL);
+        return 0;
+    }
+
+    /*
+     * Copy the statistics in one go, so that every mutex is sorted and shown
+     * with the values of the same instant.
+     */
+    snaps = shell_os_mutex_snaps;
+    num = 0;
+    skipped = 0;
+    mu = NULL;
+    OS_ENTER_CRITICAL(sr);
+    while ((mu = os_mutex_info_get_next(mu, &omi)) != NULL) {
+        if (num < SHELL_OS_MUTEX_MAX) {
+            snaps[num].mu = mu;
+            snaps[num].omi = omi;
+            num++;
+        } else {
+            skipped++;
+        }
+    }
+    OS_EXIT_CRITICAL(sr);
+
+    /* Insertion sort; there are only a few entries. */
+    for (i = 1; i < num; i++) {
+        tmp = snaps[i];
+        for (j = i; j > 0 && shell_os_mutex_before(&tmp, &snaps[j - 1]); j--) {
+            snaps[j] = snaps[j - 1];
+        }
+        snaps[j] = tmp;
+    }
+
+    streamer_printf(streamer, "Mutexes, most contended first: \n");
+    streamer_printf(streamer, "%12s %8s %8s %6s %6s %11s %9s %11s %3s\n",
+                    "mutex", "acq", "cont", "tmo", "boost", "maxwait(us)",
+                    "wait(ms)", "maxhold(us)", "wtr");
+
+    for (i = 0; i < num; i++) {
+        wait = snaps[i].omi.omi_stats.ms_total_wait;
+        if (snaps[i].omi.omi_name != NULL) {
+            streamer_printf(streamer, "%12s", snaps[i].omi.omi_name);
+        } else {
+            /* Unnamed; show where it was initialized. */
+            streamer_printf(streamer, "  %10p", snaps[i].omi.omi_init_caller);
+        }
+        streamer_printf(streamer,
+                        " %8lu %8lu %6lu %6lu %11lu %9lu %11lu %3u\n",
+                        (unsigned long)snaps[i].omi.omi_stats.ms_acquired,
+                        (unsigned long)snaps[i].omi.omi_stats.ms_contended,
+                        (unsigned long)snaps[i].omi.omi_stats.ms_timeouts,
+                        (unsigned long)snaps[i].omi.omi_stats.ms_boosts,
+                        (unsigned long)os_cputime_ticks_to_usecs(
+                            snaps[i].omi.omi_stats.ms_max_wait),
+                        (unsigned long)(os_cputime_ticks_to_usecs64(wait) /
+                                        1000),
+                        (unsigned long)os_cputime_ticks_to_usecs(
+                            snaps[i].omi.omi_stats.ms_max_hold),
+                        snaps[i].omi.omi_waiters);
+    }
+    if (skipped > 0) {
+        streamer_printf(streamer, "(%d more not shown)\n", skipped);
+    }
+
+    return 0;
+}
+#endif
+
+#if MYNEWT_VAL(OS_TASK_STACK_WATERMARK)
+int
+shell_os_stack_display_cmd(const struct shell_cmd *cmd, int argc, char **argv,
+                           struct streamer *streamer)
+{
+    struct os_task_stack_info otsi;
+    uint32_t total_size;
+    uint32_t total_rec;
+    int idx;
+
+    if (argc > 1 && !strcmp(argv[1], "reset")) {
+        os_task_stack_reset();
+        return 0;
+    }
+
+    streamer_printf(streamer, "Stacks (in %u byte words): \n",
+                    (unsigned)sizeof(os_stack_t));
+    streamer_printf(streamer, "%12s %6s %6s %6s %6s\n",
+                    "task", "stksz", "hwm", "max", "rec");
+    total_size = 0;
+    total_rec = 0;
+    idx = 0;
+    while (1) {
+        idx = os_task_stack_info_get_next(idx, &otsi);
+        if (idx < 0) {
+            break;
+        }
+
+        if (otsi.otsi_name != NULL) {
+            streamer_printf(streamer, "%12s", otsi.otsi_name);
+            total_size += otsi.otsi_stksize;
+            total_rec += otsi.otsi_recommended;
+        } else {
+            /* Seen in an earlier boot only. */
+            streamer_printf(streamer, "    %08lx",
+                            (unsigned long)otsi.otsi_name_hash);
+        }
+        streamer_printf(streamer, " %6u %6u %6u %6u\n",
+                        otsi.otsi_stksize, otsi.otsi_hwm, otsi.otsi_hwm_max,
+                        otsi.otsi_recommended);
+    }
+    streamer_printf(streamer, "running tasks: %lu allocated, "
+                    "%lu recommended\n",
+                    (unsigned long)total_size, (unsigned long)total_rec);
+
+    return 0;
+}
+#endif
+
+#if MYNEWT_VAL(OS_TRACE_RAM)
+/*
+ * Print the trace dump as hex, 32 bytes per line.  Lines start with "tr "
+ * so that the host decoder can pick them out of a console log.
+ */
+static void
+shell_os_trace_dump(struct streamer *streamer)
+{
+    uint8_t buf[32];
+    uint32_t off;
+    uint32_t len;
+    uint32_t i;
+    int running;
+
+    running = os_trace_ram_running();
+    os_trace_ram_stop();
+
+    streamer_printf(streamer, "trace dump %lu bytes\n",
+                    (unsigned long)os_trace_ram_dump_size());
+    off = 0;
+    while ((len = os_trace_ram_dump_read(off, buf, sizeof(buf))) > 0) {
+        streamer_printf(streamer, "tr ");
+        for (i = 0; i < len; i++) {
+            streamer_printf(streamer, "%02x", buf[i]);
+        }
+        streamer_printf(streamer, "\n");
+        off += len;
+    }
+    streamer_printf(streamer, "trace end\n");
+
+    if (running) {
+        os_trace_ram_start();
+    }
+}
+
+int
+shell_os_trace_cmd(const struct shell_cmd *cmd, int argc, char **argv,
+                   struct streamer *streamer)
+{
+    struct os_trace_ram_hdr hdr;
+
+    if (argc > 1) {
+        if (!strcmp(argv[1], "start")) {
+            os_trace_ram_start();
+        } else if (!strcmp(argv[1], "stop")) {
+            os_trace_ram_stop();
+        } else if (!strcmp(argv[1], "clear")) {
+            os_trace_ram_clear();
+        } else if (!strcmp(argv[1], "dump")) {
+            shell_os_trace_dump(streamer);
+        } else {
+            streamer_printf(streamer, "unknown argument: %s\n", argv[1]);
+            return -1;
+        }
+        return 0;
+    }
+
+    /* The dump starts with the buffer header. */
+    os_trace_ram_dump_read(0, &hdr, sizeof(hdr));
+    streamer_printf(streamer, "trace %s, %lu records written, %lu kept\n",
+                    os_trace_ram_running() ? "running" : "stopped",
+                    (unsigned long)hdr.oth_head,
+                    (unsigned long)min(hdr.oth_head, hdr.oth_num_recs));
+
+    return 0;
+}
+#endif
+
+#if MYNEWT_VAL(OS_HEAP_TRACK)
+static const char *
+shell_os_task_name(uint8_t prio)
+{
+    struct os_task *prev_task;
+    struct os_task_info oti;
+
+    prev_task = NULL;
+    while (1) {
+        prev_task = os_task_info_get_next(prev_task, &oti);
+        if (prev_task == NULL) {
+            return "?";
+        }
+        if (oti.oti_prio == prio) {
+            return prev_task->t_name;
+        }
+    }
+}
+
+int
+shell_os_heap_display_cmd(const struct shell_cmd *cmd, int argc, char **argv,
+                          struct streamer *streamer)
+{
+    struct os_heap_alloc_info ohai;
+    struct os_heap_site_info ohsi;
+    struct os_heap_stats ohs;
+    int all;
+    int idx;
+
+    all = 0;
+    if (argc > 1) {
+        if (!strcmp(argv[1], "reset")) {
+            os_heap_stats_reset();
+            return 0;
+        } else if (!strcmp(argv[1], "-a")) {
+            all = 1;
+        }
+    }
+
+    os_heap_stats_get(&ohs);
+    streamer_printf(streamer, "Heap: \n");
+    streamer_printf(streamer, "%8s %8s %6s %6s %8s %8s %10s %5s %5s\n",
+                    "bytes", "peak", "blocks", "peak", "allocs", "frees",
+                    "allocbytes", "fail", "lost");
+    streamer_printf(streamer, "%8lu %8lu %6u %6u %8lu %8lu %10lu %5lu %5lu\n",
+                    (unsigned long)ohs.ohs_cur_bytes,
+                    (unsigned long)ohs.ohs_peak_bytes,
+                    ohs.ohs_cur_blocks, ohs.ohs_peak_blocks,
+                    (unsigned long)ohs.ohs_allocs,
+                    (unsigned long)ohs.ohs_frees,
+                    (unsigned long)ohs.ohs_alloc_bytes,
+                    (unsigned long)ohs.ohs_fails,
+                    (unsigned long)ohs.ohs_untracked);
+
+    streamer_printf(streamer, "Call sites: \n");
+    streamer_printf(streamer, "%10s %6s %8s\n", "caller", "blocks", "bytes");
+    idx = 0;
+    while (1) {
+        idx = os_heap_site_info_get_next(idx, &ohsi);
+        if (idx < 0) {
+            break;
+        }
+        streamer_printf(streamer, "%10p %6u %8lu\n", ohsi.ohsi_caller,
+                        ohsi.ohsi_blocks, (unsigned long)ohsi.ohsi_bytes);
+    }
+
+    if (all) {
+        streamer_printf(streamer, "Allocations: \n");
+        streamer_printf(streamer, "%10s %10s %8s %8s\n",
+                        "ptr", "caller", "size", "task");
+        idx = 0;
+        while (1) {
+            idx = os_heap_alloc_info_get_next(idx, &ohai);
+            if (idx < 0) {
+                break;
+            }
+            streamer_printf(streamer, "%10p %10p %8lu %8s\n",
+                            ohai.ohai_ptr, ohai.ohai_caller,
+                            (unsigned long)ohai.ohai_size,
+                            shell_os_task_name(ohai.ohai_prio));
+        }
+    }
+
     return 0;
 }
+#endif
 
 int
 shell_os_date_cmd(const struct shell_cmd *cmd, int argc, char **argv,
@@ -207,6 +656,7 @@ shell_os_ls_dev_cmd(const struct shell_cmd *cmd, int argc, char **argv,
 
 #if MYNEWT_VAL(SHELL_CMD_HELP)
 static const struct shell_param tasks_params[] = {
+    {"-v", "show CPU time, switch counts and max ready latency"},
     {"", "task name"},
     {NULL, NULL}
 };
@@ -228,6 +678,76 @@ static const struct shell_cmd_help mpool_help = {
     .params = mpool_params,
 };
 
+#if MYNEWT_VAL(OS_EVENTQ_STATS)
+static const struct shell_param evq_params[] = {
+    {"-h", "show queue wait histogram (log2 cputime ticks)"},
+    {"reset", "clear high-water marks and wait statistics"},
+    {NULL, NULL}
+};
+
+static const struct shell_cmd_help evq_help = {
+    .summary = "show event queue depth and wait statistics",
+    .usage = NULL,
+    .params = evq_params,
+};
+#endif
+
+#if MYNEWT_VAL(OS_MUTEX_STATS)
+static const struct shell_param mutex_params[] = {
+    {"reset", "clear the statistics of registered mutexes"},
+    {NULL, NULL}
+};
+
+static const struct shell_cmd_help mutex_help = {
+    .summary = "show mutex contention, most contended first",
+    .usage = NULL,
+    .params = mutex_params,
+};
+#endif
+
+#if MYNEWT_VAL(OS_TASK_STACK_WATERMARK)
+static const struct shell_param stack_params[] = {
+    {"reset", "forget the high-water marks of earlier boots"},
+    {NULL, NULL}
+};
+
+static const struct shell_cmd_help stack_help = {
+    .summary = "show stack high-water marks and recommended sizes",
+    .usage = NULL,
+    .params = stack_params,
+};
+#endif
+
+#if MYNEWT_VAL(OS_TRACE_RAM)
+static const struct shell_param trace_params[] = {
+    {"start", "start recording"},
+    {"stop", "stop recording"},
+    {"clear", "discard recorded events"},
+    {"dump", "print the trace buffer as hex for the host decoder"},
+    {NULL, NULL}
+};
+
+static const struct shell_cmd_help trace_help = {
+    .summary = "control and dump the RAM trace buffer",
+    .usage = NULL,
+    .params = trace_params,
+};
+#endif
+
+#if MYNEWT_VAL(OS_HEAP_TRACK)
+static const struct shell_param heap_params[] = {
+    {"-a", "also list every live allocation with its owning task"},
+    {"reset", "clear counters and restart the high-water marks"},
+    {NULL, NULL}
+};
+
+static const struct shell_cmd_help heap_help = {
+    .summary = "show heap usage by call site",
+    .usage = NULL,
+    .params = heap_params,
+};
+#endif
+
 #if (MYNEWT_VAL(SHELL_OS_DATETIME_CMD) & 2) == 2
 static const struct shell_param date_params[] = {
     {"", "datetime to set"},
@@ -264,6 +784,21 @@ static const struct shell_cmd_help ls_dev_help = {
 static const struct shell_cmd os_commands[] = {
     SHELL_CMD_EXT("tasks", shell_os_tasks_display_cmd, &tasks_help),
     SHELL_CMD_EXT("mpool", shell_os_mpool_display_cmd, &mpool_help),
+#if MYNEWT_VAL(OS_EVENTQ_STATS)
+    SHELL_CMD_EXT("evq", shell_os_evq_display_cmd, &evq_help),
+#endif
+#if MYNEWT_VAL(OS_HEAP_TRACK)
+    SHELL_CMD_EXT("heap", shell_os_heap_display_cmd, &heap_help),
+#endif
+#if MYNEWT_VAL(OS_MUTEX_STATS)
+    SHELL_CMD_EXT("mutex", shell_os_mutex_display_cmd, &mutex_help),
+#endif
+#if MYNEWT_VAL(OS_TASK_STACK_WATERMARK)
+    SHELL_CMD_EXT("stack", shell_os_stack_display_cmd, &stack_help),
+#endif
+#if MYNEWT_VAL(OS_TRACE_RAM)
+    SHELL_CMD_EXT("trace", shell_os_trace_cmd, &trace_help),
+#endif
     SHELL_CMD_EXT("date", shell_os_date_cmd, &date_help),
     SHELL_CMD_EXT("reset", shell_os_reset_cmd, &reset_help),
     SHELL_CMD_EXT("lsdev", shell_os_ls_dev_cmd, &ls_dev_help),
@@ -105,7 +105,7 @@ static void
 tu_dflt_task_handler(void *arg)
 {
     while (1) {
-        os_eventq_run(os_eventq_dflt_get());
+        os_eventq_run_n(os_eventq_dflt_get(), 0);
     }
 }
 
@@ -0,0 +1,129 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef H_RWLOCK_RCU_
+#define H_RWLOCK_RCU_
+
+#include "os/mynewt.h"
+
+/**
+ * @brief Read-copy-update style protection for read-mostly lists.
+ *
+ * Readers never block: entering and leaving a read-side section only bumps
+ * a counter inside a short critical section, so lookups can run
+ * concurrently with a writer and from interrupt context.  The read-side
+ * section itself may sleep.
+ *
+ * Writers are serialized by a mutex.  A writer publishes changes with
+ * RCU_ASSIGN_POINTER() so that a concurrent reader sees either the old or
+ * the new version of the structure, never a partial one.  Before an
+ * unlinked element can be freed or reused, the writer calls
+ * rcu_synchronize(); it returns once every reader that might still hold a
+ * reference to the element has left its read-side section.
+ *
+ * Two epochs are tracked.  Readers count themselves against the current
+ * epoch; rcu_synchronize() flips the epoch and waits for the count of the
+ * old one to drain to zero.
+ *
+ * All struct fields should be considered private.
+ */
+struct rcu {
+    /** Serializes writers. */
+    struct os_mutex wmtx;
+
+    /** Wakes a writer waiting for a grace period to end. */
+    struct os_sem gp_sem;
+
+    /** The number of readers inside each epoch. */
+    uint16_t readers[2];
+
+    /** The epoch new readers are counted against; 0 or 1. */
+    uint8_t epoch;
+
+    /** Whether a writer is waiting for the old epoch to drain. */
+    bool gp_waiting;
+};
+
+/**
+ * Publishes a pointer to readers.  All stores made to initialize the
+ * pointed-to object are visible before the pointer itself is.
+ */
+#define RCU_ASSIGN_POINTER(p, v) do {                                   \
+    __sync_synchronize();                                               \
+    *(__typeof__(p) volatile *)&(p) = (v);                              \
+} while (0)
+
+/**
+ * Loads a pointer published with RCU_ASSIGN_POINTER().  Use only inside a
+ * read-side section.
+ */
+#define RCU_DEREFERENCE(p)  (*(__typeof__(p) volatile *)&(p))
+
+/**
+ * @brief Enters a read-side section.  Never blocks.
+ *
+ * @param rcu                   The rcu instance protecting the list.
+ *
+ * @return                      A token to pass to rcu_read_exit().
+ */
+uint8_t rcu_read_enter(struct rcu *rcu);
+
+/**
+ * Leaves a read-side section.
+ *
+ * @param rcu                   The rcu instance protecting the list.
+ * @param token                 The value returned by rcu_read_enter().
+ */
+void rcu_read_exit(struct rcu *rcu, uint8_t token);
+
+/**
+ * @brief Acquires exclusive write access.
+ *
+ * @param rcu                   The rcu instance to lock.
+ */
+void rcu_write_lock(struct rcu *rcu);
+
+/**
+ * Releases exclusive write access.
+ *
+ * @param rcu                   The rcu instance to unlock.
+ */
+void rcu_write_unlock(struct rcu *rcu);
+
+/**
+ * @brief Waits for all pre-existing readers to leave.
+ *
+ * Readers which enter after this call starts are not waited for.  The
+ * caller must hold the write lock and must not be inside a read-side
+ * section of the same instance.  Must not be called from interrupt context.
+ *
+ * @param rcu                   The rcu instance to synchronize.
+ */
+void rcu_synchronize(struct rcu *rcu);
+
+/**
+ * Initializes an rcu instance.
+ *
+ * @param rcu                   The rcu instance to initialize.
+ *
+ * @return                      0 on success; nonzero on failure.
+ */
+int rcu_init(struct rcu *rcu);
+
+#endif
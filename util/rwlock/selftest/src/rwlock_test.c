@@ -22,6 +22,7 @@
 TEST_SUITE(rwlock_test_suite_basic)
 {
     rwlock_test_case_basic();
+    rcu_test_case_basic();
 }
 
 int
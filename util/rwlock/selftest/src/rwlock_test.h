@@ -25,5 +25,6 @@
 
 TEST_SUITE_DECL(rwlock_test_suite_basic);
 TEST_CASE_DECL(rwlock_test_case_basic);
+TEST_CASE_DECL(rcu_test_case_basic);
 
 #endif
@@ -0,0 +1,106 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "rwlock/rcu.h"
+#include "rwlock_test.h"
+
+#define RTCR_SYNC_TASK_PRIO     10
+
+#define RTCR_STACK_SIZE         1024
+
+static void rtcr_evcb_sync(struct os_event *ev);
+
+static struct os_eventq rtcr_evq_sync;
+static struct os_task rtcr_task_sync;
+static os_stack_t rtcr_stack_sync[RTCR_STACK_SIZE];
+
+static struct rcu rtcr_rcu;
+static int rtcr_num_syncs;
+
+static struct os_event rtcr_ev_sync = {
+    .ev_cb = rtcr_evcb_sync,
+};
+
+static void
+rtcr_evcb_sync(struct os_event *ev)
+{
+    rcu_write_lock(&rtcr_rcu);
+    rcu_synchronize(&rtcr_rcu);
+    rcu_write_unlock(&rtcr_rcu);
+
+    rtcr_num_syncs++;
+}
+
+static void
+rtcr_sync_task_handler(void *arg)
+{
+    while (1) {
+        os_eventq_run(&rtcr_evq_sync);
+    }
+}
+
+TEST_CASE_TASK(rcu_test_case_basic)
+{
+    uint8_t token1;
+    uint8_t token2;
+    uint8_t token3;
+    int rc;
+
+    os_eventq_init(&rtcr_evq_sync);
+
+    rc = os_task_init(&rtcr_task_sync, "sync", rtcr_sync_task_handler, NULL,
+                      RTCR_SYNC_TASK_PRIO, OS_WAIT_FOREVER, rtcr_stack_sync,
+                      RTCR_STACK_SIZE);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    rc = rcu_init(&rtcr_rcu);
+    TEST_ASSERT_FATAL(rc == 0);
+
+    /* No readers; the grace period ends immediately. */
+    os_eventq_put(&rtcr_evq_sync, &rtcr_ev_sync);
+    TEST_ASSERT_FATAL(rtcr_num_syncs == 1);
+
+    /* An active reader holds up the writer. */
+    token1 = rcu_read_enter(&rtcr_rcu);
+    os_eventq_put(&rtcr_evq_sync, &rtcr_ev_sync);
+    TEST_ASSERT_FATAL(rtcr_num_syncs == 1);
+
+    /* Readers never block, and readers which arrive during the grace period
+     * do not extend it.
+     */
+    token2 = rcu_read_enter(&rtcr_rcu);
+    TEST_ASSERT(token2 != token1);
+    rcu_read_exit(&rtcr_rcu, token2);
+    TEST_ASSERT_FATAL(rtcr_num_syncs == 1);
+
+    token3 = rcu_read_enter(&rtcr_rcu);
+
+    /* The last pre-existing reader leaving ends the grace period. */
+    rcu_read_exit(&rtcr_rcu, token1);
+    TEST_ASSERT_FATAL(rtcr_num_syncs == 2);
+
+    /* The next grace period waits for the reader that arrived during the
+     * previous one.
+     */
+    os_eventq_put(&rtcr_evq_sync, &rtcr_ev_sync);
+    TEST_ASSERT_FATAL(rtcr_num_syncs == 2);
+
+    rcu_read_exit(&rtcr_rcu, token3);
+    TEST_ASSERT_FATAL(rtcr_num_syncs == 3);
+}
@@ -0,0 +1,129 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <assert.h>
+#include "os/mynewt.h"
+#include "rwlock/rcu.h"
+
+uint8_t
+rcu_read_enter(struct rcu *rcu)
+{
+    uint8_t token;
+    os_sr_t sr;
+
+    OS_ENTER_CRITICAL(sr);
+    token = rcu->epoch;
+    rcu->readers[token]++;
+    OS_EXIT_CRITICAL(sr);
+
+    return token;
+}
+
+void
+rcu_read_exit(struct rcu *rcu, uint8_t token)
+{
+    bool wake;
+    os_sr_t sr;
+
+    OS_ENTER_CRITICAL(sr);
+
+    assert(rcu->readers[token] > 0);
+    rcu->readers[token]--;
+
+    /* The last reader of the old epoch ends the grace period. */
+    wake = rcu->gp_waiting && token != rcu->epoch &&
+           rcu->readers[token] == 0;
+    if (wake) {
+        rcu->gp_waiting = false;
+    }
+
+    OS_EXIT_CRITICAL(sr);
+
+    if (wake) {
+        os_sem_release(&rcu->gp_sem);
+    }
+}
+
+void
+rcu_write_lock(struct rcu *rcu)
+{
+    int rc;
+
+    rc = os_mutex_pend(&rcu->wmtx, OS_TIMEOUT_NEVER);
+    assert(rc == 0 || rc == OS_NOT_STARTED);
+}
+
+void
+rcu_write_unlock(struct rcu *rcu)
+{
+    int rc;
+
+    rc = os_mutex_release(&rcu->wmtx);
+    assert(rc == 0 || rc == OS_NOT_STARTED);
+}
+
+void
+rcu_synchronize(struct rcu *rcu)
+{
+    uint8_t old;
+    bool wait;
+    os_sr_t sr;
+
+    assert(!os_started() || rcu->wmtx.mu_owner == os_sched_get_current_task());
+
+    OS_ENTER_CRITICAL(sr);
+
+    /* New readers count against the other epoch from here on.  That epoch
+     * was drained by the previous grace period.
+     */
+    old = rcu->epoch;
+    rcu->epoch = old ^ 1;
+
+    wait = rcu->readers[old] > 0;
+    rcu->gp_waiting = wait;
+
+    OS_EXIT_CRITICAL(sr);
+
+    if (wait) {
+        os_sem_pend(&rcu->gp_sem, OS_TIMEOUT_NEVER);
+    }
+}
+
+int
+rcu_init(struct rcu *rcu)
+{
+    int rc;
+
+    rcu->readers[0] = 0;
+    rcu->readers[1] = 0;
+    rcu->epoch = 0;
+    rcu->gp_waiting = false;
+
+    rc = os_mutex_init(&rcu->wmtx);
+    if (rc != 0) {
+        return rc;
+    }
+
+    rc = os_sem_init(&rcu->gp_sem, 0);
+    if (rc != 0) {
+        return rc;
+    }
+
+    return 0;
+}
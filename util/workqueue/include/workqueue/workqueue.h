@@ -0,0 +1,188 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef H_WORKQUEUE_
+#define H_WORKQUEUE_
+
+#include "os/mynewt.h"
+
+/**
+ * @file workqueue.h
+ * @brief Deferred work executed by a small set of shared worker tasks.
+ *
+ * This package creates a fixed number of worker tasks which service several
+ * priority lanes.  Packages that only need to run short jobs outside of
+ * interrupt context (sensor processing, log flushing, stats persistence) can
+ * submit work here instead of each owning a task and a stack.
+ *
+ * Submitting work which is already pending is a no-op, so a work item that
+ * is submitted many times before a worker gets to it runs only once.  Work
+ * which has been dequeued may be submitted again while it is running.
+ *
+ * The worker count, lane count, priorities and stack size are specified via
+ * syscfg.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** A unit of deferred work. */
+struct workqueue_work {
+    /** Event carrying the work function and its argument. */
+    struct os_event ww_ev;
+    /** Lane the work was last submitted to. */
+    uint8_t ww_lane;
+#if MYNEWT_VAL(WORKQUEUE_STATS)
+    /** os_cputime at which the work was queued. */
+    uint32_t ww_queued_at;
+#endif
+};
+
+/** Work which is queued after a delay. */
+struct workqueue_delayed_work {
+    struct workqueue_work wdw_work;
+    struct os_callout wdw_callout;
+};
+
+/** Per-lane statistics; times are in os_cputime ticks. */
+struct workqueue_lane_stats {
+    /** Number of times work was queued on the lane. */
+    uint32_t wls_submitted;
+    /** Number of submissions dropped because the work was pending. */
+    uint32_t wls_coalesced;
+    /** Number of work items executed. */
+    uint32_t wls_executed;
+    /** Longest time between queueing and the start of execution. */
+    uint32_t wls_max_latency;
+    /** Longest time spent executing a single work item. */
+    uint32_t wls_max_run;
+    /** Sum of all queueing latencies. */
+    uint64_t wls_total_latency;
+};
+
+/**
+ * @brief Initializes a work item.
+ *
+ * @param work                  The work item to initialize.
+ * @param fn                    The function to execute.  It receives the
+ *                                  work's event; ev_arg holds @p arg.
+ * @param arg                   Argument passed in the event.
+ */
+void workqueue_work_init(struct workqueue_work *work, os_event_fn *fn,
+                         void *arg);
+
+/**
+ * @brief Initializes a delayed work item.
+ *
+ * The delay is timed by an os_callout on the default event queue.
+ *
+ * @param dwork                 The delayed work item to initialize.
+ * @param fn                    The function to execute.
+ * @param arg                   Argument passed in the work's event.
+ */
+void workqueue_delayed_work_init(struct workqueue_delayed_work *dwork,
+                                 os_event_fn *fn, void *arg);
+
+/**
+ * @brief Queues work on the given lane.
+ *
+ * May be called from interrupt context.
+ *
+ * @param work                  The work to queue.
+ * @param lane                  The lane to queue on; 0 is the most urgent.
+ *
+ * @return                      0 if the work was queued;
+ *                              SYS_EALREADY if the work was already pending;
+ *                              SYS_EINVAL if the lane is out of range.
+ */
+int workqueue_submit(struct workqueue_work *work, uint8_t lane);
+
+/**
+ * @brief Queues work on the given lane after a delay.
+ *
+ * If the delayed work is already armed or queued, this is a no-op; the
+ * original deadline is kept.
+ *
+ * @param dwork                 The delayed work to queue.
+ * @param lane                  The lane to queue on; 0 is the most urgent.
+ * @param ticks                 The delay, in OS ticks.
+ *
+ * @return                      0 if the work was armed or queued;
+ *                              SYS_EALREADY if the work was already pending;
+ *                              SYS_EINVAL on bad arguments.
+ */
+int workqueue_submit_delayed(struct workqueue_delayed_work *dwork,
+                             uint8_t lane, os_time_t ticks);
+
+/**
+ * @brief Removes work from its lane if it has not started running.
+ *
+ * @param work                  The work to cancel.
+ *
+ * @return                      0 if the work was removed;
+ *                              SYS_ENOENT if the work was not pending.
+ */
+int workqueue_cancel(struct workqueue_work *work);
+
+/**
+ * @brief Disarms delayed work and removes it from its lane.
+ *
+ * @param dwork                 The delayed work to cancel.
+ *
+ * @return                      0 if the work was armed or queued;
+ *                              SYS_ENOENT if the work was not pending.
+ */
+int workqueue_cancel_delayed(struct workqueue_delayed_work *dwork);
+
+/**
+ * @brief Indicates whether work is waiting on a lane.
+ *
+ * @param work                  The work to check.
+ *
+ * @return                      1 if queued, 0 otherwise.
+ */
+static inline int
+workqueue_work_pending(const struct workqueue_work *work)
+{
+    return OS_EVENT_QUEUED(&work->ww_ev) != 0;
+}
+
+#if MYNEWT_VAL(WORKQUEUE_STATS)
+/**
+ * @brief Retrieves a snapshot of a lane's statistics.
+ *
+ * @param lane                  The lane to read.
+ * @param out_stats             The statistics get written here.
+ *
+ * @return                      0 on success; SYS_EINVAL on bad lane.
+ */
+int workqueue_stats_get(uint8_t lane, struct workqueue_lane_stats *out_stats);
+
+/**
+ * @brief Clears the statistics of all lanes.
+ */
+void workqueue_stats_reset(void);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,78 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "workqueue/workqueue.h"
+#include "workqueue_test.h"
+
+#define WTCD_LANE           1
+#define WTCD_DELAY          3
+
+static struct workqueue_delayed_work wtcd_dwork;
+static int wtcd_num_run;
+
+static void
+wtcd_fn(struct os_event *ev)
+{
+    wtcd_num_run++;
+}
+
+TEST_CASE_TASK(workqueue_test_case_delayed)
+{
+    struct workqueue_lane_stats stats;
+    int rc;
+
+    workqueue_delayed_work_init(&wtcd_dwork, wtcd_fn, NULL);
+
+    /* Armed work does not run before its deadline and is not rearmed. */
+    rc = workqueue_submit_delayed(&wtcd_dwork, WTCD_LANE, WTCD_DELAY);
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = workqueue_submit_delayed(&wtcd_dwork, WTCD_LANE, WTCD_DELAY);
+    TEST_ASSERT(rc == SYS_EALREADY);
+    TEST_ASSERT(wtcd_num_run == 0);
+
+    os_time_delay(WTCD_DELAY * 2);
+    TEST_ASSERT(wtcd_num_run == 1);
+    TEST_ASSERT(!workqueue_work_pending(&wtcd_dwork.wdw_work));
+
+    /* Cancelled work never runs. */
+    rc = workqueue_submit_delayed(&wtcd_dwork, WTCD_LANE, WTCD_DELAY);
+    TEST_ASSERT_FATAL(rc == 0);
+    rc = workqueue_cancel_delayed(&wtcd_dwork);
+    TEST_ASSERT(rc == 0);
+    rc = workqueue_cancel_delayed(&wtcd_dwork);
+    TEST_ASSERT(rc == SYS_ENOENT);
+
+    os_time_delay(WTCD_DELAY * 2);
+    TEST_ASSERT(wtcd_num_run == 1);
+
+    /* A zero delay queues the work immediately. */
+    rc = workqueue_submit_delayed(&wtcd_dwork, WTCD_LANE, 0);
+    TEST_ASSERT(rc == 0);
+    TEST_ASSERT(wtcd_num_run == 2);
+
+    rc = workqueue_submit_delayed(&wtcd_dwork,
+                                  MYNEWT_VAL(WORKQUEUE_NUM_LANES), 1);
+    TEST_ASSERT(rc == SYS_EINVAL);
+
+    rc = workqueue_stats_get(WTCD_LANE, &stats);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(stats.wls_submitted == 2);
+    TEST_ASSERT(stats.wls_coalesced == 1);
+    TEST_ASSERT(stats.wls_executed == 2);
+}
@@ -0,0 +1,149 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "workqueue/workqueue.h"
+#include "workqueue_test.h"
+
+#define WTCL_LANE_HIGH      0
+#define WTCL_LANE_MID       1
+#define WTCL_LANE_LOW       2
+
+static struct os_sem wtcl_block_sem;
+
+static struct workqueue_work wtcl_block[MYNEWT_VAL(WORKQUEUE_NUM_WORKERS)];
+static struct workqueue_work wtcl_high;
+static struct workqueue_work wtcl_mid;
+static struct workqueue_work wtcl_low;
+static struct workqueue_work wtcl_cancelled;
+
+static struct workqueue_work *wtcl_order[8];
+static int wtcl_num_run;
+
+static void
+wtcl_block_fn(struct os_event *ev)
+{
+    os_sem_pend(&wtcl_block_sem, OS_TIMEOUT_NEVER);
+}
+
+static void
+wtcl_record_fn(struct os_event *ev)
+{
+    if (wtcl_num_run < sizeof wtcl_order / sizeof wtcl_order[0]) {
+        wtcl_order[wtcl_num_run] = ev->ev_arg;
+    }
+    wtcl_num_run++;
+}
+
+TEST_CASE_TASK(workqueue_test_case_lanes)
+{
+    struct workqueue_lane_stats stats;
+    int rc;
+    int i;
+
+    os_sem_init(&wtcl_block_sem, 0);
+
+    workqueue_work_init(&wtcl_high, wtcl_record_fn, &wtcl_high);
+    workqueue_work_init(&wtcl_mid, wtcl_record_fn, &wtcl_mid);
+    workqueue_work_init(&wtcl_low, wtcl_record_fn, &wtcl_low);
+    workqueue_work_init(&wtcl_cancelled, wtcl_record_fn, &wtcl_cancelled);
+
+    rc = workqueue_submit(&wtcl_low, MYNEWT_VAL(WORKQUEUE_NUM_LANES));
+    TEST_ASSERT(rc == SYS_EINVAL);
+
+    /* Occupy every worker so that submitted work stays queued. */
+    for (i = 0; i < MYNEWT_VAL(WORKQUEUE_NUM_WORKERS); i++) {
+        workqueue_work_init(&wtcl_block[i], wtcl_block_fn, NULL);
+        rc = workqueue_submit(&wtcl_block[i], WTCL_LANE_LOW);
+        TEST_ASSERT_FATAL(rc == 0);
+        TEST_ASSERT(!workqueue_work_pending(&wtcl_block[i]));
+    }
+
+    /* Queue in reverse priority order; resubmitting pending work is a
+     * no-op.
+     */
+    rc = workqueue_submit(&wtcl_low, WTCL_LANE_LOW);
+    TEST_ASSERT(rc == 0);
+    rc = workqueue_submit(&wtcl_mid, WTCL_LANE_MID);
+    TEST_ASSERT(rc == 0);
+    rc = workqueue_submit(&wtcl_cancelled, WTCL_LANE_MID);
+    TEST_ASSERT(rc == 0);
+    rc = workqueue_submit(&wtcl_high, WTCL_LANE_HIGH);
+    TEST_ASSERT(rc == 0);
+    rc = workqueue_submit(&wtcl_low, WTCL_LANE_LOW);
+    TEST_ASSERT(rc == SYS_EALREADY);
+    TEST_ASSERT(workqueue_work_pending(&wtcl_low));
+    TEST_ASSERT(wtcl_num_run == 0);
+
+    rc = workqueue_cancel(&wtcl_cancelled);
+    TEST_ASSERT(rc == 0);
+    rc = workqueue_cancel(&wtcl_cancelled);
+    TEST_ASSERT(rc == SYS_ENOENT);
+
+    /* Let the queued work accumulate some latency. */
+    os_time_delay(1);
+
+    /* Free one worker; it drains the lanes most urgent first. */
+    os_sem_release(&wtcl_block_sem);
+    TEST_ASSERT_FATAL(wtcl_num_run == 3);
+    TEST_ASSERT(wtcl_order[0] == &wtcl_high);
+    TEST_ASSERT(wtcl_order[1] == &wtcl_mid);
+    TEST_ASSERT(wtcl_order[2] == &wtcl_low);
+
+    for (i = 1; i < MYNEWT_VAL(WORKQUEUE_NUM_WORKERS); i++) {
+        os_sem_release(&wtcl_block_sem);
+    }
+    TEST_ASSERT(wtcl_num_run == 3);
+
+    /* Idle workers run new work immediately. */
+    rc = workqueue_submit(&wtcl_low, WTCL_LANE_LOW);
+    TEST_ASSERT(rc == 0);
+    TEST_ASSERT_FATAL(wtcl_num_run == 4);
+    TEST_ASSERT(wtcl_order[3] == &wtcl_low);
+
+    rc = workqueue_stats_get(WTCL_LANE_HIGH, &stats);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(stats.wls_submitted == 1);
+    TEST_ASSERT(stats.wls_coalesced == 0);
+    TEST_ASSERT(stats.wls_executed == 1);
+    TEST_ASSERT(stats.wls_max_latency > 0);
+    TEST_ASSERT(stats.wls_total_latency == stats.wls_max_latency);
+
+    rc = workqueue_stats_get(WTCL_LANE_MID, &stats);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(stats.wls_submitted == 2);
+    TEST_ASSERT(stats.wls_executed == 1);
+
+    rc = workqueue_stats_get(WTCL_LANE_LOW, &stats);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(stats.wls_submitted ==
+                MYNEWT_VAL(WORKQUEUE_NUM_WORKERS) + 2);
+    TEST_ASSERT(stats.wls_coalesced == 1);
+    TEST_ASSERT(stats.wls_executed == MYNEWT_VAL(WORKQUEUE_NUM_WORKERS) + 2);
+    TEST_ASSERT(stats.wls_max_run > 0);
+
+    rc = workqueue_stats_get(MYNEWT_VAL(WORKQUEUE_NUM_LANES), &stats);
+    TEST_ASSERT(rc == SYS_EINVAL);
+
+    workqueue_stats_reset();
+    rc = workqueue_stats_get(WTCL_LANE_LOW, &stats);
+    TEST_ASSERT_FATAL(rc == 0);
+    TEST_ASSERT(stats.wls_submitted == 0);
+    TEST_ASSERT(stats.wls_executed == 0);
+    TEST_ASSERT(stats.wls_max_latency == 0);
+}
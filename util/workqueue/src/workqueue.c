@@ -0,0 +1,340 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/**
+ * The workqueue module runs deferred work on a fixed set of worker tasks.
+ *
+ * Each lane is a plain os_eventq used as a FIFO.  A counting semaphore gets
+ * a token for each submitted work item; a worker waits for a token and then
+ * runs work from the most urgent non-empty lane, pulled with a zero-timeout
+ * os_eventq_poll(), until every lane is empty.  Workers never block on the
+ * eventqs themselves, since an eventq only tracks a single waiting task.
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "os/mynewt.h"
+#include "workqueue/workqueue.h"
+
+#define WORKQUEUE_NUM_LANES     MYNEWT_VAL(WORKQUEUE_NUM_LANES)
+#define WORKQUEUE_NUM_WORKERS   MYNEWT_VAL(WORKQUEUE_NUM_WORKERS)
+
+/** Represents a single worker task. */
+struct workqueue_worker {
+    OS_TASK_STACK_DEFINE_NOSTATIC(stack, MYNEWT_VAL(WORKQUEUE_STACK_SIZE));
+    struct os_task task;
+    char name[sizeof "wqXX"];
+};
+
+static struct workqueue_worker workqueue_workers[WORKQUEUE_NUM_WORKERS];
+
+static struct os_eventq workqueue_lanes[WORKQUEUE_NUM_LANES];
+
+/** Lane pointers in priority order, as expected by os_eventq_poll(). */
+static struct os_eventq *workqueue_lane_ptrs[WORKQUEUE_NUM_LANES];
+
+/** One token per queued work item. */
+static struct os_sem workqueue_sem;
+
+#if MYNEWT_VAL(WORKQUEUE_STATS)
+static struct workqueue_lane_stats workqueue_stats[WORKQUEUE_NUM_LANES];
+#endif
+
+/**
+ * Runs the first work item of the most urgent non-empty lane.
+ *
+ * @return 1 if a work item was run, 0 if every lane was empty.
+ */
+static int
+workqueue_run_one(void)
+{
+    struct workqueue_work *work;
+    struct os_event *ev;
+#if MYNEWT_VAL(WORKQUEUE_STATS)
+    struct workqueue_lane_stats *stats;
+    uint32_t latency;
+    uint32_t start;
+    uint32_t run;
+    uint8_t lane;
+#endif
+    os_sr_t sr;
+
+    OS_ENTER_CRITICAL(sr);
+    ev = os_eventq_poll(workqueue_lane_ptrs, WORKQUEUE_NUM_LANES, 0);
+    if (ev != NULL) {
+        work = CONTAINER_OF(ev, struct workqueue_work, ww_ev);
+#if MYNEWT_VAL(WORKQUEUE_STATS)
+        start = os_cputime_get32();
+        latency = start - work->ww_queued_at;
+        lane = work->ww_lane;
+#endif
+    }
+    OS_EXIT_CRITICAL(sr);
+
+    if (ev == NULL) {
+        return 0;
+    }
+
+    ev->ev_cb(ev);
+
+#if MYNEWT_VAL(WORKQUEUE_STATS)
+    run = os_cputime_get32() - start;
+    stats = &workqueue_stats[lane];
+
+    OS_ENTER_CRITICAL(sr);
+    stats->wls_executed++;
+    stats->wls_total_latency += latency;
+    if (latency > stats->wls_max_latency) {
+        stats->wls_max_latency = latency;
+    }
+    if (run > stats->wls_max_run) {
+        stats->wls_max_run = run;
+    }
+    OS_EXIT_CRITICAL(sr);
+#endif
+
+    return 1;
+}
+
+static void
+workqueue_worker_handler(void *arg)
+{
+    while (1) {
+        /* Drain the lanes before every wait.  Work submitted before
+         * os_start() got no semaphore token, and tokens left by cancelled or
+         * already drained work only cause an empty pass.
+         */
+        while (workqueue_run_one()) {
+        }
+
+        os_sem_pend(&workqueue_sem, OS_TIMEOUT_NEVER);
+    }
+}
+
+void
+workqueue_work_init(struct workqueue_work *work, os_event_fn *fn, void *arg)
+{
+    memset(work, 0, sizeof *work);
+    work->ww_ev.ev_cb = fn;
+    work->ww_ev.ev_arg = arg;
+}
+
+static void
+workqueue_delayed_expire(struct os_event *ev)
+{
+    struct workqueue_delayed_work *dwork;
+
+    dwork = ev->ev_arg;
+    workqueue_submit(&dwork->wdw_work, dwork->wdw_work.ww_lane);
+}
+
+void
+workqueue_delayed_work_init(struct workqueue_delayed_work *dwork,
+                            os_event_fn *fn, void *arg)
+{
+    workqueue_work_init(&dwork->wdw_work, fn, arg);
+    os_callout_init(&dwork->wdw_callout, os_eventq_dflt_get(),
+                    workqueue_delayed_expire, dwork);
+}
+
+int
+workqueue_submit(struct workqueue_work *work, uint8_t lane)
+{
+    os_sr_t sr;
+
+    if (lane >= WORKQUEUE_NUM_LANES) {
+        return SYS_EINVAL;
+    }
+
+    OS_ENTER_CRITICAL(sr);
+
+    if (OS_EVENT_QUEUED(&work->ww_ev)) {
+#if MYNEWT_VAL(WORKQUEUE_STATS)
+        workqueue_stats[work->ww_lane].wls_coalesced++;
+#endif
+        OS_EXIT_CRITICAL(sr);
+        return SYS_EALREADY;
+    }
+
+    work->ww_lane = lane;
+#if MYNEWT_VAL(WORKQUEUE_STATS)
+    work->ww_queued_at = os_cputime_get32();
+    workqueue_stats[lane].wls_submitted++;
+#endif
+    os_eventq_put(&workqueue_lanes[lane], &work->ww_ev);
+
+    OS_EXIT_CRITICAL(sr);
+
+    /* Fails with OS_NOT_STARTED before os_start(); the workers drain the
+     * lanes when they first run.
+     */
+    os_sem_release(&workqueue_sem);
+
+    return 0;
+}
+
+int
+workqueue_submit_delayed(struct workqueue_delayed_work *dwork,
+                         uint8_t lane, os_time_t ticks)
+{
+    os_sr_t sr;
+    int rc;
+
+    if (lane >= WORKQUEUE_NUM_LANES) {
+        return SYS_EINVAL;
+    }
+
+    if (ticks == 0) {
+        return workqueue_submit(&dwork->wdw_work, lane);
+    }
+
+    OS_ENTER_CRITICAL(sr);
+
+    if (os_callout_queued(&dwork->wdw_callout) ||
+        OS_EVENT_QUEUED(&dwork->wdw_callout.c_ev) ||
+        OS_EVENT_QUEUED(&dwork->wdw_work.ww_ev)) {
+#if MYNEWT_VAL(WORKQUEUE_STATS)
+        workqueue_stats[dwork->wdw_work.ww_lane].wls_coalesced++;
+#endif
+        OS_EXIT_CRITICAL(sr);
+        return SYS_EALREADY;
+    }
+
+    dwork->wdw_work.ww_lane = lane;
+    rc = os_callout_reset(&dwork->wdw_callout, ticks);
+
+    OS_EXIT_CRITICAL(sr);
+
+    if (rc != 0) {
+        return SYS_EINVAL;
+    }
+
+    return 0;
+}
+
+int
+workqueue_cancel(struct workqueue_work *work)
+{
+    os_sr_t sr;
+    int rc;
+
+    OS_ENTER_CRITICAL(sr);
+
+    if (OS_EVENT_QUEUED(&work->ww_ev)) {
+        /* The semaphore token stays behind; the worker that takes it may
+         * find nothing to do.
+         */
+        os_eventq_remove(&workqueue_lanes[work->ww_lane], &work->ww_ev);
+        rc = 0;
+    } else {
+        rc = SYS_ENOENT;
+    }
+
+    OS_EXIT_CRITICAL(sr);
+
+    return rc;
+}
+
+int
+workqueue_cancel_delayed(struct workqueue_delayed_work *dwork)
+{
+    os_sr_t sr;
+    int armed;
+    int rc;
+
+    OS_ENTER_CRITICAL(sr);
+
+    armed = os_callout_queued(&dwork->wdw_callout) ||
+            OS_EVENT_QUEUED(&dwork->wdw_callout.c_ev);
+    os_callout_stop(&dwork->wdw_callout);
+
+    rc = workqueue_cancel(&dwork->wdw_work);
+    if (armed) {
+        rc = 0;
+    }
+
+    OS_EXIT_CRITICAL(sr);
+
+    return rc;
+}
+
+#if MYNEWT_VAL(WORKQUEUE_STATS)
+int
+workqueue_stats_get(uint8_t lane, struct workqueue_lane_stats *out_stats)
+{
+    os_sr_t sr;
+
+    if (lane >= WORKQUEUE_NUM_LANES) {
+        return SYS_EINVAL;
+    }
+
+    OS_ENTER_CRITICAL(sr);
+    *out_stats = workqueue_stats[lane];
+    OS_EXIT_CRITICAL(sr);
+
+    return 0;
+}
+
+void
+workqueue_stats_reset(void)
+{
+    os_sr_t sr;
+
+    OS_ENTER_CRITICAL(sr);
+    memset(workqueue_stats, 0, sizeof workqueue_stats);
+    OS_EXIT_CRITICAL(sr);
+}
+#endif
+
+void
+workqueue_init(void)
+{
+    struct workqueue_worker *worker;
+    int rc;
+    int i;
+
+    /* Ensure this function only gets called by sysinit. */
+    SYSINIT_ASSERT_ACTIVE();
+
+    for (i = 0; i < WORKQUEUE_NUM_LANES; i++) {
+        os_eventq_init(&workqueue_lanes[i]);
+        workqueue_lane_ptrs[i] = &workqueue_lanes[i];
+    }
+
+    rc = os_sem_init(&workqueue_sem, 0);
+    SYSINIT_PANIC_ASSERT(rc == 0 || rc == OS_NOT_STARTED);
+
+#if MYNEWT_VAL(WORKQUEUE_STATS)
+    memset(workqueue_stats, 0, sizeof workqueue_stats);
+#endif
+
+    for (i = 0; i < WORKQUEUE_NUM_WORKERS; i++) {
+        worker = &workqueue_workers[i];
+        snprintf(worker->name, sizeof worker->name, "wq%02d", i);
+
+        rc = os_task_init(&worker->task, worker->name,
+                          workqueue_worker_handler, NULL,
+                          MYNEWT_VAL(WORKQUEUE_TASK_PRIO) + i,
+                          OS_WAIT_FOREVER, worker->stack,
+                          MYNEWT_VAL(WORKQUEUE_STACK_SIZE));
+        SYSINIT_PANIC_ASSERT(rc == 0);
+    }
+}